@@ -22,6 +22,21 @@
 #include "bmpset.h"
 #include "uassert.h"
 
+#if U_HAVE_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+ * Number of code units which the span functions test one at a time
+ * before they try blocks, and the longest stretch between block tests.
+ * Most spans are shorter, and a block test which does not get through
+ * a whole block costs about as much as testing dozens of code units.
+ */
+#define BMP_SPAN_STRETCH (8*U_SIMD_MIN_LENGTH)
+#endif
+
 U_NAMESPACE_BEGIN
 
 BMPSet::BMPSet(const int32_t *parentList, int32_t parentListLength) :
@@ -46,6 +61,7 @@ BMPSet::BMPSet(const int32_t *parentList, int32_t parentListLength) :
 
     initBits();
     overrideIllegal();
+    initASCIIRanges();
 }
 
 BMPSet::BMPSet(const BMPSet &otherBMPSet, const int32_t *newParentList, int32_t newParentListLength) :
@@ -54,6 +70,9 @@ BMPSet::BMPSet(const BMPSet &otherBMPSet, const int32_t *newParentList, int32_t
     uprv_memcpy(table7FF, otherBMPSet.table7FF, sizeof(table7FF));
     uprv_memcpy(bmpBlockBits, otherBMPSet.bmpBlockBits, sizeof(bmpBlockBits));
     uprv_memcpy(list4kStarts, otherBMPSet.list4kStarts, sizeof(list4kStarts));
+    uprv_memcpy(asciiRangeStarts, otherBMPSet.asciiRangeStarts, sizeof(asciiRangeStarts));
+    uprv_memcpy(asciiRangeLasts, otherBMPSet.asciiRangeLasts, sizeof(asciiRangeLasts));
+    asciiRangeCount=otherBMPSet.asciiRangeCount;
 }
 
 BMPSet::~BMPSet() {
@@ -239,38 +258,23 @@ void BMPSet::overrideIllegal() {
     }
 }
 
-int32_t BMPSet::findCodePoint(UChar32 c, int32_t lo, int32_t hi) const {
-    /* Examples:
-                                       findCodePoint(c)
-       set              list[]         c=0 1 3 4 7 8
-       ===              ==============   ===========
-       []               [110000]         0 0 0 0 0 0
-       [\u0000-\u0003]  [0, 4, 110000]   1 1 1 2 2 2
-       [\u0004-\u0007]  [4, 8, 110000]   0 0 0 1 1 2
-       [:Any:]          [0, 110000]      1 1 1 1 1 1
-     */
-
-    // Return the smallest i such that c < list[i].  Assume
-    // list[len - 1] == HIGH and that c is legal (0..HIGH-1).
-    if (c < list[lo])
-        return lo;
-    // High runner test.  c is often after the last range, so an
-    // initial check for this condition pays off.
-    if (lo >= hi || c >= list[hi-1])
-        return hi;
-    // invariant: c >= list[lo]
-    // invariant: c < list[hi]
-    for (;;) {
-        int32_t i = (lo + hi) >> 1;
-        if (i == lo) {
-            break; // Found!
-        } else if (c < list[i]) {
-            hi = i;
-        } else {
-            lo = i;
+void BMPSet::initASCIIRanges() {
+    asciiRangeCount=0;
+    // The list is terminated with 0x110000, so list[i+1] exists when list[i]<0x80,
+    // but nothing follows a range which ends at or after 0x80.
+    for(int32_t i=0; list[i]<0x80; i+=2) {
+        if(asciiRangeCount==(int32_t)(sizeof(asciiRangeStarts)/sizeof(asciiRangeStarts[0]))) {
+            asciiRangeCount=-1;  // Too many ranges to be worth testing in parallel.
+            return;
+        }
+        UChar32 limit=list[i+1]<0x80 ? list[i+1] : 0x80;
+        uprv_memset(asciiRangeStarts[asciiRangeCount], list[i], 16);
+        uprv_memset(asciiRangeLasts[asciiRangeCount], limit-list[i]-1, 16);
+        ++asciiRangeCount;
+        if(limit==0x80) {
+            break;
         }
     }
-    return hi;
 }
 
 UBool
@@ -300,13 +304,217 @@ BMPSet::contains(UChar32 c) const {
     }
 }
 
+#if U_HAVE_SSE2
+
+/*
+ * Block-oriented span implementation.
+ * Blocks of 16 code units are tested with SSE2, see ustrsimd.h.
+ * Code units which are not handled by a block test are handled
+ * one code point at a time, as in the functions above.
+ */
+
+/* Returns the index of the lowest set bit. mask must not be 0. */
+static inline int32_t lowestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int32_t)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/* Returns the index of the highest set bit. mask must not be 0. */
+static inline int32_t highestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (int32_t)index;
+#else
+    return 31-__builtin_clz(mask);
+#endif
+}
+
+/*
+ * Returns a bit mask with bit i set if byte i of the block is an ASCII code point c
+ * with set.contains(c)==spanCondition.
+ * starts[] and lasts[] are the set's ASCII range starts and lengths-1
+ * in all 16 bytes of each row.
+ *
+ * Code point x is in a range if (x-start) as an unsigned value is at most last,
+ * that is, if (x-start)-last saturates to 0.
+ * Since each range ends at or below U+007F, bytes 80..FF are never in a range.
+ */
+static inline uint32_t
+matchASCIIBytes(__m128i bytes, const uint8_t starts[][16], const uint8_t lasts[][16],
+                int32_t rangeCount, UBool spanCondition) {
+    const __m128i zero=_mm_setzero_si128();
+    __m128i in=zero;
+    for(int32_t i=0; i<rangeCount; ++i) {
+        in=_mm_or_si128(in, _mm_cmpeq_epi8(
+            _mm_subs_epu8(_mm_sub_epi8(bytes, _mm_loadu_si128((const __m128i *)starts[i])),
+                          _mm_loadu_si128((const __m128i *)lasts[i])),
+            zero));
+    }
+    uint32_t mask=(uint32_t)_mm_movemask_epi8(in);
+    if(!spanCondition) {
+        mask=~(mask|(uint32_t)_mm_movemask_epi8(bytes))&0xffff;
+    }
+    return mask;
+}
+
+/*
+ * Packs s[0..15] into 16 bytes, with each non-ASCII code unit u turned into 80,
+ * so that it can be tested with matchASCIIBytes():
+ * min(u, 80)=u-((u-80) saturated to 0)
+ */
+static inline __m128i
+packASCII(const UChar *s) {
+    const __m128i x80=_mm_set1_epi16(0x80);
+    __m128i units0=_mm_loadu_si128((const __m128i *)s);
+    __m128i units1=_mm_loadu_si128((const __m128i *)(s+8));
+    units0=_mm_sub_epi16(units0, _mm_subs_epu16(units0, x80));
+    units1=_mm_sub_epi16(units1, _mm_subs_epu16(units1, x80));
+    return _mm_packus_epi16(units0, units1);
+}
+
+UBool
+BMPSet::findRange(UChar32 c, UChar32 &rangeStart, UChar32 &rangeLimit) const {
+    int32_t lo, hi;
+    if(c<=0x7ff) {
+        lo=0;
+        hi=list4kStarts[0];
+    } else {
+        // Not using bmpBlockBits[]: A range is usually longer than one 64-block,
+        // and the search is short where the 4k block is not mixed.
+        int lead=c>>12;
+        lo=list4kStarts[lead];
+        hi=list4kStarts[lead+1];
+    }
+    int32_t i=findCodePoint(c, lo, hi);
+    rangeStart= i>0 ? list[i-1] : 0;
+    rangeLimit=list[i];
+    if(c<0xd800) {
+        if(rangeLimit>0xd800) {
+            rangeLimit=0xd800;
+        }
+    } else {
+        if(rangeStart<0xe000) {
+            rangeStart=0xe000;
+        }
+        if(rangeLimit>0x10000) {
+            rangeLimit=0x10000;
+        }
+    }
+    return (UBool)(i&1);
+}
+
+/*
+ * Returns a bit mask with bit i set if s[i] (i=0..15) is in
+ * the range which starts at start and has length last+1 in each 16-bit lane.
+ */
+static inline uint32_t
+matchRangeUnits(const UChar *s, __m128i start, __m128i last) {
+    const __m128i zero=_mm_setzero_si128();
+    __m128i in0=_mm_cmpeq_epi16(
+        _mm_subs_epu16(_mm_sub_epi16(_mm_loadu_si128((const __m128i *)s), start), last), zero);
+    __m128i in1=_mm_cmpeq_epi16(
+        _mm_subs_epu16(_mm_sub_epi16(_mm_loadu_si128((const __m128i *)(s+8)), start), last), zero);
+    return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(in0, in1));
+}
+
+/*
+ * ASCII code units are compared with the set's ASCII ranges,
+ * and the other code units with one range of the inversion list,
+ * the one which contains the first of them that did not match so far.
+ * The initial range contains only U+0000 which is ASCII, that is,
+ * no non-ASCII code unit matches it.
+ * Without ASCII ranges (too many of them), ASCII code units end the blocks.
+ */
+const UChar *
+BMPSet::spanBlocks(const UChar *s, const UChar *limit, UBool spanCondition) const {
+    int32_t rangeCount=asciiRangeCount;
+    __m128i start=_mm_setzero_si128(), last=_mm_setzero_si128();
+    UChar32 rangeStart, rangeLimit;
+    while((limit-s)>=U_SIMD_MIN_LENGTH) {
+        __m128i bytes=packASCII(s);
+        uint32_t nonASCII=(uint32_t)_mm_movemask_epi8(bytes);
+        uint32_t mask= rangeCount>=0 ?
+            matchASCIIBytes(bytes, asciiRangeStarts, asciiRangeLasts, rangeCount, spanCondition) : 0;
+        if(nonASCII!=0) {
+            mask|=matchRangeUnits(s, start, last)&nonASCII;
+        }
+        if(mask!=0xffff) {
+            // Look up the range of the first mismatch once.
+            int32_t i=lowestBit(~mask);
+            UChar c=s[i];
+            if(c<=0x7f || U16_IS_SURROGATE(c) || findRange(c, rangeStart, rangeLimit)!=spanCondition) {
+                return s+i;
+            }
+            start=_mm_set1_epi16((short)rangeStart);
+            last=_mm_set1_epi16((short)(rangeLimit-rangeStart-1));
+            mask|=matchRangeUnits(s, start, last)&nonASCII;
+            if(mask!=0xffff) {
+                return s+lowestBit(~mask);
+            }
+        }
+        s+=16;
+    }
+    return s;
+}
+
+/* Symmetrical with spanBlocks(). */
+const UChar *
+BMPSet::spanBackBlocks(const UChar *s, const UChar *limit, UBool spanCondition) const {
+    int32_t rangeCount=asciiRangeCount;
+    __m128i start=_mm_setzero_si128(), last=_mm_setzero_si128();
+    UChar32 rangeStart, rangeLimit;
+    while((limit-s)>=U_SIMD_MIN_LENGTH) {
+        const UChar *block=limit-16;
+        __m128i bytes=packASCII(block);
+        uint32_t nonASCII=(uint32_t)_mm_movemask_epi8(bytes);
+        uint32_t mask= rangeCount>=0 ?
+            matchASCIIBytes(bytes, asciiRangeStarts, asciiRangeLasts, rangeCount, spanCondition) : 0;
+        if(nonASCII!=0) {
+            mask|=matchRangeUnits(block, start, last)&nonASCII;
+        }
+        if(mask!=0xffff) {
+            int32_t i=highestBit(~mask&0xffff);
+            UChar c=block[i];
+            if(c<=0x7f || U16_IS_SURROGATE(c) || findRange(c, rangeStart, rangeLimit)!=spanCondition) {
+                return block+i+1;
+            }
+            start=_mm_set1_epi16((short)rangeStart);
+            last=_mm_set1_epi16((short)(rangeLimit-rangeStart-1));
+            mask|=matchRangeUnits(block, start, last)&nonASCII;
+            if(mask!=0xffff) {
+                return block+highestBit(~mask&0xffff)+1;
+            }
+        }
+        limit=block;
+    }
+    return limit;
+}
+
+#endif  /* U_HAVE_SSE2 */
+
 /*
  * Check for sufficient length for trail unit for each surrogate pair.
  * Handle single surrogates as surrogate code points as usual in ICU.
+ *
+ * Most spans are short. Test one code point at a time until stop;
+ * a longer span continues with blocks of code units in spanWithBlocks().
+ * Calling that only as the last step keeps this function as cheap as before
+ * for short spans. A surrogate pair may straddle stop.
  */
 const UChar *
 BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition) const {
     UChar c, c2;
+#if U_HAVE_SSE2
+    const UChar *stop=(limit-s)>=2*BMP_SPAN_STRETCH ? s+BMP_SPAN_STRETCH : limit;
+#else
+    const UChar *stop=limit;
+#endif
 
     if(spanCondition) {
         // span
@@ -314,11 +522,11 @@ BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition
             c=*s;
             if(c<=0x7f) {
                 if(!asciiBytes[c]) {
-                    break;
+                    return s;
                 }
             } else if(c<=0x7ff) {
                 if((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))==0) {
-                    break;
+                    return s;
                 }
             } else if(c<0xd800 || c>=0xe000) {
                 int lead=c>>12;
@@ -327,38 +535,43 @@ BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition
                     // All 64 code points with the same bits 15..6
                     // are either in the set or not.
                     if(twoBits==0) {
-                        break;
+                        return s;
                     }
                 } else {
                     // Look up the code point in its 4k block of code points.
                     if(!containsSlow(c, list4kStarts[lead], list4kStarts[lead+1])) {
-                        break;
+                        return s;
                     }
                 }
             } else if(c>=0xdc00 || (s+1)==limit || (c2=s[1])<0xdc00 || c2>=0xe000) {
                 // surrogate code point
                 if(!containsSlow(c, list4kStarts[0xd], list4kStarts[0xe])) {
-                    break;
+                    return s;
                 }
             } else {
                 // surrogate pair
                 if(!containsSlow(U16_GET_SUPPLEMENTARY(c, c2), list4kStarts[0x10], list4kStarts[0x11])) {
-                    break;
+                    return s;
                 }
                 ++s;
             }
-        } while(++s<limit);
+        } while(++s<stop);
+#if U_HAVE_SSE2
+        if(s<limit) {
+            return spanWithBlocks(s, limit, USET_SPAN_CONTAINED);
+        }
+#endif
     } else {
         // span not
         do {
             c=*s;
             if(c<=0x7f) {
                 if(asciiBytes[c]) {
-                    break;
+                    return s;
                 }
             } else if(c<=0x7ff) {
                 if((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0) {
-                    break;
+                    return s;
                 }
             } else if(c<0xd800 || c>=0xe000) {
                 int lead=c>>12;
@@ -367,27 +580,32 @@ BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition
                     // All 64 code points with the same bits 15..6
                     // are either in the set or not.
                     if(twoBits!=0) {
-                        break;
+                        return s;
                     }
                 } else {
                     // Look up the code point in its 4k block of code points.
                     if(containsSlow(c, list4kStarts[lead], list4kStarts[lead+1])) {
-                        break;
+                        return s;
                     }
                 }
             } else if(c>=0xdc00 || (s+1)==limit || (c2=s[1])<0xdc00 || c2>=0xe000) {
                 // surrogate code point
                 if(containsSlow(c, list4kStarts[0xd], list4kStarts[0xe])) {
-                    break;
+                    return s;
                 }
             } else {
                 // surrogate pair
                 if(containsSlow(U16_GET_SUPPLEMENTARY(c, c2), list4kStarts[0x10], list4kStarts[0x11])) {
-                    break;
+                    return s;
                 }
                 ++s;
             }
-        } while(++s<limit);
+        } while(++s<stop);
+#if U_HAVE_SSE2
+        if(s<limit) {
+            return spanWithBlocks(s, limit, USET_SPAN_NOT_CONTAINED);
+        }
+#endif
     }
     return s;
 }
@@ -396,6 +614,11 @@ BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition
 const UChar *
 BMPSet::spanBack(const UChar *s, const UChar *limit, USetSpanCondition spanCondition) const {
     UChar c, c2;
+#if U_HAVE_SSE2
+    const UChar *stop=(limit-s)>=2*BMP_SPAN_STRETCH ? limit-BMP_SPAN_STRETCH : s;
+#else
+    const UChar *stop=s;
+#endif
 
     if(spanCondition) {
         // span
@@ -403,11 +626,11 @@ BMPSet::spanBack(const UChar *s, const UChar *limit, USetSpanCondition spanCondi
             c=*(--limit);
             if(c<=0x7f) {
                 if(!asciiBytes[c]) {
-                    break;
+                    return limit+1;
                 }
             } else if(c<=0x7ff) {
                 if((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))==0) {
-                    break;
+                    return limit+1;
                 }
             } else if(c<0xd800 || c>=0xe000) {
                 int lead=c>>12;
@@ -416,41 +639,46 @@ BMPSet::spanBack(const UChar *s, const UChar *limit, USetSpanCondition spanCondi
                     // All 64 code points with the same bits 15..6
                     // are either in the set or not.
                     if(twoBits==0) {
-                        break;
+                        return limit+1;
                     }
                 } else {
                     // Look up the code point in its 4k block of code points.
                     if(!containsSlow(c, list4kStarts[lead], list4kStarts[lead+1])) {
-                        break;
+                        return limit+1;
                     }
                 }
             } else if(c<0xdc00 || s==limit || (c2=*(limit-1))<0xd800 || c2>=0xdc00) {
                 // surrogate code point
                 if(!containsSlow(c, list4kStarts[0xd], list4kStarts[0xe])) {
-                    break;
+                    return limit+1;
                 }
             } else {
                 // surrogate pair
                 if(!containsSlow(U16_GET_SUPPLEMENTARY(c2, c), list4kStarts[0x10], list4kStarts[0x11])) {
-                    break;
+                    return limit+1;
                 }
                 --limit;
             }
-            if(s==limit) {
-                return s;
+            if(limit<=stop) {
+                break;
             }
         }
+#if U_HAVE_SSE2
+        if(s<limit) {
+            return spanBackWithBlocks(s, limit, USET_SPAN_CONTAINED);
+        }
+#endif
     } else {
         // span not
         for(;;) {
             c=*(--limit);
             if(c<=0x7f) {
                 if(asciiBytes[c]) {
-                    break;
+                    return limit+1;
                 }
             } else if(c<=0x7ff) {
                 if((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0) {
-                    break;
+                    return limit+1;
                 }
             } else if(c<0xd800 || c>=0xe000) {
                 int lead=c>>12;
@@ -459,37 +687,150 @@ BMPSet::spanBack(const UChar *s, const UChar *limit, USetSpanCondition spanCondi
                     // All 64 code points with the same bits 15..6
                     // are either in the set or not.
                     if(twoBits!=0) {
-                        break;
+                        return limit+1;
                     }
                 } else {
                     // Look up the code point in its 4k block of code points.
                     if(containsSlow(c, list4kStarts[lead], list4kStarts[lead+1])) {
-                        break;
+                        return limit+1;
                     }
                 }
             } else if(c<0xdc00 || s==limit || (c2=*(limit-1))<0xd800 || c2>=0xdc00) {
                 // surrogate code point
                 if(containsSlow(c, list4kStarts[0xd], list4kStarts[0xe])) {
-                    break;
+                    return limit+1;
                 }
             } else {
                 // surrogate pair
                 if(containsSlow(U16_GET_SUPPLEMENTARY(c2, c), list4kStarts[0x10], list4kStarts[0x11])) {
-                    break;
+                    return limit+1;
                 }
                 --limit;
             }
-            if(s==limit) {
-                return s;
+            if(limit<=stop) {
+                break;
+            }
+        }
+#if U_HAVE_SSE2
+        if(s<limit) {
+            return spanBackWithBlocks(s, limit, USET_SPAN_NOT_CONTAINED);
+        }
+#endif
+    }
+    return s;
+}
+
+#if U_HAVE_SSE2
+
+/*
+ * Alternates between blocks and stretches of single code points
+ * until a stretch ends the span.
+ * Stretches get shorter while blocks get far, and longer while they do not.
+ * A stretch calls span() with a limit which is too close for that
+ * to call back here, and which does not split a surrogate pair.
+ */
+const UChar *
+BMPSet::spanWithBlocks(const UChar *s, const UChar *limit, USetSpanCondition spanCondition) const {
+    UBool tf=(UBool)(spanCondition!=USET_SPAN_NOT_CONTAINED);
+    int32_t stretch=BMP_SPAN_STRETCH;
+    for(;;) {
+        const UChar *start=s;
+        s=spanBlocks(s, limit, tf);
+        if(s==limit) {
+            return s;
+        }
+        if((s-start)>=U_SIMD_MIN_LENGTH) {
+            stretch=U_SIMD_MIN_LENGTH;
+        } else if(stretch<BMP_SPAN_STRETCH) {
+            stretch*=2;
+        }
+        if((limit-s)<2*stretch) {
+            return span(s, limit, spanCondition);
+        }
+        const UChar *stop=s+stretch;
+        if(U16_IS_LEAD(stop[-1]) && U16_IS_TRAIL(*stop)) {
+            ++stop;
+        }
+        s=span(s, stop, spanCondition);
+        if(s<stop) {
+            return s;
+        }
+    }
+}
+
+/* Symmetrical with spanWithBlocks(). */
+const UChar *
+BMPSet::spanBackWithBlocks(const UChar *s, const UChar *limit, USetSpanCondition spanCondition) const {
+    UBool tf=(UBool)(spanCondition!=USET_SPAN_NOT_CONTAINED);
+    int32_t stretch=BMP_SPAN_STRETCH;
+    for(;;) {
+        const UChar *start=limit;
+        limit=spanBackBlocks(s, limit, tf);
+        if(s==limit) {
+            return limit;
+        }
+        if((start-limit)>=U_SIMD_MIN_LENGTH) {
+            stretch=U_SIMD_MIN_LENGTH;
+        } else if(stretch<BMP_SPAN_STRETCH) {
+            stretch*=2;
+        }
+        if((limit-s)<2*stretch) {
+            return spanBack(s, limit, spanCondition);
+        }
+        const UChar *stop=limit-stretch;
+        if(U16_IS_TRAIL(*stop) && U16_IS_LEAD(stop[-1])) {
+            --stop;
+        }
+        limit=spanBack(stop, limit, spanCondition);
+        if(stop<limit) {
+            return limit;
+        }
+    }
+}
+
+#endif
+
+/*
+ * Continues a long initial ASCII span of spanUTF8() with blocks of bytes
+ * while they are ASCII and in the span, then returns to spanUTF8().
+ * That does not call back here because it starts with a byte which ends
+ * the ASCII span, or with fewer than U_SIMD_MIN_LENGTH bytes.
+ * A set with too many ASCII ranges continues one byte at a time instead.
+ */
+const uint8_t *
+BMPSet::spanUTF8WithBlocks(const uint8_t *s, const uint8_t *limit,
+                           USetSpanCondition spanCondition) const {
+#if U_HAVE_SSE2
+    int32_t rangeCount=asciiRangeCount;
+    UBool tf=(UBool)(spanCondition!=USET_SPAN_NOT_CONTAINED);
+    if(rangeCount>=0) {
+        while((limit-s)>=U_SIMD_MIN_LENGTH) {
+            uint32_t mask=matchASCIIBytes(_mm_loadu_si128((const __m128i *)s),
+                                          asciiRangeStarts, asciiRangeLasts, rangeCount, tf);
+            if(mask!=0xffff) {
+                s+=lowestBit(~mask);
+                break;
             }
+            s+=16;
         }
+    } else {
+        uint8_t b;
+        while(s<limit && (int8_t)(b=*s)>=0 && asciiBytes[b]==tf) {
+            ++s;
+        }
+    }
+    if(s==limit) {
+        return s;
     }
-    return limit+1;
+#endif
+    return spanUTF8(s, (int32_t)(limit-s), spanCondition);
 }
 
 /*
  * Precheck for sufficient trail bytes at end of string only once per span.
  * Check validity.
+ *
+ * A long initial ASCII span continues with blocks of bytes in spanUTF8WithBlocks().
  */
 const uint8_t *
 BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanCondition) const {
@@ -497,17 +838,26 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
     uint8_t b=*s;
     if((int8_t)b>=0) {
         // Initial all-ASCII span.
+#if U_HAVE_SSE2
+        const uint8_t *stop=length>=2*BMP_SPAN_STRETCH ? s+BMP_SPAN_STRETCH : limit;
+#else
+        const uint8_t *stop=limit;
+#endif
         if(spanCondition) {
             do {
-                if(!asciiBytes[b] || ++s==limit) {
+                if(!asciiBytes[b]) {
                     return s;
+                } else if(++s==stop) {
+                    return s==limit ? s : spanUTF8WithBlocks(s, limit, spanCondition);
                 }
                 b=*s;
             } while((int8_t)b>=0);
         } else {
             do {
-                if(asciiBytes[b] || ++s==limit) {
+                if(asciiBytes[b]) {
                     return s;
+                } else if(++s==stop) {
+                    return s==limit ? s : spanUTF8WithBlocks(s, limit, spanCondition);
                 }
                 b=*s;
             } while((int8_t)b>=0);
@@ -19,6 +19,7 @@
 
 #include "unicode/utypes.h"
 #include "unicode/uniset.h"
+#include "ustrsimd.h"
 
 U_NAMESPACE_BEGIN
 
@@ -31,6 +32,11 @@ U_NAMESPACE_BEGIN
  * 3-byte characters: Use zero/one/mixed data per 64-block in U+0000..U+FFFF,
  *                    with mixed for illegal ranges.
  * Supplementary characters: Call contains() on the parent set.
+ *
+ * With SSE2, long spans are tested in blocks of 16 code units:
+ * ASCII code units are compared with the set's ASCII ranges in parallel,
+ * and other BMP code units with one range of the inversion list at a time,
+ * so that blocks of mixed ASCII and other code units are skipped as well.
  */
 class BMPSet : public UMemory {
 public:
@@ -71,6 +77,37 @@ public:
 private:
     void initBits();
     void overrideIllegal();
+    void initASCIIRanges();
+
+    /* Continues a long initial ASCII span of spanUTF8(). */
+    const uint8_t *spanUTF8WithBlocks(const uint8_t *s, const uint8_t *limit,
+                                      USetSpanCondition spanCondition) const;
+
+#if U_HAVE_SSE2
+    /* Continues a long span of span() and spanBack(). */
+    const UChar *spanWithBlocks(const UChar *s, const UChar *limit, USetSpanCondition spanCondition) const;
+    const UChar *spanBackWithBlocks(const UChar *s, const UChar *limit, USetSpanCondition spanCondition) const;
+
+    /*
+     * Span whole blocks of U_SIMD_MIN_LENGTH code units.
+     * Stops at the first block which is not entirely in the span,
+     * after the code units of that block which were found to be in the span.
+     * spanCondition must be 0 or 1.
+     * @return The string pointer where span() continues one code point at a time.
+     */
+    const UChar *spanBlocks(const UChar *s, const UChar *limit, UBool spanCondition) const;
+
+    /* Symmetrical with spanBlocks(). @return The new span limit. */
+    const UChar *spanBackBlocks(const UChar *s, const UChar *limit, UBool spanCondition) const;
+
+    /*
+     * For a BMP code point c>=0x80 which is not a surrogate, sets
+     * rangeStart..rangeLimit-1 to the surrounding non-surrogate BMP code points
+     * which all have the same contains() value as c.
+     * @return contains(c)
+     */
+    UBool findRange(UChar32 c, UChar32 &rangeStart, UChar32 &rangeLimit) const;
+#endif
 
     /**
      * Same as UnicodeSet::findCodePoint(UChar32 c) const except that the
@@ -88,8 +125,10 @@ private:
      * @param hi The highest index to be returned.
      * @return the smallest integer i in the range lo..hi,
      *         inclusive, such that c < list[i]
+     *
+     * Inline so that the span loops need not save registers for calling it.
      */
-    int32_t findCodePoint(UChar32 c, int32_t lo, int32_t hi) const;
+    inline int32_t findCodePoint(UChar32 c, int32_t lo, int32_t hi) const;
 
     inline UBool containsSlow(UChar32 c, int32_t lo, int32_t hi) const;
 
@@ -143,6 +182,16 @@ private:
      */
     int32_t list4kStarts[18];
 
+    /*
+     * The ranges of the set within U+0000..U+007F, as start code points and lengths-1,
+     * for testing blocks of ASCII code units in parallel.
+     * Each value is repeated 16 times so that it can be loaded into all lanes of a vector.
+     * asciiRangeCount is -1 if the set has more ASCII ranges than fit.
+     */
+    uint8_t asciiRangeStarts[16][16];
+    uint8_t asciiRangeLasts[16][16];
+    int32_t asciiRangeCount;
+
     /*
      * The inversion list of the parent set, for the slower contains() implementation
      * for mixed BMP blocks and for supplementary code points.
@@ -152,6 +201,40 @@ private:
     int32_t listLength;
 };
 
+inline int32_t BMPSet::findCodePoint(UChar32 c, int32_t lo, int32_t hi) const {
+    /* Examples:
+                                       findCodePoint(c)
+       set              list[]         c=0 1 3 4 7 8
+       ===              ==============   ===========
+       []               [110000]         0 0 0 0 0 0
+       [\u0000-\u0003]  [0, 4, 110000]   1 1 1 2 2 2
+       [\u0004-\u0007]  [4, 8, 110000]   0 0 0 1 1 2
+       [:Any:]          [0, 110000]      1 1 1 1 1 1
+     */
+
+    // Return the smallest i such that c < list[i].  Assume
+    // list[len - 1] == HIGH and that c is legal (0..HIGH-1).
+    if (c < list[lo])
+        return lo;
+    // High runner test.  c is often after the last range, so an
+    // initial check for this condition pays off.
+    if (lo >= hi || c >= list[hi-1])
+        return hi;
+    // invariant: c >= list[lo]
+    // invariant: c < list[hi]
+    for (;;) {
+        int32_t i = (lo + hi) >> 1;
+        if (i == lo) {
+            break; // Found!
+        } else if (c < list[i]) {
+            hi = i;
+        } else {
+            lo = i;
+        }
+    }
+    return hi;
+}
+
 inline UBool BMPSet::containsSlow(UChar32 c, int32_t lo, int32_t hi) const {
     return (UBool)(findCodePoint(c, lo, hi) & 1);
 }
@@ -202,6 +202,143 @@ inline UValueComparator* Hashtable::setValueComparator(UValueComparator* valueCo
 inline UBool Hashtable::equals(const Hashtable& that)const{
    return uhash_equals(hash, that.hash);
 }
+
+/**
+ * Key type support for HashMap: how keys of type K are hashed, compared,
+ * and passed to the UHashtable functions.
+ * Specialized for int32_t, const char * and const UChar * (NUL-terminated).
+ *
+ * HashMapKey is an INTERNAL CLASS.
+ */
+template<typename K>
+struct HashMapKey;
+
+template<>
+struct HashMapKey<int32_t> {
+    static UHashFunction *hasher() { return uhash_hashLong; }
+    static UKeyComparator *comparator() { return uhash_compareLong; }
+    static void *get(const UHashtable *hash, int32_t key) { return uhash_iget(hash, key); }
+    static void *put(UHashtable *hash, int32_t key, void *value, UErrorCode &status) {
+        return uhash_iput(hash, key, value, &status);
+    }
+    static void *remove(UHashtable *hash, int32_t key) { return uhash_iremove(hash, key); }
+    static int32_t fromTok(const UHashTok &tok) { return tok.integer; }
+};
+
+template<>
+struct HashMapKey<const char *> {
+    static UHashFunction *hasher() { return uhash_hashChars; }
+    static UKeyComparator *comparator() { return uhash_compareChars; }
+    static void *get(const UHashtable *hash, const char *key) { return uhash_get(hash, key); }
+    static void *put(UHashtable *hash, const char *key, void *value, UErrorCode &status) {
+        return uhash_put(hash, (void *)key, value, &status);
+    }
+    static void *remove(UHashtable *hash, const char *key) { return uhash_remove(hash, key); }
+    static const char *fromTok(const UHashTok &tok) { return (const char *)tok.pointer; }
+};
+
+template<>
+struct HashMapKey<const UChar *> {
+    static UHashFunction *hasher() { return uhash_hashUChars; }
+    static UKeyComparator *comparator() { return uhash_compareUChars; }
+    static void *get(const UHashtable *hash, const UChar *key) { return uhash_get(hash, key); }
+    static void *put(UHashtable *hash, const UChar *key, void *value, UErrorCode &status) {
+        return uhash_put(hash, (void *)key, value, &status);
+    }
+    static void *remove(UHashtable *hash, const UChar *key) { return uhash_remove(hash, key); }
+    static const UChar *fromTok(const UHashTok &tok) { return (const UChar *)tok.pointer; }
+};
+
+/**
+ * HashMap is a typed C++ wrapper around UHashtable, mapping keys of type K
+ * (see HashMapKey) to non-NULL V pointers, without casts at the call sites.
+ * The map does not own its keys; they must outlive their entries.
+ * If the map adopts its values, then it deletes them when they are
+ * replaced or removed, or when the map is destroyed.
+ *
+ * HashMap is an INTERNAL CLASS.
+ */
+template<typename K, typename V>
+class HashMap : public UMemory {
+public:
+    /**
+     * Construct a map.
+     * @param adoptValues If true, the map owns its values.
+     * @param status Error code
+     */
+    HashMap(UBool adoptValues, UErrorCode &status) : hash(NULL) {
+        init(0, adoptValues, status);
+    }
+
+    /**
+     * Construct a map with room for about size entries.
+     * @param size Initial capacity
+     * @param adoptValues If true, the map owns its values.
+     * @param status Error code
+     */
+    HashMap(int32_t size, UBool adoptValues, UErrorCode &status) : hash(NULL) {
+        init(size, adoptValues, status);
+    }
+
+    ~HashMap() { uhash_close(hash); }
+
+    int32_t count() const { return uhash_count(hash); }
+
+    /**
+     * @return the value for the key, or NULL if there is none
+     */
+    V *get(K key) const { return (V *)HashMapKey<K>::get(hash, key); }
+
+    /**
+     * Sets the value for the key. A NULL value removes the key.
+     * @return the previous value if the map does not own it, otherwise NULL
+     */
+    V *put(K key, V *value, UErrorCode &status) {
+        return (V *)HashMapKey<K>::put(hash, key, value, status);
+    }
+
+    /**
+     * Removes the key.
+     * @return the previous value if the map does not own it, otherwise NULL
+     */
+    V *remove(K key) { return (V *)HashMapKey<K>::remove(hash, key); }
+
+    void removeAll() { uhash_removeAll(hash); }
+
+    /**
+     * Iterates over the entries, in no particular order.
+     * Start with pos=-1.
+     * @return the next entry, or NULL after the last one
+     * @see keyOf
+     * @see valueOf
+     */
+    const UHashElement *nextElement(int32_t &pos) const { return uhash_nextElement(hash, &pos); }
+
+    static K keyOf(const UHashElement *e) { return HashMapKey<K>::fromTok(e->key); }
+    static V *valueOf(const UHashElement *e) { return (V *)e->value.pointer; }
+
+private:
+    static void U_CALLCONV deleteValue(void *obj) { delete (V *)obj; }
+
+    void init(int32_t size, UBool adoptValues, UErrorCode &status) {
+        if (size > 0) {
+            hash = uhash_openSize(HashMapKey<K>::hasher(), HashMapKey<K>::comparator(), NULL,
+                                  size, &status);
+        } else {
+            hash = uhash_open(HashMapKey<K>::hasher(), HashMapKey<K>::comparator(), NULL,
+                              &status);
+        }
+        if (U_SUCCESS(status) && adoptValues) {
+            uhash_setValueDeleter(hash, deleteValue);
+        }
+    }
+
+    UHashtable *hash;
+
+    HashMap(const HashMap &other); // forbid copying of this class
+    HashMap &operator=(const HashMap &other); // forbid copying of this class
+};
+
 U_NAMESPACE_END
 
 #endif
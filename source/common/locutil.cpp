@@ -19,6 +19,7 @@
 
 // see LocaleUtility::getAvailableLocaleNames
 static icu::Hashtable * LocaleUtility_cache = NULL;
+static URWLock gLocaleUtilityLock = U_RWLOCK_INITIALIZER;
 
 #define UNDERSCORE_CHAR ((UChar)0x005f)
 #define AT_SIGN_CHAR    ((UChar)64)
@@ -190,9 +191,9 @@ LocaleUtility::getAvailableLocaleNames(const UnicodeString& bundleID)
 
     UErrorCode status = U_ZERO_ERROR;
     Hashtable* cache;
-    umtx_lock(NULL);
+    umtx_rdlock(&gLocaleUtilityLock);
     cache = LocaleUtility_cache;
-    umtx_unlock(NULL);
+    umtx_rdunlock(&gLocaleUtilityLock);
 
     if (cache == NULL) {
         cache = new Hashtable(status);
@@ -201,14 +202,14 @@ LocaleUtility::getAvailableLocaleNames(const UnicodeString& bundleID)
         }
         cache->setValueDeleter(uhash_deleteHashtable);
         Hashtable* h; // set this to final LocaleUtility_cache value
-        umtx_lock(NULL);
+        umtx_wrlock(&gLocaleUtilityLock);
         h = LocaleUtility_cache;
         if (h == NULL) {
             LocaleUtility_cache = h = cache;
             cache = NULL;
             ucln_common_registerCleanup(UCLN_COMMON_SERVICE, service_cleanup);
         }
-        umtx_unlock(NULL);
+        umtx_wrunlock(&gLocaleUtilityLock);
         if(cache != NULL) {
           delete cache;
         }
@@ -218,9 +219,9 @@ LocaleUtility::getAvailableLocaleNames(const UnicodeString& bundleID)
     U_ASSERT(cache != NULL);
 
     Hashtable* htp;
-    umtx_lock(NULL);
+    umtx_rdlock(&gLocaleUtilityLock);
     htp = (Hashtable*) cache->get(bundleID);
-    umtx_unlock(NULL);
+    umtx_rdunlock(&gLocaleUtilityLock);
 
     if (htp == NULL) {
         htp = new Hashtable(status);
@@ -241,9 +242,21 @@ LocaleUtility::getAvailableLocaleNames(const UnicodeString& bundleID)
                 delete htp;
                 return NULL;
             }
-            umtx_lock(NULL);
-            cache->put(bundleID, (void*)htp, status);
-            umtx_unlock(NULL);
+            // Another thread may have loaded the same bundleID meanwhile.
+            // Keep its table: Its callers may still be using it.
+            umtx_wrlock(&gLocaleUtilityLock);
+            Hashtable* existing = (Hashtable*) cache->get(bundleID);
+            if (existing == NULL) {
+                cache->put(bundleID, (void*)htp, status);
+            }
+            umtx_wrunlock(&gLocaleUtilityLock);
+            if (existing != NULL) {
+                delete htp;
+                htp = existing;
+            } else if (U_FAILURE(status)) {
+                delete htp;
+                return NULL;
+            }
         }
     }
     return htp;
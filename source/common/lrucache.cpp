@@ -84,20 +84,9 @@ const SharedObject *LRUCache::_get(const char *localeId, UErrorCode &status) {
             localeIdToEntries, localeId));
     if (entry == NULL) {
         // Its a cache miss.
-
-        if (uhash_count(localeIdToEntries) < maxSize) {
-            // Cache not full. There is room for a new entry.
-            entry = new CacheEntry;
-            if (entry == NULL) {
-                status = U_MEMORY_ALLOCATION_ERROR;
-                return NULL;
-            }
-        } else {
-            // Cache full. Must evict an entry and re-use it.
-            entry = leastRecentlyUsedMarker->moreRecent;
-            uhash_remove(localeIdToEntries, entry->localeId);
-            entry->unlink();
-            entry->reset();
+        entry = newEntry(status);
+        if (entry == NULL) {
+            return NULL;
         }
  
         // entry is an uninitialized, unlinked cache entry 
@@ -127,6 +116,50 @@ const SharedObject *LRUCache::_get(const char *localeId, UErrorCode &status) {
     return entry->cachedData;
 }
 
+void LRUCache::put(const char *localeId, SharedObject *data, UErrorCode &status) {
+    if (U_FAILURE(status) || contains(localeId)) {
+        return;
+    }
+    CacheEntry *entry = newEntry(status);
+    if (entry == NULL) {
+        return;
+    }
+    char *dupLocaleId = uprv_strdup(localeId);
+    if (dupLocaleId == NULL) {
+        delete entry;
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    entry->init(dupLocaleId, data, U_ZERO_ERROR);
+    uhash_put(localeIdToEntries, entry->localeId, entry, &status);
+    if (U_FAILURE(status)) {
+        delete entry;
+        return;
+    }
+    moveToMostRecent(entry);
+}
+
+// Returns an uninitialized, unlinked cache entry:
+// a new one if the cache is not full, otherwise the evicted least recently used one.
+LRUCache::CacheEntry *LRUCache::newEntry(UErrorCode &status) {
+    CacheEntry *entry;
+    if (uhash_count(localeIdToEntries) < maxSize) {
+        // Cache not full. There is room for a new entry.
+        entry = new CacheEntry;
+        if (entry == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return NULL;
+        }
+    } else {
+        // Cache full. Must evict an entry and re-use it.
+        entry = leastRecentlyUsedMarker->moreRecent;
+        uhash_remove(localeIdToEntries, entry->localeId);
+        entry->unlink();
+        entry->reset();
+    }
+    return entry;
+}
+
 LRUCache::LRUCache(int32_t size, UErrorCode &status) :
         mostRecentlyUsedMarker(NULL),
         leastRecentlyUsedMarker(NULL),
@@ -33,6 +33,13 @@ public:
         SharedObject::copyPtr(value, ptr);
     }
     UBool contains(const char *localeId) const;
+    /**
+     * Adds data that the caller created for localeId,
+     * unless the cache already contains an entry for it,
+     * for clients that create data without holding their cache lock.
+     * The cache adds its own reference to data.
+     */
+    void put(const char *localeId, SharedObject *data, UErrorCode &status);
     virtual ~LRUCache();
 protected:
     virtual SharedObject *create(const char *localeId, UErrorCode &status)=0;
@@ -70,6 +77,7 @@ private:
 
     void moveToMostRecent(CacheEntry *cacheEntry);
     void init(char *localeId, CacheEntry *cacheEntry);
+    CacheEntry *newEntry(UErrorCode &status);
     const SharedObject *_get(const char *localeId, UErrorCode &status);
 };
 
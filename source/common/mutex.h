@@ -71,6 +71,39 @@ inline Mutex::~Mutex()
   umtx_unlock(fMutex);
 }
 
+// ReadLock and WriteLock hold a URWLock for their lifetime, like Mutex.
+//
+// static URWLock myLock = U_RWLOCK_INITIALIZER;
+//
+// const Object *lookup(int key) {
+//    ReadLock lock(&myLock);   // shared with other readers
+//    return table->get(key);
+// }
+
+class U_COMMON_API ReadLock : public UMemory {
+public:
+  inline ReadLock(URWLock *rwlock) : fLock(rwlock) { umtx_rdlock(fLock); }
+  inline ~ReadLock() { umtx_rdunlock(fLock); }
+
+private:
+  URWLock  *fLock;
+
+  ReadLock(const ReadLock &other); // forbid copying of this class
+  ReadLock &operator=(const ReadLock &other); // forbid copying of this class
+};
+
+class U_COMMON_API WriteLock : public UMemory {
+public:
+  inline WriteLock(URWLock *rwlock) : fLock(rwlock) { umtx_wrlock(fLock); }
+  inline ~WriteLock() { umtx_wrunlock(fLock); }
+
+private:
+  URWLock  *fLock;
+
+  WriteLock(const WriteLock &other); // forbid copying of this class
+  WriteLock &operator=(const WriteLock &other); // forbid copying of this class
+};
+
 U_NAMESPACE_END
 
 #endif //_MUTEX_
@@ -22,6 +22,9 @@
 #include "unicode/normalizer2.h"
 #include "unicode/unistr.h"
 #include "unicode/unorm.h"
+#include "unicode/ustring.h"
+#include "unicode/utf8.h"
+#include "charstr.h"
 #include "cpputils.h"
 #include "cstring.h"
 #include "mutex.h"
@@ -51,6 +54,219 @@ Normalizer2::getCombiningClass(UChar32 /*c*/) const {
     return 0;
 }
 
+// Large enough for most normalizeToBuffer() results.
+static const int32_t NORMALIZE_STACK_CAPACITY=256;
+
+namespace {
+
+// Iterates over a UTF-8 string in pieces of one well-formed run
+// followed by one ill-formed sequence.
+// Either can be empty, but only the last piece lacks the ill-formed sequence.
+// Ill-formed sequences are normalization-inert, and the default implementations
+// of the UTF-8 functions handle the well-formed runs independently via UTF-16.
+class UTF8RunIterator {
+public:
+    UTF8RunIterator(const StringPiece &s) :
+        p(s.data()), length(s.length()), runStart(0), runLimit(0), pieceLimit(0) {}
+
+    UBool next() {
+        runStart=pieceLimit;
+        if(runStart>=length) {
+            return FALSE;
+        }
+        int32_t i=runStart;
+        for(;;) {
+            runLimit=i;
+            if(i==length) {
+                pieceLimit=length;
+                return TRUE;
+            }
+            UChar32 c;
+            U8_NEXT(p, i, length, c);
+            if(c<0) {
+                pieceLimit=i;
+                return TRUE;
+            }
+        }
+    }
+    UBool hasRun() const { return runStart<runLimit; }
+    StringPiece getRun() const { return StringPiece(p+runStart, runLimit-runStart); }
+    void appendIllFormed(ByteSink &sink) const {
+        if(runLimit<pieceLimit) {
+            sink.Append(p+runLimit, pieceLimit-runLimit);
+        }
+    }
+
+    const char *p;
+    int32_t length;
+    int32_t runStart, runLimit, pieceLimit;
+};
+
+}  // namespace
+
+void
+Normalizer2::normalizeUTF8(const StringPiece &src, ByteSink &sink, UErrorCode &errorCode) const {
+    UTF8RunIterator iter(src);
+    UnicodeString s16, dest16;
+    while(U_SUCCESS(errorCode) && iter.next()) {
+        if(iter.hasRun()) {
+            StringPiece run=iter.getRun();
+            s16=UnicodeString::fromUTF8(run);
+            normalize(s16, dest16, errorCode);
+            if(U_FAILURE(errorCode)) {
+                return;
+            }
+            if(dest16==s16) {
+                sink.Append(run.data(), run.length());
+            } else {
+                dest16.toUTF8(sink);
+            }
+        }
+        iter.appendIllFormed(sink);
+    }
+}
+
+void
+Normalizer2::normalizeSecondAndAppendUTF8(const StringPiece &first,
+                                          const StringPiece &second,
+                                          ByteSink &sink,
+                                          UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return;
+    }
+    // Copy first up to its last boundary,
+    // normalize the text between that and the first boundary in second,
+    // and normalize the rest of second.
+    const char *f=first.data();
+    int32_t firstBoundary=first.length();
+    while(firstBoundary>0) {
+        int32_t i=firstBoundary;
+        UChar32 c;
+        U8_PREV(f, 0, i, c);
+        if(c<0) {
+            break;  // boundary after an ill-formed sequence
+        }
+        firstBoundary=i;
+        if(hasBoundaryBefore(c)) {
+            break;
+        }
+    }
+    const char *s=second.data();
+    int32_t secondBoundary=0;
+    while(secondBoundary<second.length()) {
+        int32_t i=secondBoundary;
+        UChar32 c;
+        U8_NEXT(s, i, second.length(), c);
+        if(c<0 || hasBoundaryBefore(c)) {
+            break;
+        }
+        secondBoundary=i;
+    }
+    if(firstBoundary>0) {
+        sink.Append(f, firstBoundary);
+    }
+    CharString middle;
+    middle.append(f+firstBoundary, first.length()-firstBoundary, errorCode).
+           append(s, secondBoundary, errorCode);
+    if(U_FAILURE(errorCode)) {
+        return;
+    }
+    normalizeUTF8(middle.toStringPiece(), sink, errorCode);
+    normalizeUTF8(StringPiece(s+secondBoundary, second.length()-secondBoundary), sink, errorCode);
+}
+
+UBool
+Normalizer2::isNormalizedUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+    UTF8RunIterator iter(s);
+    while(U_SUCCESS(errorCode) && iter.next()) {
+        if(iter.hasRun() && !isNormalized(UnicodeString::fromUTF8(iter.getRun()), errorCode)) {
+            return FALSE;
+        }
+    }
+    return U_SUCCESS(errorCode);
+}
+
+UNormalizationCheckResult
+Normalizer2::quickCheckUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+    UNormalizationCheckResult qcResult=UNORM_YES;
+    UTF8RunIterator iter(s);
+    while(U_SUCCESS(errorCode) && iter.next()) {
+        if(iter.hasRun()) {
+            UNormalizationCheckResult runResult=
+                quickCheck(UnicodeString::fromUTF8(iter.getRun()), errorCode);
+            if(runResult==UNORM_NO) {
+                return UNORM_NO;
+            } else if(runResult==UNORM_MAYBE) {
+                qcResult=UNORM_MAYBE;
+            }
+        }
+    }
+    return U_SUCCESS(errorCode) ? qcResult : UNORM_MAYBE;
+}
+
+int32_t
+Normalizer2::spanQuickCheckYesUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+    UTF8RunIterator iter(s);
+    while(U_SUCCESS(errorCode) && iter.next()) {
+        if(iter.hasRun()) {
+            UnicodeString s16=UnicodeString::fromUTF8(iter.getRun());
+            int32_t spanLength16=spanQuickCheckYes(s16, errorCode);
+            if(U_FAILURE(errorCode)) {
+                return 0;
+            }
+            if(spanLength16<s16.length()) {
+                int32_t spanLength8=0;
+                u_strToUTF8(NULL, 0, &spanLength8, s16.getBuffer(), spanLength16, &errorCode);
+                errorCode=U_ZERO_ERROR;  // U_BUFFER_OVERFLOW_ERROR from preflighting
+                return iter.runStart+spanLength8;
+            }
+        }
+    }
+    return U_SUCCESS(errorCode) ? s.length() : 0;
+}
+
+// Checks the arguments of normalizeToBuffer() and sets destString to alias
+// whichever of dest and the stack buffer is larger, so that short results,
+// including ones that are only preflighted, need no heap memory.
+// Only longer results grow into a heap buffer.
+static UBool
+initNormalizeToBuffer(const UChar *src, int32_t length,
+                      UChar *dest, int32_t capacity,
+                      UChar *stackBuffer, UnicodeString &destString,
+                      UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) {
+        return FALSE;
+    }
+    if( (src==NULL ? length!=0 : length<-1) ||
+        (dest==NULL ? capacity!=0 : capacity<0) ||
+        (src==dest && src!=NULL)
+    ) {
+        errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    if(capacity>=NORMALIZE_STACK_CAPACITY) {
+        destString.setTo(dest, 0, capacity);
+    } else {
+        destString.setTo(stackBuffer, 0, NORMALIZE_STACK_CAPACITY);
+    }
+    return TRUE;
+}
+
+int32_t
+Normalizer2::normalizeToBuffer(const UChar *src, int32_t length,
+                               UChar *dest, int32_t capacity,
+                               UErrorCode &errorCode) const {
+    UChar stackBuffer[NORMALIZE_STACK_CAPACITY];
+    UnicodeString destString;
+    if(!initNormalizeToBuffer(src, length, dest, capacity, stackBuffer, destString, errorCode)) {
+        return 0;
+    }
+    if(length!=0) {
+        normalize(UnicodeString(length<0, src, length), destString, errorCode);
+    }
+    return destString.extract(dest, capacity, errorCode);
+}
+
 // Normalizer2 implementation for the old UNORM_NONE.
 class NoopNormalizer2 : public Normalizer2 {
     virtual ~NoopNormalizer2();
@@ -150,6 +366,25 @@ public:
     virtual void
     normalize(const UChar *src, const UChar *limit,
               ReorderingBuffer &buffer, UErrorCode &errorCode) const = 0;
+    virtual int32_t
+    normalizeToBuffer(const UChar *src, int32_t length,
+                      UChar *dest, int32_t capacity,
+                      UErrorCode &errorCode) const {
+        UChar stackBuffer[NORMALIZE_STACK_CAPACITY];
+        UnicodeString destString;
+        if(!initNormalizeToBuffer(src, length, dest, capacity, stackBuffer, destString, errorCode)) {
+            return 0;
+        }
+        // length==0: Nothing to do, and normalize(NULL, NULL, buffer, ...) would crash.
+        if(length!=0) {
+            // Support NUL-terminated src.
+            ReorderingBuffer buffer(impl, destString);
+            if(buffer.init(-1, errorCode)) {  // start with the current capacity
+                normalize(src, length>=0 ? src+length : NULL, buffer, errorCode);
+            }
+        }
+        return destString.extract(dest, capacity, errorCode);
+    }
 
     // normalize and append
     virtual UnicodeString &
@@ -305,6 +540,31 @@ private:
     virtual UNormalizationCheckResult getQuickCheck(UChar32 c) const {
         return impl.isDecompYes(impl.getNorm16(c)) ? UNORM_YES : UNORM_NO;
     }
+
+    virtual void
+    normalizeUTF8(const StringPiece &src, ByteSink &sink, UErrorCode &errorCode) const {
+        if(U_SUCCESS(errorCode)) {
+            const uint8_t *s=(const uint8_t *)src.data();
+            impl.decomposeUTF8(s, s+src.length(), &sink, errorCode);
+        }
+    }
+    virtual UBool
+    isNormalizedUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+        return spanQuickCheckYesUTF8(s, errorCode)==s.length() && U_SUCCESS(errorCode);
+    }
+    virtual UNormalizationCheckResult
+    quickCheckUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+        return isNormalizedUTF8(s, errorCode) ? UNORM_YES : UNORM_NO;
+    }
+    virtual int32_t
+    spanQuickCheckYesUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return 0;
+        }
+        const uint8_t *s8=(const uint8_t *)s.data();
+        return (int32_t)(impl.decomposeUTF8(s8, s8+s.length(), NULL, errorCode)-s8);
+    }
+
     virtual UBool hasBoundaryBefore(UChar32 c) const { return impl.hasDecompBoundary(c, TRUE); }
     virtual UBool hasBoundaryAfter(UChar32 c) const { return impl.hasDecompBoundary(c, FALSE); }
     virtual UBool isInert(UChar32 c) const { return impl.isDecompInert(c); }
@@ -371,6 +631,40 @@ private:
     virtual UNormalizationCheckResult getQuickCheck(UChar32 c) const {
         return impl.getCompQuickCheck(impl.getNorm16(c));
     }
+
+    virtual void
+    normalizeUTF8(const StringPiece &src, ByteSink &sink, UErrorCode &errorCode) const {
+        if(U_SUCCESS(errorCode)) {
+            const uint8_t *s=(const uint8_t *)src.data();
+            impl.composeUTF8(s, s+src.length(), onlyContiguous, &sink, errorCode);
+        }
+    }
+    virtual UBool
+    isNormalizedUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return FALSE;
+        }
+        const uint8_t *s8=(const uint8_t *)s.data();
+        return impl.composeUTF8(s8, s8+s.length(), onlyContiguous, NULL, errorCode);
+    }
+    virtual UNormalizationCheckResult
+    quickCheckUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return UNORM_MAYBE;
+        }
+        const uint8_t *s8=(const uint8_t *)s.data();
+        UNormalizationCheckResult qcResult=UNORM_YES;
+        impl.composeQuickCheckUTF8(s8, s8+s.length(), onlyContiguous, &qcResult, errorCode);
+        return U_SUCCESS(errorCode) ? qcResult : UNORM_MAYBE;
+    }
+    virtual int32_t
+    spanQuickCheckYesUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return 0;
+        }
+        const uint8_t *s8=(const uint8_t *)s.data();
+        return (int32_t)(impl.composeQuickCheckUTF8(s8, s8+s.length(), onlyContiguous, NULL, errorCode)-s8);
+    }
     virtual UBool hasBoundaryBefore(UChar32 c) const {
         return impl.hasCompBoundaryBefore(c);
     }
@@ -693,6 +987,119 @@ Normalizer2::getInstance(const char *packageName,
     return NULL;
 }
 
+// streaming normalization ------------------------------------------------- ***
+
+StreamingNormalizer2::~StreamingNormalizer2() {}
+
+UnicodeString &
+StreamingNormalizer2::normalizeChunk(const UnicodeString &chunk, UnicodeString &dest,
+                                     UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) {
+        return dest;
+    }
+    const UChar *s=chunk.getBuffer();
+    if(s==NULL || &dest==&chunk) {
+        errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return dest;
+    }
+    int32_t length=chunk.length();
+    // A trail surrogate that completes a held-back lead surrogate
+    // is part of the held-back character.
+    int32_t start=0;
+    if( length>0 && !pending.isEmpty() &&
+        U16_IS_LEAD(pending.charAt(pending.length()-1)) && U16_IS_TRAIL(s[0])
+    ) {
+        start=1;
+    }
+    // Find the last boundary, looking backward only over the text that is held back.
+    // A lead surrogate at the end is held back without a boundary test
+    // because it might begin a supplementary combining mark.
+    int32_t lastBoundary=length;
+    if(lastBoundary>start && U16_IS_LEAD(s[lastBoundary-1])) {
+        --lastBoundary;
+    }
+    UBool found=FALSE;
+    while(lastBoundary>start) {
+        int32_t i=lastBoundary;
+        UChar32 c;
+        U16_PREV(s, start, i, c);
+        lastBoundary=i;
+        if(norm2.hasBoundaryBefore(c)) {
+            found=TRUE;
+            break;
+        }
+    }
+    if(!found) {
+        pending.append(s, length);
+        return dest;
+    }
+    // The held-back text interacts at most with the chunk's text up to its first boundary.
+    int32_t firstBoundary=start;
+    while(firstBoundary<lastBoundary) {
+        int32_t i=firstBoundary;
+        UChar32 c;
+        U16_NEXT(s, i, lastBoundary, c);
+        if(norm2.hasBoundaryBefore(c)) {
+            break;
+        }
+        firstBoundary=i;
+    }
+    if(!pending.isEmpty() || firstBoundary>0) {
+        pending.append(s, firstBoundary);
+        const UChar *p=pending.getBuffer();
+        normalizeAndAppend(p, p+pending.length(), dest, errorCode);
+    }
+    normalizeAndAppend(s+firstBoundary, s+lastBoundary, dest, errorCode);
+    pending.setTo(s+lastBoundary, length-lastBoundary);
+    return dest;
+}
+
+UnicodeString &
+StreamingNormalizer2::finish(UnicodeString &dest, UErrorCode &errorCode) {
+    if(U_SUCCESS(errorCode) && !pending.isEmpty()) {
+        const UChar *p=pending.getBuffer();
+        normalizeAndAppend(p, p+pending.length(), dest, errorCode);
+    }
+    pending.remove();
+    return dest;
+}
+
+// [src, limit[ begins and ends at normalization boundaries,
+// so its normalized form can be appended independently.
+void
+StreamingNormalizer2::normalizeAndAppend(const UChar *src, const UChar *limit,
+                                         UnicodeString &dest, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode) || src==limit) {
+        return;
+    }
+    const Normalizer2WithImpl *n2wi=dynamic_cast<const Normalizer2WithImpl *>(&norm2);
+    if(n2wi!=NULL) {
+        // Normalize straight into the destination, unless it ends with a combining mark
+        // which the ReorderingBuffer would reorder together with the new text.
+        int32_t destLength=dest.length();
+        if(destLength==0 ||
+                n2wi->impl.getCC(n2wi->impl.getNorm16(dest.char32At(destLength-1)))<=1) {
+            ReorderingBuffer buffer(n2wi->impl, dest);
+            if(buffer.init(destLength+(int32_t)(limit-src), errorCode)) {
+                n2wi->normalize(src, limit, buffer, errorCode);
+            }
+        } else {
+            UnicodeString normalized;
+            {
+                ReorderingBuffer buffer(n2wi->impl, normalized);
+                if(buffer.init((int32_t)(limit-src), errorCode)) {
+                    n2wi->normalize(src, limit, buffer, errorCode);
+                }
+            }  // The buffer destructor releases the string's buffer.
+            dest.append(normalized);
+        }
+    } else {
+        UnicodeString normalized;
+        norm2.normalize(UnicodeString(FALSE, src, (int32_t)(limit-src)), normalized, errorCode);
+        dest.append(normalized);
+    }
+}
+
 U_NAMESPACE_END
 
 // C API ------------------------------------------------------------------- ***
@@ -742,33 +1149,7 @@ unorm2_normalize(const UNormalizer2 *norm2,
                  const UChar *src, int32_t length,
                  UChar *dest, int32_t capacity,
                  UErrorCode *pErrorCode) {
-    if(U_FAILURE(*pErrorCode)) {
-        return 0;
-    }
-    if( (src==NULL ? length!=0 : length<-1) ||
-        (dest==NULL ? capacity!=0 : capacity<0) ||
-        (src==dest && src!=NULL)
-    ) {
-        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
-        return 0;
-    }
-    UnicodeString destString(dest, 0, capacity);
-    // length==0: Nothing to do, and n2wi->normalize(NULL, NULL, buffer, ...) would crash.
-    if(length!=0) {
-        const Normalizer2 *n2=(const Normalizer2 *)norm2;
-        const Normalizer2WithImpl *n2wi=dynamic_cast<const Normalizer2WithImpl *>(n2);
-        if(n2wi!=NULL) {
-            // Avoid duplicate argument checking and support NUL-terminated src.
-            ReorderingBuffer buffer(n2wi->impl, destString);
-            if(buffer.init(length, *pErrorCode)) {
-                n2wi->normalize(src, length>=0 ? src+length : NULL, buffer, *pErrorCode);
-            }
-        } else {
-            UnicodeString srcString(length<0, src, length);
-            n2->normalize(srcString, destString, *pErrorCode);
-        }
-    }
-    return destString.extract(dest, capacity, *pErrorCode);
+    return ((const Normalizer2 *)norm2)->normalizeToBuffer(src, length, dest, capacity, *pErrorCode);
 }
 
 static int32_t
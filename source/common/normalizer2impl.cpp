@@ -18,16 +18,19 @@
 
 #if !UCONFIG_NO_NORMALIZATION
 
+#include "unicode/bytestream.h"
 #include "unicode/normalizer2.h"
 #include "unicode/udata.h"
 #include "unicode/ustring.h"
 #include "unicode/utf16.h"
+#include "unicode/utf8.h"
 #include "cmemory.h"
 #include "mutex.h"
 #include "normalizer2impl.h"
 #include "putilimp.h"
 #include "uassert.h"
 #include "uset_imp.h"
+#include "ustrsimd.h"
 #include "utrie2.h"
 #include "uvector.h"
 
@@ -547,7 +550,10 @@ Normalizer2Impl::decompose(const UChar *src, const UChar *limit,
 
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
-        for(prevSrc=src; src!=limit;) {
+        // Most text is below the minimum; skip that in blocks first.
+        prevSrc=src;
+        src=uprv_skipUCharsBelow(src, limit, minNoCP);
+        while(src!=limit) {
             if( (c=*src)<minNoCP ||
                 isMostDecompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
             ) {
@@ -1166,7 +1172,10 @@ Normalizer2Impl::compose(const UChar *src, const UChar *limit,
 
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
-        for(prevSrc=src; src!=limit;) {
+        // Most text is below the minimum; skip that in blocks first.
+        prevSrc=src;
+        src=uprv_skipUCharsBelow(src, limit, minNoMaybeCP);
+        while(src!=limit) {
             if( (c=*src)<minNoMaybeCP ||
                 isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
             ) {
@@ -1410,7 +1419,10 @@ Normalizer2Impl::composeQuickCheck(const UChar *src, const UChar *limit,
 
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
-        for(prevSrc=src;;) {
+        // Most text is below the minimum; skip that in blocks first.
+        prevSrc=src;
+        src=uprv_skipUCharsBelow(src, limit, minNoMaybeCP);
+        for(;;) {
             if(src==limit) {
                 return src;
             }
@@ -1615,6 +1627,211 @@ const UChar *Normalizer2Impl::findNextCompBoundary(const UChar *p, const UChar *
     return iter.codePointStart;
 }
 
+// UTF-8 ------------------------------------------------------------------- ***
+
+// Finds the next piece of [src, limit[ that needs to be looked at more closely.
+// [src, segmentStart[ is quick check "yes" with ccc=0 throughout
+// and is copied as is, and [segmentStart, return value[ is
+// bounded by normalization boundaries on both sides.
+// Sets segmentStart=limit and returns limit if there is no such segment.
+// forCompose selects between the composition and decomposition boundaries.
+const uint8_t *
+Normalizer2Impl::findUTF8Segment(const uint8_t *src, const uint8_t *limit,
+                                 UBool forCompose,
+                                 const uint8_t *&segmentStart) const {
+    // The standard data has no ASCII mappings, but custom data might.
+    UBool asciiIsYes=(forCompose ? minCompNoMaybeCP : minDecompNoCP)>=0x80;
+    const uint8_t *prevStart=src;  // start of the last "yes" character
+    const uint8_t *prevLimit=src;  // start of the character after it
+    uint16_t norm16;
+    for(;;) {
+        if(src==limit) {
+            segmentStart=limit;
+            return limit;
+        }
+        if(*src<0x80 && asciiIsYes) {
+            src+=uprv_countASCII(src, (int32_t)(limit-src));
+            prevStart=src-1;
+            continue;
+        }
+        prevLimit=src;
+        UTRIE2_U8_NEXT16(normTrie, src, limit, norm16);
+        if(forCompose ? !isCompYesAndZeroCC(norm16) : !isDecompYesAndZeroCC(norm16)) {
+            break;
+        }
+        prevStart=prevLimit;
+    }
+    // [prevLimit, src[ is a character that needs work.
+    if(!forCompose || prevStart==prevLimit) {
+        // Decomposition cannot reach back beyond the preceding ccc=0 character.
+        segmentStart=prevLimit;
+    } else {
+        // The preceding starter might combine with the following characters.
+        // An ill-formed sequence does not combine, and it must stay outside the
+        // segment which is converted to UTF-16 where it would turn into U+FFFD.
+        int32_t i=0;
+        UChar32 c;
+        U8_NEXT(prevStart, i, (int32_t)(prevLimit-prevStart), c);
+        segmentStart= c>=0 ? prevStart : prevLimit;
+    }
+    // The segment ends before the next "yes" character with ccc=0,
+    // or before an ill-formed sequence.
+    while(src<limit) {
+        const uint8_t *cpStart=src;
+        UTRIE2_U8_NEXT16(normTrie, src, limit, norm16);
+        if(forCompose ? isCompYesAndZeroCC(norm16) : isDecompYesAndZeroCC(norm16)) {
+            return cpStart;
+        }
+    }
+    return limit;
+}
+
+namespace {
+
+// Converts a segment from findUTF8Segment() to UTF-16.
+UBool
+segmentToUTF16(const uint8_t *start, const uint8_t *limit,
+               UnicodeString &s16, UErrorCode &errorCode) {
+    s16=UnicodeString::fromUTF8(StringPiece((const char *)start, (int32_t)(limit-start)));
+    if(s16.isBogus()) {
+        errorCode=U_MEMORY_ALLOCATION_ERROR;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+// Returns the UTF-8 length of the first length16 UChars of s16.
+int32_t
+getUTF8Length(const UnicodeString &s16, int32_t length16) {
+    int32_t length8=0;
+    UErrorCode errorCode=U_ZERO_ERROR;
+    u_strToUTF8(NULL, 0, &length8, s16.getBuffer(), length16, &errorCode);
+    return length8;
+}
+
+}  // namespace
+
+const uint8_t *
+Normalizer2Impl::decomposeUTF8(const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, UErrorCode &errorCode) const {
+    // Text up to copyStart has been appended to the sink.
+    // Unchanged text is collected until a segment changes, so that
+    // already-normalized input is appended with a single Append() call.
+    const uint8_t *copyStart=src;
+    UnicodeString s16, dest16;
+    while(src<limit) {
+        const uint8_t *segmentStart;
+        const uint8_t *segmentLimit=findUTF8Segment(src, limit, FALSE, segmentStart);
+        if(segmentStart==limit || !segmentToUTF16(segmentStart, segmentLimit, s16, errorCode)) {
+            break;
+        }
+        const UChar *p16=s16.getBuffer();
+        const UChar *limit16=p16+s16.length();
+        if(sink==NULL) {
+            const UChar *spanLimit16=decompose(p16, limit16, NULL, errorCode);
+            if(spanLimit16!=limit16) {
+                return segmentStart+getUTF8Length(s16, (int32_t)(spanLimit16-p16));
+            }
+        } else {
+            dest16.remove();
+            {
+                ReorderingBuffer buffer(*this, dest16);
+                if(buffer.init(s16.length(), errorCode)) {
+                    decompose(p16, limit16, &buffer, errorCode);
+                }
+            }
+            if(U_FAILURE(errorCode)) {
+                break;
+            }
+            if(dest16!=s16) {
+                if(copyStart!=segmentStart) {
+                    sink->Append((const char *)copyStart, (int32_t)(segmentStart-copyStart));
+                }
+                dest16.toUTF8(*sink);
+                copyStart=segmentLimit;
+            }
+        }
+        src=segmentLimit;
+    }
+    if(sink!=NULL && U_SUCCESS(errorCode) && copyStart!=limit) {
+        sink->Append((const char *)copyStart, (int32_t)(limit-copyStart));
+    }
+    return limit;
+}
+
+UBool
+Normalizer2Impl::composeUTF8(const uint8_t *src, const uint8_t *limit,
+                             UBool onlyContiguous,
+                             ByteSink *sink,
+                             UErrorCode &errorCode) const {
+    // Same as in decomposeUTF8().
+    const uint8_t *copyStart=src;
+    UnicodeString s16, dest16;
+    while(src<limit) {
+        const uint8_t *segmentStart;
+        const uint8_t *segmentLimit=findUTF8Segment(src, limit, TRUE, segmentStart);
+        if(segmentStart==limit || !segmentToUTF16(segmentStart, segmentLimit, s16, errorCode)) {
+            break;
+        }
+        dest16.remove();
+        {
+            ReorderingBuffer buffer(*this, dest16);
+            if(!buffer.init(s16.length(), errorCode)) {
+                return FALSE;
+            }
+            const UChar *p16=s16.getBuffer();
+            if(!compose(p16, p16+s16.length(), onlyContiguous, sink!=NULL, buffer, errorCode)) {
+                return FALSE;  // not normalized, only possible if sink==NULL
+            }
+        }
+        if(U_FAILURE(errorCode)) {
+            break;
+        }
+        if(sink!=NULL && dest16!=s16) {
+            if(copyStart!=segmentStart) {
+                sink->Append((const char *)copyStart, (int32_t)(segmentStart-copyStart));
+            }
+            dest16.toUTF8(*sink);
+            copyStart=segmentLimit;
+        }
+        src=segmentLimit;
+    }
+    if(U_FAILURE(errorCode)) {
+        return FALSE;
+    }
+    if(sink!=NULL && copyStart!=limit) {
+        sink->Append((const char *)copyStart, (int32_t)(limit-copyStart));
+    }
+    return TRUE;
+}
+
+const uint8_t *
+Normalizer2Impl::composeQuickCheckUTF8(const uint8_t *src, const uint8_t *limit,
+                                       UBool onlyContiguous,
+                                       UNormalizationCheckResult *pQCResult,
+                                       UErrorCode &errorCode) const {
+    UnicodeString s16;
+    while(src<limit) {
+        const uint8_t *segmentStart;
+        const uint8_t *segmentLimit=findUTF8Segment(src, limit, TRUE, segmentStart);
+        if(segmentStart==limit || !segmentToUTF16(segmentStart, segmentLimit, s16, errorCode)) {
+            break;
+        }
+        const UChar *p16=s16.getBuffer();
+        const UChar *limit16=p16+s16.length();
+        const UChar *spanLimit16=composeQuickCheck(p16, limit16, onlyContiguous, pQCResult);
+        if(pQCResult!=NULL) {
+            if(*pQCResult==UNORM_NO) {
+                return segmentStart;
+            }
+        } else if(spanLimit16!=limit16) {
+            return segmentStart+getUTF8Length(s16, (int32_t)(spanLimit16-p16));
+        }
+        src=segmentLimit;
+    }
+    return limit;
+}
+
 // Note: normalizer2impl.cpp r30982 (2011-nov-27)
 // still had getFCDTrie() which built and cached an FCD trie.
 // That provided faster access to FCD data than getFCD16FromNormData()
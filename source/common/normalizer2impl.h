@@ -32,6 +32,7 @@
 
 U_NAMESPACE_BEGIN
 
+class ByteSink;
 struct CanonIterData;
 
 class U_COMMON_API Hangul {
@@ -463,6 +464,30 @@ public:
                           ReorderingBuffer &buffer,
                           UErrorCode &errorCode) const;
 
+    // UTF-8 versions, see Normalizer2::normalizeUTF8() etc.
+    // They look up norm16 values directly from the UTF-8 text and pass through
+    // runs of quick check "yes" characters with ccc=0 without conversion.
+    // Each other character is handled in the segment between the
+    // normalization boundaries around it, via the UTF-16 functions.
+    // Ill-formed sequences have the trie's error value 0 and are inert.
+
+    // sink!=NULL: Decomposes [src, limit[ into the sink and returns limit.
+    // sink==NULL: Returns the end of the quick check "yes" span.
+    const uint8_t *decomposeUTF8(const uint8_t *src, const uint8_t *limit,
+                                 ByteSink *sink, UErrorCode &errorCode) const;
+    // Dual functionality:
+    // sink!=NULL: normalize
+    // sink==NULL: isNormalized
+    UBool composeUTF8(const uint8_t *src, const uint8_t *limit,
+                      UBool onlyContiguous,
+                      ByteSink *sink,
+                      UErrorCode &errorCode) const;
+    // pQCResult!=NULL: quickCheck, pQCResult==NULL: spanQuickCheckYes
+    const uint8_t *composeQuickCheckUTF8(const uint8_t *src, const uint8_t *limit,
+                                         UBool onlyContiguous,
+                                         UNormalizationCheckResult *pQCResult,
+                                         UErrorCode &errorCode) const;
+
     UBool hasDecompBoundary(UChar32 c, UBool before) const;
     UBool isDecompInert(UChar32 c) const { return isDecompYesAndZeroCC(getNorm16(c)); }
 
@@ -525,6 +550,9 @@ private:
             return 0;
         }
     }
+    const uint8_t *findUTF8Segment(const uint8_t *src, const uint8_t *limit,
+                                   UBool forCompose,
+                                   const uint8_t *&segmentStart) const;
     // requires that the [cpStart..cpLimit[ character passes isCompYesAndZeroCC()
     uint8_t getTrailCCFromCompYesAndZeroCC(const UChar *cpStart, const UChar *cpLimit) const;
 
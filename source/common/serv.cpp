@@ -331,7 +331,9 @@ U_CDECL_END
 ******************************************************************
 */
 
-static UMutex lock = U_MUTEX_INITIALIZER;
+// Read-mostly: Cache hits in getKey() take the read lock,
+// everything else takes the write lock.
+static URWLock lock = U_RWLOCK_INITIALIZER;
 
 ICUService::ICUService()
 : name()
@@ -356,7 +358,7 @@ ICUService::ICUService(const UnicodeString& newName)
 ICUService::~ICUService()
 {
     {
-        Mutex mutex(&lock);
+        WriteLock mutex(&lock);
         clearCaches();
         delete factories;
         factories = NULL;
@@ -401,21 +403,44 @@ ICUService::getKey(ICUServiceKey& key, UnicodeString* actualReturn, UErrorCode&
 // reentrantly even without knowing the thread.
 class XMutex : public UMemory {
 public:
-    inline XMutex(UMutex *mutex, UBool reentering) 
+    inline XMutex(URWLock *mutex, UBool reentering) 
         : fMutex(mutex)
         , fActive(!reentering) 
     {
-        if (fActive) umtx_lock(fMutex);
+        if (fActive) umtx_wrlock(fMutex);
     }
     inline ~XMutex() {
-        if (fActive) umtx_unlock(fMutex);
+        if (fActive) umtx_wrunlock(fMutex);
     }
 
 private:
-    UMutex  *fMutex;
+    URWLock  *fMutex;
     UBool fActive;
 };
 
+// Sets actualReturn to the cache entry's descriptor, without the null prefix.
+static UBool
+copyActualDescriptor(const UnicodeString& actualDescriptor, UnicodeString* actualReturn, UErrorCode& status)
+{
+    if (actualReturn != NULL) {
+        // strip null prefix
+        if (actualDescriptor.indexOf((UChar)0x2f) == 0) { // U+002f=slash (/)
+            actualReturn->remove();
+            actualReturn->append(actualDescriptor, 
+                1, 
+                actualDescriptor.length() - 1);
+        } else {
+            *actualReturn = actualDescriptor;
+        }
+
+        if (actualReturn->isBogus()) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
 struct UVectorDeleter {
     UVector* _obj;
     UVectorDeleter() : _obj(NULL) {}
@@ -437,12 +462,30 @@ ICUService::getKey(ICUServiceKey& key, UnicodeString* actualReturn, const ICUSer
     ICUService* ncthis = (ICUService*)this; // cast away semantic const
 
     CacheEntry* result = NULL;
+    if (factory == NULL) {
+        // Fast path: Most lookups hit the cache with the key's first descriptor.
+        // Cached entries are only deleted under the write lock,
+        // so readers can share the lock.
+        UnicodeString currentDescriptor;
+        key.currentDescriptor(currentDescriptor);
+
+        ReadLock readLock(&lock);
+        if (serviceCache != NULL) {
+            result = (CacheEntry*)serviceCache->get(currentDescriptor);
+            if (result != NULL) {
+                if (!copyActualDescriptor(result->actualDescriptor, actualReturn, status)) {
+                    return NULL;
+                }
+                return cloneInstance(result->service);
+            }
+        }
+    }
     {
         // The factory list can't be modified until we're done, 
         // otherwise we might update the cache with an invalid result.
         // The cache has to stay in synch with the factory list.
-        // ICU doesn't have monitors so we can't use rw locks, so 
-        // we single-thread everything using this service, for now.
+        // Only the cache lookup above shares the lock; 
+        // creating and caching a service is single-threaded.
 
         // if factory is not null, we're calling from within the mutex,
         // and since some unix machines don't have reentrant mutexes we
@@ -564,22 +607,9 @@ outerEnd:
                 }
             }
 
-            if (actualReturn != NULL) {
-                // strip null prefix
-                if (result->actualDescriptor.indexOf((UChar)0x2f) == 0) { // U+002f=slash (/)
-                    actualReturn->remove();
-                    actualReturn->append(result->actualDescriptor, 
-                        1, 
-                        result->actualDescriptor.length() - 1);
-                } else {
-                    *actualReturn = result->actualDescriptor;
-                }
-
-                if (actualReturn->isBogus()) {
-                    status = U_MEMORY_ALLOCATION_ERROR;
-                    delete result;
-                    return NULL;
-                }
+            if (!copyActualDescriptor(result->actualDescriptor, actualReturn, status)) {
+                delete result;
+                return NULL;
             }
 
             UObject* service = cloneInstance(result->service);
@@ -614,7 +644,7 @@ ICUService::getVisibleIDs(UVector& result, const UnicodeString* matchID, UErrorC
     }
 
     {
-        Mutex mutex(&lock);
+        WriteLock mutex(&lock);
         const Hashtable* map = getVisibleIDMap(status);
         if (map != NULL) {
             ICUServiceKey* fallbackKey = createKey(matchID, status);
@@ -691,7 +721,7 @@ ICUService::getDisplayName(const UnicodeString& id, UnicodeString& result, const
 {
     {
         UErrorCode status = U_ZERO_ERROR;
-        Mutex mutex(&lock);
+        WriteLock mutex(&lock);
         const Hashtable* map = getVisibleIDMap(status);
         if (map != NULL) {
             ICUServiceFactory* f = (ICUServiceFactory*)map->get(id);
@@ -743,7 +773,7 @@ ICUService::getDisplayNames(UVector& result,
     result.setDeleter(userv_deleteStringPair);
     if (U_SUCCESS(status)) {
         ICUService* ncthis = (ICUService*)this; // cast away semantic const
-        Mutex mutex(&lock);
+        WriteLock mutex(&lock);
 
         if (dnCache != NULL && dnCache->locale != locale) {
             delete dnCache;
@@ -848,7 +878,7 @@ URegistryKey
 ICUService::registerFactory(ICUServiceFactory* factoryToAdopt, UErrorCode& status) 
 {
     if (U_SUCCESS(status) && factoryToAdopt != NULL) {
-        Mutex mutex(&lock);
+        WriteLock mutex(&lock);
 
         if (factories == NULL) {
             factories = new UVector(deleteUObject, NULL, status);
@@ -879,7 +909,7 @@ ICUService::unregister(URegistryKey rkey, UErrorCode& status)
     ICUServiceFactory *factory = (ICUServiceFactory*)rkey;
     UBool result = FALSE;
     if (factory != NULL && factories != NULL) {
-        Mutex mutex(&lock);
+        WriteLock mutex(&lock);
 
         if (factories->removeElement(factory)) {
             clearCaches();
@@ -899,7 +929,7 @@ void
 ICUService::reset() 
 {
     {
-        Mutex mutex(&lock);
+        WriteLock mutex(&lock);
         reInitializeFactories();
         clearCaches();
     }
@@ -25,7 +25,7 @@
 
 U_NAMESPACE_BEGIN
 
-static UMutex llock = U_MUTEX_INITIALIZER;
+static URWLock llock = U_RWLOCK_INITIALIZER;
 ICULocaleService::ICULocaleService()
   : fallbackLocale(Locale::getDefault())
 {
@@ -264,7 +264,14 @@ ICULocaleService::validateFallbackLocale() const
     const Locale&     loc    = Locale::getDefault();
     ICULocaleService* ncThis = (ICULocaleService*)this;
     {
-        Mutex mutex(&llock);
+        // The default locale rarely changes: Check it under the shared lock.
+        ReadLock readLock(&llock);
+        if (loc == fallbackLocale) {
+            return fallbackLocaleName;
+        }
+    }
+    {
+        WriteLock mutex(&llock);
         if (loc != fallbackLocale) {
             ncThis->fallbackLocale = loc;
             LocaleUtility::initNameFromLocale(loc, ncThis->fallbackLocaleName);
@@ -22,6 +22,7 @@
 
 #include "unicode/utypes.h"
 #include "unicode/udata.h"
+#include "cmemory.h"
 #include "cstring.h"
 #include "ucmndata.h"
 #include "udatamem.h"
@@ -57,6 +58,21 @@ udata_getInfoSize(const UDataInfo *info) {
         return (uint16_t)((x<<8)|(x>>8));
     }
 }
+U_CAPI uint32_t U_EXPORT2
+udata_hashTOCEntryName(const char *name, uint32_t seed) {
+    /* FNV-1a over the name bytes, seeded, followed by a 32-bit finalizer mix */
+    uint32_t h=0x811c9dc5^(seed*0x9e3779b9);
+    uint8_t c;
+    while((c=(uint8_t)*name++)!=0) {
+        h=(h^c)*0x01000193;
+    }
+    h^=h>>16;
+    h*=0x85ebca6b;
+    h^=h>>13;
+    h*=0xc2b2ae35;
+    h^=h>>16;
+    return h;
+}
 
 /*-----------------------------------------------------------------------------*
  *                                                                             *
@@ -205,6 +221,102 @@ pointerTOCPrefixBinarySearch(const char *s, const PointerTOCEntry *toc, int32_t
     return -1;
 }
 
+/**
+ * Look up a name with the optional perfect hash index.
+ * Returns the only ToC entry number that could match the name;
+ * the caller must still compare the names.
+ */
+static int32_t
+offsetTOCHashLookup(const char *s, const uint32_t *tocIndex) {
+    uint32_t count=tocIndex[UDATA_TOC_INDEX_COUNT];
+    uint32_t bucketCount=tocIndex[UDATA_TOC_INDEX_BUCKET_COUNT];
+    const uint32_t *displacements=tocIndex+UDATA_TOC_INDEX_DISPLACEMENTS;
+    uint32_t d=displacements[udata_hashTOCEntryName(s, 0)%bucketCount];
+    return (int32_t)displacements[bucketCount+udata_hashTOCEntryName(s, d)%count];
+}
+
+/**
+ * Find and validate the optional perfect hash index of a .dat package.
+ * Returns NULL if there is none or if it does not match this ToC,
+ * in which case lookups use the binary search.
+ */
+static const uint32_t *
+offsetTOCFindIndex(const UDataMemory *pData) {
+    const UDataOffsetTOC *toc=(const UDataOffsetTOC *)pData->toc;
+    const char *base=(const char *)toc;
+    const char *firstName, *prefixLimit;
+    const DataHeader *pHeader;
+    const uint32_t *tocIndex;
+    char name[64];
+    int32_t count, prefixLength, number, indexLength;
+    uint16_t headerSize;
+
+    count=(int32_t)toc->count;
+    if(count<=0) {
+        return NULL;
+    }
+    /* the index item name has the same package prefix as the other items */
+    firstName=base+toc->entry[0].nameOffset;
+    prefixLimit=uprv_strchr(firstName, U_TREE_ENTRY_SEP_CHAR);
+    if(prefixLimit==NULL) {
+        return NULL;
+    }
+    prefixLength=(int32_t)(prefixLimit-firstName)+1;
+    if((prefixLength+(int32_t)sizeof(UDATA_TOC_INDEX_NAME))>(int32_t)sizeof(name)) {
+        return NULL;
+    }
+    uprv_memcpy(name, firstName, prefixLength);
+    uprv_strcpy(name+prefixLength, UDATA_TOC_INDEX_NAME);
+    number=offsetTOCPrefixBinarySearch(name, base, toc->entry, count);
+    if(number<0) {
+        return NULL;
+    }
+
+    pHeader=(const DataHeader *)(base+toc->entry[number].dataOffset);
+    headerSize=udata_getHeaderSize(pHeader);
+    if((number+1)<count) {
+        indexLength=(int32_t)(toc->entry[number+1].dataOffset-toc->entry[number].dataOffset)-headerSize;
+    } else if(pData->length>=0) {
+        indexLength=pData->length-(int32_t)((const char *)pHeader-(const char *)pData->pHeader)-headerSize;
+    } else {
+        indexLength=-1;  /* the last item in memory of unknown length */
+    }
+    if(!(pHeader->dataHeader.magic1==0xda &&
+        pHeader->dataHeader.magic2==0x27 &&
+        pHeader->info.isBigEndian==U_IS_BIG_ENDIAN &&
+        pHeader->info.charsetFamily==U_CHARSET_FAMILY &&
+        pHeader->info.dataFormat[0]==0x54 &&   /* dataFormat="ToCH" */
+        pHeader->info.dataFormat[1]==0x6f &&
+        pHeader->info.dataFormat[2]==0x43 &&
+        pHeader->info.dataFormat[3]==0x48 &&
+        pHeader->info.formatVersion[0]==1 &&
+        (indexLength<0 || indexLength>=4*UDATA_TOC_INDEX_DISPLACEMENTS))
+    ) {
+        return NULL;
+    }
+    tocIndex=(const uint32_t *)((const char *)pHeader+headerSize);
+    if( tocIndex[UDATA_TOC_INDEX_COUNT]!=(uint32_t)count ||
+        tocIndex[UDATA_TOC_INDEX_BUCKET_COUNT]==0 ||
+        (indexLength>=0 &&
+            indexLength<4*(int32_t)(UDATA_TOC_INDEX_DISPLACEMENTS+tocIndex[UDATA_TOC_INDEX_BUCKET_COUNT]+count))
+    ) {
+        return NULL;
+    }
+    /*
+     * Spot-check that the index was built for these names,
+     * for example not before a charset conversion of the package.
+     * A wrong index that passes the spot checks only costs
+     * the binary search after a hash miss in offsetTOCLookupFn().
+     */
+    if( offsetTOCHashLookup(firstName, tocIndex)!=0 ||
+        offsetTOCHashLookup(name, tocIndex)!=number ||
+        offsetTOCHashLookup(base+toc->entry[count-1].nameOffset, tocIndex)!=(count-1)
+    ) {
+        return NULL;
+    }
+    return tocIndex;
+}
+
 static uint32_t offsetTOCEntryCount(const UDataMemory *pData) {
     int32_t          retVal=0;
     const UDataOffsetTOC *toc = (UDataOffsetTOC *)pData->toc;
@@ -224,14 +336,28 @@ offsetTOCLookupFn(const UDataMemory *pData,
         const char *base=(const char *)toc;
         int32_t number, count=(int32_t)toc->count;
 
-        /* perform a binary search for the data in the common data's table of contents */
+        /* look up the data in the common data's table of contents */
 #if defined (UDATA_DEBUG_DUMP)
         /* list the contents of the TOC each time .. not recommended */
         for(number=0; number<count; ++number) {
             fprintf(stderr, "\tx%d: %s\n", number, &base[toc->entry[number].nameOffset]);
         }
 #endif
-        number=offsetTOCPrefixBinarySearch(tocEntryName, base, toc->entry, count);
+        number=-1;
+        if(pData->tocIndex!=NULL) {
+            /* the perfect hash yields the only candidate entry */
+            number=offsetTOCHashLookup(tocEntryName, pData->tocIndex);
+            if((uint32_t)number>=(uint32_t)count || uprv_strcmp(tocEntryName, base+toc->entry[number].nameOffset)!=0) {
+                number=-1;
+            }
+        }
+        if(number<0) {
+            /*
+             * Not found via the index, or no index:
+             * Only the spot checks vouch for the index, so a miss is not final.
+             */
+            number=offsetTOCPrefixBinarySearch(tocEntryName, base, toc->entry, count);
+        }
         if(number>=0) {
             /* found it */
             const UDataOffsetTOCEntry *entry=toc->entry+number;
@@ -240,6 +366,9 @@ offsetTOCLookupFn(const UDataMemory *pData,
 #endif
             if((number+1) < count) {
                 *pLength = (int32_t)(entry[1].dataOffset - entry->dataOffset);
+            } else if(pData->length >= 0) {
+                /* the last item extends to the end of the mapped file */
+                *pLength = pData->length - (int32_t)(base + entry->dataOffset - (const char *)pData->pHeader);
             } else {
                 *pLength = -1;
             }
@@ -336,6 +465,7 @@ U_CFUNC void udata_checkCommonData(UDataMemory *udm, UErrorCode *err) {
         /* dataFormat="CmnD" */
         udm->vFuncs = &CmnDFuncs;
         udm->toc=(const char *)udm->pHeader+udata_getHeaderSize(udm->pHeader);
+        udm->tocIndex=offsetTOCFindIndex(udm);
     }
     else if(udm->pHeader->info.dataFormat[0]==0x54 &&
         udm->pHeader->info.dataFormat[1]==0x6f &&
@@ -53,6 +53,37 @@ typedef struct {
     UDataOffsetTOCEntry entry[2];    /* Actual size of array is from count. */
 } UDataOffsetTOC;
 
+/*
+ * Optional index item in a .dat package (dataFormat="ToCH", formatVersion 1).
+ * It is stored like any other item, under the package prefix plus
+ * UDATA_TOC_INDEX_NAME, and contains a minimal perfect hash of all item names
+ * including its own. Readers that do not know about it simply ignore it.
+ *
+ * After the usual ICU data header, the item contains uint32_t values:
+ *   [0] count: number of ToC entries
+ *   [1] bucketCount
+ *   displacement[bucketCount]
+ *   entryIndex[count]
+ *
+ * The ToC entry for a name is entryIndex[
+ *     udata_hashTOCEntryName(name, displacement[
+ *         udata_hashTOCEntryName(name, 0)%bucketCount])%count]
+ * and the name still needs to be compared with that entry's name.
+ */
+#define UDATA_TOC_INDEX_NAME "tocindex.idx"
+
+/*
+ * Set in the count by tools that change the item names without
+ * rebuilding the index; the count then does not match the ToC count.
+ */
+#define UDATA_TOC_INDEX_INVALID 0x80000000
+
+enum {
+    UDATA_TOC_INDEX_COUNT,
+    UDATA_TOC_INDEX_BUCKET_COUNT,
+    UDATA_TOC_INDEX_DISPLACEMENTS
+};
+
 /**
  * Get the header size from a const DataHeader *udh.
  * Handles opposite-endian data.
@@ -71,6 +102,15 @@ udata_getHeaderSize(const DataHeader *udh);
 U_CFUNC uint16_t
 udata_getInfoSize(const UDataInfo *info);
 
+/**
+ * Hash function for the optional .dat package ToC index.
+ * Must not change as long as the index formatVersion stays the same.
+ *
+ * @internal
+ */
+U_CAPI uint32_t U_EXPORT2
+udata_hashTOCEntryName(const char *name, uint32_t seed);
+
 U_CDECL_BEGIN
 /*
  *  "Virtual" functions for data lookup.
@@ -474,6 +474,7 @@ ucnv_setSubstChars (UConverter * converter,
     * we set subChar1 to 0.
     */
     converter->subChar1 = 0;
+    converter->options |= UCNV_OPTION_CUSTOM_SUBST;
     
     return;
 }
@@ -563,6 +564,7 @@ ucnv_setSubstString(UConverter *cnv,
 
     /* See comment in ucnv_setSubstChars(). */
     cnv->subChar1 = 0;
+    cnv->options |= UCNV_OPTION_CUSTOM_SUBST;
 }
 
 /*resets the internal states of a converter
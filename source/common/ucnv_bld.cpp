@@ -43,6 +43,7 @@
 #include "cmemory.h"
 #include "ucln_cmn.h"
 #include "ustr_cnv.h"
+#include "ustr_imp.h"
 
 
 #if 0
@@ -158,11 +159,82 @@ static struct {
 };
 
 
+/*
+ * The shared data cache is split into shards by a hash of the converter name.
+ * Each shard has its own mutex, which protects the shard's hash table
+ * and the reference counters of the shared data cached in it.
+ * (An uncached, non-algorithmic shared data object uses the mutex of the
+ * shard for its name as well.)
+ * Opening a converter whose data is already cached only locks one shard,
+ * so that threads opening different converters do not contend.
+ *
+ * The shard also holds the pools of idle converters for its names (see ucnv_acquire()).
+ * They are only added under the shard mutex; otherwise the pools use atomic operations.
+ *
+ * cnvCacheMutex serializes loading of converter data on a cache miss
+ * and flushing of the cache.
+ * Lock order: A shard mutex may be locked while holding cnvCacheMutex,
+ * but no other mutex may be locked while holding a shard mutex.
+ */
+#define UCNV_CACHE_SHARD_COUNT 16
+
+/* Maximum number of converter names with pools per shard. */
+#define UCNV_POOL_SHARD_NAMES 16
+
+/* Maximum number of idle converters pooled per name. */
+#define UCNV_POOL_CAPACITY 64
+
+/*
+ * A pool slot holds one idle converter or none.
+ * A thread owns the slot while it has incremented busy from 0 to 1.
+ * full tells other threads whether to try the slot.
+ */
+typedef struct UConverterPoolSlot {
+    u_atomic_int32_t busy;
+    u_atomic_int32_t full;
+    UConverter *cnv;  /* guarded by busy */
+} UConverterPoolSlot;
+
+/*
+ * The idle converters for one name.
+ * idleCount is the number of converters in slots that are not reserved by ucnv_acquire().
+ * Slots are used up to slotLimit, which grows with the number of converters
+ * released at the same time, up to UCNV_POOL_CAPACITY.
+ */
+typedef struct UConverterPool {
+    char name[UCNV_MAX_CONVERTER_NAME_LENGTH];
+    u_atomic_int32_t idleCount;
+    u_atomic_int32_t slotLimit;
+    u_atomic_int32_t hits;
+    u_atomic_int32_t misses;
+    UConverterPoolSlot slots[UCNV_POOL_CAPACITY];
+} UConverterPool;
+
+typedef struct U_CACHE_LINE_ALIGNED UConverterCacheShard {
+    UMutex mutex;
+    UHashtable *table;
+    u_atomic_int32_t poolCount;
+    UConverterPool *pools[UCNV_POOL_SHARD_NAMES];  /* set before poolCount is incremented */
+    u_atomic_int32_t poolMisses;  /* ucnv_acquire() misses for names without pools */
+} UConverterCacheShard;
+
+#define UCNV_CACHE_SHARD_INITIALIZER { \
+    U_MUTEX_INITIALIZER, NULL, ATOMIC_INT32_T_INITIALIZER(0), { NULL }, ATOMIC_INT32_T_INITIALIZER(0) \
+}
+
 /*initializes some global variables */
-static UHashtable *SHARED_DATA_HASHTABLE = NULL;
-static UMutex cnvCacheMutex = U_MUTEX_INITIALIZER;  /* Mutex for synchronizing cnv cache access. */
-                                                    /*  Note:  the global mutex is used for      */
-                                                    /*         reference count updates.          */
+static UConverterCacheShard gCacheShards[UCNV_CACHE_SHARD_COUNT] = {
+    UCNV_CACHE_SHARD_INITIALIZER, UCNV_CACHE_SHARD_INITIALIZER,
+    UCNV_CACHE_SHARD_INITIALIZER, UCNV_CACHE_SHARD_INITIALIZER,
+    UCNV_CACHE_SHARD_INITIALIZER, UCNV_CACHE_SHARD_INITIALIZER,
+    UCNV_CACHE_SHARD_INITIALIZER, UCNV_CACHE_SHARD_INITIALIZER,
+    UCNV_CACHE_SHARD_INITIALIZER, UCNV_CACHE_SHARD_INITIALIZER,
+    UCNV_CACHE_SHARD_INITIALIZER, UCNV_CACHE_SHARD_INITIALIZER,
+    UCNV_CACHE_SHARD_INITIALIZER, UCNV_CACHE_SHARD_INITIALIZER,
+    UCNV_CACHE_SHARD_INITIALIZER, UCNV_CACHE_SHARD_INITIALIZER
+};
+static UMutex cnvCacheMutex = U_MUTEX_INITIALIZER;  /* Mutex for loading into and flushing the cnv cache, */
+                                                    /*   and for the default converter name.             */
 
 static const char **gAvailableConverters = NULL;
 static uint16_t gAvailableConverterCount = 0;
@@ -208,10 +280,28 @@ ucnv_flushAvailableConverterCache() {
 /*                Not thread safe.                                            */
 /*                Not supported API.                                          */
 static UBool U_CALLCONV ucnv_cleanup(void) {
+    UBool isEmpty = TRUE;
+    int32_t i;
+
     ucnv_flushCache();
-    if (SHARED_DATA_HASHTABLE != NULL && uhash_count(SHARED_DATA_HASHTABLE) == 0) {
-        uhash_close(SHARED_DATA_HASHTABLE);
-        SHARED_DATA_HASHTABLE = NULL;
+    for (i = 0; i < UCNV_CACHE_SHARD_COUNT; ++i) {
+        UConverterCacheShard *shard = gCacheShards + i;
+        /* ucnv_flushCache() emptied the pools */
+        int32_t count = umtx_loadAcquire(shard->poolCount);
+        for (int32_t p = 0; p < count; ++p) {
+            uprv_free(shard->pools[p]);
+            shard->pools[p] = NULL;
+        }
+        umtx_storeRelease(shard->poolCount, 0);
+        umtx_storeRelease(shard->poolMisses, 0);
+        if (shard->table != NULL) {
+            if (uhash_count(shard->table) == 0) {
+                uhash_close(shard->table);
+                shard->table = NULL;
+            } else {
+                isEmpty = FALSE;
+            }
+        }
     }
 
     /* Isn't called from flushCache because other threads may have preexisting references to the table. */
@@ -224,7 +314,7 @@ static UBool U_CALLCONV ucnv_cleanup(void) {
     gDefaultAlgorithmicSharedData = NULL;
 #endif
 
-    return (SHARED_DATA_HASHTABLE == NULL);
+    return isEmpty;
 }
 
 static UBool U_CALLCONV
@@ -407,23 +497,38 @@ getAlgorithmicTypeFromName(const char *realName)
 */
 #define UCNV_CACHE_LOAD_FACTOR 2
 
-/* Puts the shared data in the static hashtable SHARED_DATA_HASHTABLE */
+/* Returns the cache shard for a converter name. */
+static UConverterCacheShard *
+ucnv_getCacheShard(const char *name)
+{
+    uint32_t hash = (uint32_t)ustr_fastHashCharsN(name, (int32_t)uprv_strlen(name));
+    return gCacheShards + (hash % UCNV_CACHE_SHARD_COUNT);
+}
+
+/* Puts the shared data in its cache shard.                           */
 /*   Will always be called with the cnvCacheMutex alrady being held   */
 /*     by the calling function.                                       */
-/* Stores the shared data in the SHARED_DATA_HASHTABLE
+/* Stores the shared data in the shard's hash table
  * @param data The shared data
  */
 static void
 ucnv_shareConverterData(UConverterSharedData * data)
 {
     UErrorCode err = U_ZERO_ERROR;
-    /*Lazy evaluates the Hashtable itself */
+    UConverterCacheShard *shard = ucnv_getCacheShard(data->staticData->name);
     /*void *sanity = NULL;*/
 
-    if (SHARED_DATA_HASHTABLE == NULL)
+    /*
+     * Lazy evaluates the shard's Hashtable itself.
+     * Only this function creates shard tables, and it is serialized by cnvCacheMutex,
+     * so the table can be created before locking the shard,
+     * without calling into other code while holding the shard mutex.
+     */
+    UHashtable *table = shard->table;
+    if (table == NULL)
     {
-        SHARED_DATA_HASHTABLE = uhash_openSize(uhash_hashChars, uhash_compareChars, NULL,
-                            ucnv_io_countKnownConverters(&err)*UCNV_CACHE_LOAD_FACTOR,
+        table = uhash_openSize(uhash_fastHashChars, uhash_compareChars, NULL,
+                            ucnv_io_countKnownConverters(&err)*UCNV_CACHE_LOAD_FACTOR/UCNV_CACHE_SHARD_COUNT,
                             &err);
         ucln_common_registerCleanup(UCLN_COMMON_UCNV, ucnv_cleanup);
 
@@ -442,40 +547,48 @@ ucnv_shareConverterData(UConverterSharedData * data)
     UCNV_DEBUG_LOG("put:chk",data->staticData->name,sanity);
     */
 
+    umtx_lock(&shard->mutex);
+    shard->table = table;
+
     /* Mark it shared */
     data->sharedDataCached = TRUE;
 
-    uhash_put(SHARED_DATA_HASHTABLE,
+    uhash_put(table,
             (void*) data->staticData->name, /* Okay to cast away const as long as
             keyDeleter == NULL */
             data,
             &err);
+    umtx_unlock(&shard->mutex);
     UCNV_DEBUG_LOG("put", data->staticData->name,data);
 
 }
 
-/*  Look up a converter name in the shared data cache.                    */
-/*    cnvCacheMutex must be held by the caller to protect the hash table. */
-/* gets the shared data from the SHARED_DATA_HASHTABLE (might return NULL if it isn't there)
+/*  Look up a converter name in the shared data cache,                    */
+/*    and if found, add a reference to it.                                */
+/*    Only locks the name's cache shard.                                  */
+/* gets the shared data from its cache shard (might return NULL if it isn't there)
  * @param name The name of the shared data
- * @return the shared data from the SHARED_DATA_HASHTABLE
+ * @return the shared data from the cache, with its referenceCounter incremented
  */
 static UConverterSharedData *
 ucnv_getSharedConverterData(const char *name)
 {
+    UConverterCacheShard *shard = ucnv_getCacheShard(name);
+    UConverterSharedData *rc = NULL;
+
+    umtx_lock(&shard->mutex);
     /*special case when no Table has yet been created we return NULL */
-    if (SHARED_DATA_HASHTABLE == NULL)
+    if (shard->table != NULL)
     {
-        return NULL;
-    }
-    else
-    {
-        UConverterSharedData *rc;
-
-        rc = (UConverterSharedData*)uhash_get(SHARED_DATA_HASHTABLE, name);
-        UCNV_DEBUG_LOG("get",name,rc);
-        return rc;
+        rc = (UConverterSharedData*)uhash_get(shard->table, name);
+        if (rc != NULL) {
+            /* Update the reference counter on the shared data: one more client */
+            rc->referenceCounter++;
+        }
     }
+    umtx_unlock(&shard->mutex);
+    UCNV_DEBUG_LOG("get",name,rc);
+    return rc;
 }
 
 /*frees the string of memory blocks associates with a sharedConverter
@@ -538,6 +651,7 @@ ucnv_deleteSharedConverterData(UConverterSharedData * deadSharedData)
 /**
  * Load a non-algorithmic converter.
  * If pkg==NULL, then this function must be called inside umtx_lock(&cnvCacheMutex).
+ * A cache hit only additionally locks the cache shard for the converter name.
  */
 UConverterSharedData *
 ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
@@ -552,6 +666,8 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
         return createConverterFromFile(pArgs, err);
     }
 
+    /* If the data for this converter is already in the cache, */
+    /*   then this adds a reference to it.                     */
     mySharedConverterData = ucnv_getSharedConverterData(pArgs->name);
     if (mySharedConverterData == NULL)
     {
@@ -567,29 +683,31 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
             ucnv_shareConverterData(mySharedConverterData);
         }
     }
-    else
-    {
-        /* The data for this converter was already in the cache.            */
-        /* Update the reference counter on the shared data: one more client */
-        mySharedConverterData->referenceCounter++;
-    }
 
     return mySharedConverterData;
 }
 
 /**
  * Unload a non-algorithmic converter.
- * It must be sharedData->referenceCounter != ~0
- * and this function must be called inside umtx_lock(&cnvCacheMutex).
+ * It must be sharedData->referenceCounter != ~0.
+ * This function locks the cache shard for the converter name
+ * and must not be called while holding any shard mutex.
  */
 U_CAPI void
 ucnv_unload(UConverterSharedData *sharedData) {
     if(sharedData != NULL) {
+        UConverterCacheShard *shard = ucnv_getCacheShard(sharedData->staticData->name);
+        UBool isUnused;
+
+        umtx_lock(&shard->mutex);
         if (sharedData->referenceCounter > 0) {
             sharedData->referenceCounter--;
         }
+        isUnused = (UBool)((sharedData->referenceCounter <= 0)&&(sharedData->sharedDataCached == FALSE));
+        umtx_unlock(&shard->mutex);
 
-        if((sharedData->referenceCounter <= 0)&&(sharedData->sharedDataCached == FALSE)) {
+        /* An uncached, unreferenced object is not reachable by any other thread. */
+        if(isUnused) {
             ucnv_deleteSharedConverterData(sharedData);
         }
     }
@@ -604,9 +722,7 @@ ucnv_unloadSharedDataIfReady(UConverterSharedData *sharedData)
     Don't check referenceCounter for any other value.
     */
     if(sharedData != NULL && sharedData->referenceCounter != (uint32_t)~0) {
-        umtx_lock(&cnvCacheMutex);
         ucnv_unload(sharedData);
-        umtx_unlock(&cnvCacheMutex);
     }
 }
 
@@ -619,9 +735,10 @@ ucnv_incrementRefCount(UConverterSharedData *sharedData)
     Don't check referenceCounter for any other value.
     */
     if(sharedData != NULL && sharedData->referenceCounter != (uint32_t)~0) {
-        umtx_lock(&cnvCacheMutex);
+        UConverterCacheShard *shard = ucnv_getCacheShard(sharedData->staticData->name);
+        umtx_lock(&shard->mutex);
         sharedData->referenceCounter++;
-        umtx_unlock(&cnvCacheMutex);
+        umtx_unlock(&shard->mutex);
     }
 }
 
@@ -815,19 +932,24 @@ ucnv_loadSharedData(const char *converterName,
     if (mySharedConverterData == NULL)
     {
         /* it is a data-based converter, get its shared data.               */
-        /* Hold the cnvCacheMutex through the whole process of checking the */
-        /*   converter data cache, and adding new entries to the cache      */
-        /*   to prevent other threads from modifying the cache during the   */
-        /*   process.                                                       */
+        /* A cache hit only locks the cache shard for the converter name.   */
+        /* Otherwise, hold the cnvCacheMutex through the whole process of   */
+        /*   checking the converter data cache again, and adding new        */
+        /*   entries to the cache to prevent other threads from loading     */
+        /*   the same converter during the process.                         */
         pArgs->nestedLoads=1;
         pArgs->pkg=NULL;
 
-        umtx_lock(&cnvCacheMutex);
-        mySharedConverterData = ucnv_load(pArgs, err);
-        umtx_unlock(&cnvCacheMutex);
-        if (U_FAILURE (*err) || (mySharedConverterData == NULL))
+        mySharedConverterData = ucnv_getSharedConverterData(pArgs->name);
+        if (mySharedConverterData == NULL)
         {
-            return NULL;
+            umtx_lock(&cnvCacheMutex);
+            mySharedConverterData = ucnv_load(pArgs, err);
+            umtx_unlock(&cnvCacheMutex);
+            if (U_FAILURE (*err) || (mySharedConverterData == NULL))
+            {
+                return NULL;
+            }
         }
     }
 
@@ -1040,6 +1162,332 @@ ucnv_createConverterFromSharedData(UConverter *myUConverter,
     return myUConverter;
 }
 
+/* converter pool ----------------------------------------------------------- */
+
+/*
+ * Writes the pool key for a converter name to key[UCNV_MAX_CONVERTER_NAME_LENGTH]:
+ * The canonical converter name followed by the options from the input name, if any.
+ * In the common cases, this is the same as ucnv_getName() of the converter
+ * that ucnv_open() returns for the input name.
+ * Pooled converters are keyed by ucnv_getName(), so a name whose key differs
+ * from that only misses in the pool.
+ * Returns FALSE if the name cannot be keyed.
+ */
+static UBool
+ucnv_getPoolKey(const char *converterName, char *key)
+{
+    char baseName[UCNV_MAX_CONVERTER_NAME_LENGTH];
+    const char *canonicalName;
+    const char *options;
+    int32_t length, optionsLength;
+
+    if (converterName == NULL) {
+        /* the default converter name is already canonical */
+        canonicalName = ucnv_getDefaultName();
+        if (canonicalName == NULL) {
+            return FALSE;
+        }
+        options = "";
+    } else {
+        options = uprv_strchr(converterName, UCNV_OPTION_SEP_CHAR);
+        if (options == NULL) {
+            options = converterName + uprv_strlen(converterName);
+        }
+        length = (int32_t)(options - converterName);
+        if (length >= UCNV_MAX_CONVERTER_NAME_LENGTH) {
+            return FALSE;
+        }
+        uprv_memcpy(baseName, converterName, length);
+        baseName[length] = 0;
+
+        if (UCNV_FAST_IS_UTF8(baseName)) {
+            canonicalName = "UTF-8";
+        } else {
+            UErrorCode errorCode = U_ZERO_ERROR;
+            UBool containsOption = FALSE;
+            canonicalName = ucnv_io_getConverterName(baseName, &containsOption, &errorCode);
+            if (U_FAILURE(errorCode) || canonicalName == NULL) {
+                /* same as in ucnv_loadSharedData() */
+                canonicalName = baseName;
+            } else if (containsOption && *options != 0) {
+                /* ucnv_open() would apply the canonical name's options after the input options */
+                return FALSE;
+            }
+        }
+    }
+
+    length = (int32_t)uprv_strlen(canonicalName);
+    optionsLength = (int32_t)uprv_strlen(options);
+    if ((length + optionsLength) >= UCNV_MAX_CONVERTER_NAME_LENGTH) {
+        return FALSE;
+    }
+    uprv_memcpy(key, canonicalName, length);
+    uprv_memcpy(key + length, options, optionsLength + 1);
+    return TRUE;
+}
+
+/*
+ * Returns TRUE if the converter is in the configuration of a freshly opened one,
+ * apart from its conversion state, which ucnv_reset() takes care of.
+ * Its data must be what ucnv_open() of its name yields: the cached standard data
+ * or a built-in algorithmic converter, and not data from ucnv_openPackage()
+ * or otherwise kept out of the cache.
+ */
+static UBool
+ucnv_isPoolable(const UConverter *cnv)
+{
+    return (UBool)(
+        (cnv->sharedData->sharedDataCached ||
+            cnv->sharedData->referenceCounter == (uint32_t)~0) &&
+        !cnv->isCopyLocal &&
+        cnv->fromCharErrorBehaviour == UCNV_TO_U_DEFAULT_CALLBACK &&
+        cnv->fromUCharErrorBehaviour == UCNV_FROM_U_DEFAULT_CALLBACK &&
+        cnv->toUContext == NULL &&
+        cnv->fromUContext == NULL &&
+        !cnv->useFallback &&
+        (cnv->options & UCNV_OPTION_CUSTOM_SUBST) == 0);
+}
+
+/* Number of unsuccessful passes over pool slots before yielding to other threads. */
+#define UCNV_POOL_SPINS 100
+
+/* Returns the pool for a converter name (a pool key), or NULL if there is none yet. */
+static UConverterPool *
+ucnv_findPool(UConverterCacheShard *shard, const char *name)
+{
+    int32_t count = umtx_loadAcquire(shard->poolCount);
+    int32_t i;
+    for (i = 0; i < count; ++i) {
+        if (uprv_strcmp(name, shard->pools[i]->name) == 0) {
+            return shard->pools[i];
+        }
+    }
+    return NULL;
+}
+
+/* Returns the pool for a converter name, adding it if there is room. */
+static UConverterPool *
+ucnv_addPool(UConverterCacheShard *shard, const char *name)
+{
+    UConverterPool *pool;
+    int32_t count, i;
+
+    umtx_lock(&shard->mutex);
+    pool = ucnv_findPool(shard, name);
+    count = umtx_loadAcquire(shard->poolCount);
+    if (pool == NULL && count < UCNV_POOL_SHARD_NAMES) {
+        pool = (UConverterPool *)uprv_malloc(sizeof(UConverterPool));
+        if (pool != NULL) {
+            uprv_strcpy(pool->name, name);
+            umtx_storeRelease(pool->idleCount, 0);
+            umtx_storeRelease(pool->slotLimit, 1);
+            umtx_storeRelease(pool->hits, 0);
+            umtx_storeRelease(pool->misses, 0);
+            for (i = 0; i < UCNV_POOL_CAPACITY; ++i) {
+                umtx_storeRelease(pool->slots[i].busy, 0);
+                umtx_storeRelease(pool->slots[i].full, 0);
+                pool->slots[i].cnv = NULL;
+            }
+            shard->pools[count] = pool;
+            umtx_storeRelease(shard->poolCount, count + 1);
+        }
+    }
+    umtx_unlock(&shard->mutex);
+    return pool;
+}
+
+static inline int32_t
+ucnv_getPoolSlotLimit(UConverterPool *pool)
+{
+    int32_t limit = umtx_loadAcquire(pool->slotLimit);
+    return limit <= UCNV_POOL_CAPACITY ? limit : UCNV_POOL_CAPACITY;
+}
+
+/* Removes an idle converter from the pool. Returns NULL if there is none. */
+static UConverter *
+ucnv_takeFromPool(UConverterPool *pool)
+{
+    int32_t spins, limit, i;
+
+    /* Reserve one of the idle converters. */
+    if (umtx_atomic_dec(&pool->idleCount) < 0) {
+        umtx_atomic_inc(&pool->idleCount);
+        return NULL;
+    }
+    /* The reserved converter is in one of the full slots; other threads only own them briefly. */
+    for (spins = 0;; ++spins) {
+        limit = ucnv_getPoolSlotLimit(pool);
+        for (i = 0; i < limit; ++i) {
+            UConverterPoolSlot *slot = pool->slots + i;
+            if (umtx_loadAcquire(slot->full) != 0) {
+                UConverter *cnv = NULL;
+                if (umtx_atomic_inc(&slot->busy) == 1) {
+                    cnv = slot->cnv;
+                    if (cnv != NULL) {
+                        slot->cnv = NULL;
+                        umtx_storeRelease(slot->full, 0);
+                    }
+                }
+                umtx_atomic_dec(&slot->busy);
+                if (cnv != NULL) {
+                    return cnv;
+                }
+            }
+        }
+        if (spins >= UCNV_POOL_SPINS) {
+            umtx_yield();
+        }
+    }
+}
+
+/* Adds an idle converter to the pool. Returns FALSE if the pool is full. */
+static UBool
+ucnv_putIntoPool(UConverterPool *pool, UConverter *cnv)
+{
+    int32_t spins, limit, i;
+
+    for (spins = 0;; ++spins) {
+        UBool sawBusySlot = FALSE;
+        limit = ucnv_getPoolSlotLimit(pool);
+        for (i = 0; i < limit; ++i) {
+            UConverterPoolSlot *slot = pool->slots + i;
+            if (umtx_loadAcquire(slot->full) == 0) {
+                UBool isPut = FALSE;
+                if (umtx_atomic_inc(&slot->busy) == 1) {
+                    if (slot->cnv == NULL) {
+                        slot->cnv = cnv;
+                        umtx_storeRelease(slot->full, 1);
+                        isPut = TRUE;
+                    }
+                } else {
+                    sawBusySlot = TRUE;
+                }
+                umtx_atomic_dec(&slot->busy);
+                if (isPut) {
+                    umtx_atomic_inc(&pool->idleCount);
+                    return TRUE;
+                }
+            }
+        }
+        if (!sawBusySlot) {
+            /* All slots in use are full. Use one more if the capacity allows. */
+            if (limit >= UCNV_POOL_CAPACITY) {
+                return FALSE;
+            }
+            umtx_atomic_inc(&pool->slotLimit);
+        } else if (spins >= UCNV_POOL_SPINS) {
+            umtx_yield();
+        }
+    }
+}
+
+U_CAPI UConverter * U_EXPORT2
+ucnv_acquire(const char *converterName, UErrorCode *err)
+{
+    char key[UCNV_MAX_CONVERTER_NAME_LENGTH];
+    UConverterCacheShard *shard;
+    UConverterPool *pool;
+
+    if (err == NULL || U_FAILURE(*err)) {
+        return NULL;
+    }
+
+    if (ucnv_getPoolKey(converterName, key)) {
+        shard = ucnv_getCacheShard(key);
+        pool = ucnv_findPool(shard, key);
+        if (pool != NULL) {
+            UConverter *cnv = ucnv_takeFromPool(pool);
+            if (cnv != NULL) {
+                umtx_atomic_inc(&pool->hits);
+                /* ucnv_release() reset the converter */
+                return cnv;
+            }
+            umtx_atomic_inc(&pool->misses);
+        } else {
+            umtx_atomic_inc(&shard->poolMisses);
+        }
+    } else {
+        umtx_atomic_inc(&gCacheShards[0].poolMisses);
+    }
+
+    return ucnv_open(converterName, err);
+}
+
+U_CAPI void U_EXPORT2
+ucnv_release(UConverter *converter)
+{
+    if (converter == NULL) {
+        return;
+    }
+
+    if (ucnv_isPoolable(converter)) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        const char *name = ucnv_getName(converter, &errorCode);
+        if (U_SUCCESS(errorCode) && name != NULL &&
+                uprv_strlen(name) < UCNV_MAX_CONVERTER_NAME_LENGTH) {
+            UConverterCacheShard *shard = ucnv_getCacheShard(name);
+            UConverterPool *pool = ucnv_findPool(shard, name);
+            if (pool == NULL) {
+                pool = ucnv_addPool(shard, name);
+            }
+            if (pool != NULL) {
+                ucnv_reset(converter);
+                if (ucnv_putIntoPool(pool, converter)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    /* not poolable, or the pool is full */
+    ucnv_close(converter);
+}
+
+U_CAPI void U_EXPORT2
+ucnv_getPoolCounts(int32_t *pHits, int32_t *pMisses)
+{
+    int32_t hits = 0, misses = 0;
+    int32_t s, i, count;
+
+    for (s = 0; s < UCNV_CACHE_SHARD_COUNT; ++s) {
+        UConverterCacheShard *shard = gCacheShards + s;
+        misses += umtx_loadAcquire(shard->poolMisses);
+        count = umtx_loadAcquire(shard->poolCount);
+        for (i = 0; i < count; ++i) {
+            hits += umtx_loadAcquire(shard->pools[i]->hits);
+            misses += umtx_loadAcquire(shard->pools[i]->misses);
+        }
+    }
+    if (pHits != NULL) {
+        *pHits = hits;
+    }
+    if (pMisses != NULL) {
+        *pMisses = misses;
+    }
+}
+
+/*
+ * Closes all pooled converters, so that their shared data can be flushed.
+ * The pools themselves remain until ucnv_cleanup() because other threads may be using them.
+ */
+static void
+ucnv_flushPool()
+{
+    UConverter *cnv;
+    int32_t s, i, count;
+
+    for (s = 0; s < UCNV_CACHE_SHARD_COUNT; ++s) {
+        UConverterCacheShard *shard = gCacheShards + s;
+        count = umtx_loadAcquire(shard->poolCount);
+        for (i = 0; i < count; ++i) {
+            /* ucnv_close() locks shards itself */
+            while ((cnv = ucnv_takeFromPool(shard->pools[i])) != NULL) {
+                ucnv_close(cnv);
+            }
+        }
+    }
+}
+
 /*Frees all shared immutable objects that aren't referred to (reference count = 0)
  */
 U_CAPI int32_t U_EXPORT2
@@ -1050,31 +1498,28 @@ ucnv_flushCache ()
     int32_t tableDeletedNum = 0;
     const UHashElement *e;
     /*UErrorCode status = U_ILLEGAL_ARGUMENT_ERROR;*/
-    int32_t i, remaining;
+    int32_t i, s, remaining;
 
     UTRACE_ENTRY_OC(UTRACE_UCNV_FLUSH_CACHE);
 
     /* Close the default converter without creating a new one so that everything will be flushed. */
     u_flushDefaultConverter();
+    /* Same for the idle converters in the pool. */
+    ucnv_flushPool();
 
-    /*if shared data hasn't even been lazy evaluated yet
-    * return 0
-    */
-    if (SHARED_DATA_HASHTABLE == NULL) {
-        UTRACE_EXIT_VALUE((int32_t)0);
-        return 0;
-    }
-
-    /*creates an enumeration to iterate through every element in the
-    * table
+    /*creates an enumeration to iterate through every element in each
+    * shard's table
     *
     * Synchronization:  holding cnvCacheMutex will prevent any other thread from
-    *                   accessing or modifying the hash table during the iteration.
-    *                   The reference count of an entry may be decremented by
-    *                   ucnv_close while the iteration is in process, but this is
-    *                   benign.  It can't be incremented (in ucnv_createConverter())
-    *                   because the sequence of looking up in the cache + incrementing
-    *                   is protected by cnvCacheMutex.
+    *                   adding to the hash tables during the iteration.
+    *                   The shard mutex is held while checking and removing an entry,
+    *                   so that its reference count cannot be incremented
+    *                   (in ucnv_createConverter()) between the check and the removal.
+    *                   The shard mutex is released while deleting the removed shared data
+    *                   because that may unload a base converter,
+    *                   which locks that converter's cache shard.
+    *                   Other threads only look up entries in the meantime,
+    *                   so the iteration position remains valid.
     */
     umtx_lock(&cnvCacheMutex);
     /*
@@ -1086,23 +1531,35 @@ ucnv_flushCache ()
     i = 0;
     do {
         remaining = 0;
-        pos = -1;
-        while ((e = uhash_nextElement (SHARED_DATA_HASHTABLE, &pos)) != NULL)
+        for (s = 0; s < UCNV_CACHE_SHARD_COUNT; ++s)
         {
-            mySharedData = (UConverterSharedData *) e->value.pointer;
-            /*deletes only if reference counter == 0 */
-            if (mySharedData->referenceCounter == 0)
+            UConverterCacheShard *shard = gCacheShards + s;
+            /*if this shard's table hasn't even been lazy evaluated yet, skip it */
+            if (shard->table == NULL) {
+                continue;
+            }
+            pos = -1;
+            umtx_lock(&shard->mutex);
+            while ((e = uhash_nextElement (shard->table, &pos)) != NULL)
             {
-                tableDeletedNum++;
-
-                UCNV_DEBUG_LOG("del",mySharedData->staticData->name,mySharedData);
-
-                uhash_removeElement(SHARED_DATA_HASHTABLE, e);
-                mySharedData->sharedDataCached = FALSE;
-                ucnv_deleteSharedConverterData (mySharedData);
-            } else {
-                ++remaining;
+                mySharedData = (UConverterSharedData *) e->value.pointer;
+                /*deletes only if reference counter == 0 */
+                if (mySharedData->referenceCounter == 0)
+                {
+                    tableDeletedNum++;
+
+                    UCNV_DEBUG_LOG("del",mySharedData->staticData->name,mySharedData);
+
+                    uhash_removeElement(shard->table, e);
+                    mySharedData->sharedDataCached = FALSE;
+                    umtx_unlock(&shard->mutex);
+                    ucnv_deleteSharedConverterData (mySharedData);
+                    umtx_lock(&shard->mutex);
+                } else {
+                    ++remaining;
+                }
             }
+            umtx_unlock(&shard->mutex);
         }
     } while(++i == 1 && remaining > 0);
     umtx_unlock(&cnvCacheMutex);
@@ -41,6 +41,8 @@
 /* converter options bits */
 #define UCNV_OPTION_VERSION     0xf
 #define UCNV_OPTION_SWAP_LFNL   0x10
+/* set in UConverter.options when the substitution characters were changed by API calls */
+#define UCNV_OPTION_CUSTOM_SUBST 0x80000000
 
 #define UCNV_GET_VERSION(cnv) ((cnv)->options&UCNV_OPTION_VERSION)
 
@@ -266,8 +268,9 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err);
 
 /**
  * Unload a non-algorithmic converter.
- * It must be sharedData->referenceCounter != ~0
- * and this function must be called inside umtx_lock(&cnvCacheMutex).
+ * It must be sharedData->referenceCounter != ~0.
+ * This function synchronizes the reference counter update itself
+ * and need not be called inside umtx_lock(&cnvCacheMutex).
  */
 U_CAPI void
 ucnv_unload(UConverterSharedData *sharedData);
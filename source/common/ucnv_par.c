@@ -0,0 +1,548 @@
+/*
+*******************************************************************************
+*
+*   Copyright (C) 2014, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+*
+*******************************************************************************
+*   file name:  ucnv_par.c
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Conversion of large buffers in independent chunks,
+*   which a caller-provided task runner may convert concurrently.
+*   The input is split only at points where a stateless charset
+*   is known to start a new character; otherwise the whole input
+*   is converted serially.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include "unicode/ucnv.h"
+#include "unicode/ustring.h"
+#include "unicode/utf16.h"
+#include "unicode/utf8.h"
+#include "ucnv_bld.h"
+#include "ucnv_cnv.h"
+#include "ucnvmbcs.h"
+#include "cmemory.h"
+#include "cstring.h"
+#include "ustr_imp.h"
+
+/* default number of source units per chunk */
+#define DEFAULT_CHUNK_LENGTH 0x100000
+
+/* how the source text can be split, see getToUSplitKind() and getFromUSplitKind() */
+enum {
+    SPLIT_NONE,
+    SPLIT_ANYWHERE,
+    SPLIT_UTF8,
+    SPLIT_UTF16BE,
+    SPLIT_UTF16LE,
+    SPLIT_UTF32,
+    SPLIT_BYTES,
+    SPLIT_CODE_POINTS
+};
+
+typedef struct Chunk {
+    int32_t start, limit;   /* source indexes */
+    UConverter *cnv;
+    void *target;           /* uprv_malloc()'ed output */
+    int32_t targetLength;   /* in UChars or chars */
+    UErrorCode errorCode;
+} Chunk;
+
+typedef struct ParallelConversion {
+    UBool toUnicode;
+    const void *src;
+    Chunk *chunks;
+} ParallelConversion;
+
+static int32_t
+getToUSplitKind(const UConverter *cnv, UBool splitBytes[256]) {
+    switch(ucnv_getType(cnv)) {
+    case UCNV_LATIN_1:
+    case UCNV_US_ASCII:
+        return SPLIT_ANYWHERE;
+    case UCNV_UTF8:
+    case UCNV_CESU8:
+        return SPLIT_UTF8;
+    case UCNV_UTF16_BigEndian:
+        /* version 1 handles a BOM */
+        return UCNV_GET_VERSION(cnv)==0 ? SPLIT_UTF16BE : SPLIT_NONE;
+    case UCNV_UTF16_LittleEndian:
+        return UCNV_GET_VERSION(cnv)==0 ? SPLIT_UTF16LE : SPLIT_NONE;
+    case UCNV_UTF32_BigEndian:
+    case UCNV_UTF32_LittleEndian:
+        return SPLIT_UTF32;
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    case UCNV_SBCS:
+    case UCNV_DBCS:
+    case UCNV_MBCS:
+        return ucnv_MBCSGetSplitBytes(cnv->sharedData, splitBytes) ? SPLIT_BYTES : SPLIT_NONE;
+#endif
+    default:
+        /* stateful or BOM-sensitive */
+        return SPLIT_NONE;
+    }
+}
+
+static int32_t
+getFromUSplitKind(const UConverter *cnv) {
+    switch(ucnv_getType(cnv)) {
+    case UCNV_LATIN_1:
+    case UCNV_US_ASCII:
+    case UCNV_UTF8:
+    case UCNV_CESU8:
+    case UCNV_UTF32_BigEndian:
+    case UCNV_UTF32_LittleEndian:
+        return SPLIT_CODE_POINTS;
+    case UCNV_UTF16_BigEndian:
+    case UCNV_UTF16_LittleEndian:
+        /* version 1 writes a BOM */
+        return UCNV_GET_VERSION(cnv)==0 ? SPLIT_CODE_POINTS : SPLIT_NONE;
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    case UCNV_SBCS:
+    case UCNV_DBCS:
+    case UCNV_MBCS:
+        return ucnv_MBCSCanSplitFromUnicode(cnv->sharedData) ? SPLIT_CODE_POINTS : SPLIT_NONE;
+#endif
+    default:
+        return SPLIT_NONE;
+    }
+}
+
+/*
+ * Returns the first index i with start<=i<limit where the source can be split,
+ * or -1 if there is none.
+ * start>0 so that the preceding unit can be examined.
+ */
+static int32_t
+findToUSplit(int32_t kind, const UBool splitBytes[256],
+             const uint8_t *s, int32_t start, int32_t limit) {
+    int32_t i;
+
+    switch(kind) {
+    case SPLIT_ANYWHERE:
+        return start;
+    case SPLIT_UTF8:
+        /* a sequence never continues with a non-trail byte */
+        for(i=start; i<limit; ++i) {
+            if(!U8_IS_TRAIL(s[i])) {
+                return i;
+            }
+        }
+        break;
+    case SPLIT_UTF16BE:
+        for(i=(start+1)&~1; i<limit; i+=2) {
+            if(!U16_IS_LEAD(((UChar)s[i-2]<<8)|s[i-1])) {
+                return i;
+            }
+        }
+        break;
+    case SPLIT_UTF16LE:
+        for(i=(start+1)&~1; i<limit; i+=2) {
+            if(!U16_IS_LEAD(((UChar)s[i-1]<<8)|s[i-2])) {
+                return i;
+            }
+        }
+        break;
+    case SPLIT_UTF32:
+        i=(start+3)&~3;
+        if(i<limit) {
+            return i;
+        }
+        break;
+    case SPLIT_BYTES:
+        for(i=start; i<limit; ++i) {
+            if(splitBytes[s[i]]) {
+                return i;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    return -1;
+}
+
+static int32_t
+findFromUSplit(const UChar *s, int32_t start, int32_t limit) {
+    /* do not split a surrogate pair */
+    if(U16_IS_TRAIL(s[start]) && U16_IS_LEAD(s[start-1])) {
+        ++start;
+    }
+    return start<limit ? start : -1;
+}
+
+/*
+ * Sets up chunks of about chunkLength source units each,
+ * with a converter per chunk: cnv for the first one and clones for the others.
+ * Returns the number of chunks, or 0 if an error occurred.
+ */
+static int32_t
+openChunks(UConverter *cnv, UBool toUnicode,
+           const void *src, int32_t srcLength, int32_t chunkLength,
+           UConverterTaskRunner runner,
+           Chunk **pChunks, UErrorCode *pErrorCode) {
+    UBool splitBytes[256];
+    Chunk *chunks;
+    int32_t kind, maxCount, count, start, split, i;
+
+    if(toUnicode) {
+        ucnv_resetToUnicode(cnv);
+        kind=getToUSplitKind(cnv, splitBytes);
+    } else {
+        ucnv_resetFromUnicode(cnv);
+        kind=getFromUSplitKind(cnv);
+    }
+    if(chunkLength<=0) {
+        chunkLength=DEFAULT_CHUNK_LENGTH;
+    }
+    if(runner==NULL || kind==SPLIT_NONE || srcLength<=chunkLength) {
+        maxCount=1;
+    } else {
+        maxCount=(int32_t)(((int64_t)srcLength+chunkLength-1)/chunkLength);
+    }
+
+    chunks=(Chunk *)uprv_malloc(maxCount*sizeof(Chunk));
+    if(chunks==NULL) {
+        *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    uprv_memset(chunks, 0, maxCount*sizeof(Chunk));
+
+    /* move each nominal chunk boundary forward to the next split point */
+    count=0;
+    start=0;
+    for(i=1; i<maxCount; ++i) {
+        split=(int32_t)i*chunkLength;
+        if(split<=start) {
+            continue;
+        }
+        if(toUnicode) {
+            split=findToUSplit(kind, splitBytes, (const uint8_t *)src, split, srcLength);
+        } else {
+            split=findFromUSplit((const UChar *)src, split, srcLength);
+        }
+        if(split<0) {
+            break;
+        }
+        chunks[count].start=start;
+        chunks[count++].limit=start=split;
+    }
+    chunks[count].start=start;
+    chunks[count++].limit=srcLength;
+
+    /* clone while cnv is not in use, so that the clones can be used concurrently */
+    chunks[0].cnv=cnv;
+    for(i=1; i<count; ++i) {
+        chunks[i].cnv=ucnv_safeClone(cnv, NULL, NULL, pErrorCode);
+        if(U_FAILURE(*pErrorCode)) {
+            while(--i>0) {
+                ucnv_close(chunks[i].cnv);
+            }
+            uprv_free(chunks);
+            return 0;
+        }
+        *pErrorCode=U_ZERO_ERROR;  /* U_SAFECLONE_ALLOCATED_WARNING */
+    }
+
+    *pChunks=chunks;
+    return count;
+}
+
+static void
+closeChunks(Chunk *chunks, int32_t count) {
+    int32_t i;
+
+    for(i=0; i<count; ++i) {
+        if(i>0) {
+            ucnv_close(chunks[i].cnv);
+        }
+        uprv_free(chunks[i].target);
+    }
+    uprv_free(chunks);
+}
+
+/* UConverterTask: converts one chunk into a growing buffer */
+static void U_EXPORT2
+convertChunk(void *context, int32_t index) {
+    const ParallelConversion *pc=(const ParallelConversion *)context;
+    Chunk *chunk=pc->chunks+index;
+    UErrorCode *pErrorCode=&chunk->errorCode;
+    int32_t unitSize=pc->toUnicode ? U_SIZEOF_UCHAR : 1;
+    int32_t capacity=chunk->limit-chunk->start+16;
+    int32_t length=0;
+    const char *s=NULL, *sLimit=NULL;
+    const UChar *u=NULL, *uLimit=NULL;
+    char *buffer;
+
+    if(pc->toUnicode) {
+        s=(const char *)pc->src+chunk->start;
+        sLimit=(const char *)pc->src+chunk->limit;
+    } else {
+        u=(const UChar *)pc->src+chunk->start;
+        uLimit=(const UChar *)pc->src+chunk->limit;
+    }
+
+    for(;;) {
+        buffer=(char *)uprv_realloc(chunk->target, (size_t)capacity*unitSize);
+        if(buffer==NULL) {
+            *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        chunk->target=buffer;
+        if(pc->toUnicode) {
+            UChar *t=(UChar *)buffer+length;
+            ucnv_toUnicode(chunk->cnv, &t, (UChar *)buffer+capacity, &s, sLimit, NULL, TRUE, pErrorCode);
+            length=(int32_t)(t-(UChar *)buffer);
+        } else {
+            char *t=buffer+length;
+            ucnv_fromUnicode(chunk->cnv, &t, buffer+capacity, &u, uLimit, NULL, TRUE, pErrorCode);
+            length=(int32_t)(t-buffer);
+        }
+        if(*pErrorCode!=U_BUFFER_OVERFLOW_ERROR) {
+            break;
+        }
+        *pErrorCode=U_ZERO_ERROR;
+        if(capacity>0x3fffffff) {
+            *pErrorCode=U_INDEX_OUTOFBOUNDS_ERROR;
+            return;
+        }
+        capacity*=2;
+    }
+    chunk->targetLength=length;
+}
+
+/*
+ * Converts all chunks and returns the total output length.
+ * Sets the error code of the first chunk (in source order) that failed.
+ */
+static int32_t
+convertChunks(UBool toUnicode, const void *src, Chunk *chunks, int32_t count,
+              UConverterTaskRunner runner, const void *runnerContext,
+              UErrorCode *pErrorCode) {
+    ParallelConversion pc;
+    int32_t i, totalLength;
+
+    pc.toUnicode=toUnicode;
+    pc.src=src;
+    pc.chunks=chunks;
+    if(count==1) {
+        convertChunk(&pc, 0);
+    } else {
+        runner(runnerContext, convertChunk, &pc, count);
+    }
+
+    totalLength=0;
+    for(i=0; i<count; ++i) {
+        if(U_FAILURE(chunks[i].errorCode)) {
+            *pErrorCode=chunks[i].errorCode;
+            return 0;
+        }
+        if(chunks[i].targetLength>0x7fffffff-totalLength) {
+            *pErrorCode=U_INDEX_OUTOFBOUNDS_ERROR;
+            return 0;
+        }
+        totalLength+=chunks[i].targetLength;
+    }
+    return totalLength;
+}
+
+static int32_t
+convertParallel(UConverter *cnv, UBool toUnicode,
+                void *dest, int32_t destCapacity,
+                const void *src, int32_t srcLength,
+                int32_t chunkLength,
+                UConverterTaskRunner runner, const void *runnerContext,
+                UErrorCode *pErrorCode) {
+    Chunk *chunks;
+    char *p;
+    int32_t unitSize, count, destLength, i;
+
+    count=openChunks(cnv, toUnicode, src, srcLength, chunkLength, runner, &chunks, pErrorCode);
+    if(count==0) {
+        return 0;
+    }
+    if(count==1) {
+        /* serial conversion, directly into dest */
+        uprv_free(chunks);
+        if(toUnicode) {
+            return ucnv_toUChars(cnv, (UChar *)dest, destCapacity,
+                                 (const char *)src, srcLength, pErrorCode);
+        } else {
+            return ucnv_fromUChars(cnv, (char *)dest, destCapacity,
+                                   (const UChar *)src, srcLength, pErrorCode);
+        }
+    }
+
+    destLength=convertChunks(toUnicode, src, chunks, count, runner, runnerContext, pErrorCode);
+    if(U_SUCCESS(*pErrorCode) && destLength<=destCapacity) {
+        unitSize=toUnicode ? U_SIZEOF_UCHAR : 1;
+        p=(char *)dest;
+        for(i=0; i<count; ++i) {
+            uprv_memcpy(p, chunks[i].target, (size_t)chunks[i].targetLength*unitSize);
+            p+=(size_t)chunks[i].targetLength*unitSize;
+        }
+    }
+    closeChunks(chunks, count);
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(toUnicode) {
+        return u_terminateUChars((UChar *)dest, destCapacity, destLength, pErrorCode);
+    } else {
+        return u_terminateChars((char *)dest, destCapacity, destLength, pErrorCode);
+    }
+}
+
+static int32_t
+convertToSegments(UConverter *cnv, UBool toUnicode,
+                  const void *src, int32_t srcLength,
+                  int32_t chunkLength,
+                  UConverterTaskRunner runner, const void *runnerContext,
+                  UConverterSegment **pSegments,
+                  UErrorCode *pErrorCode) {
+    Chunk *chunks;
+    UConverterSegment *segments;
+    int32_t count, i;
+
+    count=openChunks(cnv, toUnicode, src, srcLength, chunkLength, runner, &chunks, pErrorCode);
+    if(count==0) {
+        return 0;
+    }
+    convertChunks(toUnicode, src, chunks, count, runner, runnerContext, pErrorCode);
+    segments=NULL;
+    if(U_SUCCESS(*pErrorCode)) {
+        segments=(UConverterSegment *)uprv_malloc(count*sizeof(UConverterSegment));
+        if(segments==NULL) {
+            *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+        }
+    }
+    if(U_FAILURE(*pErrorCode)) {
+        closeChunks(chunks, count);
+        return 0;
+    }
+
+    /* hand the chunk buffers over to the segments */
+    for(i=0; i<count; ++i) {
+        segments[i].sourceIndex=chunks[i].start;
+        segments[i].sourceLength=chunks[i].limit-chunks[i].start;
+        segments[i].target=chunks[i].target;
+        segments[i].targetLength=chunks[i].targetLength;
+        chunks[i].target=NULL;
+    }
+    closeChunks(chunks, count);
+    *pSegments=segments;
+    return count;
+}
+
+U_CAPI int32_t U_EXPORT2
+ucnv_toUCharsParallel(UConverter *cnv,
+                      UChar *dest, int32_t destCapacity,
+                      const char *src, int32_t srcLength,
+                      int32_t chunkLength,
+                      UConverterTaskRunner runner, const void *runnerContext,
+                      UErrorCode *pErrorCode) {
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if( cnv==NULL ||
+        destCapacity<0 || (destCapacity>0 && dest==NULL) ||
+        srcLength<-1 || (srcLength!=0 && src==NULL)
+    ) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if(srcLength==-1) {
+        srcLength=(int32_t)uprv_strlen(src);
+    }
+    return convertParallel(cnv, TRUE, dest, destCapacity, src, srcLength,
+                           chunkLength, runner, runnerContext, pErrorCode);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucnv_fromUCharsParallel(UConverter *cnv,
+                        char *dest, int32_t destCapacity,
+                        const UChar *src, int32_t srcLength,
+                        int32_t chunkLength,
+                        UConverterTaskRunner runner, const void *runnerContext,
+                        UErrorCode *pErrorCode) {
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if( cnv==NULL ||
+        destCapacity<0 || (destCapacity>0 && dest==NULL) ||
+        srcLength<-1 || (srcLength!=0 && src==NULL)
+    ) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if(srcLength==-1) {
+        srcLength=u_strlen(src);
+    }
+    return convertParallel(cnv, FALSE, dest, destCapacity, src, srcLength,
+                           chunkLength, runner, runnerContext, pErrorCode);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucnv_toUSegmentsParallel(UConverter *cnv,
+                         const char *src, int32_t srcLength,
+                         int32_t chunkLength,
+                         UConverterTaskRunner runner, const void *runnerContext,
+                         UConverterSegment **pSegments,
+                         UErrorCode *pErrorCode) {
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(cnv==NULL || pSegments==NULL || srcLength<-1 || (srcLength!=0 && src==NULL)) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    *pSegments=NULL;
+    if(srcLength==-1) {
+        srcLength=(int32_t)uprv_strlen(src);
+    }
+    return convertToSegments(cnv, TRUE, src, srcLength,
+                             chunkLength, runner, runnerContext, pSegments, pErrorCode);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucnv_fromUSegmentsParallel(UConverter *cnv,
+                           const UChar *src, int32_t srcLength,
+                           int32_t chunkLength,
+                           UConverterTaskRunner runner, const void *runnerContext,
+                           UConverterSegment **pSegments,
+                           UErrorCode *pErrorCode) {
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(cnv==NULL || pSegments==NULL || srcLength<-1 || (srcLength!=0 && src==NULL)) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    *pSegments=NULL;
+    if(srcLength==-1) {
+        srcLength=u_strlen(src);
+    }
+    return convertToSegments(cnv, FALSE, src, srcLength,
+                             chunkLength, runner, runnerContext, pSegments, pErrorCode);
+}
+
+U_CAPI void U_EXPORT2
+ucnv_closeSegments(UConverterSegment *segments, int32_t count) {
+    int32_t i;
+
+    if(segments!=NULL) {
+        for(i=0; i<count; ++i) {
+            uprv_free((void *)segments[i].target);
+        }
+        uprv_free(segments);
+    }
+}
+
+#endif
@@ -29,6 +29,7 @@
 #include "ucnv_bld.h"
 #include "ucnv_cnv.h"
 #include "cmemory.h"
+#include "ustrsimd.h"
 
 /* Prototypes --------------------------------------------------------------- */
 
@@ -98,7 +99,7 @@ static void ucnv_toUnicode_UTF8 (UConverterToUnicodeArgs * args,
     unsigned char *toUBytes = cnv->toUBytes;
     UBool isCESU8 = (UBool)(cnv->sharedData == &_CESU8Data);
     uint32_t ch, ch2 = 0;
-    int32_t i, inBytes;
+    int32_t i, inBytes, count;
   
     /* Restore size of current sequence */
     if (cnv->toUnicodeStatus && myTarget < targetLimit)
@@ -119,6 +120,21 @@ static void ucnv_toUnicode_UTF8 (UConverterToUnicodeArgs * args,
         if (ch < 0x80)        /* Simple case */
         {
             *(myTarget++) = (UChar) ch;
+            if (mySource < sourceLimit && *mySource < 0x80)
+            {
+                /* widen a run of ASCII bytes in bulk */
+                count = (int32_t)(sourceLimit - mySource);
+                if (count > (int32_t)(targetLimit - myTarget))
+                {
+                    count = (int32_t)(targetLimit - myTarget);
+                }
+                if (count >= U_SIMD_MIN_LENGTH)
+                {
+                    count = uprv_copyASCIIToUChars(myTarget, mySource, count);
+                    mySource += count;
+                    myTarget += count;
+                }
+            }
         }
         else
         {
@@ -228,7 +244,7 @@ static void ucnv_toUnicode_UTF8_OFFSETS_LOGIC (UConverterToUnicodeArgs * args,
     unsigned char *toUBytes = cnv->toUBytes;
     UBool isCESU8 = (UBool)(cnv->sharedData == &_CESU8Data);
     uint32_t ch, ch2 = 0;
-    int32_t i, inBytes;
+    int32_t i, inBytes, count;
 
     /* Restore size of current sequence */
     if (cnv->toUnicodeStatus && myTarget < targetLimit)
@@ -249,6 +265,26 @@ static void ucnv_toUnicode_UTF8_OFFSETS_LOGIC (UConverterToUnicodeArgs * args,
         {
             *(myTarget++) = (UChar) ch;
             *(myOffsets++) = offsetNum++;
+            if (mySource < sourceLimit && *mySource < 0x80)
+            {
+                /* widen a run of ASCII bytes in bulk */
+                count = (int32_t)(sourceLimit - mySource);
+                if (count > (int32_t)(targetLimit - myTarget))
+                {
+                    count = (int32_t)(targetLimit - myTarget);
+                }
+                if (count >= U_SIMD_MIN_LENGTH)
+                {
+                    count = uprv_copyASCIIToUChars(myTarget, mySource, count);
+                    mySource += count;
+                    myTarget += count;
+                    while (count > 0)
+                    {
+                        *(myOffsets++) = offsetNum++;
+                        --count;
+                    }
+                }
+            }
         }
         else
         {
@@ -356,7 +392,7 @@ U_CFUNC void ucnv_fromUnicode_UTF8 (UConverterFromUnicodeArgs * args,
     uint8_t *tempPtr;
     UChar32 ch;
     uint8_t tempBuf[4];
-    int32_t indexToWrite;
+    int32_t indexToWrite, count;
     UBool isNotCESU8 = (UBool)(cnv->sharedData != &_CESU8Data);
 
     if (cnv->fromUChar32 && myTarget < targetLimit)
@@ -373,6 +409,21 @@ U_CFUNC void ucnv_fromUnicode_UTF8 (UConverterFromUnicodeArgs * args,
         if (ch < 0x80)        /* Single byte */
         {
             *(myTarget++) = (uint8_t) ch;
+            if (mySource < sourceLimit && *mySource < 0x80)
+            {
+                /* narrow a run of ASCII UChars in bulk */
+                count = (int32_t)(sourceLimit - mySource);
+                if (count > (int32_t)(targetLimit - myTarget))
+                {
+                    count = (int32_t)(targetLimit - myTarget);
+                }
+                if (count >= U_SIMD_MIN_LENGTH)
+                {
+                    count = uprv_copyUCharsToASCII(myTarget, mySource, count);
+                    mySource += count;
+                    myTarget += count;
+                }
+            }
         }
         else if (ch < 0x800)  /* Double byte */
         {
@@ -471,7 +522,7 @@ U_CFUNC void ucnv_fromUnicode_UTF8_OFFSETS_LOGIC (UConverterFromUnicodeArgs * ar
     uint8_t *tempPtr;
     UChar32 ch;
     int32_t offsetNum, nextSourceIndex;
-    int32_t indexToWrite;
+    int32_t indexToWrite, count;
     uint8_t tempBuf[4];
     UBool isNotCESU8 = (UBool)(cnv->sharedData != &_CESU8Data);
 
@@ -494,6 +545,26 @@ U_CFUNC void ucnv_fromUnicode_UTF8_OFFSETS_LOGIC (UConverterFromUnicodeArgs * ar
         {
             *(myOffsets++) = offsetNum++;
             *(myTarget++) = (char) ch;
+            if (mySource < sourceLimit && *mySource < 0x80)
+            {
+                /* narrow a run of ASCII UChars in bulk */
+                count = (int32_t)(sourceLimit - mySource);
+                if (count > (int32_t)(targetLimit - myTarget))
+                {
+                    count = (int32_t)(targetLimit - myTarget);
+                }
+                if (count >= U_SIMD_MIN_LENGTH)
+                {
+                    count = uprv_copyUCharsToASCII(myTarget, mySource, count);
+                    mySource += count;
+                    myTarget += count;
+                    while (count > 0)
+                    {
+                        *(myOffsets++) = offsetNum++;
+                        --count;
+                    }
+                }
+            }
         }
         else if (ch < 0x800)  /* Double byte */
         {
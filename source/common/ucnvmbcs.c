@@ -57,6 +57,7 @@
 #include "cmemory.h"
 #include "cstring.h"
 #include "cmutex.h"
+#include "ustrsimd.h"
 
 /* control optimizations according to the platform */
 #define MBCS_UNROLL_SINGLE_TO_BMP 1
@@ -5474,6 +5475,169 @@ unassigned:
     pFromUArgs->target=(char *)target;
 }
 
+/*
+ * This is a direct conversion from an MBCS charset to UTF-8 without
+ * an intermediate UTF-16 pivot buffer.
+ * It handles the same cases as the optimized loop in
+ * ucnv_MBCSToUnicodeWithOffsets(): single-byte and two-byte sequences
+ * that map directly to BMP code points.
+ *
+ * Anything else -- a truncated sequence, a fallback, an extension mapping,
+ * a state change, an unassigned or illegal sequence --
+ * is left for the regular toUnicode path:
+ * The function stops before such a sequence and returns U_USING_DEFAULT_WARNING
+ * so that ucnv_convertEx() pivots through UTF-16 for a while,
+ * with unchanged callback and offset semantics.
+ */
+static void
+ucnv_MBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode) {
+    UConverter *cnv, *utf8;
+    const uint8_t *source, *sourceLimit;
+    uint8_t *target, *targetLimit;
+
+    const int32_t (*stateTable)[256];
+    const uint16_t *unicodeCodeUnits;
+
+    uint8_t state;
+    int32_t entry;
+    UChar c;
+    uint32_t asciiRoundtrips;
+
+    cnv=pToUArgs->converter;
+    utf8=pFromUArgs->converter;
+
+    if(cnv->toULength>0 || utf8->fromUChar32!=0) {
+        /* continue a partial sequence or a lead surrogate in the pivoting code */
+        *pErrorCode=U_USING_DEFAULT_WARNING;
+        return;
+    }
+
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
+        stateTable=(const int32_t (*)[256])cnv->sharedData->mbcs.swapLFNLStateTable;
+    } else {
+        stateTable=cnv->sharedData->mbcs.stateTable;
+    }
+    unicodeCodeUnits=cnv->sharedData->mbcs.unicodeCodeUnits;
+
+    /*
+     * ASCII bytes that map to themselves in state 0 are copied in runs.
+     * asciiRoundtrips is calculated from the unswapped state table.
+     */
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)==0) {
+        asciiRoundtrips=cnv->sharedData->mbcs.asciiRoundtrips;
+    } else {
+        asciiRoundtrips=0;
+    }
+
+    /* get the converter state from UConverter */
+    state=(uint8_t)(cnv->mode);
+    if(state==0) {
+        state=cnv->sharedData->mbcs.dbcsOnlyState;
+    }
+
+    source=(const uint8_t *)pToUArgs->source;
+    sourceLimit=(const uint8_t *)pToUArgs->sourceLimit;
+    target=(uint8_t *)pFromUArgs->target;
+    targetLimit=(uint8_t *)pFromUArgs->targetLimit;
+
+    while(source<sourceLimit) {
+        const uint8_t *next;
+        if(*source<=0x7f && state==0 && IS_ASCII_ROUNDTRIP(*source, asciiRoundtrips)) {
+            /* copy an ASCII run */
+            int32_t length=(int32_t)(sourceLimit-source);
+            if(length>(targetLimit-target)) {
+                length=(int32_t)(targetLimit-target);
+                if(length==0) {
+                    break;  /* target is full */
+                }
+            }
+            if(asciiRoundtrips==0xffffffff) {
+                length=uprv_countASCII(source, length);
+            } else {
+                int32_t i=1;
+                while(i<length && source[i]<=0x7f && IS_ASCII_ROUNDTRIP(source[i], asciiRoundtrips)) {
+                    ++i;
+                }
+                length=i;
+            }
+            uprv_memcpy(target, source, length);
+            source+=length;
+            target+=length;
+            continue;
+        }
+        entry=stateTable[state][*source];
+        if(MBCS_ENTRY_IS_TRANSITION(entry)) {
+            /* a two-byte sequence with a 16-bit result, as in the optimized toUnicode loop */
+            uint32_t offset;
+            if((source+1)>=sourceLimit) {
+                break;  /* truncated sequence */
+            }
+            offset=MBCS_ENTRY_TRANSITION_OFFSET(entry);
+            entry=stateTable[MBCS_ENTRY_TRANSITION_STATE(entry)][source[1]];
+            if( MBCS_ENTRY_IS_FINAL(entry) &&
+                MBCS_ENTRY_FINAL_ACTION(entry)==MBCS_STATE_VALID_16 &&
+                (c=unicodeCodeUnits[offset+MBCS_ENTRY_FINAL_VALUE_16(entry)])<0xfffe
+            ) {
+                next=source+2;
+            } else {
+                break;
+            }
+        } else if(MBCS_ENTRY_FINAL_IS_VALID_DIRECT_16(entry)) {
+            c=(UChar)MBCS_ENTRY_FINAL_VALUE_16(entry);
+            next=source+1;
+        } else {
+            break;
+        }
+        if(U16_IS_SURROGATE(c)) {
+            break;  /* not expected from these actions, but let the pivoting code handle it */
+        }
+
+        /* write the UTF-8 bytes */
+        if(c<=0x7f) {
+            if(target>=targetLimit) {
+                *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+                break;
+            }
+            *target++=(uint8_t)c;
+        } else if(c<=0x7ff) {
+            if((targetLimit-target)<2) {
+                break;
+            }
+            target[0]=(uint8_t)(0xc0|(c>>6));
+            target[1]=(uint8_t)(0x80|(c&0x3f));
+            target+=2;
+        } else {
+            if((targetLimit-target)<3) {
+                break;
+            }
+            target[0]=(uint8_t)(0xe0|(c>>12));
+            target[1]=(uint8_t)(0x80|((c>>6)&0x3f));
+            target[2]=(uint8_t)(0x80|(c&0x3f));
+            target+=3;
+        }
+        state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+        source=next;
+    }
+
+    if(U_SUCCESS(*pErrorCode) && source<sourceLimit) {
+        if(target>=targetLimit) {
+            *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+        } else {
+            /* not enough room for the next character, or a sequence for the pivoting code */
+            *pErrorCode=U_USING_DEFAULT_WARNING;
+        }
+    }
+
+    /* set the converter state back into UConverter */
+    cnv->mode=state;
+
+    /* write back the updated pointers */
+    pToUArgs->source=(const char *)source;
+    pFromUArgs->target=(char *)target;
+}
+
 /* miscellaneous ------------------------------------------------------------ */
 
 static void
@@ -5499,6 +5663,63 @@ ucnv_MBCSIsLeadByte(UConverterSharedData *sharedData, char byte) {
     return (UBool)MBCS_ENTRY_IS_TRANSITION(sharedData->mbcs.stateTable[0][(uint8_t)byte]);
 }
 
+U_CFUNC UBool
+ucnv_MBCSGetSplitBytes(const UConverterSharedData *sharedData, UBool splitBytes[256]) {
+    const UConverterMBCSTable *mbcs=&sharedData->mbcs;
+    const int32_t (*stateTable)[256]=mbcs->stateTable;
+    int32_t entry;
+    int state, b;
+    UBool isSplitByte, hasSplitBytes;
+
+    if( (mbcs->outputType&0xff)==MBCS_OUTPUT_2_SISO || mbcs->dbcsOnlyState!=0 ||
+        (mbcs->extIndexes!=NULL &&
+            (mbcs->extIndexes[UCNV_EXT_COUNT_BYTES]>>16)>sharedData->staticData->maxBytesPerChar)
+    ) {
+        return FALSE;
+    }
+
+    /* every valid sequence must end in the initial state */
+    for(state=0; state<mbcs->countStates; ++state) {
+        for(b=0; b<256; ++b) {
+            entry=stateTable[state][b];
+            if( MBCS_ENTRY_IS_FINAL(entry) &&
+                MBCS_ENTRY_FINAL_ACTION(entry)!=MBCS_STATE_ILLEGAL &&
+                MBCS_ENTRY_FINAL_STATE(entry)!=0
+            ) {
+                return FALSE;
+            }
+        }
+    }
+
+    hasSplitBytes=FALSE;
+    for(b=0; b<256; ++b) {
+        entry=stateTable[0][b];
+        isSplitByte=(UBool)(
+            MBCS_ENTRY_IS_FINAL(entry) &&
+            MBCS_ENTRY_FINAL_ACTION(entry)!=MBCS_STATE_ILLEGAL &&
+            MBCS_ENTRY_FINAL_ACTION(entry)!=MBCS_STATE_CHANGE_ONLY);
+        for(state=1; isSplitByte && state<mbcs->countStates; ++state) {
+            entry=stateTable[state][b];
+            if(!MBCS_ENTRY_IS_FINAL(entry) || MBCS_ENTRY_FINAL_ACTION(entry)!=MBCS_STATE_ILLEGAL) {
+                isSplitByte=FALSE;
+            }
+        }
+        splitBytes[b]=isSplitByte;
+        hasSplitBytes|=isSplitByte;
+    }
+    return hasSplitBytes;
+}
+
+U_CFUNC UBool
+ucnv_MBCSCanSplitFromUnicode(const UConverterSharedData *sharedData) {
+    const UConverterMBCSTable *mbcs=&sharedData->mbcs;
+
+    /* an extension mapping from more than one code point may be from a surrogate pair or not */
+    return (UBool)(
+        (mbcs->outputType&0xff)!=MBCS_OUTPUT_2_SISO && mbcs->dbcsOnlyState==0 &&
+        (mbcs->extIndexes==NULL || (mbcs->extIndexes[UCNV_EXT_COUNT_UCHARS]>>16)<=1));
+}
+
 static void
 ucnv_MBCSWriteSub(UConverterFromUnicodeArgs *pArgs,
               int32_t offsetIndex,
@@ -5594,7 +5815,7 @@ static const UConverterImpl _SBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_MBCSToUTF8,
     ucnv_SBCSFromUTF8
 };
 
@@ -5620,7 +5841,7 @@ static const UConverterImpl _DBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_MBCSToUTF8,
     ucnv_DBCSFromUTF8
 };
 
@@ -5644,7 +5865,10 @@ static const UConverterImpl _MBCSImpl={
     ucnv_MBCSGetName,
     ucnv_MBCSWriteSub,
     NULL,
-    ucnv_MBCSGetUnicodeSet
+    ucnv_MBCSGetUnicodeSet,
+
+    ucnv_MBCSToUTF8,
+    NULL
 };
 
 
@@ -524,6 +524,28 @@ ucnv_MBCSIsLeadByte(UConverterSharedData *sharedData, char byte);
 #define _MBCS_IS_LEAD_BYTE(sharedData, byte) \
     (UBool)MBCS_ENTRY_IS_TRANSITION((sharedData)->mbcs.stateTable[0][(uint8_t)(byte)])
 
+/**
+ * Internal function for splitting codepage text for independent conversion
+ * of the pieces (see ucnv_toUCharsParallel()).
+ * Sets splitBytes[b] to TRUE for each byte value b that always starts a new character:
+ * b is a valid single byte in the initial state and illegal in every other state,
+ * so that no character sequence can continue across it.
+ *
+ * Returns FALSE if no byte qualifies, or if the codepage is stateful or
+ * has extension mappings for multiple characters.
+ */
+U_CFUNC UBool
+ucnv_MBCSGetSplitBytes(const UConverterSharedData *sharedData, UBool splitBytes[256]);
+
+/**
+ * Internal function for splitting Unicode text for independent conversion
+ * of the pieces (see ucnv_fromUCharsParallel()).
+ * Returns TRUE if the codepage can be split between any two code points,
+ * or FALSE if it is stateful or has extension mappings for multiple code points.
+ */
+U_CFUNC UBool
+ucnv_MBCSCanSplitFromUnicode(const UConverterSharedData *sharedData);
+
 /*
  * This is another simple conversion function for internal use by other
  * conversion implementations.
@@ -973,6 +973,7 @@ static UDataMemory *doLoadFromIndividualFiles(const char *pkgName,
                 *  and return it.   */
                 pEntryData->mapAddr = dataMemory.mapAddr;
                 pEntryData->map     = dataMemory.map;
+                pEntryData->length  = dataMemory.length;
 
 #ifdef UDATA_DEBUG
                 fprintf(stderr, "** Mapped file: %s\n", pathBuffer);
@@ -1375,3 +1376,35 @@ U_CAPI void U_EXPORT2 udata_setFileAccess(UDataFileAccess access, UErrorCode * /
 {
     gDataFileAccess = access;
 }
+
+U_CAPI void U_EXPORT2 udata_setMapOptions(uint32_t options, UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return;
+    }
+    if(options&~(uint32_t)(UDATA_MAP_WILLNEED|UDATA_MAP_HUGEPAGE|UDATA_MAP_POPULATE)) {
+        *status=U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    uprv_setMapOptions(options);
+}
+
+U_CAPI int32_t U_EXPORT2
+udata_warmUp(const char *path, const char *type, const char *name, UErrorCode *pErrorCode)
+{
+    UDataMemory *pData;
+    int32_t length, count;
+
+    pData=udata_open(path, type, name, pErrorCode);
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    length=pData->length;
+    if(length<0) {
+        /* unknown length (last item in a package, or linked data): touch only the header */
+        length=udata_getHeaderSize(pData->pHeader);
+    }
+    count=uprv_touchPages(pData->pHeader, length);
+    udata_close(pData);
+    return count;
+}
@@ -29,6 +29,8 @@ struct UDataMemory {
                                    /*   UDataMemory object.                           */
     const void       *toc;         /* For common memory, table of contents for        */
                                    /*   the pieces within.                            */
+    const uint32_t   *tocIndex;    /* For common memory with an offset TOC, the       */
+                                   /*   optional perfect hash index, else NULL.       */
     UBool             heapAllocated;  /* True if this UDataMemory Object is on the    */
                                    /*  heap and thus needs to be deleted when closed. */
 
@@ -17,86 +17,89 @@
 #include "uassert.h"
 #include "ustr_imp.h"
 
-/* This hashtable is implemented as a double hash.  All elements are
- * stored in a single array with no secondary storage for collision
- * resolution (no linked list, etc.).  When there is a hash collision
- * (when two unequal keys have the same hashcode) we resolve this by
- * using a secondary hash.  The secondary hash is an increment
- * computed as a hash function (a different one) of the primary
- * hashcode.  This increment is added to the initial hash value to
- * obtain further slots assigned to the same hash code.  For this to
- * work, the length of the array and the increment must be relatively
- * prime.  The easiest way to achieve this is to have the length of
- * the array be prime, and the increment be any value from
- * 1..length-1.
+#include "ustrsimd.h"
+
+#if U_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/* This hashtable uses open addressing with a separate array of
+ * control bytes, one per element slot.  All elements are stored in a
+ * single array with no secondary storage for collision resolution
+ * (no linked list, etc.).
  *
  * Hashcodes are 32-bit integers.  We make sure all hashcodes are
- * non-negative by masking off the top bit.  This has two effects: (1)
- * modulo arithmetic is simplified.  If we allowed negative hashcodes,
- * then when we computed hashcode % length, we could get a negative
- * result, which we would then have to adjust back into range.  It's
- * simpler to just make hashcodes non-negative. (2) It makes it easy
- * to check for empty vs. occupied slots in the table.  We just mark
- * empty or deleted slots with a negative hashcode.
+ * non-negative by masking off the top bit, and store them in the
+ * elements.  For probing, the hashcode is mixed so that hash
+ * functions with poor low bits (like uhash_hashLong()) still spread
+ * well.  The low 7 bits of the mixed hash go into the control byte of
+ * the slot that holds the element; a control byte with its high bit
+ * set marks an empty or a deleted slot instead.
+ *
+ * The slots are divided into groups of 16.  The remaining bits of
+ * the mixed hash select the first group to probe, and further groups
+ * follow in a triangular sequence (+1, +2, +3, ... groups), which
+ * visits every group once because the number of groups is a power of
+ * two.  Each probe compares all 16 control bytes of a group with the
+ * 7-bit hash at once (with SSE2 where available), so the
+ * keyComparator is called almost only for the matching key.  A
+ * lookup stops at the first group that has an empty slot.
  *
- * The central function is _uhash_find().  This function looks for a
- * slot matching the given key and hashcode.  If one is found, it
- * returns a pointer to that slot.  If the table is full, and no match
- * is found, it returns NULL -- in theory.  This would make the code
- * more complicated, since all callers of _uhash_find() would then
- * have to check for a NULL result.  To keep this from happening, we
- * don't allow the table to fill.  When there is only one
- * empty/deleted slot left, uhash_put() will refuse to increase the
- * count, and fail.  This simplifies the code.  In practice, one will
- * seldom encounter this using default UHashtables.  However, if a
- * hashtable is set to a U_FIXED resize policy, or if memory is
- * exhausted, then the table may fill.
+ * An element is inserted into the first empty or deleted slot of its
+ * probe sequence.  Therefore, no probe sequence continues past a
+ * group that has an empty slot, and removing an element from such a
+ * group can mark its slot empty again.  Otherwise the slot is marked
+ * deleted, and deleted slots count towards the load of the table,
+ * until the next rehash removes them.
+ *
+ * The central function is _uhash_find().  It returns a pointer to the
+ * element matching the given key and hashcode, or NULL if there is
+ * none.  _uhash_findFreeSlot() returns the slot for a new element.
+ * We don't allow the table to fill: When there is only one empty or
+ * deleted slot left, uhash_put() will refuse to increase the count,
+ * and fail.  In practice, one will seldom encounter this using
+ * default UHashtables.  However, if a hashtable is set to a U_FIXED
+ * resize policy, or if memory is exhausted, then the table may fill.
  *
  * High and low water ratios control rehashing.  They establish levels
  * of fullness (from 0 to 1) outside of which the data array is
  * reallocated and repopulated.  Setting the low water ratio to zero
  * means the table will never shrink.  Setting the high water ratio to
  * one means the table will never grow.  The ratios should be
- * coordinated with the ratio between successive elements of the
- * PRIMES table, so that when the primeIndex is incremented or
- * decremented during rehashing, it brings the ratio of count / length
- * back into the desired range (between low and high water ratios).
+ * coordinated with the factor of 2 between successive table lengths,
+ * so that when the table grows or shrinks, the ratio of count /
+ * length is brought back into the desired range (between low and
+ * high water ratios).
  */
 
 /********************************************************************
  * PRIVATE Constants, Macros
  ********************************************************************/
 
-/* This is a list of non-consecutive primes chosen such that
- * PRIMES[i+1] ~ 2*PRIMES[i].  (Currently, the ratio ranges from 1.81
- * to 2.18; the inverse ratio ranges from 0.459 to 0.552.)  If this
- * ratio is changed, the low and high water ratios should also be
- * adjusted to suit.
- *
- * These prime numbers were also chosen so that they are the largest
- * prime number while being less than a power of two.
- */
-static const int32_t PRIMES[] = {
-    13, 31, 61, 127, 251, 509, 1021, 2039, 4093, 8191, 16381, 32749,
-    65521, 131071, 262139, 524287, 1048573, 2097143, 4194301, 8388593,
-    16777213, 33554393, 67108859, 134217689, 268435399, 536870909,
-    1073741789, 2147483647 /*, 4294967291 */
-};
+/* Number of slots, and of control bytes, per group. */
+#define GROUP_WIDTH 16
+#define GROUP_SHIFT 4
 
-#define PRIMES_LENGTH (sizeof(PRIMES) / sizeof(PRIMES[0]))
-#define DEFAULT_PRIME_INDEX 3
+/* Table lengths are 1<<lengthShift. */
+#define MIN_LENGTH_SHIFT GROUP_SHIFT
+#define MAX_LENGTH_SHIFT 30
+#define DEFAULT_LENGTH_SHIFT 7
 
-/* These ratios are tuned to the PRIMES array such that a resize
- * places the table back into the zone of non-resizing.  That is,
- * after a call to _uhash_rehash(), a subsequent call to
- * _uhash_rehash() should do nothing (should not churn).  This is only
- * a potential problem with U_GROW_AND_SHRINK.
+/* These ratios are tuned to the factor of 2 between table lengths
+ * such that a resize places the table back into the zone of
+ * non-resizing.  That is, after a call to _uhash_rehash(), a
+ * subsequent call to _uhash_rehash() should do nothing (should not
+ * churn).  This is only a potential problem with U_GROW_AND_SHRINK.
  */
 static const float RESIZE_POLICY_RATIO_TABLE[6] = {
     /* low, high water ratio */
-    0.0F, 0.5F, /* U_GROW: Grow on demand, do not shrink */
-    0.1F, 0.5F, /* U_GROW_AND_SHRINK: Grow and shrink on demand */
-    0.0F, 1.0F  /* U_FIXED: Never change size */
+    0.0F, 0.875F, /* U_GROW: Grow on demand, do not shrink */
+    0.2F, 0.875F, /* U_GROW_AND_SHRINK: Grow and shrink on demand */
+    0.0F, 1.0F    /* U_FIXED: Never change size */
 };
 
 /*
@@ -115,6 +118,15 @@ static const float RESIZE_POLICY_RATIO_TABLE[6] = {
 
 #define IS_EMPTY_OR_DELETED(x) ((x) < 0)
 
+/*
+  Control byte values.  Slots with elements have the low 7 bits of
+  the mixed hashcode; empty and deleted slots have the high bit set.
+*/
+#define CTRL_EMPTY      ((uint8_t) 0x80)
+#define CTRL_DELETED    ((uint8_t) 0xfe)
+
+#define IS_FULL_CTRL(c) (((c) & 0x80) == 0)
+
 /* This macro expects a UHashTok.pointer as its keypointer and
    valuepointer parameters */
 #define HASH_DELETE_KEY_VALUE(hash, keypointer, valuepointer) \
@@ -133,10 +145,91 @@ static const float RESIZE_POLICY_RATIO_TABLE[6] = {
 #define HINT_KEY_POINTER   (1)
 #define HINT_VALUE_POINTER (2)
 
+/* Integer keys hashed to themselves; see _uhash_findLong(). */
+#define IS_LONG_KEYED(hash) \
+    ((hash)->keyHasher == uhash_hashLong && (hash)->keyComparator == uhash_compareLong)
+
 /********************************************************************
  * PRIVATE Implementation
  ********************************************************************/
 
+/**
+ * Mixes the bits of a non-negative hashcode (MurmurHash3 finalizer).
+ * The low 7 bits go into the control byte, the others select the
+ * first group to probe.
+ */
+static uint32_t
+_uhash_mix(int32_t hashcode) {
+    uint32_t h = (uint32_t)hashcode;
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * Returns a bit mask with bit i set if group[i] == c,
+ * for the GROUP_WIDTH control bytes of a group.
+ */
+static uint32_t
+_uhash_matchCtrl(const uint8_t *group, uint8_t c) {
+#if U_HAVE_SSE2
+    __m128i g = _mm_loadu_si128((const __m128i *)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)c)));
+#else
+    uint32_t mask = 0;
+    int32_t i;
+    for (i = 0; i < GROUP_WIDTH; ++i) {
+        if (group[i] == c) {
+            mask |= (uint32_t)1 << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+/**
+ * Returns a bit mask with bit i set if group[i] is empty or deleted.
+ */
+static uint32_t
+_uhash_matchFreeCtrl(const uint8_t *group) {
+#if U_HAVE_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+    uint32_t mask = 0;
+    int32_t i;
+    for (i = 0; i < GROUP_WIDTH; ++i) {
+        if (!IS_FULL_CTRL(group[i])) {
+            mask |= (uint32_t)1 << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+/**
+ * Returns the index of the lowest set bit.  mask must not be 0.
+ */
+static int32_t
+_uhash_lowestBit(uint32_t mask) {
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int32_t)index;
+#else
+    int32_t i = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
 static UHashTok
 _uhash_setElement(UHashtable *hash, UHashElement* e,
                   int32_t hashcode,
@@ -180,10 +273,22 @@ _uhash_setElement(UHashtable *hash, UHashElement* e,
 static UHashTok
 _uhash_internalRemoveElement(UHashtable *hash, UHashElement* e) {
     UHashTok empty;
+    int32_t i = (int32_t)(e - hash->elements);
+    int32_t hashcode;
     U_ASSERT(!IS_EMPTY_OR_DELETED(e->hashcode));
     --hash->count;
+    /* If the group has an empty slot, then no probe sequence
+     * continues past it, and this slot can be empty again. */
+    if (_uhash_matchCtrl(hash->ctrl + (i & ~(GROUP_WIDTH - 1)), CTRL_EMPTY) != 0) {
+        hash->ctrl[i] = CTRL_EMPTY;
+        hashcode = HASH_EMPTY;
+    } else {
+        hash->ctrl[i] = CTRL_DELETED;
+        ++hash->deletedCount;
+        hashcode = HASH_DELETED;
+    }
     empty.pointer = NULL; empty.integer = 0;
-    return _uhash_setElement(hash, e, HASH_DELETED, empty, empty, 0);
+    return _uhash_setElement(hash, e, hashcode, empty, empty, 0);
 }
 
 static void
@@ -195,52 +300,73 @@ _uhash_internalSetResizePolicy(UHashtable *hash, enum UHashResizePolicy policy)
     hash->highWaterRatio = RESIZE_POLICY_RATIO_TABLE[policy * 2 + 1];
 }
 
+static void
+_uhash_setWaterMarks(UHashtable *hash) {
+    hash->lowWaterMark = (int32_t)(hash->length * hash->lowWaterRatio);
+    hash->highWaterMark = (int32_t)(hash->length * hash->highWaterRatio);
+    if (hash->highWaterMark >= hash->length) {
+        /* Keep one slot free; see uhash_put(). */
+        hash->highWaterMark = hash->length - 1;
+    }
+}
+
 /**
- * Allocate internal data array of a size determined by the given
- * prime index.  If the index is out of range it is pinned into range.
+ * Allocate internal data arrays of length 1<<lengthShift.
  * If the allocation fails the status is set to
- * U_MEMORY_ALLOCATION_ERROR and all array storage is freed.  In
- * either case the previous array pointer is overwritten.
+ * U_MEMORY_ALLOCATION_ERROR and the hashtable is unchanged.
+ * Otherwise the previous array pointers are overwritten.
  *
- * Caller must ensure primeIndex is in range 0..PRIME_LENGTH-1.
+ * Caller must ensure lengthShift is in range
+ * MIN_LENGTH_SHIFT..MAX_LENGTH_SHIFT.
  */
 static void
 _uhash_allocate(UHashtable *hash,
-                int32_t primeIndex,
+                int32_t lengthShift,
                 UErrorCode *status) {
 
     UHashElement *p, *limit;
     UHashTok emptytok;
+    int32_t length;
 
     if (U_FAILURE(*status)) return;
 
-    U_ASSERT(primeIndex >= 0 && primeIndex < PRIMES_LENGTH);
+    U_ASSERT(lengthShift >= MIN_LENGTH_SHIFT && lengthShift <= MAX_LENGTH_SHIFT);
 
-    hash->primeIndex = primeIndex;
-    hash->length = PRIMES[primeIndex];
+    length = (int32_t)1 << lengthShift;
+    if ((size_t)length > ((size_t)-1) / (sizeof(UHashElement) + 1)) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
 
-    p = hash->elements = (UHashElement*)
-        uprv_malloc(sizeof(UHashElement) * hash->length);
+    /* The control bytes follow the elements in the same block. */
+    p = (UHashElement*)
+        uprv_malloc((sizeof(UHashElement) + 1) * (size_t)length);
 
-    if (hash->elements == NULL) {
+    if (p == NULL) {
         *status = U_MEMORY_ALLOCATION_ERROR;
         return;
     }
 
+    hash->elements = p;
+    hash->ctrl = (uint8_t *)(p + length);
+    hash->lengthShift = (int8_t)lengthShift;
+    hash->length = length;
+
     emptytok.pointer = NULL; /* Only one of these two is needed */
     emptytok.integer = 0;    /* but we don't know which one. */
     
-    limit = p + hash->length;
+    limit = p + length;
     while (p < limit) {
         p->key = emptytok;
         p->value = emptytok;
         p->hashcode = HASH_EMPTY;
         ++p;
     }
+    uprv_memset(hash->ctrl, CTRL_EMPTY, length);
 
     hash->count = 0;
-    hash->lowWaterMark = (int32_t)(hash->length * hash->lowWaterRatio);
-    hash->highWaterMark = (int32_t)(hash->length * hash->highWaterRatio);
+    hash->deletedCount = 0;
+    _uhash_setWaterMarks(hash);
 }
 
 static UHashtable*
@@ -248,7 +374,7 @@ _uhash_init(UHashtable *result,
               UHashFunction *keyHash, 
               UKeyComparator *keyComp,
               UValueComparator *valueComp,
-              int32_t primeIndex,
+              int32_t lengthShift,
               UErrorCode *status)
 {
     if (U_FAILURE(*status)) return NULL;
@@ -263,7 +389,7 @@ _uhash_init(UHashtable *result,
     result->allocated       = FALSE;
     _uhash_internalSetResizePolicy(result, U_GROW);
 
-    _uhash_allocate(result, primeIndex, status);
+    _uhash_allocate(result, lengthShift, status);
 
     if (U_FAILURE(*status)) {
         return NULL;
@@ -276,7 +402,7 @@ static UHashtable*
 _uhash_create(UHashFunction *keyHash, 
               UKeyComparator *keyComp,
               UValueComparator *valueComp,
-              int32_t primeIndex,
+              int32_t lengthShift,
               UErrorCode *status) {
     UHashtable *result;
 
@@ -288,7 +414,7 @@ _uhash_create(UHashFunction *keyHash,
         return NULL;
     }
 
-    _uhash_init(result, keyHash, keyComp, valueComp, primeIndex, status);
+    _uhash_init(result, keyHash, keyComp, valueComp, lengthShift, status);
     result->allocated       = TRUE;
 
     if (U_FAILURE(*status)) {
@@ -300,132 +426,174 @@ _uhash_create(UHashFunction *keyHash,
 }
 
 /**
- * Look for a key in the table, or if no such key exists, the first
- * empty slot matching the given hashcode.  Keys are compared using
- * the keyComparator function.
- *
- * First find the start position, which is the hashcode modulo
- * the length.  Test it to see if it is:
- *
- * a. identical:  First check the hash values for a quick check,
- *    then compare keys for equality using keyComparator.
- * b. deleted
- * c. empty
- *
- * Stop if it is identical or empty, otherwise continue by adding a
- * "jump" value (moduloing by the length again to keep it within
- * range) and retesting.  For efficiency, there need enough empty
- * values so that the searchs stop within a reasonable amount of time.
- * This can be changed by changing the high/low water marks.
+ * Look for a key in the table.  Keys are compared using the
+ * keyComparator function, but only for elements whose control byte
+ * and stored hashcode match.
  *
- * In theory, this function can return NULL, if it is full (no empty
- * or deleted slots) and if no matching key is found.  In practice, we
- * prevent this elsewhere (in uhash_put) by making sure the last slot
- * in the table is never filled.
+ * Probe the groups of the key's probe sequence until one of them
+ * has an empty slot, or all groups have been probed.
  *
- * The size of the table should be prime for this algorithm to work;
- * otherwise we are not guaranteed that the jump value (the secondary
- * hash) is relatively prime to the table length.
+ * @return the element with the key, or NULL if there is none
  */
 static UHashElement*
 _uhash_find(const UHashtable *hash, UHashTok key,
             int32_t hashcode) {
 
-    int32_t firstDeleted = -1;  /* assume invalid index */
-    int32_t theIndex, startIndex;
-    int32_t jump = 0; /* lazy evaluate */
-    int32_t tableHash;
-    UHashElement *elements = hash->elements;
+    uint32_t h;
+    uint8_t h7;
+    int32_t groupMask = (hash->length >> GROUP_SHIFT) - 1;
+    int32_t group, step;
 
     hashcode &= 0x7FFFFFFF; /* must be positive */
-    startIndex = theIndex = (hashcode ^ 0x4000000) % hash->length;
+    h = _uhash_mix(hashcode);
+    h7 = (uint8_t)(h & 0x7f);
+    group = (int32_t)(h >> 7) & groupMask;
+
+    for (step = 1; step <= groupMask + 1; ++step) {
+        int32_t start = group << GROUP_SHIFT;
+        const uint8_t *ctrl = hash->ctrl + start;
+        uint32_t match = _uhash_matchCtrl(ctrl, h7);
+        while (match != 0) {
+            UHashElement *e = hash->elements + start + _uhash_lowestBit(match);
+            if (e->hashcode == hashcode &&          /* quick check */
+                    (*hash->keyComparator)(key, e->key)) {
+                return e;
+            }
+            match &= match - 1;
+        }
+        if (_uhash_matchCtrl(ctrl, CTRL_EMPTY) != 0) {
+            break; /* empty, end o' the line */
+        }
+        group = (group + step) & groupMask;
+    }
+    return NULL;
+}
 
-    do {
-        tableHash = elements[theIndex].hashcode;
-        if (tableHash == hashcode) {          /* quick check */
-            if ((*hash->keyComparator)(key, elements[theIndex].key)) {
-                return &(elements[theIndex]);
+/**
+ * _uhash_find() for tables with uhash_hashLong() and uhash_compareLong(),
+ * where the hashcode is the key.  Hashing and comparing inline rather
+ * than through the function pointers leaves no calls in the lookup.
+ * The hashcode is still mixed: With power-of-2 table lengths, keys that
+ * differ only in their high bits (such as collation elements) would
+ * otherwise all start in the same group.
+ */
+static UHashElement*
+_uhash_findLong(const UHashtable *hash, int32_t key) {
+    int32_t hashcode = key & 0x7FFFFFFF; /* must be positive */
+    uint32_t h = _uhash_mix(hashcode);
+    uint8_t h7 = (uint8_t)(h & 0x7f);
+    int32_t groupMask = (hash->length >> GROUP_SHIFT) - 1;
+    int32_t group = (int32_t)(h >> 7) & groupMask;
+    int32_t step;
+
+    for (step = 1; step <= groupMask + 1; ++step) {
+        int32_t start = group << GROUP_SHIFT;
+        const uint8_t *ctrl = hash->ctrl + start;
+        uint32_t match = _uhash_matchCtrl(ctrl, h7);
+        while (match != 0) {
+            UHashElement *e = hash->elements + start + _uhash_lowestBit(match);
+            if (e->key.integer == key) {
+                return e;
             }
-        } else if (!IS_EMPTY_OR_DELETED(tableHash)) {
-            /* We have hit a slot which contains a key-value pair,
-             * but for which the hash code does not match.  Keep
-             * looking.
-             */
-        } else if (tableHash == HASH_EMPTY) { /* empty, end o' the line */
-            break;
-        } else if (firstDeleted < 0) { /* remember first deleted */
-            firstDeleted = theIndex;
+            match &= match - 1;
         }
-        if (jump == 0) { /* lazy compute jump */
-            /* The jump value must be relatively prime to the table
-             * length.  As long as the length is prime, then any value
-             * 1..length-1 will be relatively prime to it.
-             */
-            jump = (hashcode % (hash->length - 1)) + 1;
+        if (_uhash_matchCtrl(ctrl, CTRL_EMPTY) != 0) {
+            break; /* empty, end o' the line */
         }
-        theIndex = (theIndex + jump) % hash->length;
-    } while (theIndex != startIndex);
-
-    if (firstDeleted >= 0) {
-        theIndex = firstDeleted; /* reset if had deleted slot */
-    } else if (tableHash != HASH_EMPTY) {
-        /* We get to this point if the hashtable is full (no empty or
-         * deleted slots), and we've failed to find a match.  THIS
-         * WILL NEVER HAPPEN as long as uhash_put() makes sure that
-         * count is always < length.
-         */
-        U_ASSERT(FALSE);
-        return NULL; /* Never happens if uhash_put() behaves */
+        group = (group + step) & groupMask;
+    }
+    return NULL;
+}
+
+/**
+ * Find the slot where a new element with this hashcode is to be
+ * inserted: the first empty or deleted slot in its probe sequence.
+ *
+ * @return the slot index, or -1 if the table is full
+ */
+static int32_t
+_uhash_findFreeSlot(const UHashtable *hash, int32_t hashcode) {
+    uint32_t h = _uhash_mix(hashcode);
+    int32_t groupMask = (hash->length >> GROUP_SHIFT) - 1;
+    int32_t group = (int32_t)(h >> 7) & groupMask;
+    int32_t step;
+
+    for (step = 1; step <= groupMask + 1; ++step) {
+        int32_t start = group << GROUP_SHIFT;
+        uint32_t match = _uhash_matchFreeCtrl(hash->ctrl + start);
+        if (match != 0) {
+            return start + _uhash_lowestBit(match);
+        }
+        group = (group + step) & groupMask;
+    }
+    return -1;
+}
+
+/**
+ * Insert an element with a hashcode that is not in the table yet.
+ * Assumes that there is a free slot.
+ */
+static UHashElement*
+_uhash_insertSlot(UHashtable *hash, int32_t hashcode) {
+    int32_t i = _uhash_findFreeSlot(hash, hashcode);
+    U_ASSERT(i >= 0);
+    if (hash->ctrl[i] == CTRL_DELETED) {
+        --hash->deletedCount;
     }
-    return &(elements[theIndex]);
+    hash->ctrl[i] = (uint8_t)(_uhash_mix(hashcode) & 0x7f);
+    ++hash->count;
+    return hash->elements + i;
 }
 
 /**
  * Attempt to grow or shrink the data arrays in order to make the
- * count fit between the high and low water marks.  hash_put() and
- * hash_remove() call this method when the count exceeds the high or
- * low water marks.  This method may do nothing, if memory allocation
- * fails, or if the count is already in range, or if the length is
- * already at the low or high limit.  In any case, upon return the
- * arrays will be valid.
+ * count fit between the high and low water marks, or to remove
+ * deleted slots.  hash_put() and hash_remove() call this method when
+ * the count plus deleted slots exceeds the high water mark, or the
+ * count falls below the low water mark.  This method may do nothing,
+ * if memory allocation fails, or if the count is already in range,
+ * or if the length is already at the low or high limit.  In any
+ * case, upon return the arrays will be valid.
  */
 static void
 _uhash_rehash(UHashtable *hash, UErrorCode *status) {
 
     UHashElement *old = hash->elements;
+    uint8_t *oldCtrl = hash->ctrl;
     int32_t oldLength = hash->length;
-    int32_t newPrimeIndex = hash->primeIndex;
+    int32_t newLengthShift = hash->lengthShift;
     int32_t i;
 
-    if (hash->count > hash->highWaterMark) {
-        if (++newPrimeIndex >= PRIMES_LENGTH) {
+    if (hash->count + hash->deletedCount >= hash->highWaterMark) {
+        /* Grow if the elements themselves fill the table more than
+         * half way, otherwise just remove the deleted slots. */
+        if (hash->highWaterRatio < 1.0F &&
+                hash->count >= hash->highWaterMark / 2 &&
+                newLengthShift < MAX_LENGTH_SHIFT) {
+            ++newLengthShift;
+        } else if (hash->deletedCount == 0) {
             return;
         }
     } else if (hash->count < hash->lowWaterMark) {
-        if (--newPrimeIndex < 0) {
+        if (--newLengthShift < MIN_LENGTH_SHIFT) {
             return;
         }
     } else {
         return;
     }
 
-    _uhash_allocate(hash, newPrimeIndex, status);
+    _uhash_allocate(hash, newLengthShift, status);
 
     if (U_FAILURE(*status)) {
-        hash->elements = old;
-        hash->length = oldLength;       
         return;
     }
 
-    for (i = oldLength - 1; i >= 0; --i) {
-        if (!IS_EMPTY_OR_DELETED(old[i].hashcode)) {
-            UHashElement *e = _uhash_find(hash, old[i].key, old[i].hashcode);
-            U_ASSERT(e != NULL);
-            U_ASSERT(e->hashcode == HASH_EMPTY);
+    for (i = 0; i < oldLength; ++i) {
+        if (IS_FULL_CTRL(oldCtrl[i])) {
+            UHashElement *e = _uhash_insertSlot(hash, old[i].hashcode);
             e->key = old[i].key;
             e->value = old[i].value;
             e->hashcode = old[i].hashcode;
-            ++hash->count;
         }
     }
 
@@ -437,17 +605,15 @@ _uhash_remove(UHashtable *hash,
               UHashTok key) {
     /* First find the position of the key in the table.  If the object
      * has not been removed already, remove it.  If the user wanted
-     * keys deleted, then delete it also.  We have to put a special
-     * hashcode in that position that means that something has been
-     * deleted, since when we do a find, we have to continue PAST any
-     * deleted values.
+     * keys deleted, then delete it also.  The slot is marked deleted
+     * (or empty, see _uhash_internalRemoveElement()), since when we
+     * do a find, we have to continue PAST any deleted values.
      */
     UHashTok result;
     UHashElement* e = _uhash_find(hash, key, hash->keyHasher(key));
-    U_ASSERT(e != NULL);
     result.pointer = NULL;
     result.integer = 0;
-    if (!IS_EMPTY_OR_DELETED(e->hashcode)) {
+    if (e != NULL) {
         result = _uhash_internalRemoveElement(hash, e);
         if (hash->count < hash->lowWaterMark) {
             UErrorCode status = U_ZERO_ERROR;
@@ -484,39 +650,36 @@ _uhash_put(UHashtable *hash,
          */
         return _uhash_remove(hash, key);
     }
-    if (hash->count > hash->highWaterMark) {
-        _uhash_rehash(hash, status);
-        if (U_FAILURE(*status)) {
-            goto err;
-        }
-    }
 
-    hashcode = (*hash->keyHasher)(key);
+    /* Make hashcodes stored in table positive. */
+    hashcode = (*hash->keyHasher)(key) & 0x7FFFFFFF;
     e = _uhash_find(hash, key, hashcode);
-    U_ASSERT(e != NULL);
 
-    if (IS_EMPTY_OR_DELETED(e->hashcode)) {
-        /* Important: We must never actually fill the table up.  If we
-         * do so, then _uhash_find() will return NULL, and we'll have
-         * to check for NULL after every call to _uhash_find().  To
-         * avoid this we make sure there is always at least one empty
-         * or deleted slot in the table.  This only is a problem if we
-         * are out of memory and rehash isn't working.
+    if (e == NULL) {
+        if (hash->count + hash->deletedCount >= hash->highWaterMark) {
+            _uhash_rehash(hash, status);
+            if (U_FAILURE(*status)) {
+                goto err;
+            }
+        }
+        /* Important: We must never actually fill the table up.
+         * To keep lookups of absent keys short, we make sure there
+         * is always at least one empty or deleted slot in the table.
+         * This only is a problem if we are out of memory and rehash
+         * isn't working, or with U_FIXED.
          */
-        ++hash->count;
-        if (hash->count == hash->length) {
+        if (hash->count + 1 >= hash->length) {
             /* Don't allow count to reach length */
-            --hash->count;
             *status = U_MEMORY_ALLOCATION_ERROR;
             goto err;
         }
+        e = _uhash_insertSlot(hash, hashcode);
     }
 
     /* We must in all cases handle storage properly.  If there was an
      * old key, then it must be deleted (if the deleter != NULL).
-     * Make hashcodes stored in table positive.
      */
-    return _uhash_setElement(hash, e, hashcode & 0x7FFFFFFF, key, value, hint);
+    return _uhash_setElement(hash, e, hashcode, key, value, hint);
 
  err:
     /* If the deleters are non-NULL, this method adopts its key and/or
@@ -539,7 +702,7 @@ uhash_open(UHashFunction *keyHash,
            UValueComparator *valueComp,
            UErrorCode *status) {
 
-    return _uhash_create(keyHash, keyComp, valueComp, DEFAULT_PRIME_INDEX, status);
+    return _uhash_create(keyHash, keyComp, valueComp, DEFAULT_LENGTH_SHIFT, status);
 }
 
 U_CAPI UHashtable* U_EXPORT2
@@ -549,9 +712,9 @@ uhash_openSize(UHashFunction *keyHash,
                int32_t size,
                UErrorCode *status) {
 
-    /* Find the smallest index i for which PRIMES[i] >= size. */
-    int32_t i = 0;
-    while (i<(PRIMES_LENGTH-1) && PRIMES[i]<size) {
+    /* Find the smallest i for which (1<<i) >= size. */
+    int32_t i = MIN_LENGTH_SHIFT;
+    while (i<MAX_LENGTH_SHIFT && ((int32_t)1<<i)<size) {
         ++i;
     }
 
@@ -565,7 +728,7 @@ uhash_init(UHashtable *fillinResult,
            UValueComparator *valueComp,
            UErrorCode *status) {
 
-    return _uhash_init(fillinResult, keyHash, keyComp, valueComp, DEFAULT_PRIME_INDEX, status);
+    return _uhash_init(fillinResult, keyHash, keyComp, valueComp, DEFAULT_LENGTH_SHIFT, status);
 }
 
 U_CAPI void U_EXPORT2
@@ -583,6 +746,7 @@ uhash_close(UHashtable *hash) {
         }
         uprv_free(hash->elements);
         hash->elements = NULL;
+        hash->ctrl = NULL;
     }
     if (hash->allocated) {
         uprv_free(hash);
@@ -627,8 +791,7 @@ U_CAPI void U_EXPORT2
 uhash_setResizePolicy(UHashtable *hash, enum UHashResizePolicy policy) {
     UErrorCode status = U_ZERO_ERROR;
     _uhash_internalSetResizePolicy(hash, policy);
-    hash->lowWaterMark  = (int32_t)(hash->length * hash->lowWaterRatio);
-    hash->highWaterMark = (int32_t)(hash->length * hash->highWaterRatio);    
+    _uhash_setWaterMarks(hash);
     _uhash_rehash(hash, &status);
 }
 
@@ -641,32 +804,48 @@ U_CAPI void* U_EXPORT2
 uhash_get(const UHashtable *hash,
           const void* key) {
     UHashTok keyholder;
+    const UHashElement *e;
     keyholder.pointer = (void*) key;
-    return _uhash_find(hash, keyholder, hash->keyHasher(keyholder))->value.pointer;
+    e = _uhash_find(hash, keyholder, hash->keyHasher(keyholder));
+    return e == NULL ? NULL : e->value.pointer;
 }
 
 U_CAPI void* U_EXPORT2
 uhash_iget(const UHashtable *hash,
            int32_t key) {
     UHashTok keyholder;
-    keyholder.integer = key;
-    return _uhash_find(hash, keyholder, hash->keyHasher(keyholder))->value.pointer;
+    const UHashElement *e;
+    if (IS_LONG_KEYED(hash)) {
+        e = _uhash_findLong(hash, key);
+    } else {
+        keyholder.integer = key;
+        e = _uhash_find(hash, keyholder, hash->keyHasher(keyholder));
+    }
+    return e == NULL ? NULL : e->value.pointer;
 }
 
 U_CAPI int32_t U_EXPORT2
 uhash_geti(const UHashtable *hash,
            const void* key) {
     UHashTok keyholder;
+    const UHashElement *e;
     keyholder.pointer = (void*) key;
-    return _uhash_find(hash, keyholder, hash->keyHasher(keyholder))->value.integer;
+    e = _uhash_find(hash, keyholder, hash->keyHasher(keyholder));
+    return e == NULL ? 0 : e->value.integer;
 }
 
 U_CAPI int32_t U_EXPORT2
 uhash_igeti(const UHashtable *hash,
            int32_t key) {
     UHashTok keyholder;
-    keyholder.integer = key;
-    return _uhash_find(hash, keyholder, hash->keyHasher(keyholder))->value.integer;
+    const UHashElement *e;
+    if (IS_LONG_KEYED(hash)) {
+        e = _uhash_findLong(hash, key);
+    } else {
+        keyholder.integer = key;
+        e = _uhash_find(hash, keyholder, hash->keyHasher(keyholder));
+    }
+    return e == NULL ? 0 : e->value.integer;
 }
 
 U_CAPI void* U_EXPORT2
@@ -765,15 +944,18 @@ uhash_removeAll(UHashtable *hash) {
         }
     }
     U_ASSERT(hash->count == 0);
+    if (hash->deletedCount != 0) {
+        /* No elements are left to probe past. */
+        uprv_memset(hash->ctrl, CTRL_EMPTY, hash->length);
+        hash->deletedCount = 0;
+    }
 }
 
 U_CAPI const UHashElement* U_EXPORT2
 uhash_find(const UHashtable *hash, const void* key) {
     UHashTok keyholder;
-    const UHashElement *e;
     keyholder.pointer = (void*) key;
-    e = _uhash_find(hash, keyholder, hash->keyHasher(keyholder));
-    return IS_EMPTY_OR_DELETED(e->hashcode) ? NULL : e;
+    return _uhash_find(hash, keyholder, hash->keyHasher(keyholder));
 }
 
 U_CAPI const UHashElement* U_EXPORT2
@@ -784,7 +966,7 @@ uhash_nextElement(const UHashtable *hash, int32_t *pos) {
     int32_t i;
     U_ASSERT(hash != NULL);
     for (i = *pos + 1; i < hash->length; ++i) {
-        if (!IS_EMPTY_OR_DELETED(hash->elements[i].hashcode)) {
+        if (IS_FULL_CTRL(hash->ctrl[i])) {
             *pos = i;
             return &(hash->elements[i]);
         }
@@ -851,6 +1033,18 @@ uhash_hashIChars(const UHashTok key) {
     return s == NULL ? 0 : ustr_hashICharsN(s, uprv_strlen(s));
 }
 
+U_CAPI int32_t U_EXPORT2
+uhash_fastHashUChars(const UHashTok key) {
+    const UChar *s = (const UChar *)key.pointer;
+    return s == NULL ? 0 : ustr_fastHashUCharsN(s, u_strlen(s));
+}
+
+U_CAPI int32_t U_EXPORT2
+uhash_fastHashChars(const UHashTok key) {
+    const char *s = (const char *)key.pointer;
+    return s == NULL ? 0 : ustr_fastHashCharsN(s, (int32_t)uprv_strlen(s));
+}
+
 U_CAPI UBool U_EXPORT2 
 uhash_equals(const UHashtable* hash1, const UHashtable* hash2){
     int32_t count1, count2, pos, i;
@@ -895,8 +1089,7 @@ uhash_equals(const UHashtable* hash1, const UHashtable* hash2){
          * contain equal values for the same key!
          */
         const UHashElement* elem2 = _uhash_find(hash2, key1, hash2->keyHasher(key1));
-        const UHashTok val2 = elem2->value;
-        if(hash1->valueComparator(val1, val2)==FALSE){
+        if(elem2 == NULL || hash1->valueComparator(val1, elem2->value)==FALSE){
             return FALSE;
         }
     }
@@ -18,11 +18,14 @@
 #include "uelement.h"
 
 /**
- * UHashtable stores key-value pairs and does moderately fast lookup
- * based on keys.  It provides a good tradeoff between access time and
- * storage space.  As elements are added to it, it grows to accomodate
- * them.  By default, the table never shrinks, even if all elements
- * are removed from it.
+ * UHashtable stores key-value pairs and does fast lookup based on
+ * keys.  It is an open-addressing table with one control byte per
+ * slot, which holds 7 bits of the slot's hash code, and lookups test
+ * a group of 16 control bytes at a time (with SSE2 where available),
+ * so that most probes touch one cache line of control bytes and call
+ * the key comparator only for likely matches.  As elements are added
+ * to it, it grows to accomodate them.  By default, the table never
+ * shrinks, even if all elements are removed from it.
  *
  * Keys and values are stored as void* pointers.  These void* pointers
  * may be actual pointers to strings, objects, or any other structure
@@ -134,6 +137,12 @@ struct UHashtable {
 
     UHashElement *elements;
 
+    /* One control byte per element: empty, deleted, or
+     * the low 7 bits of the element's mixed hash code.
+     * Allocated together with the elements. */
+
+    uint8_t *ctrl;
+
     /* Function pointers */
 
     UHashFunction *keyHasher;      /* Computes hash from key.
@@ -152,18 +161,19 @@ struct UHashtable {
     int32_t     count;      /* The number of key-value pairs in this table.
                              * 0 <= count <= length.  In practice we
                              * never let count == length (see code). */
-    int32_t     length;     /* The physical size of the arrays hashes, keys
-                             * and values.  Must be prime. */
+    int32_t     deletedCount; /* The number of deleted slots, which
+                               * lookups must probe past. */
+    int32_t     length;     /* The physical size of the arrays elements
+                             * and ctrl.  A power of 2, at least 16. */
 
     /* Rehashing thresholds */
     
-    int32_t     highWaterMark;  /* If count > highWaterMark, rehash */
+    int32_t     highWaterMark;  /* If count+deletedCount > highWaterMark, rehash */
     int32_t     lowWaterMark;   /* If count < lowWaterMark, rehash */
     float       highWaterRatio; /* 0..1; high water as a fraction of length */
     float       lowWaterRatio;  /* 0..1; low water as a fraction of length */
     
-    int8_t      primeIndex;     /* Index into our prime table for length.
-                                 * length == PRIMES[primeIndex] */
+    int8_t      lengthShift;    /* length == 1<<lengthShift */
     UBool       allocated; /* Was this UHashtable allocated? */
 };
 typedef struct UHashtable UHashtable;
@@ -569,6 +579,27 @@ uhash_hashChars(const UHashTok key);
 U_CAPI int32_t U_EXPORT2
 uhash_hashIChars(const UHashTok key);
 
+/**
+ * Generate a hash code for a null-terminated UChar* string with the
+ * word-at-a-time ustr_fastHashUCharsN(), which looks at every
+ * character.  Prefer it to uhash_hashUChars for long keys or keys
+ * with long common prefixes.  Use together with uhash_compareUChars.
+ * @param key The string (const UChar*) to hash.
+ * @return A hash code for the key.
+ */
+U_CAPI int32_t U_EXPORT2
+uhash_fastHashUChars(const UHashTok key);
+
+/**
+ * Generate a hash code for a null-terminated char* string with the
+ * word-at-a-time ustr_fastHashCharsN().  Use together with
+ * uhash_compareChars.
+ * @param key The string (const char*) to hash.
+ * @return A hash code for the key.
+ */
+U_CAPI int32_t U_EXPORT2
+uhash_fastHashChars(const UHashTok key);
+
 /**
  * Comparator for null-terminated UChar* strings.  Use together with
  * uhash_hashUChars.
@@ -15,14 +15,34 @@
  *         wrapper functions.
  *
  *----------------------------------------------------------------------------*/
+/*
+ * glibc declares madvise(), mincore() and MAP_POPULATE only
+ * with _DEFAULT_SOURCE (formerly _BSD_SOURCE) in addition to _XOPEN_SOURCE.
+ */
+#ifndef _DEFAULT_SOURCE
+#   define _DEFAULT_SOURCE
+#endif
+#ifndef _BSD_SOURCE
+#   define _BSD_SOURCE
+#endif
+
 /* Defines _XOPEN_SOURCE for access to POSIX functions.
  * Must be before any other #includes. */
 #include "uposixdefs.h"
 
 #include "unicode/putil.h"
+#include "unicode/udata.h"
 #include "udatamem.h"
 #include "umapfile.h"
 
+/* UDataMapOption bit set, see udata_setMapOptions() */
+static uint32_t gMapOptions = 0;
+
+U_CFUNC void
+uprv_setMapOptions(uint32_t options) {
+    gMapOptions = options;
+}
+
 /* memory-mapping base definitions ------------------------------------------ */
 
 #if MAP_IMPLEMENTATION==MAP_WIN32
@@ -130,6 +150,7 @@
 
         /* create an unnamed Windows file-mapping object for the specified file */
         map=CreateFileMapping(file, mappingAttributesPtr, PAGE_READONLY, 0, 0, NULL);
+        pData->length=(int32_t)GetFileSize(file, NULL);
         CloseHandle(file);
         if(map==NULL) {
             return FALSE;
@@ -162,6 +183,7 @@
     uprv_mapFile(UDataMemory *pData, const char *path) {
         int fd;
         int length;
+        int flags;
         struct stat mystat;
         void *data;
 
@@ -181,10 +203,16 @@
 
         /* get a view of the mapping */
 #if U_PLATFORM != U_PF_HPUX
-        data=mmap(0, length, PROT_READ, MAP_SHARED,  fd, 0);
+        flags=MAP_SHARED;
 #else
-        data=mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        flags=MAP_PRIVATE;
+#endif
+#ifdef MAP_POPULATE
+        if(gMapOptions&UDATA_MAP_POPULATE) {
+            flags|=MAP_POPULATE;    /* read the whole file and map all of its pages now */
+        }
 #endif
+        data=mmap(0, length, PROT_READ, flags, fd, 0);
         close(fd); /* no longer needed */
         if(data==MAP_FAILED) {
             return FALSE;
@@ -193,8 +221,18 @@
         pData->map = (char *)data + length;
         pData->pHeader=(const DataHeader *)data;
         pData->mapAddr = data;
+        pData->length = length;
 #if U_PLATFORM == U_PF_IPHONE
         posix_madvise(data, length, POSIX_MADV_RANDOM);
+#endif
+        /* the hints are best-effort; failures are ignored */
+        if(gMapOptions&UDATA_MAP_WILLNEED) {
+            posix_madvise(data, length, POSIX_MADV_WILLNEED);
+        }
+#ifdef MADV_HUGEPAGE
+        if(gMapOptions&UDATA_MAP_HUGEPAGE) {
+            madvise(data, length, MADV_HUGEPAGE);
+        }
 #endif
         return TRUE;
     }
@@ -266,6 +304,7 @@
         pData->map=p;
         pData->pHeader=(const DataHeader *)p;
         pData->mapAddr=p;
+        pData->length=fileLength;
         return TRUE;
     }
 
@@ -462,3 +501,72 @@
 #else
 #   error MAP_IMPLEMENTATION is set incorrectly
 #endif
+
+/*----------------------------------------------------------------------------*
+ *                                                                            *
+ *   Page touching for udata_warmUp().                                        *
+ *                                                                            *
+ *----------------------------------------------------------------------------*/
+#if MAP_IMPLEMENTATION==MAP_POSIX && U_PLATFORM_IS_LINUX_BASED
+#   include "cmemory.h"
+#   define HAVE_MINCORE 1
+#else
+#   define HAVE_MINCORE 0
+#endif
+
+static size_t
+umap_pageSize(void) {
+#if MAP_IMPLEMENTATION==MAP_WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#elif MAP_IMPLEMENTATION==MAP_POSIX || MAP_IMPLEMENTATION==MAP_390DLL
+    long size=sysconf(_SC_PAGESIZE);
+    return size>0 ? (size_t)size : 4096;
+#else
+    return 4096;
+#endif
+}
+
+U_CFUNC int32_t
+uprv_touchPages(const void *start, int32_t length) {
+    const char *p, *limit;
+    size_t pageSize;
+    int32_t count, faulted, i;
+    volatile char sum;
+
+    if(start==NULL || length<=0) {
+        return 0;
+    }
+    pageSize=umap_pageSize();
+    p=(const char *)((size_t)start&~(pageSize-1));
+    limit=(const char *)start+length;
+    count=(int32_t)((limit-p+pageSize-1)/pageSize);
+    faulted=count;
+
+#if HAVE_MINCORE
+    {
+        /* count the pages that are not resident yet */
+        unsigned char *residency=(unsigned char *)uprv_malloc(count);
+        if(residency!=NULL) {
+            if(mincore((void *)p, limit-p, residency)==0) {
+                faulted=0;
+                for(i=0; i<count; ++i) {
+                    if((residency[i]&1)==0) {
+                        ++faulted;
+                    }
+                }
+            }
+            uprv_free(residency);
+        }
+    }
+#endif
+
+    /* read one byte per page, but not before start */
+    sum=*(const char *)start;
+    for(i=1; i<count; ++i) {
+        sum+=p[i*pageSize];
+    }
+    (void)sum;
+    return faulted;
+}
@@ -30,6 +30,16 @@
 U_CFUNC UBool uprv_mapFile(UDataMemory *pdm, const char *path);
 U_CFUNC void  uprv_unmapFile(UDataMemory *pData);
 
+/* Sets the UDataMapOption bits for subsequent uprv_mapFile() calls. */
+U_CFUNC void  uprv_setMapOptions(uint32_t options);
+
+/*
+ * Reads one byte from each memory page of [start..start+length[ so that
+ * the pages are faulted in. Returns the number of pages that were not
+ * resident before, where this can be determined, otherwise the number of pages.
+ */
+U_CFUNC int32_t uprv_touchPages(const void *start, int32_t length);
+
 /* MAP_NONE: no memory mapping, no file access at all */
 #define MAP_NONE        0
 #define MAP_WIN32       1
@@ -133,6 +133,50 @@ umtx_unlock(UMutex* mutex)
     LeaveCriticalSection(&mutex->fCS);
 }
 
+U_CAPI void U_EXPORT2
+umtx_condWait(UConditionVar *cond, UMutex *mutex) {
+    // The caller has locked the mutex, so its critical section is initialized.
+    U_ASSERT(mutex != NULL);
+    BOOL success = SleepConditionVariableCS(&cond->fCV, &mutex->fCS, INFINITE);
+    (void)success;
+    U_ASSERT(success);
+}
+
+U_CAPI void U_EXPORT2
+umtx_condBroadcast(UConditionVar *cond) {
+    WakeAllConditionVariable(&cond->fCV);
+}
+
+U_CAPI void U_EXPORT2
+umtx_rdlock(URWLock *rwlock) {
+    umtx_lock(&rwlock->fMutex);
+    ++rwlock->fReaders;
+    umtx_unlock(&rwlock->fMutex);
+}
+
+U_CAPI void U_EXPORT2
+umtx_rdunlock(URWLock *rwlock) {
+    umtx_lock(&rwlock->fMutex);
+    if (--rwlock->fReaders == 0) {
+        umtx_condBroadcast(&rwlock->fNoReaders);
+    }
+    umtx_unlock(&rwlock->fMutex);
+}
+
+U_CAPI void U_EXPORT2
+umtx_wrlock(URWLock *rwlock) {
+    // Keep fMutex locked while writing, so that new readers block.
+    umtx_lock(&rwlock->fMutex);
+    while (rwlock->fReaders != 0) {
+        umtx_condWait(&rwlock->fNoReaders, &rwlock->fMutex);
+    }
+}
+
+U_CAPI void U_EXPORT2
+umtx_wrunlock(URWLock *rwlock) {
+    umtx_unlock(&rwlock->fMutex);
+}
+
 #elif U_PLATFORM_IMPLEMENTS_POSIX
 
 //-------------------------------------------------------------------------------------------
@@ -169,6 +213,49 @@ umtx_unlock(UMutex* mutex)
     U_ASSERT(sysErr == 0);
 }
 
+U_CAPI void U_EXPORT2
+umtx_condWait(UConditionVar *cond, UMutex *mutex) {
+    U_ASSERT(mutex != NULL);
+    int sysErr = pthread_cond_wait(&cond->fCondition, &mutex->fMutex);
+    (void)sysErr;
+    U_ASSERT(sysErr == 0);
+}
+
+U_CAPI void U_EXPORT2
+umtx_condBroadcast(UConditionVar *cond) {
+    int sysErr = pthread_cond_broadcast(&cond->fCondition);
+    (void)sysErr;
+    U_ASSERT(sysErr == 0);
+}
+
+U_CAPI void U_EXPORT2
+umtx_rdlock(URWLock *rwlock) {
+    int sysErr = pthread_rwlock_rdlock(&rwlock->fLock);
+    (void)sysErr;
+    U_ASSERT(sysErr == 0);
+}
+
+U_CAPI void U_EXPORT2
+umtx_rdunlock(URWLock *rwlock) {
+    int sysErr = pthread_rwlock_unlock(&rwlock->fLock);
+    (void)sysErr;
+    U_ASSERT(sysErr == 0);
+}
+
+U_CAPI void U_EXPORT2
+umtx_wrlock(URWLock *rwlock) {
+    int sysErr = pthread_rwlock_wrlock(&rwlock->fLock);
+    (void)sysErr;
+    U_ASSERT(sysErr == 0);
+}
+
+U_CAPI void U_EXPORT2
+umtx_wrunlock(URWLock *rwlock) {
+    int sysErr = pthread_rwlock_unlock(&rwlock->fLock);
+    (void)sysErr;
+    U_ASSERT(sysErr == 0);
+}
+
 U_NAMESPACE_BEGIN
 
 static pthread_mutex_t initMutex = PTHREAD_MUTEX_INITIALIZER;
@@ -230,6 +317,28 @@ U_NAMESPACE_END
 #endif  // Platform #define chain.
 
 
+//-------------------------------------------------------------------------------
+//
+//   Yielding. Platform dependent, but independent of the mutex implementation.
+//
+//-------------------------------------------------------------------------------
+
+#if U_PLATFORM_HAS_WIN32_API
+# include <windows.h>
+#elif U_PLATFORM_IMPLEMENTS_POSIX
+# include <sched.h>
+#endif
+
+U_CAPI void U_EXPORT2
+umtx_yield() {
+#if U_PLATFORM_HAS_WIN32_API
+    SwitchToThread();
+#elif U_PLATFORM_IMPLEMENTS_POSIX
+    sched_yield();
+#endif
+}
+
+
 //-------------------------------------------------------------------------------
 //
 //   Atomic Operations, out-of-line versions.
@@ -278,12 +278,39 @@ U_NAMESPACE_END
 
 
 
+/*************************************************************************************************
+ *
+ *  Cache line alignment.
+ *     For the element types of static arrays of locks and counters, such as the shards
+ *     of a cache, so that threads working with neighboring elements
+ *     do not invalidate each other's lines (false sharing).
+ *     Do not use it for types that are allocated with new or uprv_malloc():
+ *     They do not honor alignments beyond that of max_align_t before C++17.
+ *
+ *************************************************************************************************/
+
+#ifndef U_CACHE_LINE_SIZE
+#define U_CACHE_LINE_SIZE 64
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define U_CACHE_LINE_ALIGNED __attribute__((aligned(U_CACHE_LINE_SIZE)))
+#elif defined(_MSC_VER)
+#   define U_CACHE_LINE_ALIGNED __declspec(align(U_CACHE_LINE_SIZE))
+#else
+#   define U_CACHE_LINE_ALIGNED
+#endif
+
+
 /*************************************************************************************************
  *
  *  Mutex Definitions. Platform Dependent, #if platform chain follows.
  *         TODO:  Add a C++11 version.
  *                Need to convert all mutex using files to C++ first.
  *
+ *  A user mutex header must define UMutex, UConditionVar and URWLock
+ *  with their static initializers.
+ *
  *************************************************************************************************/
 
 #if defined(U_USER_MUTEX_H)
@@ -329,6 +356,27 @@ typedef struct UMutex {
  */
 #define U_MUTEX_INITIALIZER {U_INITONCE_INITIALIZER}
 
+/* Condition variable, for use with the CRITICAL_SECTION of a UMutex.
+ *  Requires Windows Vista or later.
+ */
+typedef struct UConditionVar {
+    CONDITION_VARIABLE  fCV;
+} UConditionVar;
+
+#define U_CONDITION_INITIALIZER {CONDITION_VARIABLE_INIT}
+
+/* Reader/writer lock.
+ *  A writer holds fMutex while it owns the lock; it waits on fNoReaders for fReaders
+ *  to drop to 0. Readers lock fMutex only to change fReaders.
+ */
+typedef struct URWLock {
+    UMutex         fMutex;
+    UConditionVar  fNoReaders;
+    int32_t        fReaders;
+} URWLock;
+
+#define U_RWLOCK_INITIALIZER {U_MUTEX_INITIALIZER, U_CONDITION_INITIALIZER, 0}
+
 
 
 #elif U_PLATFORM_IMPLEMENTS_POSIX
@@ -345,6 +393,18 @@ struct UMutex {
 typedef struct UMutex UMutex;
 #define U_MUTEX_INITIALIZER  {PTHREAD_MUTEX_INITIALIZER}
 
+struct UConditionVar {
+    pthread_cond_t   fCondition;
+};
+typedef struct UConditionVar UConditionVar;
+#define U_CONDITION_INITIALIZER  {PTHREAD_COND_INITIALIZER}
+
+struct URWLock {
+    pthread_rwlock_t fLock;
+};
+typedef struct URWLock URWLock;
+#define U_RWLOCK_INITIALIZER  {PTHREAD_RWLOCK_INITIALIZER}
+
 #else
 
 /*
@@ -379,5 +439,38 @@ U_INTERNAL void U_EXPORT2 umtx_lock(UMutex* mutex);
  */
 U_INTERNAL void U_EXPORT2 umtx_unlock (UMutex* mutex);
 
+/* Wait on a condition variable.
+ * The mutex must be locked by the caller. It is unlocked while waiting
+ * and locked again before returning.
+ * Spurious wakeups are possible; callers must re-test their condition.
+ * @param cond   The condition variable. Must be statically initialized
+ *               with U_CONDITION_INITIALIZER.
+ * @param mutex  The locked mutex. Must not be NULL.
+ */
+U_INTERNAL void U_EXPORT2 umtx_condWait(UConditionVar *cond, UMutex *mutex);
+
+/* Wake all threads waiting on a condition variable.
+ * Callers should hold the associated mutex.
+ * @param cond   The condition variable.
+ */
+U_INTERNAL void U_EXPORT2 umtx_condBroadcast(UConditionVar *cond);
+
+/* Yield the processor to another thread, for example while spin-waiting
+ * for other threads that might have been preempted.
+ */
+U_INTERNAL void U_EXPORT2 umtx_yield(void);
+
+/* Reader/writer lock, for read-mostly data such as registries and caches.
+ * Any number of threads may hold the read lock at the same time;
+ * the write lock is exclusive.
+ * Neither lock is recursive, and a read lock must not be nested in another one
+ * on the same thread: Some platforms block new readers while a writer waits.
+ * Statically initialize with U_RWLOCK_INITIALIZER.
+ */
+U_INTERNAL void U_EXPORT2 umtx_rdlock(URWLock *rwlock);
+U_INTERNAL void U_EXPORT2 umtx_rdunlock(URWLock *rwlock);
+U_INTERNAL void U_EXPORT2 umtx_wrlock(URWLock *rwlock);
+U_INTERNAL void U_EXPORT2 umtx_wrunlock(URWLock *rwlock);
+
 #endif /* UMUTEX_H */
 /*eof*/
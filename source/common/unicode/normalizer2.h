@@ -26,6 +26,8 @@
 
 #if !UCONFIG_NO_NORMALIZATION
 
+#include "unicode/bytestream.h"
+#include "unicode/stringpiece.h"
 #include "unicode/uniset.h"
 #include "unicode/unistr.h"
 #include "unicode/unorm2.h"
@@ -213,6 +215,30 @@ public:
     normalize(const UnicodeString &src,
               UnicodeString &dest,
               UErrorCode &errorCode) const = 0;
+    /**
+     * Writes the normalized form of the source string to the destination array,
+     * with preflighting, like unorm2_normalize().
+     *
+     * The standard instances do not allocate heap memory if the result fits into dest,
+     * or if it is short (a few hundred UChars), even when it is only preflighted.
+     * This is useful for normalizing large numbers of short strings.
+     * The default implementation calls normalize(const UnicodeString &, UnicodeString &, UErrorCode &).
+     * @param src source string
+     * @param length length of the source string, or -1 if NUL-terminated
+     * @param dest destination buffer; can be NULL if capacity==0
+     * @param capacity number of UChars that can be written to dest
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return the length of the normalized string;
+     *         U_BUFFER_OVERFLOW_ERROR is set if it is greater than capacity
+     * @draft ICU 54
+     */
+    virtual int32_t
+    normalizeToBuffer(const UChar *src, int32_t length,
+                      UChar *dest, int32_t capacity,
+                      UErrorCode &errorCode) const;
     /**
      * Appends the normalized form of the second string to the first string
      * (merging them at the boundary) and returns the first string.
@@ -382,6 +408,92 @@ public:
     virtual int32_t
     spanQuickCheckYes(const UnicodeString &s, UErrorCode &errorCode) const = 0;
 
+    /**
+     * Normalizes a UTF-8 string and appends the result to the sink.
+     * Ill-formed byte sequences are treated as normalization-inert
+     * and are copied unchanged.
+     *
+     * The standard composition and decomposition instances work directly
+     * on UTF-8: Only the segments around characters that are not quick check "yes"
+     * are converted to UTF-16 and back, and text that is already normalized
+     * is appended unchanged, in one single Append() call if all of src is normalized.
+     * The default implementation converts each well-formed run to UTF-16 and back.
+     * @param src source UTF-8 string
+     * @param sink receives the normalized UTF-8 string
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 54
+     */
+    virtual void
+    normalizeUTF8(const StringPiece &src, ByteSink &sink, UErrorCode &errorCode) const;
+
+    /**
+     * Appends the first UTF-8 string followed by the normalized form of the second
+     * one to the sink, merging them at the boundary.
+     * The result is normalized if the first string was normalized.
+     * Ill-formed byte sequences are handled as in normalizeUTF8().
+     * @param first UTF-8 string, should be normalized
+     * @param second UTF-8 string, will be normalized
+     * @param sink receives the UTF-8 result
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 54
+     */
+    virtual void
+    normalizeSecondAndAppendUTF8(const StringPiece &first,
+                                 const StringPiece &second,
+                                 ByteSink &sink,
+                                 UErrorCode &errorCode) const;
+
+    /**
+     * Tests if the UTF-8 string is normalized, like isNormalized().
+     * Ill-formed byte sequences are handled as in normalizeUTF8().
+     * @param s input UTF-8 string
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return TRUE if s is normalized
+     * @draft ICU 54
+     */
+    virtual UBool
+    isNormalizedUTF8(const StringPiece &s, UErrorCode &errorCode) const;
+
+    /**
+     * Tests if the UTF-8 string is normalized, like quickCheck().
+     * Ill-formed byte sequences are handled as in normalizeUTF8().
+     * @param s input UTF-8 string
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return UNormalizationCheckResult
+     * @draft ICU 54
+     */
+    virtual UNormalizationCheckResult
+    quickCheckUTF8(const StringPiece &s, UErrorCode &errorCode) const;
+
+    /**
+     * Returns the end of the normalized prefix of the UTF-8 string,
+     * like spanQuickCheckYes().
+     * The end index is at a normalization boundary but might be
+     * earlier than the one returned for the equivalent UTF-16 string.
+     * Ill-formed byte sequences are handled as in normalizeUTF8().
+     * @param s input UTF-8 string
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return "yes" span end byte index
+     * @draft ICU 54
+     */
+    virtual int32_t
+    spanQuickCheckYesUTF8(const StringPiece &s, UErrorCode &errorCode) const;
+
     /**
      * Tests if the character always has a normalization boundary before it,
      * regardless of context.
@@ -652,6 +764,95 @@ private:
     const UnicodeSet &set;
 };
 
+/**
+ * Normalizes text that arrives in chunks, for example while reading a large
+ * document from a file or a network connection, without holding all of it in memory.
+ *
+ * Each normalizeChunk() call appends the normalized form of the text up to
+ * the last normalization boundary in the chunk, and holds back only the text
+ * after that boundary which might still interact with the next chunk.
+ * finish() appends the normalized form of the held-back text.
+ * The concatenation of all of the output is the same as the normalized form
+ * of the concatenation of all of the chunks.
+ * Each input character is normalized only once, and earlier output is not revisited.
+ *
+ * The held-back text is usually short, a starter and the characters that
+ * combine with it. Text without any boundary, such as a very long sequence
+ * of combining marks, is held back until a chunk with a boundary or finish().
+ *
+ * An instance of this class is not thread-safe.
+ * It aliases the Normalizer2 which must not be deleted while this object is used.
+ * @draft ICU 54
+ */
+class U_COMMON_API StreamingNormalizer2 : public UMemory {
+public:
+    /**
+     * Constructs a streaming normalizer for any Normalizer2 instance.
+     * @param n2 the Normalizer2 instance, aliased
+     * @draft ICU 54
+     */
+    StreamingNormalizer2(const Normalizer2 &n2) : norm2(n2) {}
+
+    /**
+     * Destructor.
+     * @draft ICU 54
+     */
+    ~StreamingNormalizer2();
+
+    /**
+     * Appends to dest the normalized form of the text held back from earlier chunks
+     * plus this chunk, up to the last normalization boundary in the chunk.
+     * Holds back the rest.
+     * The chunk may end in the middle of a surrogate pair.
+     * @param chunk the next piece of the input text
+     * @param dest destination string; the normalized text is appended to it
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return dest
+     * @draft ICU 54
+     */
+    UnicodeString &
+    normalizeChunk(const UnicodeString &chunk, UnicodeString &dest, UErrorCode &errorCode);
+
+    /**
+     * Appends to dest the normalized form of the held-back text, at the end of the input.
+     * Then this object is ready for the next input text.
+     * @param dest destination string; the normalized text is appended to it
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return dest
+     * @draft ICU 54
+     */
+    UnicodeString &
+    finish(UnicodeString &dest, UErrorCode &errorCode);
+
+    /**
+     * Discards the held-back text, for starting over with a new input text.
+     * @draft ICU 54
+     */
+    void reset() { pending.remove(); }
+
+    /**
+     * @return the number of UChars that are held back for the next chunk
+     * @draft ICU 54
+     */
+    int32_t getPendingLength() const { return pending.length(); }
+
+private:
+    StreamingNormalizer2(const StreamingNormalizer2 &other);  // not implemented
+    StreamingNormalizer2 &operator=(const StreamingNormalizer2 &other);  // not implemented
+
+    void normalizeAndAppend(const UChar *src, const UChar *limit,
+                            UnicodeString &dest, UErrorCode &errorCode) const;
+
+    const Normalizer2 &norm2;
+    UnicodeString pending;
+};
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_NORMALIZATION
@@ -568,6 +568,66 @@ ucnv_safeClone(const UConverter *cnv,
 U_STABLE void  U_EXPORT2
 ucnv_close(UConverter * converter);
 
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Returns a converter for the given name from a process-wide pool of idle converters,
+ * or opens a new one if the pool has none for this name.
+ * Pooled converters are keyed by their canonical names, so that aliases share pool entries.
+ * In steady state, acquiring and releasing a converter does not allocate memory
+ * and does not lock any mutex, also when several threads use the same converter name.
+ *
+ * The converter behaves like one that was just opened with ucnv_open():
+ * It is reset, and it has the default callbacks, substitution characters and fallback setting.
+ * It must be returned with ucnv_release() (or closed with ucnv_close()).
+ * It must not be used by more than one thread at a time.
+ *
+ * @param converterName name of the converter, as for ucnv_open(),
+ *                      or NULL for the default converter
+ * @param err outgoing error status, as for ucnv_open()
+ * @return a converter, or NULL if an error occured
+ * @see ucnv_release
+ * @see ucnv_open
+ * @draft ICU 54
+ */
+U_DRAFT UConverter * U_EXPORT2
+ucnv_acquire(const char *converterName, UErrorCode *err);
+
+/**
+ * Returns a converter to the pool of idle converters for use by ucnv_acquire(),
+ * or closes it if it cannot be reused or if the pool is full.
+ * The pool keeps up to 64 idle converters per name.
+ * The converter is reset. A converter that is not in its default configuration
+ * (callbacks, substitution characters or fallback setting were changed,
+ * or it is a clone in a user-provided buffer) is closed rather than pooled.
+ * The converter must not be used after this call.
+ *
+ * This may be called for any converter, not only for one from ucnv_acquire().
+ * ucnv_flushCache() closes all pooled converters.
+ *
+ * @param converter the converter; can be NULL
+ * @see ucnv_acquire
+ * @see ucnv_close
+ * @draft ICU 54
+ */
+U_DRAFT void U_EXPORT2
+ucnv_release(UConverter *converter);
+
+/**
+ * Returns the cumulative numbers of ucnv_acquire() calls that were served
+ * from the converter pool (hits) and those that had to open a new converter (misses).
+ * The counts are reset by u_cleanup().
+ *
+ * @param pHits receives the number of pool hits; can be NULL
+ * @param pMisses receives the number of pool misses; can be NULL
+ * @see ucnv_acquire
+ * @draft ICU 54
+ */
+U_DRAFT void U_EXPORT2
+ucnv_getPoolCounts(int32_t *pHits, int32_t *pMisses);
+
+#endif  /* U_HIDE_DRAFT_API */
+
 #if U_SHOW_CPLUSPLUS_API
 
 U_NAMESPACE_BEGIN
@@ -1275,6 +1335,207 @@ ucnv_toUChars(UConverter *cnv,
               const char *src, int32_t srcLength,
               UErrorCode *pErrorCode);
 
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Function type for one unit of work of a chunked conversion,
+ * passed to a UConverterTaskRunner.
+ *
+ * @param taskContext the taskContext that was passed to the runner
+ * @param index the index of the task, 0..count-1
+ * @see UConverterTaskRunner
+ * @draft ICU 54
+ */
+typedef void (U_EXPORT2 *UConverterTask)(void *taskContext, int32_t index);
+
+/**
+ * Function type for a caller-provided task runner, for example
+ * one that submits the tasks to a thread pool. ICU does not create threads itself.
+ *
+ * The runner must call task(taskContext, i) exactly once for each i from 0 to count-1,
+ * in any order and on any threads, and it must return only after all of these calls
+ * have returned.
+ *
+ * @param runnerContext the runnerContext that was passed into the conversion function
+ * @param task the function to be called for each task
+ * @param taskContext the context pointer to be passed into each task call
+ * @param count the number of tasks, at least 2
+ * @see ucnv_toUCharsParallel
+ * @draft ICU 54
+ */
+typedef void (U_EXPORT2 *UConverterTaskRunner)(const void *runnerContext,
+                                               UConverterTask task, void *taskContext,
+                                               int32_t count);
+
+/**
+ * One piece of the output of ucnv_toUSegmentsParallel() or ucnv_fromUSegmentsParallel().
+ * The segments are in source text order, and their concatenation is the converted text.
+ * @draft ICU 54
+ */
+typedef struct UConverterSegment {
+    /** Index of the first source unit that was converted into this segment. @draft ICU 54 */
+    int32_t sourceIndex;
+    /** Number of source units that were converted into this segment. @draft ICU 54 */
+    int32_t sourceLength;
+    /**
+     * The converted text, not NUL-terminated:
+     * const UChar * for ucnv_toUSegmentsParallel(), const char * for ucnv_fromUSegmentsParallel().
+     * @draft ICU 54
+     */
+    const void *target;
+    /** Length of the converted text in UChars or chars. @draft ICU 54 */
+    int32_t targetLength;
+} UConverterSegment;
+
+/**
+ * Convert the codepage string into a Unicode string like ucnv_toUChars(),
+ * but split the input into chunks that are converted independently
+ * and possibly concurrently by the runner.
+ *
+ * The input is split only where the charset is known to start a new character:
+ * For UTF-8 and CESU-8 before non-trail bytes; for UTF-16BE/LE between code points;
+ * for UTF-32BE/LE at 4-byte boundaries; for US-ASCII and ISO-8859-1 anywhere;
+ * for table-based SBCS, DBCS and MBCS codepages before bytes that are single-byte
+ * characters and cannot be trail bytes (e.g., ASCII controls and digits in Shift-JIS).
+ * Stateful and BOM-sensitive converters (e.g., ISO-2022, UTF-7, SCSU, EBCDIC_STATEFUL,
+ * UTF-16 and UTF-32 with signature detection) and codepages
+ * without such split points are converted serially.
+ * The output is the same as from ucnv_toUChars() for well-formed input.
+ * Ill-formed input may report truncated instead of illegal sequences
+ * at chunk boundaries.
+ *
+ * Each chunk except for the first is converted with a clone of cnv (see ucnv_safeClone())
+ * which shares the callbacks and their contexts.
+ * The callback contexts must tolerate concurrent calls.
+ * If a chunk fails, then the error of the first failing chunk in text order is returned.
+ *
+ * @param cnv the converter object to be used (ucnv_resetToUnicode() will be called)
+ * @param dest destination string buffer, can be NULL if destCapacity==0
+ * @param destCapacity the number of UChars available at dest
+ * @param src the input codepage string
+ * @param srcLength the input string length, or -1 if NUL-terminated
+ * @param chunkLength approximate number of bytes per chunk, or 0 for a default of 1MB
+ * @param runner the task runner; if NULL, then the input is converted serially
+ * @param runnerContext passed into the runner
+ * @param pErrorCode normal ICU error code, as for ucnv_toUChars()
+ * @return the length of the output string, not counting the terminating NUL;
+ *         if the length is greater than destCapacity, then the string will not fit
+ *         and a buffer of the indicated length would need to be passed in
+ * @see ucnv_toUChars
+ * @see ucnv_toUSegmentsParallel
+ * @draft ICU 54
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_toUCharsParallel(UConverter *cnv,
+                      UChar *dest, int32_t destCapacity,
+                      const char *src, int32_t srcLength,
+                      int32_t chunkLength,
+                      UConverterTaskRunner runner, const void *runnerContext,
+                      UErrorCode *pErrorCode);
+
+/**
+ * Convert the Unicode string into a codepage string like ucnv_fromUChars(),
+ * but split the input into chunks that are converted independently
+ * and possibly concurrently by the runner.
+ *
+ * The input is split between code points, never inside a surrogate pair.
+ * Stateful converters (e.g., ISO-2022, UTF-7, SCSU, EBCDIC_STATEFUL,
+ * UTF-16 and UTF-32 which write a BOM) and codepages with extension mappings
+ * from multiple code points are converted serially.
+ * Otherwise as ucnv_toUCharsParallel().
+ *
+ * @param cnv the converter object to be used (ucnv_resetFromUnicode() will be called)
+ * @param dest destination string buffer, can be NULL if destCapacity==0
+ * @param destCapacity the number of chars available at dest
+ * @param src the input Unicode string
+ * @param srcLength the input string length, or -1 if NUL-terminated
+ * @param chunkLength approximate number of UChars per chunk, or 0 for a default of 1M UChars
+ * @param runner the task runner; if NULL, then the input is converted serially
+ * @param runnerContext passed into the runner
+ * @param pErrorCode normal ICU error code, as for ucnv_fromUChars()
+ * @return the length of the output string, not counting the terminating NUL;
+ *         if the length is greater than destCapacity, then the string will not fit
+ *         and a buffer of the indicated length would need to be passed in
+ * @see ucnv_fromUChars
+ * @see ucnv_fromUSegmentsParallel
+ * @see ucnv_toUCharsParallel
+ * @draft ICU 54
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_fromUCharsParallel(UConverter *cnv,
+                        char *dest, int32_t destCapacity,
+                        const UChar *src, int32_t srcLength,
+                        int32_t chunkLength,
+                        UConverterTaskRunner runner, const void *runnerContext,
+                        UErrorCode *pErrorCode);
+
+/**
+ * Same as ucnv_toUCharsParallel() but returns the output of each chunk
+ * in a separate segment rather than copying it into one contiguous buffer.
+ * When the input is converted serially, there is one segment.
+ *
+ * @param cnv the converter object to be used (ucnv_resetToUnicode() will be called)
+ * @param src the input codepage string
+ * @param srcLength the input string length, or -1 if NUL-terminated
+ * @param chunkLength approximate number of bytes per chunk, or 0 for a default of 1MB
+ * @param runner the task runner; if NULL, then the input is converted serially
+ * @param runnerContext passed into the runner
+ * @param pSegments receives an array of segments which must be released
+ *                  with ucnv_closeSegments(); set to NULL if an error occurs
+ * @param pErrorCode normal ICU error code
+ * @return the number of segments
+ * @see ucnv_toUCharsParallel
+ * @see ucnv_closeSegments
+ * @draft ICU 54
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_toUSegmentsParallel(UConverter *cnv,
+                         const char *src, int32_t srcLength,
+                         int32_t chunkLength,
+                         UConverterTaskRunner runner, const void *runnerContext,
+                         UConverterSegment **pSegments,
+                         UErrorCode *pErrorCode);
+
+/**
+ * Same as ucnv_fromUCharsParallel() but returns the output of each chunk
+ * in a separate segment rather than copying it into one contiguous buffer.
+ * When the input is converted serially, there is one segment.
+ *
+ * @param cnv the converter object to be used (ucnv_resetFromUnicode() will be called)
+ * @param src the input Unicode string
+ * @param srcLength the input string length, or -1 if NUL-terminated
+ * @param chunkLength approximate number of UChars per chunk, or 0 for a default of 1M UChars
+ * @param runner the task runner; if NULL, then the input is converted serially
+ * @param runnerContext passed into the runner
+ * @param pSegments receives an array of segments which must be released
+ *                  with ucnv_closeSegments(); set to NULL if an error occurs
+ * @param pErrorCode normal ICU error code
+ * @return the number of segments
+ * @see ucnv_fromUCharsParallel
+ * @see ucnv_closeSegments
+ * @draft ICU 54
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_fromUSegmentsParallel(UConverter *cnv,
+                           const UChar *src, int32_t srcLength,
+                           int32_t chunkLength,
+                           UConverterTaskRunner runner, const void *runnerContext,
+                           UConverterSegment **pSegments,
+                           UErrorCode *pErrorCode);
+
+/**
+ * Releases the segments returned by ucnv_toUSegmentsParallel() or ucnv_fromUSegmentsParallel(),
+ * including their converted text.
+ *
+ * @param segments the array of segments; can be NULL
+ * @param count the number of segments
+ * @draft ICU 54
+ */
+U_DRAFT void U_EXPORT2
+ucnv_closeSegments(UConverterSegment *segments, int32_t count);
+
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Convert a codepage buffer into Unicode one character at a time.
  * The input is completely consumed when the U_INDEX_OUTOFBOUNDS_ERROR is set.
@@ -1668,6 +1929,7 @@ ucnv_fromAlgorithmic(UConverter *cnv,
 
 /**
  * Frees up memory occupied by unused, cached converter shared data.
+ * Idle converters pooled by ucnv_release() are closed first.
  *
  * @return the number of cached converters successfully deleted
  * @see ucnv_close
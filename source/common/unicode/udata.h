@@ -411,6 +411,76 @@ typedef enum UDataFileAccess {
 U_STABLE void U_EXPORT2
 udata_setFileAccess(UDataFileAccess access, UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Option bits for udata_setMapOptions().
+ * They are hints for how data files are memory-mapped;
+ * they are ignored where the platform does not support them.
+ * @see udata_setMapOptions
+ * @draft ICU 54
+ */
+typedef enum UDataMapOption {
+    /**
+     * Advise the operating system that the whole file will be needed soon
+     * (POSIX_MADV_WILLNEED), so that it can start reading it in the background.
+     * @draft ICU 54
+     */
+    UDATA_MAP_WILLNEED = 1,
+    /**
+     * Advise the operating system to back the mapping with huge pages
+     * where possible (Linux MADV_HUGEPAGE), to reduce TLB misses.
+     * @draft ICU 54
+     */
+    UDATA_MAP_HUGEPAGE = 2,
+    /**
+     * Read the whole file and map all of its pages when it is mapped
+     * (Linux MAP_POPULATE), rather than on first access.
+     * @draft ICU 54
+     */
+    UDATA_MAP_POPULATE = 4
+} UDataMapOption;
+
+/**
+ * Sets how ICU memory-maps data files (.dat packages and individual files)
+ * that are loaded after this call.
+ * Like udata_setFileAccess(), this function is not thread safe and should be called
+ * before any ICU data is loaded.
+ *
+ * @param options a bit set of UDataMapOption values, or 0 for the default
+ * @param status Error code. Set to U_ILLEGAL_ARGUMENT_ERROR for unknown option bits.
+ * @see UDataMapOption
+ * @see udata_warmUp
+ * @draft ICU 54
+ */
+U_DRAFT void U_EXPORT2
+udata_setMapOptions(uint32_t options, UErrorCode *status);
+
+/**
+ * Loads a data item like udata_open() and reads every memory page of it,
+ * so that later accesses do not incur page faults.
+ * This can be used at startup for data that is needed with low latency,
+ * for example udata_warmUp(NULL, "nrm", "nfc", &errorCode)
+ * or udata_warmUp(U_ICUDATA_COLL, "res", "root", &errorCode).
+ *
+ * If the length of the item is not known (for example, for the last item
+ * of a package linked into a library), then only its header is read.
+ *
+ * @param path the package path, as for udata_open()
+ * @param type the item type, as for udata_open()
+ * @param name the item name, as for udata_open()
+ * @param pErrorCode ICU error code
+ * @return the number of memory pages that were faulted in,
+ *         that is, that were not resident before this call;
+ *         on platforms where this cannot be determined, the number of pages that were read
+ * @see udata_setMapOptions
+ * @draft ICU 54
+ */
+U_DRAFT int32_t U_EXPORT2
+udata_warmUp(const char *path, const char *type, const char *name, UErrorCode *pErrorCode);
+
+#endif  /* U_HIDE_DRAFT_API */
+
 U_CDECL_END
 
 #endif
@@ -578,14 +578,17 @@
 #define ucln_io_registerCleanup U_ICU_ENTRY_POINT_RENAME(ucln_io_registerCleanup)
 #define ucln_lib_cleanup U_ICU_ENTRY_POINT_RENAME(ucln_lib_cleanup)
 #define ucln_registerCleanup U_ICU_ENTRY_POINT_RENAME(ucln_registerCleanup)
+#define ucnv_MBCSCanSplitFromUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSCanSplitFromUnicode)
 #define ucnv_MBCSFromUChar32 U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSFromUChar32)
 #define ucnv_MBCSFromUnicodeWithOffsets U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSFromUnicodeWithOffsets)
 #define ucnv_MBCSGetFilteredUnicodeSetForUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetFilteredUnicodeSetForUnicode)
+#define ucnv_MBCSGetSplitBytes U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetSplitBytes)
 #define ucnv_MBCSGetType U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetType)
 #define ucnv_MBCSGetUnicodeSetForUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetUnicodeSetForUnicode)
 #define ucnv_MBCSIsLeadByte U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSIsLeadByte)
 #define ucnv_MBCSSimpleGetNextUChar U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSSimpleGetNextUChar)
 #define ucnv_MBCSToUnicodeWithOffsets U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSToUnicodeWithOffsets)
+#define ucnv_acquire U_ICU_ENTRY_POINT_RENAME(ucnv_acquire)
 #define ucnv_bld_countAvailableConverters U_ICU_ENTRY_POINT_RENAME(ucnv_bld_countAvailableConverters)
 #define ucnv_bld_getAvailableConverter U_ICU_ENTRY_POINT_RENAME(ucnv_bld_getAvailableConverter)
 #define ucnv_canCreateConverter U_ICU_ENTRY_POINT_RENAME(ucnv_canCreateConverter)
@@ -595,6 +598,7 @@
 #define ucnv_cbToUWriteSub U_ICU_ENTRY_POINT_RENAME(ucnv_cbToUWriteSub)
 #define ucnv_cbToUWriteUChars U_ICU_ENTRY_POINT_RENAME(ucnv_cbToUWriteUChars)
 #define ucnv_close U_ICU_ENTRY_POINT_RENAME(ucnv_close)
+#define ucnv_closeSegments U_ICU_ENTRY_POINT_RENAME(ucnv_closeSegments)
 #define ucnv_compareNames U_ICU_ENTRY_POINT_RENAME(ucnv_compareNames)
 #define ucnv_convert U_ICU_ENTRY_POINT_RENAME(ucnv_convert)
 #define ucnv_convertEx U_ICU_ENTRY_POINT_RENAME(ucnv_convertEx)
@@ -617,7 +621,9 @@
 #define ucnv_flushCache U_ICU_ENTRY_POINT_RENAME(ucnv_flushCache)
 #define ucnv_fromAlgorithmic U_ICU_ENTRY_POINT_RENAME(ucnv_fromAlgorithmic)
 #define ucnv_fromUChars U_ICU_ENTRY_POINT_RENAME(ucnv_fromUChars)
+#define ucnv_fromUCharsParallel U_ICU_ENTRY_POINT_RENAME(ucnv_fromUCharsParallel)
 #define ucnv_fromUCountPending U_ICU_ENTRY_POINT_RENAME(ucnv_fromUCountPending)
+#define ucnv_fromUSegmentsParallel U_ICU_ENTRY_POINT_RENAME(ucnv_fromUSegmentsParallel)
 #define ucnv_fromUWriteBytes U_ICU_ENTRY_POINT_RENAME(ucnv_fromUWriteBytes)
 #define ucnv_fromUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_fromUnicode)
 #define ucnv_fromUnicode_UTF8 U_ICU_ENTRY_POINT_RENAME(ucnv_fromUnicode_UTF8)
@@ -639,6 +645,7 @@
 #define ucnv_getNextUChar U_ICU_ENTRY_POINT_RENAME(ucnv_getNextUChar)
 #define ucnv_getNonSurrogateUnicodeSet U_ICU_ENTRY_POINT_RENAME(ucnv_getNonSurrogateUnicodeSet)
 #define ucnv_getPlatform U_ICU_ENTRY_POINT_RENAME(ucnv_getPlatform)
+#define ucnv_getPoolCounts U_ICU_ENTRY_POINT_RENAME(ucnv_getPoolCounts)
 #define ucnv_getStandard U_ICU_ENTRY_POINT_RENAME(ucnv_getStandard)
 #define ucnv_getStandardName U_ICU_ENTRY_POINT_RENAME(ucnv_getStandardName)
 #define ucnv_getStarters U_ICU_ENTRY_POINT_RENAME(ucnv_getStarters)
@@ -661,6 +668,7 @@
 #define ucnv_openPackage U_ICU_ENTRY_POINT_RENAME(ucnv_openPackage)
 #define ucnv_openStandardNames U_ICU_ENTRY_POINT_RENAME(ucnv_openStandardNames)
 #define ucnv_openU U_ICU_ENTRY_POINT_RENAME(ucnv_openU)
+#define ucnv_release U_ICU_ENTRY_POINT_RENAME(ucnv_release)
 #define ucnv_reset U_ICU_ENTRY_POINT_RENAME(ucnv_reset)
 #define ucnv_resetFromUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_resetFromUnicode)
 #define ucnv_resetToUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_resetToUnicode)
@@ -675,7 +683,9 @@
 #define ucnv_swapAliases U_ICU_ENTRY_POINT_RENAME(ucnv_swapAliases)
 #define ucnv_toAlgorithmic U_ICU_ENTRY_POINT_RENAME(ucnv_toAlgorithmic)
 #define ucnv_toUChars U_ICU_ENTRY_POINT_RENAME(ucnv_toUChars)
+#define ucnv_toUCharsParallel U_ICU_ENTRY_POINT_RENAME(ucnv_toUCharsParallel)
 #define ucnv_toUCountPending U_ICU_ENTRY_POINT_RENAME(ucnv_toUCountPending)
+#define ucnv_toUSegmentsParallel U_ICU_ENTRY_POINT_RENAME(ucnv_toUSegmentsParallel)
 #define ucnv_toUWriteCodePoint U_ICU_ENTRY_POINT_RENAME(ucnv_toUWriteCodePoint)
 #define ucnv_toUWriteUChars U_ICU_ENTRY_POINT_RENAME(ucnv_toUWriteUChars)
 #define ucnv_toUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_toUnicode)
@@ -717,6 +727,7 @@
 #define ucol_getSortKey U_ICU_ENTRY_POINT_RENAME(ucol_getSortKey)
 #define ucol_getStrength U_ICU_ENTRY_POINT_RENAME(ucol_getStrength)
 #define ucol_getTailoredSet U_ICU_ENTRY_POINT_RENAME(ucol_getTailoredSet)
+#define ucol_getTailoringCacheStatistics U_ICU_ENTRY_POINT_RENAME(ucol_getTailoringCacheStatistics)
 #define ucol_getUCAVersion U_ICU_ENTRY_POINT_RENAME(ucol_getUCAVersion)
 #define ucol_getUnsafeSet U_ICU_ENTRY_POINT_RENAME(ucol_getUnsafeSet)
 #define ucol_getVariableTop U_ICU_ENTRY_POINT_RENAME(ucol_getVariableTop)
@@ -822,6 +833,7 @@
 #define udata_getLength U_ICU_ENTRY_POINT_RENAME(udata_getLength)
 #define udata_getMemory U_ICU_ENTRY_POINT_RENAME(udata_getMemory)
 #define udata_getRawMemory U_ICU_ENTRY_POINT_RENAME(udata_getRawMemory)
+#define udata_hashTOCEntryName U_ICU_ENTRY_POINT_RENAME(udata_hashTOCEntryName)
 #define udata_open U_ICU_ENTRY_POINT_RENAME(udata_open)
 #define udata_openChoice U_ICU_ENTRY_POINT_RENAME(udata_openChoice)
 #define udata_openSwapper U_ICU_ENTRY_POINT_RENAME(udata_openSwapper)
@@ -832,8 +844,10 @@
 #define udata_setAppData U_ICU_ENTRY_POINT_RENAME(udata_setAppData)
 #define udata_setCommonData U_ICU_ENTRY_POINT_RENAME(udata_setCommonData)
 #define udata_setFileAccess U_ICU_ENTRY_POINT_RENAME(udata_setFileAccess)
+#define udata_setMapOptions U_ICU_ENTRY_POINT_RENAME(udata_setMapOptions)
 #define udata_swapDataHeader U_ICU_ENTRY_POINT_RENAME(udata_swapDataHeader)
 #define udata_swapInvStringBlock U_ICU_ENTRY_POINT_RENAME(udata_swapInvStringBlock)
+#define udata_warmUp U_ICU_ENTRY_POINT_RENAME(udata_warmUp)
 #define udatpg_addPattern U_ICU_ENTRY_POINT_RENAME(udatpg_addPattern)
 #define udatpg_clone U_ICU_ENTRY_POINT_RENAME(udatpg_clone)
 #define udatpg_close U_ICU_ENTRY_POINT_RENAME(udatpg_close)
@@ -911,6 +925,8 @@
 #define uhash_deleteScriptSet U_ICU_ENTRY_POINT_RENAME(uhash_deleteScriptSet)
 #define uhash_equals U_ICU_ENTRY_POINT_RENAME(uhash_equals)
 #define uhash_equalsScriptSet U_ICU_ENTRY_POINT_RENAME(uhash_equalsScriptSet)
+#define uhash_fastHashChars U_ICU_ENTRY_POINT_RENAME(uhash_fastHashChars)
+#define uhash_fastHashUChars U_ICU_ENTRY_POINT_RENAME(uhash_fastHashUChars)
 #define uhash_find U_ICU_ENTRY_POINT_RENAME(uhash_find)
 #define uhash_get U_ICU_ENTRY_POINT_RENAME(uhash_get)
 #define uhash_geti U_ICU_ENTRY_POINT_RENAME(uhash_geti)
@@ -1062,8 +1078,15 @@
 #define umsg_toPattern U_ICU_ENTRY_POINT_RENAME(umsg_toPattern)
 #define umsg_vformat U_ICU_ENTRY_POINT_RENAME(umsg_vformat)
 #define umsg_vparse U_ICU_ENTRY_POINT_RENAME(umsg_vparse)
+#define umtx_condBroadcast U_ICU_ENTRY_POINT_RENAME(umtx_condBroadcast)
+#define umtx_condWait U_ICU_ENTRY_POINT_RENAME(umtx_condWait)
 #define umtx_lock U_ICU_ENTRY_POINT_RENAME(umtx_lock)
+#define umtx_rdlock U_ICU_ENTRY_POINT_RENAME(umtx_rdlock)
+#define umtx_rdunlock U_ICU_ENTRY_POINT_RENAME(umtx_rdunlock)
 #define umtx_unlock U_ICU_ENTRY_POINT_RENAME(umtx_unlock)
+#define umtx_wrlock U_ICU_ENTRY_POINT_RENAME(umtx_wrlock)
+#define umtx_wrunlock U_ICU_ENTRY_POINT_RENAME(umtx_wrunlock)
+#define umtx_yield U_ICU_ENTRY_POINT_RENAME(umtx_yield)
 #define uniset_getUnicode32Instance U_ICU_ENTRY_POINT_RENAME(uniset_getUnicode32Instance)
 #define unorm2_append U_ICU_ENTRY_POINT_RENAME(unorm2_append)
 #define unorm2_close U_ICU_ENTRY_POINT_RENAME(unorm2_close)
@@ -1266,6 +1289,8 @@
 #define uprv_ebcdicToLowercaseAscii U_ICU_ENTRY_POINT_RENAME(uprv_ebcdicToLowercaseAscii)
 #define uprv_ebcdictolower U_ICU_ENTRY_POINT_RENAME(uprv_ebcdictolower)
 #define uprv_fabs U_ICU_ENTRY_POINT_RENAME(uprv_fabs)
+#define uprv_findBytesDifference U_ICU_ENTRY_POINT_RENAME(uprv_findBytesDifference)
+#define uprv_findUCharsDifference U_ICU_ENTRY_POINT_RENAME(uprv_findUCharsDifference)
 #define uprv_floor U_ICU_ENTRY_POINT_RENAME(uprv_floor)
 #define uprv_fmax U_ICU_ENTRY_POINT_RENAME(uprv_fmax)
 #define uprv_fmin U_ICU_ENTRY_POINT_RENAME(uprv_fmin)
@@ -1305,6 +1330,7 @@
 #define uprv_pow10 U_ICU_ENTRY_POINT_RENAME(uprv_pow10)
 #define uprv_realloc U_ICU_ENTRY_POINT_RENAME(uprv_realloc)
 #define uprv_round U_ICU_ENTRY_POINT_RENAME(uprv_round)
+#define uprv_setMapOptions U_ICU_ENTRY_POINT_RENAME(uprv_setMapOptions)
 #define uprv_sortArray U_ICU_ENTRY_POINT_RENAME(uprv_sortArray)
 #define uprv_stableBinarySearch U_ICU_ENTRY_POINT_RENAME(uprv_stableBinarySearch)
 #define uprv_strCompare U_ICU_ENTRY_POINT_RENAME(uprv_strCompare)
@@ -1314,6 +1340,7 @@
 #define uprv_strnicmp U_ICU_ENTRY_POINT_RENAME(uprv_strnicmp)
 #define uprv_syntaxError U_ICU_ENTRY_POINT_RENAME(uprv_syntaxError)
 #define uprv_timezone U_ICU_ENTRY_POINT_RENAME(uprv_timezone)
+#define uprv_touchPages U_ICU_ENTRY_POINT_RENAME(uprv_touchPages)
 #define uprv_toupper U_ICU_ENTRY_POINT_RENAME(uprv_toupper)
 #define uprv_trunc U_ICU_ENTRY_POINT_RENAME(uprv_trunc)
 #define uprv_tzname U_ICU_ENTRY_POINT_RENAME(uprv_tzname)
@@ -1427,6 +1454,7 @@
 #define ures_getName U_ICU_ENTRY_POINT_RENAME(ures_getName)
 #define ures_getNextResource U_ICU_ENTRY_POINT_RENAME(ures_getNextResource)
 #define ures_getNextString U_ICU_ENTRY_POINT_RENAME(ures_getNextString)
+#define ures_getPathCacheStatistics U_ICU_ENTRY_POINT_RENAME(ures_getPathCacheStatistics)
 #define ures_getSize U_ICU_ENTRY_POINT_RENAME(ures_getSize)
 #define ures_getString U_ICU_ENTRY_POINT_RENAME(ures_getString)
 #define ures_getStringByIndex U_ICU_ENTRY_POINT_RENAME(ures_getStringByIndex)
@@ -1589,6 +1617,8 @@
 #define usprep_openByType U_ICU_ENTRY_POINT_RENAME(usprep_openByType)
 #define usprep_prepare U_ICU_ENTRY_POINT_RENAME(usprep_prepare)
 #define usprep_swap U_ICU_ENTRY_POINT_RENAME(usprep_swap)
+#define ustr_fastHashCharsN U_ICU_ENTRY_POINT_RENAME(ustr_fastHashCharsN)
+#define ustr_fastHashUCharsN U_ICU_ENTRY_POINT_RENAME(ustr_fastHashUCharsN)
 #define ustr_hashCharsN U_ICU_ENTRY_POINT_RENAME(ustr_hashCharsN)
 #define ustr_hashICharsN U_ICU_ENTRY_POINT_RENAME(ustr_hashICharsN)
 #define ustr_hashUCharsN U_ICU_ENTRY_POINT_RENAME(ustr_hashUCharsN)
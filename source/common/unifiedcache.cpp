@@ -0,0 +1,519 @@
+/*
+******************************************************************************
+* Copyright (C) 2014, International Business Machines Corporation and
+* others. All Rights Reserved.
+******************************************************************************
+*
+* File UNIFIEDCACHE.CPP
+******************************************************************************
+*/
+
+#include "unifiedcache.h"
+#include "cmemory.h"
+#include "cstring.h"
+#include "mutex.h"
+#include "uassert.h"
+#include "ucln_cmn.h"
+#include "ustr_imp.h"
+
+/**
+ * Maximum number of entries in the process-wide cache, for all types together.
+ * Can be overridden at build time.
+ */
+#ifndef U_UNIFIED_CACHE_MAX_ENTRIES
+#define U_UNIFIED_CACHE_MAX_ENTRIES 400
+#endif
+
+static icu::UnifiedCache *gCache = NULL;
+static icu::UInitOnce gCacheInitOnce = U_INITONCE_INITIALIZER;
+
+// Serializes misses, insertions and evictions of all UnifiedCache instances.
+// Hits do not use it.
+static UMutex gCacheMutex = U_MUTEX_INITIALIZER;
+// Signaled when an in-progress entry becomes ready.
+static UConditionVar gCacheCond = U_CONDITION_INITIALIZER;
+
+U_CDECL_BEGIN
+static UBool U_CALLCONV unifiedcache_cleanup() {
+    gCacheInitOnce.reset();
+    if (gCache) {
+        delete gCache;
+        gCache = NULL;
+    }
+    return TRUE;
+}
+U_CDECL_END
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+// Entry states.
+enum {
+    ENTRY_FREE,
+    ENTRY_IN_PROGRESS,
+    ENTRY_READY,
+    ENTRY_RETIRED
+};
+
+// Slot value for a removed entry. Probing continues past it.
+static const int32_t DELETED_SLOT = -1;
+
+// Maximum number of distinct UnifiedCacheType objects per cache.
+static const int32_t MAX_TYPES = 16;
+
+// Number of times waitForReaders() checks the reader count before it starts yielding.
+static const int32_t WAIT_FOR_READERS_SPINS = 100;
+
+}  // namespace
+
+struct UnifiedCache::Entry : public UMemory {
+    const UnifiedCacheType *type;
+    char *localeId;
+    int32_t hash;
+    int32_t typeIndex;
+    // value and status are valid when the state is ENTRY_READY.
+    const SharedObject *value;
+    UErrorCode status;
+    u_atomic_int32_t state;
+    // CLOCK bit: Set by hits, cleared by the eviction sweep.
+    u_atomic_int32_t referenced;
+    int32_t next;
+};
+
+struct UnifiedCache::TypeStatistics : public UMemory {
+    const UnifiedCacheType *type;
+    u_atomic_int32_t hits;
+    u_atomic_int32_t misses;
+    u_atomic_int32_t evictions;
+};
+
+static void U_CALLCONV cacheInit(UErrorCode &status) {
+    U_ASSERT(gCache == NULL);
+    ucln_common_registerCleanup(UCLN_COMMON_UNIFIED_CACHE, unifiedcache_cleanup);
+    gCache = new UnifiedCache(U_UNIFIED_CACHE_MAX_ENTRIES, status);
+    if (gCache == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    } else if (U_FAILURE(status)) {
+        delete gCache;
+        gCache = NULL;
+    }
+}
+
+UnifiedCache *UnifiedCache::getInstance(UErrorCode &status) {
+    umtx_initOnce(gCacheInitOnce, &cacheInit, status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    U_ASSERT(gCache != NULL);
+    return gCache;
+}
+
+UnifiedCache::UnifiedCache(int32_t maxEntryCount, UErrorCode &status) :
+        maxEntries(maxEntryCount),
+        capacity(0),
+        slotsMask(0),
+        entries(NULL),
+        slots(NULL),
+        typeStats(NULL),
+        typeCount(0),
+        liveCount(0),
+        usedSlots(0),
+        freeList(-1),
+        retiredList(-1),
+        clockHand(0) {
+    umtx_storeRelease(epoch, 0);
+    umtx_storeRelease(readers[0], 0);
+    umtx_storeRelease(readers[1], 0);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (maxEntries <= 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    // Retired entries wait for a grace period before they can be reused.
+    // The extra capacity lets evictions be reclaimed in batches.
+    capacity = maxEntries + maxEntries / 2 + 1;
+    // At least half of the slots are empty, so that probe sequences are short.
+    int32_t slotCount = 16;
+    while (slotCount < 2 * capacity) {
+        slotCount <<= 1;
+    }
+    slotsMask = slotCount - 1;
+    entries = new Entry[capacity];
+    slots = (u_atomic_int32_t *)uprv_malloc(slotCount * sizeof(u_atomic_int32_t));
+    typeStats = new TypeStatistics[MAX_TYPES];
+    if (entries == NULL || slots == NULL || typeStats == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < capacity; ++i) {
+        Entry &entry = entries[i];
+        entry.type = NULL;
+        entry.localeId = NULL;
+        entry.hash = 0;
+        entry.typeIndex = 0;
+        entry.value = NULL;
+        entry.status = U_ZERO_ERROR;
+        umtx_storeRelease(entry.state, ENTRY_FREE);
+        umtx_storeRelease(entry.referenced, 0);
+        entry.next = i + 1 < capacity ? i + 1 : -1;
+    }
+    freeList = 0;
+    for (int32_t i = 0; i < slotCount; ++i) {
+        umtx_storeRelease(slots[i], 0);
+    }
+}
+
+UnifiedCache::~UnifiedCache() {
+    // No other thread may use the cache any more.
+    if (entries != NULL) {
+        for (int32_t i = 0; i < capacity; ++i) {
+            Entry &entry = entries[i];
+            U_ASSERT(umtx_loadAcquire(entry.state) != ENTRY_IN_PROGRESS);
+            SharedObject::clearPtr(entry.value);
+            uprv_free(entry.localeId);
+        }
+    }
+    delete[] entries;
+    uprv_free(slots);
+    delete[] typeStats;
+}
+
+const SharedObject *
+UnifiedCache::_get(const UnifiedCacheType &type, const char *localeId,
+                   UErrorCode &status) {
+    int32_t hash = ustr_fastHashCharsN(localeId, (int32_t)uprv_strlen(localeId));
+    const SharedObject *value = NULL;
+    if (lookUp(type, localeId, hash, value, status)) {
+        return value;
+    }
+
+    int32_t entryIndex;
+    {
+        Mutex lock(&gCacheMutex);
+        for (;;) {
+            entryIndex = findEntry(type, localeId, hash);
+            if (entryIndex < 0) {
+                break;
+            }
+            Entry &entry = entries[entryIndex];
+            if (umtx_loadAcquire(entry.state) == ENTRY_READY) {
+                umtx_atomic_inc(&typeStats[entry.typeIndex].hits);
+                umtx_storeRelease(entry.referenced, 1);
+                if (U_FAILURE(entry.status)) {
+                    status = entry.status;
+                    return NULL;
+                }
+                entry.value->addRef();
+                return entry.value;
+            }
+            // Another thread is creating this value. Wait for it, then look again:
+            // The entry may have been evicted and reused in the meantime.
+            umtx_condWait(&gCacheCond, &gCacheMutex);
+        }
+        int32_t typeIndex = getTypeIndex(type);
+        if (typeIndex >= 0) {
+            umtx_atomic_inc(&typeStats[typeIndex].misses);
+            entryIndex = allocateEntry();
+        }
+        if (entryIndex >= 0) {
+            Entry &entry = entries[entryIndex];
+            entry.localeId = uprv_strdup(localeId);
+            if (entry.localeId == NULL) {
+                entry.next = freeList;
+                freeList = entryIndex;
+                entryIndex = -1;
+            } else {
+                entry.type = &type;
+                entry.hash = hash;
+                entry.typeIndex = typeIndex;
+                entry.value = NULL;
+                entry.status = U_ZERO_ERROR;
+                umtx_storeRelease(entry.state, ENTRY_IN_PROGRESS);
+                umtx_storeRelease(entry.referenced, 1);
+                ++liveCount;
+                insertSlot(entryIndex);
+            }
+        }
+        // If entryIndex < 0, then the value is created but not cached.
+    }
+
+    // Create the value without holding the mutex so that misses on other keys,
+    // including ones made by the creation function itself, proceed.
+    UErrorCode createStatus = U_ZERO_ERROR;
+    SharedObject *created = type.createFunc(localeId, createStatus);
+    if (U_FAILURE(createStatus)) {
+        if (created != NULL) {
+            created->deleteIfZeroRefCount();
+            created = NULL;
+        }
+    } else if (created == NULL) {
+        createStatus = U_INTERNAL_PROGRAM_ERROR;
+    } else {
+        created->addRef();  // the caller's reference
+    }
+    if (entryIndex >= 0) {
+        Mutex lock(&gCacheMutex);
+        Entry &entry = entries[entryIndex];
+        SharedObject::copyPtr((const SharedObject *)created, entry.value);
+        entry.status = createStatus;
+        umtx_storeRelease(entry.state, ENTRY_READY);
+        umtx_condBroadcast(&gCacheCond);
+    }
+    if (U_FAILURE(createStatus)) {
+        status = createStatus;
+        return NULL;
+    }
+    return created;
+}
+
+UBool
+UnifiedCache::lookUp(const UnifiedCacheType &type, const char *localeId, int32_t hash,
+                     const SharedObject *&value, UErrorCode &status) {
+    UBool found = FALSE;
+    int32_t phase = enterReader();
+    for (int32_t i = hash & slotsMask;; i = (i + 1) & slotsMask) {
+        int32_t slot = umtx_loadAcquire(slots[i]);
+        if (slot == 0) {
+            break;
+        }
+        if (slot == DELETED_SLOT) {
+            continue;
+        }
+        // The entry cannot be reused before this reader has exited,
+        // so its fields are stable.
+        Entry &entry = entries[slot - 1];
+        if (entry.type == &type && entry.hash == hash &&
+                uprv_strcmp(entry.localeId, localeId) == 0) {
+            if (umtx_loadAcquire(entry.state) == ENTRY_READY) {
+                umtx_atomic_inc(&typeStats[entry.typeIndex].hits);
+                if (umtx_loadAcquire(entry.referenced) == 0) {
+                    umtx_storeRelease(entry.referenced, 1);
+                }
+                if (U_FAILURE(entry.status)) {
+                    status = entry.status;
+                } else {
+                    // The retired entry still owns a reference until reclaimed.
+                    value = entry.value;
+                    value->addRef();
+                }
+                found = TRUE;
+            }
+            break;
+        }
+    }
+    exitReader(phase);
+    return found;
+}
+
+int32_t
+UnifiedCache::enterReader() {
+    for (;;) {
+        int32_t phase = umtx_loadAcquire(epoch) & 1;
+        umtx_atomic_inc(&readers[phase]);
+        // If the epoch changed before we were counted,
+        // then waitForReaders() might not have seen us.
+        if ((umtx_loadAcquire(epoch) & 1) == phase) {
+            return phase;
+        }
+        umtx_atomic_dec(&readers[phase]);
+    }
+}
+
+void
+UnifiedCache::waitForReaders() {
+    int32_t oldPhase = (umtx_atomic_inc(&epoch) - 1) & 1;
+    // New readers now count themselves in the other phase.
+    // The atomic read-modify-write orders our check after the epoch change:
+    // A reader that increments after it also sees the new epoch and backs off.
+    umtx_atomic_inc(&readers[oldPhase]);
+    umtx_atomic_dec(&readers[oldPhase]);
+    // Readers only probe the table; they usually leave quickly.
+    // Yield after a short spin, in case a reader was preempted:
+    // This thread holds gCacheMutex, so other writers wait for it as well.
+    for (int32_t spins = 0; umtx_loadAcquire(readers[oldPhase]) != 0; ++spins) {
+        if (spins >= WAIT_FOR_READERS_SPINS) {
+            umtx_yield();
+        }
+    }
+}
+
+int32_t
+UnifiedCache::findEntry(const UnifiedCacheType &type, const char *localeId,
+                        int32_t hash) const {
+    for (int32_t i = hash & slotsMask;; i = (i + 1) & slotsMask) {
+        int32_t slot = umtx_loadAcquire(slots[i]);
+        if (slot == 0) {
+            return -1;
+        }
+        if (slot == DELETED_SLOT) {
+            continue;
+        }
+        const Entry &entry = entries[slot - 1];
+        if (entry.type == &type && entry.hash == hash &&
+                uprv_strcmp(entry.localeId, localeId) == 0) {
+            return slot - 1;
+        }
+    }
+}
+
+int32_t
+UnifiedCache::getTypeIndex(const UnifiedCacheType &type) {
+    for (int32_t i = 0; i < typeCount; ++i) {
+        if (typeStats[i].type == &type) {
+            return i;
+        }
+    }
+    if (typeCount == MAX_TYPES) {
+        return -1;  // Values of this type are created but not cached.
+    }
+    TypeStatistics &stats = typeStats[typeCount];
+    stats.type = &type;
+    umtx_storeRelease(stats.hits, 0);
+    umtx_storeRelease(stats.misses, 0);
+    umtx_storeRelease(stats.evictions, 0);
+    return typeCount++;
+}
+
+int32_t
+UnifiedCache::allocateEntry() {
+    if (liveCount >= maxEntries && !evictOne()) {
+        return -1;  // All entries are in progress.
+    }
+    if (freeList < 0) {
+        reclaimRetired();
+        if (freeList < 0) {
+            return -1;
+        }
+    }
+    if (4 * (usedSlots + 1) > 3 * (slotsMask + 1)) {
+        rebuildSlots();  // too many deleted slots
+    }
+    int32_t entryIndex = freeList;
+    freeList = entries[entryIndex].next;
+    return entryIndex;
+}
+
+void
+UnifiedCache::insertSlot(int32_t entryIndex) {
+    for (int32_t i = entries[entryIndex].hash & slotsMask;; i = (i + 1) & slotsMask) {
+        int32_t slot = umtx_loadAcquire(slots[i]);
+        if (slot <= 0) {
+            if (slot == 0) {
+                ++usedSlots;
+            }
+            umtx_storeRelease(slots[i], entryIndex + 1);
+            return;
+        }
+    }
+}
+
+void
+UnifiedCache::rebuildSlots() {
+    // Concurrent readers may miss entries while the table is rebuilt.
+    // They then look again on the locked path.
+    for (int32_t i = 0; i <= slotsMask; ++i) {
+        umtx_storeRelease(slots[i], 0);
+    }
+    usedSlots = 0;
+    for (int32_t e = 0; e < capacity; ++e) {
+        int32_t state = umtx_loadAcquire(entries[e].state);
+        if (state == ENTRY_IN_PROGRESS || state == ENTRY_READY) {
+            insertSlot(e);
+        }
+    }
+}
+
+UBool
+UnifiedCache::evictOne() {
+    // Two sweeps: The first may only clear referenced bits.
+    for (int32_t n = 2 * capacity; n > 0; --n) {
+        int32_t entryIndex = clockHand;
+        if (++clockHand == capacity) {
+            clockHand = 0;
+        }
+        Entry &entry = entries[entryIndex];
+        if (umtx_loadAcquire(entry.state) != ENTRY_READY) {
+            continue;
+        }
+        if (umtx_loadAcquire(entry.referenced) != 0) {
+            umtx_storeRelease(entry.referenced, 0);
+            continue;
+        }
+        umtx_atomic_inc(&typeStats[entry.typeIndex].evictions);
+        retire(entryIndex);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+void
+UnifiedCache::retire(int32_t entryIndex) {
+    Entry &entry = entries[entryIndex];
+    for (int32_t i = entry.hash & slotsMask;; i = (i + 1) & slotsMask) {
+        if (umtx_loadAcquire(slots[i]) == entryIndex + 1) {
+            umtx_storeRelease(slots[i], DELETED_SLOT);
+            break;
+        }
+    }
+    umtx_storeRelease(entry.state, ENTRY_RETIRED);
+    --liveCount;
+    entry.next = retiredList;
+    retiredList = entryIndex;
+}
+
+void
+UnifiedCache::reclaimRetired() {
+    if (retiredList < 0) {
+        return;
+    }
+    waitForReaders();
+    while (retiredList >= 0) {
+        Entry &entry = entries[retiredList];
+        retiredList = entry.next;
+        SharedObject::clearPtr(entry.value);
+        uprv_free(entry.localeId);
+        entry.localeId = NULL;
+        entry.type = NULL;
+        umtx_storeRelease(entry.state, ENTRY_FREE);
+        entry.next = freeList;
+        freeList = (int32_t)(&entry - entries);
+    }
+}
+
+void
+UnifiedCache::flush() {
+    Mutex lock(&gCacheMutex);
+    for (int32_t i = 0; i < capacity; ++i) {
+        if (umtx_loadAcquire(entries[i].state) == ENTRY_READY) {
+            retire(i);
+        }
+    }
+    reclaimRetired();
+}
+
+UBool
+UnifiedCache::getStatistics(const char *typeName,
+                            int32_t &hits, int32_t &misses, int32_t &evictions) const {
+    Mutex lock(&gCacheMutex);
+    for (int32_t i = 0; i < typeCount; ++i) {
+        TypeStatistics &stats = typeStats[i];
+        if (uprv_strcmp(stats.type->name, typeName) == 0) {
+            hits = umtx_loadAcquire(stats.hits);
+            misses = umtx_loadAcquire(stats.misses);
+            evictions = umtx_loadAcquire(stats.evictions);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+int32_t
+UnifiedCache::getEntryCount() const {
+    Mutex lock(&gCacheMutex);
+    return liveCount;
+}
+
+U_NAMESPACE_END
@@ -0,0 +1,176 @@
+/*
+******************************************************************************
+* Copyright (C) 2014, International Business Machines Corporation and
+* others. All Rights Reserved.
+******************************************************************************
+*
+* File UNIFIEDCACHE.H
+******************************************************************************
+*/
+
+#ifndef __UNIFIED_CACHE_H__
+#define __UNIFIED_CACHE_H__
+
+#include "unicode/uobject.h"
+#include "sharedobject.h"
+#include "umutex.h"
+
+U_NAMESPACE_BEGIN
+
+/**
+ * Creates the cached object for a locale ID.
+ * Returns a new object with a reference count of 0,
+ * or NULL and a failure code.
+ */
+typedef SharedObject *UnifiedCacheCreateFunc(const char *localeId, UErrorCode &status);
+
+/**
+ * Identifies one kind of cached data, for example NumberFormat or PluralRules.
+ * Entries of different types never match each other even if their
+ * locale IDs are equal.
+ * Statically initialize with U_UNIFIEDCACHE_TYPE_INITIALIZER.
+ */
+struct UnifiedCacheType {
+    /** Type name, used for statistics. */
+    const char *name;
+    UnifiedCacheCreateFunc *createFunc;
+};
+
+#define U_UNIFIEDCACHE_TYPE_INITIALIZER(name, createFunc) {name, createFunc}
+
+/**
+ * Process-wide cache of SharedObject data keyed by type and locale ID,
+ * shared by all services instead of one LRUCache plus mutex per service.
+ *
+ * Hits do not lock: They probe an open-addressing table of atomic slots and
+ * add a reference to the value. Readers announce themselves in one of two
+ * reader counters, selected by the parity of an epoch. Evicted entries are
+ * first unlinked from the table and retired; their memory and their values
+ * are released only after a grace period in which all readers of the old
+ * epoch have left.
+ *
+ * Misses lock a mutex. The first thread to miss on a key inserts an
+ * in-progress entry and creates the value without holding the mutex;
+ * other threads asking for the same key wait for it instead of creating
+ * duplicates. Creation failures are cached like values.
+ *
+ * The number of cached entries is bounded by a budget shared by all types.
+ * When it is reached, an entry is evicted with the CLOCK policy:
+ * Hits set a referenced bit, and the eviction sweep clears set bits and
+ * evicts the first entry without one.
+ *
+ * Hits, misses and evictions are counted per type.
+ *
+ * Values must not use the cache in their destructors,
+ * which may run while the cache mutex is held.
+ */
+class U_COMMON_API UnifiedCache : public UMemory {
+public:
+    /**
+     * Returns the process-wide cache.
+     */
+    static UnifiedCache *getInstance(UErrorCode &status);
+
+    /**
+     * Creates a cache that holds at most maxEntries entries.
+     * Normally, use the process-wide getInstance().
+     */
+    UnifiedCache(int32_t maxEntries, UErrorCode &status);
+    ~UnifiedCache();
+
+    /**
+     * Fetches the object of the given type for localeId, creating it on a miss.
+     * On success, ptr is made an owner of the object (see SharedObject::copyPtr()).
+     * On failure, ptr is unchanged.
+     *
+     * T must be the SharedObject subclass returned by type.createFunc.
+     */
+    template<typename T>
+    void get(const UnifiedCacheType &type, const char *localeId,
+             const T *&ptr, UErrorCode &status) {
+        if (U_FAILURE(status)) {
+            return;
+        }
+        const T *value = (const T *) _get(type, localeId, status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        // value already carries our reference.
+        if (ptr != NULL) {
+            ptr->removeRef();
+        }
+        ptr = value;
+    }
+
+    /**
+     * Gets the counters for the type with the given name.
+     * Returns FALSE if this cache has not seen that type.
+     */
+    UBool getStatistics(const char *typeName,
+                        int32_t &hits, int32_t &misses, int32_t &evictions) const;
+
+    /**
+     * Returns the number of entries, including ones still being created.
+     */
+    int32_t getEntryCount() const;
+
+    /**
+     * Returns the maximum number of entries.
+     */
+    int32_t getMaxEntries() const { return maxEntries; }
+
+    /**
+     * Evicts all entries whose values are not being created.
+     * Does not reset the statistics.
+     */
+    void flush();
+
+private:
+    struct Entry;
+    struct TypeStatistics;
+
+    UnifiedCache(const UnifiedCache &other);
+    UnifiedCache &operator=(const UnifiedCache &other);
+
+    const SharedObject *_get(const UnifiedCacheType &type, const char *localeId,
+                             UErrorCode &status);
+    UBool lookUp(const UnifiedCacheType &type, const char *localeId, int32_t hash,
+                 const SharedObject *&value, UErrorCode &status);
+
+    // The following require the cache mutex.
+    int32_t findEntry(const UnifiedCacheType &type, const char *localeId, int32_t hash) const;
+    int32_t getTypeIndex(const UnifiedCacheType &type);
+    int32_t allocateEntry();
+    void insertSlot(int32_t entryIndex);
+    void rebuildSlots();
+    UBool evictOne();
+    void retire(int32_t entryIndex);
+    void reclaimRetired();
+    void waitForReaders();
+
+    int32_t enterReader();
+    void exitReader(int32_t phase) { umtx_atomic_dec(&readers[phase]); }
+
+    int32_t maxEntries;
+    int32_t capacity;     // number of Entry structs, maxEntries plus room for retired ones
+    int32_t slotsMask;    // number of slots - 1
+
+    Entry *entries;
+    /** 0=empty, -1=deleted, otherwise entry index + 1. */
+    u_atomic_int32_t *slots;
+    TypeStatistics *typeStats;
+    int32_t typeCount;
+
+    int32_t liveCount;    // in-progress and ready entries
+    int32_t usedSlots;    // non-empty slots, including deleted ones
+    int32_t freeList;     // linked through Entry::next, -1 if empty
+    int32_t retiredList;  // linked through Entry::next, -1 if empty
+    int32_t clockHand;
+
+    u_atomic_int32_t epoch;
+    u_atomic_int32_t readers[2];
+};
+
+U_NAMESPACE_END
+
+#endif
@@ -47,13 +47,56 @@ static icu::UInitOnce gCacheInitOnce;
 
 static UMutex resbMutex = U_MUTEX_INITIALIZER;
 
+/*
+Lookup cache in front of entryOpen(), so that opening an already-loaded
+bundle does not lock resbMutex.
+It maps a (path, locale ID) pair to the UResourceDataEntry that entryOpen()
+returned for it, together with the returned status.
+Only results that do not depend on the default locale are added.
+
+The cache is split into shards by the hash of the key. Each shard holds
+up to URES_OPEN_CACHE_SHARD_CAPACITY entries; it only grows, under resbMutex,
+by storing a new entry pointer and then publishing the new length.
+Lookups read the length and the entries without locking, and count
+themselves in the shard's readers counter while they do.
+ures_flushCache() resets the lengths and waits for the readers counters to
+drop to zero before it frees the entries and any unused data entries.
+*/
+#define URES_OPEN_CACHE_SHARD_COUNT 16
+#define URES_OPEN_CACHE_SHARD_CAPACITY 32
+
+typedef struct UResOpenCacheEntry {
+    int32_t hashCode;
+    UErrorCode status;
+    UResourceDataEntry *entry;
+    char *path; /* NULL, or points into this struct's allocation */
+    char localeID[1]; /* variable length */
+} UResOpenCacheEntry;
+
+typedef struct U_CACHE_LINE_ALIGNED UResOpenCacheShard {
+    u_atomic_int32_t readers;
+    u_atomic_int32_t length;
+    UResOpenCacheEntry *entries[URES_OPEN_CACHE_SHARD_CAPACITY];
+} UResOpenCacheShard;
+
+static UResOpenCacheShard gOpenCacheShards[URES_OPEN_CACHE_SHARD_COUNT];
+
+/*
+UResourceDataEntry.fCountExisting is modified with atomic operations,
+so that bundles can be opened from the lookup cache and closed without
+locking resbMutex.
+*/
+static inline u_atomic_int32_t *entryCount(UResourceDataEntry *entry) {
+    return (u_atomic_int32_t *)&entry->fCountExisting;
+}
+
 /* INTERNAL: hashes an entry  */
 static int32_t U_CALLCONV hashEntry(const UHashTok parm) {
     UResourceDataEntry *b = (UResourceDataEntry *)parm.pointer;
     UHashTok namekey, pathkey;
     namekey.pointer = b->fName;
     pathkey.pointer = b->fPath;
-    return uhash_hashChars(namekey)+37*uhash_hashChars(pathkey);
+    return uhash_fastHashChars(namekey)+37*uhash_fastHashChars(pathkey);
 }
 
 /* INTERNAL: compares two entries */
@@ -89,13 +132,385 @@ static UBool chopLocale(char *name) {
  *  Internal function
  */
 static void entryIncrease(UResourceDataEntry *entry) {
-    umtx_lock(&resbMutex);
-    entry->fCountExisting++;
+    umtx_atomic_inc(entryCount(entry));
     while(entry->fParent != NULL) {
       entry = entry->fParent;
-      entry->fCountExisting++;
+      umtx_atomic_inc(entryCount(entry));
+    }
+}
+
+/*
+Cache of resolved ures_getByKeyWithFallback() paths.
+When a key path is not found in a resource table itself, or leads to an alias,
+ures_getByKeyWithFallback() looks for the table's path plus the key
+in each parent bundle, following aliases on the way, and then resolves
+the alias where the search ended.
+Each UResourceDataEntry has a table in fPathCache which maps
+"requested locale:table path/key" to the entry and Resource where that search
+ended, or to NULL if it failed, and for an alias, to the entry, Resource,
+key and resource path that the alias resolved to.
+The requested (top-level) locale is part of the key
+because "/LOCALE/" aliases are resolved relative to it.
+
+Items found directly in the table are not cached:
+Looking up a key in a table is about as fast as hashing and comparing the cache key.
+
+Cached entries must stay loaded as long as the entry that owns the cache.
+The owner's parents do anyway. For an entry further down the owner's fallback chain
+(where "/LOCALE/" aliases lead), the cache holds references to that entry
+and its parents below the owner, which free_entry() releases.
+Results in other bundles are not cached,
+so that the caches of two bundles cannot keep each other loaded.
+
+The tables are protected by reader/writer locks selected by the owner's address.
+Values are neither changed nor removed until the owner is freed.
+*/
+#define URES_PATH_CACHE_SHARD_COUNT 16
+
+typedef struct UResPathCacheValue {
+    UResourceDataEntry *found; /* where the path was found, NULL if it was not */
+    Resource res;
+    UBool isFallback; /* TRUE if found in a parent bundle */
+    UBool isFoundHeld; /* TRUE if found is below the owner, see pathCacheHold() */
+    UBool isTargetHeld;
+    /* What the alias in res resolved to. target==NULL if res is not an alias. */
+    UResourceDataEntry *target;
+    UResourceDataEntry *targetTopLevel;
+    const char *targetKey;
+    Resource targetRes;
+    int32_t targetResPathLength;
+    char targetResPath[1]; /* variable length */
+} UResPathCacheValue;
+
+typedef struct U_CACHE_LINE_ALIGNED UResPathCacheShard {
+    URWLock lock;
+    u_atomic_int32_t hits;
+    u_atomic_int32_t misses;
+} UResPathCacheShard;
+
+#define URES_PATH_CACHE_SHARD_INITIALIZER { \
+    U_RWLOCK_INITIALIZER, ATOMIC_INT32_T_INITIALIZER(0), ATOMIC_INT32_T_INITIALIZER(0) \
+}
+static UResPathCacheShard gPathCacheShards[URES_PATH_CACHE_SHARD_COUNT] = {
+    URES_PATH_CACHE_SHARD_INITIALIZER, URES_PATH_CACHE_SHARD_INITIALIZER,
+    URES_PATH_CACHE_SHARD_INITIALIZER, URES_PATH_CACHE_SHARD_INITIALIZER,
+    URES_PATH_CACHE_SHARD_INITIALIZER, URES_PATH_CACHE_SHARD_INITIALIZER,
+    URES_PATH_CACHE_SHARD_INITIALIZER, URES_PATH_CACHE_SHARD_INITIALIZER,
+    URES_PATH_CACHE_SHARD_INITIALIZER, URES_PATH_CACHE_SHARD_INITIALIZER,
+    URES_PATH_CACHE_SHARD_INITIALIZER, URES_PATH_CACHE_SHARD_INITIALIZER,
+    URES_PATH_CACHE_SHARD_INITIALIZER, URES_PATH_CACHE_SHARD_INITIALIZER,
+    URES_PATH_CACHE_SHARD_INITIALIZER, URES_PATH_CACHE_SHARD_INITIALIZER
+};
+
+static UResPathCacheShard *pathCacheShard(const UResourceDataEntry *entry) {
+    return gPathCacheShards + (((size_t)entry >> 4) % URES_PATH_CACHE_SHARD_COUNT);
+}
+
+/* INTERNAL: compares two path cache keys */
+static UBool U_CALLCONV comparePathCacheKeys(const UHashTok key1, const UHashTok key2) {
+    return (UBool)(uprv_strcmp((const char *)key1.pointer, (const char *)key2.pointer) == 0);
+}
+
+/**
+ *  Internal function, checks whether entry is start or one of its parents
+ */
+static UBool entryIsInChain(const UResourceDataEntry *start, const UResourceDataEntry *entry) {
+    while(start != NULL) {
+        if(start == entry) {
+            return TRUE;
+        }
+        start = start->fParent;
+    }
+    return FALSE;
+}
+
+/**
+ *  INTERNAL: Checks whether a path cache can refer to entry:
+ *  entry is NULL, or in the owner's fallback chain above or below it.
+ */
+static UBool pathCacheCanHold(const UResourceDataEntry *owner, const UResourceDataEntry *entry) {
+    return (UBool)(entry == NULL || entryIsInChain(owner, entry) || entryIsInChain(entry, owner));
+}
+
+/**
+ *  INTERNAL: Checks whether entry is below owner in its fallback chain.
+ */
+static UBool pathCacheMustHold(const UResourceDataEntry *owner, const UResourceDataEntry *entry) {
+    return (UBool)(entry != NULL && entry != owner && entryIsInChain(entry, owner));
+}
+
+/**
+ *  INTERNAL: Increments or decrements the reference counts of entry and its parents
+ *  below owner, where pathCacheMustHold(owner, entry).
+ *  Does not look at owner's parents: ures_flushCache() may have freed them
+ *  when owner is freed.
+ */
+static void pathCacheHold(const UResourceDataEntry *owner, UResourceDataEntry *entry, UBool hold) {
+    while(entry != owner) {
+        if(hold) {
+            umtx_atomic_inc(entryCount(entry));
+        } else {
+            umtx_atomic_dec(entryCount(entry));
+        }
+        entry = entry->fParent;
+    }
+}
+
+/**
+ *  INTERNAL: Writes the path cache key for inKey in resB into buffer.
+ *  Returns NULL if it does not fit.
+ */
+static const char *pathCacheKey(const UResourceBundle *resB, const char *inKey,
+                                char *buffer, int32_t capacity) {
+    const char *topLevelName = resB->fTopLevelData->fName;
+    int32_t nameLength = (int32_t)uprv_strlen(topLevelName);
+    int32_t keyLength = (int32_t)uprv_strlen(inKey);
+    if(nameLength + 1 + resB->fResPathLen + keyLength >= capacity) {
+        return NULL;
+    }
+    uprv_memcpy(buffer, topLevelName, nameLength);
+    buffer[nameLength++] = ':';
+    if(resB->fResPathLen > 0) {
+        uprv_memcpy(buffer + nameLength, resB->fResPath, resB->fResPathLen);
+    }
+    uprv_memcpy(buffer + nameLength + resB->fResPathLen, inKey, keyLength + 1);
+    return buffer;
+}
+
+/**
+ *  INTERNAL: Looks up a resolved path in the entry's path cache.
+ *  Counts a hit or a miss.
+ */
+static const UResPathCacheValue *pathCacheGet(UResourceDataEntry *entry, const char *key) {
+    UResPathCacheShard *shard = pathCacheShard(entry);
+    const UResPathCacheValue *value = NULL;
+
+    umtx_rdlock(&shard->lock);
+    if(entry->fPathCache != NULL) {
+        value = (const UResPathCacheValue *)uhash_get(entry->fPathCache, key);
+    }
+    umtx_rdunlock(&shard->lock);
+    umtx_atomic_inc(value != NULL ? &shard->hits : &shard->misses);
+    return value;
+}
+
+/**
+ *  INTERNAL: Adds a resolved path to the entry's path cache.
+ *  resolved is the bundle that the alias in res resolved to, or NULL.
+ *  Does nothing if a result is in another bundle, or on memory allocation failure.
+ */
+static void pathCachePut(UResourceDataEntry *entry, const char *key,
+                         UResourceDataEntry *found, Resource res, UBool isFallback,
+                         const UResourceBundle *resolved) {
+    UResPathCacheShard *shard = pathCacheShard(entry);
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UResourceDataEntry *target = resolved != NULL ? resolved->fData : NULL;
+    int32_t resPathLength = resolved != NULL ? resolved->fResPathLen : 0;
+    char *keyCopy;
+    UResPathCacheValue *value;
+
+    if(!pathCacheCanHold(entry, found) || !pathCacheCanHold(entry, target)) {
+        return;
+    }
+    keyCopy = uprv_strdup(key);
+    value = (UResPathCacheValue *)uprv_malloc(sizeof(UResPathCacheValue) + resPathLength);
+    if(keyCopy == NULL || value == NULL) {
+        uprv_free(keyCopy);
+        uprv_free(value);
+        return;
+    }
+    value->found = found;
+    value->res = res;
+    value->isFallback = isFallback;
+    value->isFoundHeld = pathCacheMustHold(entry, found);
+    value->isTargetHeld = pathCacheMustHold(entry, target);
+    value->target = target;
+    if(resolved != NULL) {
+        value->targetTopLevel = resolved->fTopLevelData;
+        value->targetKey = resolved->fKey;
+        value->targetRes = resolved->fRes;
+        if(resPathLength > 0) {
+            uprv_memcpy(value->targetResPath, resolved->fResPath, resPathLength);
+        }
+    }
+    value->targetResPathLength = resPathLength;
+    value->targetResPath[resPathLength] = 0;
+
+    umtx_wrlock(&shard->lock);
+    if(entry->fPathCache == NULL) {
+        entry->fPathCache = uhash_open(uhash_fastHashChars, comparePathCacheKeys, NULL, &errorCode);
+        if(U_SUCCESS(errorCode)) {
+            uhash_setKeyDeleter(entry->fPathCache, uprv_free);
+            uhash_setValueDeleter(entry->fPathCache, uprv_free);
+        } else {
+            entry->fPathCache = NULL;
+        }
+    }
+    if(entry->fPathCache != NULL && uhash_get(entry->fPathCache, key) == NULL) {
+        uhash_put(entry->fPathCache, keyCopy, value, &errorCode);
+        if(U_SUCCESS(errorCode)) {
+            if(value->isFoundHeld) {
+                pathCacheHold(entry, found, TRUE);
+            }
+            if(value->isTargetHeld) {
+                pathCacheHold(entry, target, TRUE);
+            }
+        }
+        keyCopy = NULL;
+        value = NULL;
+    }
+    umtx_wrunlock(&shard->lock);
+    uprv_free(keyCopy);
+    uprv_free(value);
+}
+
+/**
+ *  INTERNAL: Releases the references that the entry's path cache holds.
+ *  Called when the entry is freed.
+ */
+static void pathCacheRelease(UResourceDataEntry *entry) {
+    int32_t pos = -1;
+    const UHashElement *e;
+    while((e = uhash_nextElement(entry->fPathCache, &pos)) != NULL) {
+        UResPathCacheValue *value = (UResPathCacheValue *)e->value.pointer;
+        if(value->isFoundHeld) {
+            pathCacheHold(entry, value->found, FALSE);
+        }
+        if(value->isTargetHeld) {
+            pathCacheHold(entry, value->target, FALSE);
+        }
+    }
+}
+
+U_CAPI void U_EXPORT2
+ures_getPathCacheStatistics(int32_t *hits, int32_t *misses) {
+    int32_t i;
+    *hits = *misses = 0;
+    for(i = 0; i < URES_PATH_CACHE_SHARD_COUNT; ++i) {
+        UResPathCacheShard *shard = gPathCacheShards + i;
+        *hits += umtx_loadAcquire(shard->hits);
+        *misses += umtx_loadAcquire(shard->misses);
+    }
+}
+
+static int32_t openCacheHash(const char *path, const char *localeID) {
+    UHashTok namekey, pathkey;
+    namekey.pointer = (void *)localeID;
+    pathkey.pointer = (void *)path;
+    return uhash_fastHashChars(namekey)+37*uhash_fastHashChars(pathkey);
+}
+
+static UResOpenCacheShard *openCacheShard(int32_t hashCode) {
+    return gOpenCacheShards + ((uint32_t)hashCode % URES_OPEN_CACHE_SHARD_COUNT);
+}
+
+/* INTERNAL: finds an entry in a shard of the open cache */
+static UResOpenCacheEntry *openCacheFind(UResOpenCacheShard *shard, int32_t hashCode,
+                                         const char *path, const char *localeID) {
+    int32_t length = umtx_loadAcquire(shard->length);
+    int32_t i;
+    for(i = 0; i < length; ++i) {
+        UResOpenCacheEntry *e = shard->entries[i];
+        if(e->hashCode == hashCode &&
+            uprv_strcmp(e->localeID, localeID) == 0 &&
+            (path == NULL ? e->path == NULL : (e->path != NULL && uprv_strcmp(e->path, path) == 0))
+        ) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/**
+ *  INTERNAL: Looks up a previous result of entryOpen() without locking.
+ *  If found, increases the reference counts of the entry and its parents
+ *  as entryOpen() does, and sets a warning status like entryOpen() did.
+ */
+static UResourceDataEntry *openCacheGet(const char *path, const char *localeID, UErrorCode *status) {
+    int32_t hashCode = openCacheHash(path, localeID);
+    UResOpenCacheShard *shard = openCacheShard(hashCode);
+    UResourceDataEntry *r = NULL;
+    UResOpenCacheEntry *e;
+
+    umtx_atomic_inc(&shard->readers);
+    e = openCacheFind(shard, hashCode, path, localeID);
+    if(e != NULL) {
+        r = e->entry;
+        entryIncrease(r);
+        if(e->status != U_ZERO_ERROR) {
+            *status = e->status;
+        }
+    }
+    umtx_atomic_dec(&shard->readers);
+    return r;
+}
+
+/**
+ *  INTERNAL: Adds a result of entryOpen() to the open cache.
+ *  Does nothing if the shard is full or on memory allocation failure.
+ *    CAUTION:  resbMutex must be locked when calling this function.
+ */
+static void openCachePut(const char *path, const char *localeID,
+                         UResourceDataEntry *r, UErrorCode status) {
+    int32_t hashCode = openCacheHash(path, localeID);
+    UResOpenCacheShard *shard = openCacheShard(hashCode);
+    int32_t length = umtx_loadAcquire(shard->length);
+    int32_t localeIDLength, pathLength;
+    UResOpenCacheEntry *e;
+
+    if(length >= URES_OPEN_CACHE_SHARD_CAPACITY ||
+        openCacheFind(shard, hashCode, path, localeID) != NULL
+    ) {
+        return;
+    }
+    localeIDLength = (int32_t)uprv_strlen(localeID);
+    pathLength = path == NULL ? 0 : (int32_t)uprv_strlen(path) + 1;
+    e = (UResOpenCacheEntry *)uprv_malloc(sizeof(UResOpenCacheEntry) + localeIDLength + pathLength);
+    if(e == NULL) {
+        return;
+    }
+    e->hashCode = hashCode;
+    e->status = status;
+    e->entry = r;
+    uprv_strcpy(e->localeID, localeID);
+    if(path != NULL) {
+        e->path = e->localeID + localeIDLength + 1;
+        uprv_strcpy(e->path, path);
+    } else {
+        e->path = NULL;
+    }
+    shard->entries[length] = e;
+    umtx_storeRelease(shard->length, length + 1);
+}
+
+/**
+ *  INTERNAL: Empties the open cache.
+ *  When this function returns, no lookup is using any of the removed entries.
+ *    CAUTION:  resbMutex must be locked when calling this function.
+ */
+static void openCacheClear() {
+    int32_t i, j;
+    for(i = 0; i < URES_OPEN_CACHE_SHARD_COUNT; ++i) {
+        UResOpenCacheShard *shard = gOpenCacheShards + i;
+        int32_t length = umtx_loadAcquire(shard->length);
+        if(length == 0) {
+            continue;
+        }
+        umtx_storeRelease(shard->length, 0);
+        /*
+         * Wait until no lookup is running in this shard.
+         * A lookup that starts after the readers counter was seen at zero
+         * also sees the new length.
+         */
+        while(umtx_atomic_inc(&shard->readers) != 1) {
+            umtx_atomic_dec(&shard->readers);
+        }
+        umtx_atomic_dec(&shard->readers);
+        for(j = 0; j < length; ++j) {
+            uprv_free(shard->entries[j]);
+            shard->entries[j] = NULL;
+        }
     }
-    umtx_unlock(&resbMutex);
 }
 
 /**
@@ -152,15 +567,19 @@ free_entry(UResourceDataEntry *entry) {
     if(entry->fPath != NULL) {
         uprv_free(entry->fPath);
     }
+    if(entry->fPathCache != NULL) {
+        pathCacheRelease(entry);
+        uhash_close(entry->fPathCache);
+    }
     if(entry->fPool != NULL) {
-        --entry->fPool->fCountExisting;
+        umtx_atomic_dec(entryCount(entry->fPool));
     }
     alias = entry->fAlias;
     if(alias != NULL) {
         while(alias->fAlias != NULL) {
             alias = alias->fAlias;
         }
-        --alias->fCountExisting;
+        umtx_atomic_dec(entryCount(alias));
     }
     uprv_free(entry);
 }
@@ -183,6 +602,9 @@ static int32_t ures_flushCache()
         return 0;
     }
 
+    /* Remove the lookup shortcuts first, so that no reference counts increase any more. */
+    openCacheClear();
+
     do {
         deletedMore = FALSE;
         /*creates an enumeration to iterate through every element in the table */
@@ -199,7 +621,7 @@ static int32_t ures_flushCache()
             /* 04/05/2002 [weiv] fCountExisting should now be accurate. If it's not zero, that means that    */
             /* some resource bundles are still open somewhere. */
 
-            if (resB->fCountExisting == 0) {
+            if (umtx_loadAcquire(*entryCount(resB)) == 0) {
                 rbDeletedNum++;
                 deletedMore = TRUE;
                 uhash_removeElement(cache, e);
@@ -422,7 +844,7 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
         while(r->fAlias != NULL) {
             r = r->fAlias;
         }
-        r->fCountExisting++; /* we increase its reference count */
+        umtx_atomic_inc(entryCount(r)); /* we increase its reference count */
         /* if the resource has a warning */
         /* we don't want to overwrite a status with no error */
         if(r->fBogus != U_ZERO_ERROR && U_SUCCESS(*status)) {
@@ -465,7 +887,7 @@ static UResourceDataEntry *findFirstExisting(const char* path, char* name, UBool
             /* not to be used - as there might be parent   */
             /* lines in cache from previous openings that  */
             /* are not updated yet. */
-            r->fCountExisting--;
+            umtx_atomic_dec(entryCount(r));
             /*entryCloseInt(r);*/
             r = NULL;
             *status = U_USING_FALLBACK_WARNING;
@@ -525,6 +947,11 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID, UEr
         return NULL;
     }
 
+    r = openCacheGet(path, localeID, status);
+    if(r != NULL) {
+        return r;
+    }
+
     uprv_strncpy(name, localeID, sizeof(name) - 1);
     name[sizeof(name) - 1] = 0;
 
@@ -556,7 +983,7 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID, UEr
                    r = u1;
                  } else {
                    /* the USR override data wasn't found, set it to be deleted */
-                   u1->fCountExisting = 0;
+                   umtx_storeRelease(*entryCount(u1), 0);
                  }
                }
             }
@@ -591,7 +1018,7 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID, UEr
                     t1->fParent = t2;
                     if(usingUSRData) {
                         /* the USR override data wasn't found, set it to be deleted */
-                        u2->fCountExisting = 0;
+                        umtx_storeRelease(*entryCount(u2), 0);
                     }
                 }
                 t1 = t2;
@@ -669,10 +1096,17 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID, UEr
         }
 
         while(r != NULL && !isRoot && t1->fParent != NULL) {
-            t1->fParent->fCountExisting++;
+            umtx_atomic_inc(entryCount(t1->fParent));
             t1 = t1->fParent;
             hasRealData = (UBool)((t1->fBogus == U_ZERO_ERROR) || hasRealData);
         }
+
+        /* remember the result, unless it depends on the default locale */
+        if(U_SUCCESS(*status) && U_SUCCESS(parentStatus) &&
+            (intStatus == U_ZERO_ERROR || intStatus == U_USING_FALLBACK_WARNING)
+        ) {
+            openCachePut(path, localeID, r, intStatus);
+        }
     } /* umtx_lock */
 finishUnlock:
     umtx_unlock(&resbMutex);
@@ -695,15 +1129,15 @@ finishUnlock:
 
 /**
  * Functions to create and destroy resource bundles.
- *     CAUTION:  resbMutex must be locked when calling this function.
  */
 /* INTERNAL: */
 static void entryCloseInt(UResourceDataEntry *resB) {
     UResourceDataEntry *p = resB;
 
     while(resB != NULL) {
+        /* read the parent first: resB may be flushed as soon as its count is decremented */
         p = resB->fParent;
-        resB->fCountExisting--;
+        umtx_atomic_dec(entryCount(resB));
 
         /* Entries are left in the cache. TODO: add ures_flushCache() to force a flush
          of the cache. */
@@ -732,9 +1166,7 @@ static void entryCloseInt(UResourceDataEntry *resB) {
  */
 
 static void entryClose(UResourceDataEntry *resB) {
-  umtx_lock(&resbMutex);
   entryCloseInt(resB);
-  umtx_unlock(&resbMutex);
 }
 
 /*
@@ -1709,14 +2141,136 @@ static Resource getTableItemByKeyPath(const ResourceData *pResData, Resource tab
   return resource;
 }
 
+/**
+ *  INTERNAL: Sets the warning status for a resource found in a parent bundle.
+ */
+static void setFallbackWarning(const UResourceDataEntry *dataEntry, UErrorCode *status) {
+    if(uprv_strcmp(dataEntry->fName, uloc_getDefault())==0 || uprv_strcmp(dataEntry->fName, kRootLocaleName)==0) {
+        *status = U_USING_DEFAULT_WARNING;
+    } else {
+        *status = U_USING_FALLBACK_WARNING;
+    }
+}
+
+/**
+ *  INTERNAL: Returns the result of ures_getByKeyWithFallback() from its path cache value.
+ */
+static UResourceBundle *pathCacheResult(const UResPathCacheValue *value,
+                                        const UResourceBundle *resB, const char *inKey,
+                                        UResourceBundle *fillIn, UErrorCode *status) {
+    if(value->found == NULL) {
+        *status = U_MISSING_RESOURCE_ERROR;
+        return fillIn;
+    }
+    if(value->isFallback) {
+        setFallbackWarning(value->found, status);
+    }
+    if(value->target == NULL) {
+        return init_resb_result(&(value->found->fData), value->res, inKey, -1, value->found, resB, 0, fillIn, status);
+    } else {
+        /* Stand-in for the bundle in which the alias was resolved. */
+        UResourceBundle parent;
+        ures_initStackObject(&parent);
+        parent.fTopLevelData = value->targetTopLevel;
+        if(value->targetResPathLength > 0) {
+            parent.fResPath = (char *)value->targetResPath;
+            parent.fResPathLen = value->targetResPathLength;
+        }
+        fillIn = init_resb_result(&(value->target->fData), value->targetRes, NULL, -1, value->target, &parent, 0, fillIn, status);
+        if(U_SUCCESS(*status) && fillIn != NULL) {
+            fillIn->fKey = value->targetKey;
+        }
+        return fillIn;
+    }
+}
+
+/**
+ *  INTERNAL: ures_getByKeyWithFallback() for a key path that is not found
+ *  in the table itself (res==RES_BOGUS), or that leads to an alias.
+ *  Looks in the parent bundles and resolves aliases, using the path cache.
+ */
+static UResourceBundle *getByKeyWithFallbackAndAlias(const UResourceBundle *resB, const char *inKey,
+                                                     Resource res, UResourceBundle *fillIn,
+                                                     UErrorCode *status) {
+    Resource rootRes = RES_BOGUS;
+    UResourceBundle *helper = NULL;
+    const char* key = inKey;
+    /* fillIn may be resB: Remember what is needed from resB after init_resb_result(). */
+    UResourceDataEntry *owner = resB->fData;
+    UResourceDataEntry *dataEntry = resB->fData;
+    UBool isFallback = (UBool)(res == RES_BOGUS);
+    char cacheKeyBuffer[URES_MAX_BUFFER_SIZE];
+    const char *cacheKey = pathCacheKey(resB, inKey, cacheKeyBuffer, (int32_t)sizeof(cacheKeyBuffer));
+    const UResPathCacheValue *cached = NULL;
+    if(cacheKey != NULL) {
+        cached = pathCacheGet(owner, cacheKey);
+    }
+    if(cached != NULL) {
+        return pathCacheResult(cached, resB, inKey, fillIn, status);
+    }
+    char path[256];
+    char* myPath = path;
+    const char* resPath = resB->fResPath;
+    int32_t len = resB->fResPathLen;
+    while(res == RES_BOGUS && dataEntry->fParent != NULL) { /* Otherwise, we'll look in parents */
+        dataEntry = dataEntry->fParent;
+        rootRes = dataEntry->fData.rootRes;
+
+        if(dataEntry->fBogus == U_ZERO_ERROR) {
+            if (len > 0) {
+                uprv_memcpy(path, resPath, len);
+            }
+            uprv_strcpy(path+len, inKey);
+            myPath = path;
+            key = inKey;
+            do {
+                res = res_findResource(&(dataEntry->fData), rootRes, &myPath, &key);
+                if (RES_GET_TYPE(res) == URES_ALIAS && *myPath) {
+                    /* We hit an alias, but we didn't finish following the path. */
+                    helper = init_resb_result(&(dataEntry->fData), res, NULL, -1, dataEntry, resB, 0, helper, status); 
+                    /*helper = init_resb_result(&(dataEntry->fData), res, inKey, -1, dataEntry, resB, 0, helper, status);*/
+                    if(helper) {
+                      dataEntry = helper->fData;
+                      rootRes = helper->fRes;
+                      resPath = helper->fResPath;
+                      len = helper->fResPathLen;
+
+                    } else {
+                      break;
+                    }
+                }
+            } while(*myPath); /* Continue until the whole path is consumed */
+        }
+    }
+    UBool isCacheable = (UBool)(cacheKey != NULL && U_SUCCESS(*status));
+    /*const ResourceData *rd = getFallbackData(resB, &key, &realData, &res, status);*/
+    if(res != RES_BOGUS) {
+      /* check if resB->fResPath gives the right name here */
+        if(isFallback) {
+            setFallbackWarning(dataEntry, status);
+        }
+
+        fillIn = init_resb_result(&(dataEntry->fData), res, inKey, -1, dataEntry, resB, 0, fillIn, status);
+        if(isCacheable && U_SUCCESS(*status) && fillIn != NULL) {
+            pathCachePut(owner, cacheKey, dataEntry, res, isFallback,
+                         RES_GET_TYPE(res) == URES_ALIAS ? fillIn : NULL);
+        }
+    } else {
+        *status = U_MISSING_RESOURCE_ERROR;
+        if(isCacheable) {
+            pathCachePut(owner, cacheKey, NULL, RES_BOGUS, isFallback, NULL);
+        }
+    }
+    ures_close(helper);
+    return fillIn;
+}
+
 U_CAPI UResourceBundle* U_EXPORT2 
 ures_getByKeyWithFallback(const UResourceBundle *resB, 
                           const char* inKey, 
                           UResourceBundle *fillIn, 
                           UErrorCode *status) {
-    Resource res = RES_BOGUS, rootRes = RES_BOGUS;
-    /*UResourceDataEntry *realData = NULL;*/
-    UResourceBundle *helper = NULL;
+    Resource res = RES_BOGUS;
 
     if (status==NULL || U_FAILURE(*status)) {
         return fillIn;
@@ -1730,55 +2284,8 @@ ures_getByKeyWithFallback(const UResourceBundle *resB,
     if(URES_IS_TABLE(type)) {
         res = getTableItemByKeyPath(&(resB->fResData), resB->fRes, inKey);
         const char* key = inKey;
-        if(res == RES_BOGUS) {
-            UResourceDataEntry *dataEntry = resB->fData;
-            char path[256];
-            char* myPath = path;
-            const char* resPath = resB->fResPath;
-            int32_t len = resB->fResPathLen;
-            while(res == RES_BOGUS && dataEntry->fParent != NULL) { /* Otherwise, we'll look in parents */
-                dataEntry = dataEntry->fParent;
-                rootRes = dataEntry->fData.rootRes;
-
-                if(dataEntry->fBogus == U_ZERO_ERROR) {
-                    if (len > 0) {
-                        uprv_memcpy(path, resPath, len);
-                    }
-                    uprv_strcpy(path+len, inKey);
-                    myPath = path;
-                    key = inKey;
-                    do {
-                        res = res_findResource(&(dataEntry->fData), rootRes, &myPath, &key);
-                        if (RES_GET_TYPE(res) == URES_ALIAS && *myPath) {
-                            /* We hit an alias, but we didn't finish following the path. */
-                            helper = init_resb_result(&(dataEntry->fData), res, NULL, -1, dataEntry, resB, 0, helper, status); 
-                            /*helper = init_resb_result(&(dataEntry->fData), res, inKey, -1, dataEntry, resB, 0, helper, status);*/
-                            if(helper) {
-                              dataEntry = helper->fData;
-                              rootRes = helper->fRes;
-                              resPath = helper->fResPath;
-                              len = helper->fResPathLen;
-
-                            } else {
-                              break;
-                            }
-                        }
-                    } while(*myPath); /* Continue until the whole path is consumed */
-                }
-            }
-            /*const ResourceData *rd = getFallbackData(resB, &key, &realData, &res, status);*/
-            if(res != RES_BOGUS) {
-              /* check if resB->fResPath gives the right name here */
-                if(uprv_strcmp(dataEntry->fName, uloc_getDefault())==0 || uprv_strcmp(dataEntry->fName, kRootLocaleName)==0) {
-                    *status = U_USING_DEFAULT_WARNING;
-                } else {
-                    *status = U_USING_FALLBACK_WARNING;
-                }
-
-                fillIn = init_resb_result(&(dataEntry->fData), res, inKey, -1, dataEntry, resB, 0, fillIn, status);
-            } else {
-                *status = U_MISSING_RESOURCE_ERROR;
-            }
+        if(res == RES_BOGUS || RES_GET_TYPE(res) == URES_ALIAS) {
+            fillIn = getByKeyWithFallbackAndAlias(resB, inKey, res, fillIn, status);
         } else {
             fillIn = init_resb_result(&(resB->fResData), res, key, -1, resB->fData, resB, 0, fillIn, status);
         }
@@ -1786,7 +2293,6 @@ ures_getByKeyWithFallback(const UResourceBundle *resB,
     else {
         *status = U_RESOURCE_TYPE_MISMATCH;
     }
-    ures_close(helper);
     return fillIn;
 }
 
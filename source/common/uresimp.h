@@ -60,8 +60,9 @@ struct UResourceDataEntry {
     UResourceDataEntry *fPool;
     ResourceData fData; /* data for low level access */
     char fNameBuffer[3]; /* A small buffer of free space for fName. The free space is due to struct padding. */
-    uint32_t fCountExisting; /* how much is this resource used */
+    uint32_t fCountExisting; /* how much is this resource used; modified atomically in uresbund.cpp */
     UErrorCode fBogus;
+    struct UHashtable *fPathCache; /* resolved ures_getByKeyWithFallback() paths, see uresbund.cpp */
     /* int32_t fHashKey;*/ /* for faster access in the hashtable */
 };
 
@@ -202,6 +203,17 @@ ures_getByKeyWithFallback(const UResourceBundle *resB,
                           UErrorCode *status);
 
 
+/**
+ * Get statistics for the cache of resolved ures_getByKeyWithFallback() paths.
+ * A lookup that is not found in the top resource table itself
+ * either hits the cache, or it misses and searches the parent bundles.
+ * The counts are cumulative since the process started.
+ * @param hits              fills in the number of lookups that were found in the cache
+ * @param misses            fills in the number of lookups that searched the parent bundles
+ */
+U_CAPI void U_EXPORT2
+ures_getPathCacheStatistics(int32_t *hits, int32_t *misses);
+
 /**
  * Get a String with multi-level fallback. Normally only the top level resources will
  * fallback to its parent. This performs fallback on subresources. For example, when a table
@@ -208,6 +208,22 @@ ustr_hashCharsN(const char *str, int32_t length);
 U_CAPI int32_t U_EXPORT2
 ustr_hashICharsN(const char *str, int32_t length);
 
+/**
+ * Word-at-a-time hash of all length units of str, for hash table keys.
+ * Slower to set up than ustr_hashUCharsN() for very short strings,
+ * but much faster and collision-resistant for long ones.
+ * The value is platform-dependent and must not be stored.
+ */
+U_CAPI int32_t U_EXPORT2
+ustr_fastHashUCharsN(const UChar *str, int32_t length);
+
+/**
+ * Word-at-a-time hash of all length bytes of str.
+ * @see ustr_fastHashUCharsN
+ */
+U_CAPI int32_t U_EXPORT2
+ustr_fastHashCharsN(const char *str, int32_t length);
+
 /**
  * NUL-terminate a UChar * string if possible.
  * If length  < destCapacity then NUL-terminate.
@@ -1514,3 +1514,75 @@ U_CAPI int32_t U_EXPORT2
 ustr_hashICharsN(const char *str, int32_t length) {
     STRING_HASH(char, str, length, (uint8_t)uprv_tolower(*p));
 }
+
+/*
+  Word-at-a-time hash for hash table keys, after xxHash64.
+  Unlike STRING_HASH, every byte contributes, so long keys that differ
+  only in skipped characters (paths, long locale IDs) do not collide.
+  Eight bytes are mixed per step; uprv_memcpy() compiles to an
+  unaligned load.  The value depends on the byte order of the
+  platform and must not be stored.
+*/
+
+#define FAST_HASH_PRIME_1 UINT64_C(0x9E3779B185EBCA87)
+#define FAST_HASH_PRIME_2 UINT64_C(0xC2B2AE3D27D4EB4F)
+#define FAST_HASH_PRIME_3 UINT64_C(0x165667B19E3779F9)
+#define FAST_HASH_PRIME_4 UINT64_C(0x85EBCA77C2B2AE63)
+#define FAST_HASH_PRIME_5 UINT64_C(0x27D4EB2F165667C5)
+
+static inline uint64_t
+fastHashRotate(uint64_t x, int32_t r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t
+fastHashMixWord(uint64_t h, uint64_t w) {
+    w = fastHashRotate(w * FAST_HASH_PRIME_2, 31) * FAST_HASH_PRIME_1;
+    return fastHashRotate(h ^ w, 27) * FAST_HASH_PRIME_1 + FAST_HASH_PRIME_4;
+}
+
+static int32_t
+fastHashBytes(const uint8_t *s, int32_t length) {
+    uint64_t h = FAST_HASH_PRIME_5 + (uint64_t)length;
+    uint64_t w;
+    while (length >= 8) {
+        uprv_memcpy(&w, s, 8);
+        h = fastHashMixWord(h, w);
+        s += 8;
+        length -= 8;
+    }
+    if (length >= 4) {
+        /* 4..7 remaining bytes in two overlapping loads */
+        uint32_t lo, hi;
+        uprv_memcpy(&lo, s, 4);
+        uprv_memcpy(&hi, s + length - 4, 4);
+        h = fastHashMixWord(h, ((uint64_t)hi << 32) | lo);
+    } else if (length > 0) {
+        /* 1..3 remaining bytes: first, middle and last cover all of them */
+        w = ((uint64_t)s[0] << 16) | ((uint64_t)s[length >> 1] << 8) | s[length - 1];
+        h = fastHashMixWord(h, w);
+    }
+    /* final avalanche */
+    h ^= h >> 33;
+    h *= FAST_HASH_PRIME_2;
+    h ^= h >> 29;
+    h *= FAST_HASH_PRIME_3;
+    h ^= h >> 32;
+    return (int32_t)h;
+}
+
+U_CAPI int32_t U_EXPORT2
+ustr_fastHashUCharsN(const UChar *str, int32_t length) {
+    if (str == NULL) {
+        return 0;
+    }
+    return fastHashBytes((const uint8_t *)str, length * U_SIZEOF_UCHAR);
+}
+
+U_CAPI int32_t U_EXPORT2
+ustr_fastHashCharsN(const char *str, int32_t length) {
+    if (str == NULL) {
+        return 0;
+    }
+    return fastHashBytes((const uint8_t *)str, length);
+}
@@ -0,0 +1,238 @@
+/*
+**********************************************************************
+*   Copyright (C) 2014, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+**********************************************************************
+*   file name:  ustrsimd.c
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   created on: 2014jun02
+*
+*   Block-oriented helper functions, see ustrsimd.h.
+*   With SSE2, 16 code units are tested per step.
+*   Otherwise, a portable loop tests several code units at a time.
+*/
+
+#include "unicode/utypes.h"
+#include "unicode/utf8.h"
+#include "unicode/utf16.h"
+#include "ustrsimd.h"
+
+#if U_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+U_CFUNC int32_t
+uprv_copyASCIIToUChars(UChar *dest, const uint8_t *src, int32_t length) {
+    int32_t i=0;
+#if U_HAVE_SSE2
+    const __m128i zero=_mm_setzero_si128();
+    while(i<=(length-16)) {
+        __m128i bytes=_mm_loadu_si128((const __m128i *)(src+i));
+        if(_mm_movemask_epi8(bytes)!=0) {
+            break;  /* at least one non-ASCII byte */
+        }
+        _mm_storeu_si128((__m128i *)(dest+i), _mm_unpacklo_epi8(bytes, zero));
+        _mm_storeu_si128((__m128i *)(dest+i+8), _mm_unpackhi_epi8(bytes, zero));
+        i+=16;
+    }
+#else
+    while(i<=(length-4) && ((src[i]|src[i+1]|src[i+2]|src[i+3])&0x80)==0) {
+        dest[i]=src[i];
+        dest[i+1]=src[i+1];
+        dest[i+2]=src[i+2];
+        dest[i+3]=src[i+3];
+        i+=4;
+    }
+#endif
+    while(i<length && src[i]<=0x7f) {
+        dest[i]=src[i];
+        ++i;
+    }
+    return i;
+}
+
+U_CFUNC int32_t
+uprv_countASCII(const uint8_t *src, int32_t length) {
+    int32_t i=0;
+#if U_HAVE_SSE2
+    while(i<=(length-16)) {
+        if(_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(src+i)))!=0) {
+            break;
+        }
+        i+=16;
+    }
+#else
+    while(i<=(length-4) && ((src[i]|src[i+1]|src[i+2]|src[i+3])&0x80)==0) {
+        i+=4;
+    }
+#endif
+    while(i<length && src[i]<=0x7f) {
+        ++i;
+    }
+    return i;
+}
+
+U_CFUNC int32_t
+uprv_copyUCharsToASCII(uint8_t *dest, const UChar *src, int32_t length) {
+    int32_t i=0;
+#if U_HAVE_SSE2
+    const __m128i nonASCIIMask=_mm_set1_epi16((short)0xff80);
+    const __m128i zero=_mm_setzero_si128();
+    while(i<=(length-16)) {
+        __m128i units0=_mm_loadu_si128((const __m128i *)(src+i));
+        __m128i units1=_mm_loadu_si128((const __m128i *)(src+i+8));
+        __m128i nonASCII=_mm_and_si128(_mm_or_si128(units0, units1), nonASCIIMask);
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(nonASCII, zero))!=0xffff) {
+            break;  /* at least one non-ASCII UChar */
+        }
+        _mm_storeu_si128((__m128i *)(dest+i), _mm_packus_epi16(units0, units1));
+        i+=16;
+    }
+#else
+    while(i<=(length-4) && ((src[i]|src[i+1]|src[i+2]|src[i+3])&0xff80)==0) {
+        dest[i]=(uint8_t)src[i];
+        dest[i+1]=(uint8_t)src[i+1];
+        dest[i+2]=(uint8_t)src[i+2];
+        dest[i+3]=(uint8_t)src[i+3];
+        i+=4;
+    }
+#endif
+    while(i<length && src[i]<=0x7f) {
+        dest[i]=(uint8_t)src[i];
+        ++i;
+    }
+    return i;
+}
+
+U_CFUNC int32_t
+uprv_countUTF8FromBMP(const UChar *src, int32_t length, int32_t *pUTF8Length) {
+    int32_t i=0, utf8Length=0;
+    UChar c;
+#if U_HAVE_SSE2
+    const __m128i mask80=_mm_set1_epi16((short)0xff80);
+    const __m128i mask800=_mm_set1_epi16((short)0xf800);
+    const __m128i surrogate=_mm_set1_epi16((short)0xd800);
+    const __m128i zero=_mm_setzero_si128();
+    while(i<=(length-8)) {
+        /*
+         * Count 3 bytes per UChar, minus 1 for each <U+0800 and minus 1 for each <U+0080.
+         * The per-lane counters are 16 bits wide and decrease by at most 2 per block,
+         * so they are summed up at least every 0x3fff blocks.
+         */
+        __m128i counts=zero, sums;
+        int32_t blockLimit=length-8;
+        int32_t start=i;
+        if(blockLimit>(i+0x3fff*8)) {
+            blockLimit=i+0x3fff*8;
+        }
+        while(i<=blockLimit) {
+            __m128i units=_mm_loadu_si128((const __m128i *)(src+i));
+            __m128i high5=_mm_and_si128(units, mask800);
+            if(_mm_movemask_epi8(_mm_cmpeq_epi16(high5, surrogate))!=0) {
+                break;  /* at least one surrogate */
+            }
+            counts=_mm_add_epi16(counts, _mm_cmpeq_epi16(high5, zero));
+            counts=_mm_add_epi16(counts, _mm_cmpeq_epi16(_mm_and_si128(units, mask80), zero));
+            i+=8;
+        }
+        sums=_mm_madd_epi16(counts, _mm_set1_epi16(1));
+        sums=_mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+        sums=_mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+        utf8Length+=3*(i-start)+_mm_cvtsi128_si32(sums);
+        if(i<=blockLimit) {
+            break;  /* stopped at a surrogate */
+        }
+    }
+#endif
+    while(i<length && !U16_IS_SURROGATE(c=src[i])) {
+        utf8Length+=U8_LENGTH(c);
+        ++i;
+    }
+    *pUTF8Length+=utf8Length;
+    return i;
+}
+
+U_CFUNC const UChar *
+uprv_skipUCharsBelow(const UChar *src, const UChar *limit, UChar32 min) {
+    if(min>0xffff) {
+        return limit;  /* every code unit is below min */
+    }
+#if U_HAVE_SSE2
+    {
+        /* SSE2 has no unsigned 16-bit compare: min-c saturates to 0 for c>=min. */
+        __m128i minimum=_mm_set1_epi16((short)min);
+        __m128i zero=_mm_setzero_si128();
+        while((limit-src)>=16) {
+            __m128i atOrAbove0=_mm_cmpeq_epi16(
+                _mm_subs_epu16(minimum, _mm_loadu_si128((const __m128i *)src)), zero);
+            __m128i atOrAbove1=_mm_cmpeq_epi16(
+                _mm_subs_epu16(minimum, _mm_loadu_si128((const __m128i *)(src+8))), zero);
+            if(_mm_movemask_epi8(_mm_or_si128(atOrAbove0, atOrAbove1))!=0) {
+                break;
+            }
+            src+=16;
+        }
+    }
+#else
+    while((limit-src)>=4 && src[0]<min && src[1]<min && src[2]<min && src[3]<min) {
+        src+=4;
+    }
+#endif
+    while(src<limit && *src<min) {
+        ++src;
+    }
+    return src;
+}
+
+U_CAPI int32_t U_EXPORT2
+uprv_findUCharsDifference(const UChar *s1, const UChar *s2, int32_t length) {
+    int32_t i=0;
+#if U_HAVE_SSE2
+    while(i<=(length-16)) {
+        __m128i equal0=_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)(s1+i)),
+                                       _mm_loadu_si128((const __m128i *)(s2+i)));
+        __m128i equal1=_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)(s1+i+8)),
+                                       _mm_loadu_si128((const __m128i *)(s2+i+8)));
+        if(_mm_movemask_epi8(_mm_and_si128(equal0, equal1))!=0xffff) {
+            break;  /* the difference is in this block */
+        }
+        i+=16;
+    }
+#else
+    while(i<=(length-4) &&
+            ((s1[i]^s2[i])|(s1[i+1]^s2[i+1])|(s1[i+2]^s2[i+2])|(s1[i+3]^s2[i+3]))==0) {
+        i+=4;
+    }
+#endif
+    while(i<length && s1[i]==s2[i]) {
+        ++i;
+    }
+    return i;
+}
+
+U_CAPI int32_t U_EXPORT2
+uprv_findBytesDifference(const uint8_t *s1, const uint8_t *s2, int32_t length) {
+    int32_t i=0;
+#if U_HAVE_SSE2
+    while(i<=(length-16)) {
+        __m128i equal=_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s1+i)),
+                                     _mm_loadu_si128((const __m128i *)(s2+i)));
+        if(_mm_movemask_epi8(equal)!=0xffff) {
+            break;  /* the difference is in this block */
+        }
+        i+=16;
+    }
+#else
+    while(i<=(length-4) &&
+            ((s1[i]^s2[i])|(s1[i+1]^s2[i+1])|(s1[i+2]^s2[i+2])|(s1[i+3]^s2[i+3]))==0) {
+        i+=4;
+    }
+#endif
+    while(i<length && s1[i]==s2[i]) {
+        ++i;
+    }
+    return i;
+}
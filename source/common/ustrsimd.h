@@ -0,0 +1,118 @@
+/*
+**********************************************************************
+*   Copyright (C) 2014, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+**********************************************************************
+*   file name:  ustrsimd.h
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   created on: 2014jun02
+*
+*   Block-oriented helper functions for the hot loops of the
+*   UTF conversion functions, the UTF-8 converter and string comparisons.
+*   Each function processes as many code units as possible in bulk
+*   and stops at the first code unit that needs the regular,
+*   per-character code path, so that callers keep their exact
+*   error and substitution semantics.
+*/
+
+#ifndef __USTRSIMD_H__
+#define __USTRSIMD_H__
+
+#include "unicode/utypes.h"
+
+/**
+ * \def U_HAVE_SSE2
+ * Defined to 1 if the SSE2 code paths in ustrsimd.c are compiled in.
+ * SSE2 is part of the baseline instruction set on x86-64,
+ * so no runtime detection is necessary.
+ * Define to 0 to force the portable implementation.
+ * @internal
+ */
+#ifdef U_HAVE_SSE2
+    /* Use the predefined value. */
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP>=2)
+#   define U_HAVE_SSE2 1
+#else
+#   define U_HAVE_SSE2 0
+#endif
+
+/**
+ * Minimum number of code units for which it is worth calling
+ * one of the block functions instead of handling them inline.
+ * @internal
+ */
+#define U_SIMD_MIN_LENGTH 16
+
+/**
+ * Widens the leading run of ASCII bytes (00..7F) of src[0..length[ to UChars.
+ * Stops before the first non-ASCII byte.
+ * dest must have room for length UChars.
+ * @return the number of bytes read and UChars written
+ * @internal
+ */
+U_CFUNC int32_t
+uprv_copyASCIIToUChars(UChar *dest, const uint8_t *src, int32_t length);
+
+/**
+ * @return the number of leading ASCII bytes (00..7F) in src[0..length[
+ * @internal
+ */
+U_CFUNC int32_t
+uprv_countASCII(const uint8_t *src, int32_t length);
+
+/**
+ * Narrows the leading run of ASCII UChars (0000..007F) of src[0..length[ to bytes.
+ * Stops before the first non-ASCII UChar.
+ * dest must have room for length bytes.
+ * @return the number of UChars read and bytes written
+ * @internal
+ */
+U_CFUNC int32_t
+uprv_copyUCharsToASCII(uint8_t *dest, const UChar *src, int32_t length);
+
+/**
+ * Counts the UTF-8 length of the leading run of non-surrogate UChars
+ * of src[0..length[. Stops before the first surrogate code unit.
+ * @param pUTF8Length the UTF-8 length of the run is added to *pUTF8Length
+ * @return the number of UChars in the run
+ * @internal
+ */
+U_CFUNC int32_t
+uprv_countUTF8FromBMP(const UChar *src, int32_t length, int32_t *pUTF8Length);
+
+/**
+ * Skips the leading UChars of [src..limit[ that are below min.
+ * Used by the normalizer to skip text below its quick check thresholds.
+ * Not inlined on purpose: It runs once per quick check loop, and keeps
+ * its registers out of the per-code point loops that follow it.
+ * @return a pointer to the first UChar c>=min, or limit
+ * @internal
+ */
+U_CFUNC const UChar *
+uprv_skipUCharsBelow(const UChar *src, const UChar *limit, UChar32 min);
+
+/**
+ * Finds the first position where two UChar arrays differ.
+ * Reads all of s1[0..length[ and s2[0..length[ (no NUL-termination handling).
+ * @return the index of the first differing code unit,
+ *         or length if the arrays are equal
+ * @internal
+ */
+U_CAPI int32_t U_EXPORT2
+uprv_findUCharsDifference(const UChar *s1, const UChar *s2, int32_t length);
+
+/**
+ * Finds the first position where two byte arrays differ.
+ * Reads all of s1[0..length[ and s2[0..length[ (no NUL-termination handling).
+ * @return the index of the first differing byte,
+ *         or length if the arrays are equal
+ * @internal
+ */
+U_CAPI int32_t U_EXPORT2
+uprv_findBytesDifference(const uint8_t *s1, const uint8_t *s2, int32_t length);
+
+#endif
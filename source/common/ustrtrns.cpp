@@ -32,6 +32,7 @@
 #include "cstring.h"
 #include "cmemory.h"
 #include "ustr_imp.h"
+#include "ustrsimd.h"
 #include "uassert.h"
 
 #define LENGTHOF(array) (int32_t)(sizeof(array)/sizeof((array)[0]))
@@ -565,6 +566,13 @@ u_strFromUTF8WithSub(UChar *dest,
                 if(ch <= 0x7f){
                     *pDest++=(UChar)ch;
                     ++pSrc;
+                    if(count > U_SIMD_MIN_LENGTH && *pSrc <= 0x7f) {
+                        /* widen a run of ASCII bytes in bulk, at most count-1 more */
+                        int32_t asciiLength = uprv_copyASCIIToUChars(pDest, pSrc, count - 1);
+                        pDest += asciiLength;
+                        pSrc += asciiLength;
+                        count -= asciiLength;
+                    }
                 } else {
                     if(ch > 0xe0) {
                         if( /* handle U+1000..U+CFFF inline */
@@ -668,8 +676,10 @@ u_strFromUTF8WithSub(UChar *dest,
         while(pSrc < pSrcLimit){
             ch = *pSrc;
             if(ch <= 0x7f){
-                reqLength++;
-                ++pSrc;
+                /* count a run of ASCII bytes in bulk */
+                int32_t asciiLength = uprv_countASCII(pSrc, (int32_t)(pSrcLimit - pSrc));
+                reqLength += asciiLength;
+                pSrc += asciiLength;
             } else {
                 if(ch > 0xe0) {
                     if( /* handle U+1000..U+CFFF inline */
@@ -1107,6 +1117,13 @@ u_strToUTF8WithSub(char *dest,
                 ch=*pSrc++;
                 if(ch <= 0x7f) {
                     *pDest++ = (uint8_t)ch;
+                    if(count > U_SIMD_MIN_LENGTH && *pSrc <= 0x7f) {
+                        /* narrow a run of ASCII UChars in bulk, at most count-1 more */
+                        int32_t asciiLength = uprv_copyUCharsToASCII(pDest, pSrc, count - 1);
+                        pDest += asciiLength;
+                        pSrc += asciiLength;
+                        count -= asciiLength;
+                    }
                 } else if(ch <= 0x7ff) {
                     *pDest++=(uint8_t)((ch>>6)|0xc0);
                     *pDest++=(uint8_t)((ch&0x3f)|0x80);
@@ -1203,6 +1220,11 @@ u_strToUTF8WithSub(char *dest,
             }
         }
         while(pSrc<pSrcLimit) {
+            /* count the UTF-8 length of a run of BMP code points in bulk */
+            pSrc+=uprv_countUTF8FromBMP(pSrc, (int32_t)(pSrcLimit-pSrc), &reqLength);
+            if(pSrc==pSrcLimit) {
+                break;
+            }
             ch=*pSrc++;
             if(ch<=0x7f) {
                 ++reqLength;
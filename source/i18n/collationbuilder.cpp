@@ -185,7 +185,8 @@ RuleBasedCollator::internalBuildTailoring(const UnicodeString &rules,
             fastLatinOptions != ts.fastLatinOptions ||
             (fastLatinOptions >= 0 &&
                 uprv_memcmp(fastLatinPrimaries, ts.fastLatinPrimaries,
-                            sizeof(fastLatinPrimaries)) != 0)) {
+                            sizeof(fastLatinPrimaries)) != 0) ||
+            !CollationFastLatin::hasScriptOptions(t->data, ts)) {
         CollationSettings *ownedSettings = SharedObject::copyOnWrite(t->settings);
         if(ownedSettings == NULL) {
             errorCode = U_MEMORY_ALLOCATION_ERROR;
@@ -200,6 +201,7 @@ RuleBasedCollator::internalBuildTailoring(const UnicodeString &rules,
         ownedSettings->fastLatinOptions = CollationFastLatin::getOptions(
             t->data, *ownedSettings,
             ownedSettings->fastLatinPrimaries, LENGTHOF(ownedSettings->fastLatinPrimaries));
+        CollationFastLatin::setScriptOptions(t->data, *ownedSettings);
     }
     if(U_FAILURE(errorCode)) { return; }
     t->actualLocale.setToBogus();
@@ -287,6 +289,8 @@ CollationBuilder::parseAndBuild(const UnicodeString &ruleString,
         dataBuilder->build(*tailoring->ownedData, errorCode);
         tailoring->builder = dataBuilder;
         dataBuilder = NULL;
+        tailoring->buildFastScriptTables(errorCode);
+        tailoring->buildFastKeyTable(errorCode);
     } else {
         tailoring->data = baseData;
     }
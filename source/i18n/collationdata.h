@@ -18,6 +18,7 @@
 
 #include "unicode/uniset.h"
 #include "collation.h"
+#include "collationfastlatin.h"
 #include "normalizer2impl.h"
 #include "utrie2.h"
 
@@ -43,8 +44,17 @@ struct U_I18N_API CollationData : public UMemory {
               compressibleBytes(NULL),
               unsafeBackwardSet(NULL),
               fastLatinTable(NULL), fastLatinTableLength(0),
+              fastKeyCEs(NULL),
               scripts(NULL), scriptsLength(0),
-              rootElements(NULL), rootElementsLength(0) {}
+              rootElements(NULL), rootElementsLength(0) {
+        for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_TABLES; ++i) {
+            fastScriptTables[i] = NULL;
+            fastScriptTableLengths[i] = 0;
+        }
+    }
+
+    /** Limit of code points that have fastKeyCEs entries. */
+    static const UChar32 FAST_KEY_LIMIT = 0x500;
 
     uint32_t getCE32(UChar32 c) const {
         return UTRIE2_GET32(trie, c);
@@ -184,6 +194,22 @@ struct U_I18N_API CollationData : public UMemory {
      */
     const uint16_t *fastLatinTable;
     int32_t fastLatinTableLength;
+    /**
+     * Fast Greek, Cyrillic & full-width forms tables, same format as the fastLatinTable.
+     * They are not serialized but built at load time;
+     * indexed by CollationFastLatin::GREEK_TABLE etc.
+     */
+    const uint16_t *fastScriptTables[CollationFastLatin::NUM_SCRIPT_TABLES];
+    int32_t fastScriptTableLengths[CollationFastLatin::NUM_SCRIPT_TABLES];
+    /**
+     * Sort key fast path: Two CEs per code point below FAST_KEY_LIMIT,
+     * for characters that map to at most two CEs without context,
+     * and that have lccc=0 so that a string of them is FCD.
+     * The second CE is 0 for single-CE characters.
+     * The first CE is Collation::NO_CE for other characters.
+     * Not serialized but built at load time; NULL if not available.
+     */
+    const int64_t *fastKeyCEs;
 
     /**
      * Data for scripts and reordering groups.
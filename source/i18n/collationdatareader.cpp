@@ -366,6 +366,14 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
         return;
     }
 
+    if(data != NULL) {
+        // The fast Greek, Cyrillic & full-width tables and the sort key fast path table
+        // are not stored in the data.
+        tailoring.buildFastScriptTables(errorCode);
+        tailoring.buildFastKeyTable(errorCode);
+        if(U_FAILURE(errorCode)) { return; }
+    }
+
     const CollationSettings &ts = *tailoring.settings;
     int32_t options = inIndexes[IX_OPTIONS] & 0xffff;
     uint16_t fastLatinPrimaries[CollationFastLatin::LATIN_LIMIT];
@@ -377,7 +385,8 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
             fastLatinOptions == ts.fastLatinOptions &&
             (fastLatinOptions < 0 ||
                 uprv_memcmp(fastLatinPrimaries, ts.fastLatinPrimaries,
-                            sizeof(fastLatinPrimaries)) == 0)) {
+                            sizeof(fastLatinPrimaries)) == 0) &&
+            CollationFastLatin::hasScriptOptions(tailoring.data, ts)) {
         return;
     }
 
@@ -410,6 +419,7 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
     settings->fastLatinOptions = CollationFastLatin::getOptions(
         tailoring.data, *settings,
         settings->fastLatinPrimaries, LENGTHOF(settings->fastLatinPrimaries));
+    CollationFastLatin::setScriptOptions(tailoring.data, *settings);
 }
 
 UBool U_CALLCONV
@@ -14,18 +14,68 @@
 #if !UCONFIG_NO_COLLATION
 
 #include "unicode/ucol.h"
+#include "cmemory.h"
 #include "collationdata.h"
 #include "collationfastlatin.h"
 #include "collationsettings.h"
 #include "putilimp.h"  // U_ALIGN_CODE
 #include "uassert.h"
 
+#define LENGTHOF(array) (int32_t)(sizeof(array)/sizeof((array)[0]))
+
 U_NAMESPACE_BEGIN
 
 int32_t
 CollationFastLatin::getOptions(const CollationData *data, const CollationSettings &settings,
                                uint16_t *primaries, int32_t capacity) {
-    const uint16_t *table = data->fastLatinTable;
+    return getOptions(data, data->fastLatinTable, USCRIPT_LATIN, settings, primaries, capacity);
+}
+
+int32_t
+CollationFastLatin::getScriptOptions(const CollationData *data, const CollationSettings &settings,
+                                     int32_t scriptTable,
+                                     uint16_t *primaries, int32_t capacity) {
+    U_ASSERT(0 <= scriptTable && scriptTable < NUM_SCRIPT_TABLES);
+    if(scriptTable == FULLWIDTH_TABLE && (settings.options & CollationSettings::NUMERIC) != 0) {
+        // The compare functions bail out only for ASCII digits, not for full-width ones.
+        return -1;
+    }
+    // The full-width forms table has the Latin primaries.
+    return getOptions(data, data->fastScriptTables[scriptTable],
+                      scriptTable == GREEK_TABLE ? USCRIPT_GREEK :
+                          scriptTable == CYRILLIC_TABLE ? USCRIPT_CYRILLIC : USCRIPT_LATIN,
+                      settings, primaries, capacity);
+}
+
+void
+CollationFastLatin::setScriptOptions(const CollationData *data, CollationSettings &settings) {
+    for(int32_t i = 0; i < NUM_SCRIPT_TABLES; ++i) {
+        settings.fastScriptOptions[i] = getScriptOptions(
+                data, settings, i,
+                settings.fastScriptPrimaries[i], LENGTHOF(settings.fastScriptPrimaries[i]));
+    }
+}
+
+UBool
+CollationFastLatin::hasScriptOptions(const CollationData *data,
+                                     const CollationSettings &settings) {
+    uint16_t primaries[LATIN_LIMIT];
+    for(int32_t i = 0; i < NUM_SCRIPT_TABLES; ++i) {
+        int32_t options = getScriptOptions(data, settings, i, primaries, LENGTHOF(primaries));
+        if(options != settings.fastScriptOptions[i] ||
+                (options >= 0 &&
+                    uprv_memcmp(primaries, settings.fastScriptPrimaries[i],
+                                sizeof(primaries)) != 0)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+int32_t
+CollationFastLatin::getOptions(const CollationData *data, const uint16_t *table, int32_t script,
+                               const CollationSettings &settings,
+                               uint16_t *primaries, int32_t capacity) {
     if(table == NULL) { return -1; }
     U_ASSERT(capacity == LATIN_LIMIT);
     if(capacity != LATIN_LIMIT) { return -1; }
@@ -53,16 +103,22 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
         const uint16_t *scripts = data->scripts;
         int32_t length = data->scriptsLength;
         uint32_t prevLastByte = 0;
+        UBool afterDigits = FALSE;
         for(int32_t i = 0; i < length;) {
-            // reordered last byte of the group
-            uint32_t lastByte = reorderTable[scripts[i] & 0xff];
-            if(lastByte < prevLastByte) {
-                // The permutation affects the groups up to Latin.
-                return -1;
+            int32_t group = scripts[i + 2];
+            // Groups between the digits and the table's script do not have fast mini CEs.
+            if(!afterDigits || group == script) {
+                // reordered last byte of the group
+                uint32_t lastByte = reorderTable[scripts[i] & 0xff];
+                if(lastByte < prevLastByte) {
+                    // The permutation affects the groups up to the table's script.
+                    return -1;
+                }
+                if(group == script) { break; }
+                prevLastByte = lastByte;
             }
-            if(scripts[i + 2] == USCRIPT_LATIN) { break; }
+            if(group == UCOL_REORDER_CODE_DIGIT) { afterDigits = TRUE; }
             i = i + 2 + scripts[i + 1];
-            prevLastByte = lastByte;
         }
     }
 
@@ -87,12 +143,14 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
     return ((int32_t)miniVarTop << 16) | settings.options;
 }
 
+template<int32_t blockStart>
 int32_t
-CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primaries, int32_t options,
-                                 const UChar *left, int32_t leftLength,
-                                 const UChar *right, int32_t rightLength) {
+CollationFastLatin::compareBlockUTF16(const uint16_t *table, const uint16_t *primaries,
+                                      int32_t options,
+                                      const UChar *left, int32_t leftLength,
+                                      const UChar *right, int32_t rightLength) {
     // This is a modified copy of CollationCompare::compareUpToQuaternary(),
-    // optimized for common Latin text.
+    // optimized for common Latin text (or common text of a fast script table).
     // Keep them in sync!
     // Keep compareUTF16() and compareUTF8() in sync very closely!
 
@@ -118,13 +176,14 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = left[leftIndex++];
-            if(c <= LATIN_MAX) {
-                leftPair = primaries[c];
+            if(isBlockChar<blockStart>(c)) {
+                int32_t i = blockIndex<blockStart>(c);
+                leftPair = primaries[i];
                 if(leftPair != 0) { break; }
                 if(c <= 0x39 && c >= 0x30 && (options & CollationSettings::NUMERIC) != 0) {
                     return BAIL_OUT_RESULT;
                 }
-                leftPair = table[c];
+                leftPair = table[i];
             } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                 leftPair = table[c - PUNCT_START + LATIN_LIMIT];
             } else {
@@ -137,7 +196,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 leftPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair<blockStart>(table, c, leftPair, left, NULL, leftIndex, leftLength);
                 if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 leftPair = getPrimaries(variableTop, leftPair);
             }
@@ -149,13 +208,14 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = right[rightIndex++];
-            if(c <= LATIN_MAX) {
-                rightPair = primaries[c];
+            if(isBlockChar<blockStart>(c)) {
+                int32_t i = blockIndex<blockStart>(c);
+                rightPair = primaries[i];
                 if(rightPair != 0) { break; }
                 if(c <= 0x39 && c >= 0x30 && (options & CollationSettings::NUMERIC) != 0) {
                     return BAIL_OUT_RESULT;
                 }
-                rightPair = table[c];
+                rightPair = table[i];
             } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                 rightPair = table[c - PUNCT_START + LATIN_LIMIT];
             } else {
@@ -168,7 +228,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 rightPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair<blockStart>(table, c, rightPair, right, NULL, rightIndex, rightLength);
                 if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 rightPair = getPrimaries(variableTop, rightPair);
             }
@@ -205,8 +265,8 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                if(c <= LATIN_MAX) {
-                    leftPair = table[c];
+                if(isBlockChar<blockStart>(c)) {
+                    leftPair = table[blockIndex<blockStart>(c)];
                 } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                     leftPair = table[c - PUNCT_START + LATIN_LIMIT];
                 } else {
@@ -219,7 +279,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     leftPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                    leftPair = nextPair<blockStart>(table, c, leftPair, left, NULL, leftIndex, leftLength);
                     leftPair = getSecondaries(variableTop, leftPair);
                 }
             }
@@ -230,8 +290,8 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                if(c <= LATIN_MAX) {
-                    rightPair = table[c];
+                if(isBlockChar<blockStart>(c)) {
+                    rightPair = table[blockIndex<blockStart>(c)];
                 } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                     rightPair = table[c - PUNCT_START + LATIN_LIMIT];
                 } else {
@@ -244,7 +304,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     rightPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                    rightPair = nextPair<blockStart>(table, c, rightPair, right, NULL, rightIndex, rightLength);
                     rightPair = getSecondaries(variableTop, rightPair);
                 }
             }
@@ -281,9 +341,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+                leftPair = isBlockChar<blockStart>(c) ?
+                    table[blockIndex<blockStart>(c)] : lookup(table, c);
                 if(leftPair < MIN_LONG) {
-                    leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                    leftPair = nextPair<blockStart>(table, c, leftPair, left, NULL, leftIndex, leftLength);
                 }
                 leftPair = getCases(variableTop, strengthIsPrimary, leftPair);
             }
@@ -294,9 +355,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+                rightPair = isBlockChar<blockStart>(c) ?
+                    table[blockIndex<blockStart>(c)] : lookup(table, c);
                 if(rightPair < MIN_LONG) {
-                    rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                    rightPair = nextPair<blockStart>(table, c, rightPair, right, NULL, rightIndex, rightLength);
                 }
                 rightPair = getCases(variableTop, strengthIsPrimary, rightPair);
             }
@@ -334,9 +396,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            leftPair = isBlockChar<blockStart>(c) ?
+                    table[blockIndex<blockStart>(c)] : lookup(table, c);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair<blockStart>(table, c, leftPair, left, NULL, leftIndex, leftLength);
             }
             leftPair = getTertiaries(variableTop, withCaseBits, leftPair);
         }
@@ -347,9 +410,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            rightPair = isBlockChar<blockStart>(c) ?
+                    table[blockIndex<blockStart>(c)] : lookup(table, c);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair<blockStart>(table, c, rightPair, right, NULL, rightIndex, rightLength);
             }
             rightPair = getTertiaries(variableTop, withCaseBits, rightPair);
         }
@@ -390,9 +454,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            leftPair = isBlockChar<blockStart>(c) ?
+                    table[blockIndex<blockStart>(c)] : lookup(table, c);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair<blockStart>(table, c, leftPair, left, NULL, leftIndex, leftLength);
             }
             leftPair = getQuaternaries(variableTop, leftPair);
         }
@@ -403,9 +468,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            rightPair = isBlockChar<blockStart>(c) ?
+                    table[blockIndex<blockStart>(c)] : lookup(table, c);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair<blockStart>(table, c, rightPair, right, NULL, rightIndex, rightLength);
             }
             rightPair = getQuaternaries(variableTop, rightPair);
         }
@@ -427,11 +493,18 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
     return UCOL_EQUAL;
 }
 
+template<int32_t blockStart>
 int32_t
-CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries, int32_t options,
-                                 const uint8_t *left, int32_t leftLength,
-                                 const uint8_t *right, int32_t rightLength) {
+CollationFastLatin::compareBlockUTF8(const uint16_t *table, const uint16_t *primaries,
+                                     int32_t options,
+                                     const uint8_t *left, int32_t leftLength,
+                                     const uint8_t *right, int32_t rightLength) {
     // Keep compareUTF16() and compareUTF8() in sync very closely!
+    // UTF-8 lead bytes of the block, e.g., C2..C5 for U+0080..U+017F.
+    // A block of three-byte characters has none (maxLead < minLead);
+    // they are handled by lookupBlockUTF8() & lookupUTF8Unsafe().
+    const int32_t minLead = blockStart < 0x800 ? 0xc0 + (blockStart >> 6) : 0x100;
+    const int32_t maxLead = blockStart < 0x800 ? 0xc0 + ((blockStart + BLOCK_LENGTH - 1) >> 6) : 0;
 
     U_ASSERT((table[0] >> 8) == VERSION);
     table += (table[0] & 0xff);  // skip the header
@@ -466,15 +539,15 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     return BAIL_OUT_RESULT;
                 }
                 leftPair = table[c];
-            } else if(c <= LATIN_MAX_UTF8_LEAD && 0xc2 <= c && leftIndex != leftLength &&
+            } else if(c <= maxLead && minLead <= c && leftIndex != leftLength &&
                     0x80 <= (t = left[leftIndex]) && t <= 0xbf) {
                 ++leftIndex;
-                c = ((c - 0xc2) << 6) + t;
+                c = ((c - 0xc0) << 6) + t - blockStart;
                 leftPair = primaries[c];
                 if(leftPair != 0) { break; }
                 leftPair = table[c];
             } else {
-                leftPair = lookupUTF8(table, c, left, leftIndex, leftLength);
+                leftPair = lookupBlockUTF8<blockStart>(table, c, left, leftIndex, leftLength);
             }
             if(leftPair >= MIN_SHORT) {
                 leftPair &= SHORT_PRIMARY_MASK;
@@ -483,7 +556,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 leftPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair<blockStart>(table, c, leftPair, NULL, left, leftIndex, leftLength);
                 if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 leftPair = getPrimaries(variableTop, leftPair);
             }
@@ -503,15 +576,15 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     return BAIL_OUT_RESULT;
                 }
                 rightPair = table[c];
-            } else if(c <= LATIN_MAX_UTF8_LEAD && 0xc2 <= c && rightIndex != rightLength &&
+            } else if(c <= maxLead && minLead <= c && rightIndex != rightLength &&
                     0x80 <= (t = right[rightIndex]) && t <= 0xbf) {
                 ++rightIndex;
-                c = ((c - 0xc2) << 6) + t;
+                c = ((c - 0xc0) << 6) + t - blockStart;
                 rightPair = primaries[c];
                 if(rightPair != 0) { break; }
                 rightPair = table[c];
             } else {
-                rightPair = lookupUTF8(table, c, right, rightIndex, rightLength);
+                rightPair = lookupBlockUTF8<blockStart>(table, c, right, rightIndex, rightLength);
             }
             if(rightPair >= MIN_SHORT) {
                 rightPair &= SHORT_PRIMARY_MASK;
@@ -520,7 +593,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 rightPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair<blockStart>(table, c, rightPair, NULL, right, rightIndex, rightLength);
                 if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 rightPair = getPrimaries(variableTop, rightPair);
             }
@@ -559,10 +632,10 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 UChar32 c = left[leftIndex++];
                 if(c <= 0x7f) {
                     leftPair = table[c];
-                } else if(c <= LATIN_MAX_UTF8_LEAD) {
-                    leftPair = table[((c - 0xc2) << 6) + left[leftIndex++]];
+                } else if(c <= maxLead) {
+                    leftPair = table[((c - 0xc0) << 6) + left[leftIndex++] - blockStart];
                 } else {
-                    leftPair = lookupUTF8Unsafe(table, c, left, leftIndex);
+                    leftPair = lookupUTF8Unsafe<blockStart>(table, c, left, leftIndex);
                 }
                 if(leftPair >= MIN_SHORT) {
                     leftPair = getSecondariesFromOneShortCE(leftPair);
@@ -571,7 +644,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     leftPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                    leftPair = nextPair<blockStart>(table, c, leftPair, NULL, left, leftIndex, leftLength);
                     leftPair = getSecondaries(variableTop, leftPair);
                 }
             }
@@ -584,10 +657,10 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 UChar32 c = right[rightIndex++];
                 if(c <= 0x7f) {
                     rightPair = table[c];
-                } else if(c <= LATIN_MAX_UTF8_LEAD) {
-                    rightPair = table[((c - 0xc2) << 6) + right[rightIndex++]];
+                } else if(c <= maxLead) {
+                    rightPair = table[((c - 0xc0) << 6) + right[rightIndex++] - blockStart];
                 } else {
-                    rightPair = lookupUTF8Unsafe(table, c, right, rightIndex);
+                    rightPair = lookupUTF8Unsafe<blockStart>(table, c, right, rightIndex);
                 }
                 if(rightPair >= MIN_SHORT) {
                     rightPair = getSecondariesFromOneShortCE(rightPair);
@@ -596,7 +669,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     rightPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                    rightPair = nextPair<blockStart>(table, c, rightPair, NULL, right, rightIndex, rightLength);
                     rightPair = getSecondaries(variableTop, rightPair);
                 }
             }
@@ -633,9 +706,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+                leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe<blockStart>(table, c, left, leftIndex);
                 if(leftPair < MIN_LONG) {
-                    leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                    leftPair = nextPair<blockStart>(table, c, leftPair, NULL, left, leftIndex, leftLength);
                 }
                 leftPair = getCases(variableTop, strengthIsPrimary, leftPair);
             }
@@ -646,9 +719,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+                rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe<blockStart>(table, c, right, rightIndex);
                 if(rightPair < MIN_LONG) {
-                    rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                    rightPair = nextPair<blockStart>(table, c, rightPair, NULL, right, rightIndex, rightLength);
                 }
                 rightPair = getCases(variableTop, strengthIsPrimary, rightPair);
             }
@@ -686,9 +759,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe<blockStart>(table, c, left, leftIndex);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair<blockStart>(table, c, leftPair, NULL, left, leftIndex, leftLength);
             }
             leftPair = getTertiaries(variableTop, withCaseBits, leftPair);
         }
@@ -699,9 +772,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe<blockStart>(table, c, right, rightIndex);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair<blockStart>(table, c, rightPair, NULL, right, rightIndex, rightLength);
             }
             rightPair = getTertiaries(variableTop, withCaseBits, rightPair);
         }
@@ -742,9 +815,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe<blockStart>(table, c, left, leftIndex);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair<blockStart>(table, c, leftPair, NULL, left, leftIndex, leftLength);
             }
             leftPair = getQuaternaries(variableTop, leftPair);
         }
@@ -755,9 +828,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe<blockStart>(table, c, right, rightIndex);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair<blockStart>(table, c, rightPair, NULL, right, rightIndex, rightLength);
             }
             rightPair = getQuaternaries(variableTop, rightPair);
         }
@@ -779,9 +852,102 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
     return UCOL_EQUAL;
 }
 
+int32_t
+CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primaries, int32_t options,
+                                 const UChar *left, int32_t leftLength,
+                                 const UChar *right, int32_t rightLength) {
+    return compareBlockUTF16<LATIN_BLOCK_START>(table, primaries, options,
+                                                left, leftLength, right, rightLength);
+}
+
+int32_t
+CollationFastLatin::compareScriptUTF16(int32_t scriptTable,
+                                       const uint16_t *table, const uint16_t *primaries,
+                                       int32_t options,
+                                       const UChar *left, int32_t leftLength,
+                                       const UChar *right, int32_t rightLength) {
+    if(scriptTable == GREEK_TABLE) {
+        return compareBlockUTF16<GREEK_BLOCK_START>(table, primaries, options,
+                                                    left, leftLength, right, rightLength);
+    } else if(scriptTable == CYRILLIC_TABLE) {
+        return compareBlockUTF16<CYRILLIC_BLOCK_START>(table, primaries, options,
+                                                       left, leftLength, right, rightLength);
+    } else {
+        return compareBlockUTF16<FULLWIDTH_BLOCK_START>(table, primaries, options,
+                                                        left, leftLength, right, rightLength);
+    }
+}
+
+int32_t
+CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries, int32_t options,
+                                const uint8_t *left, int32_t leftLength,
+                                const uint8_t *right, int32_t rightLength) {
+    return compareBlockUTF8<LATIN_BLOCK_START>(table, primaries, options,
+                                               left, leftLength, right, rightLength);
+}
+
+int32_t
+CollationFastLatin::compareScriptUTF8(int32_t scriptTable,
+                                      const uint16_t *table, const uint16_t *primaries,
+                                      int32_t options,
+                                      const uint8_t *left, int32_t leftLength,
+                                      const uint8_t *right, int32_t rightLength) {
+    if(scriptTable == GREEK_TABLE) {
+        return compareBlockUTF8<GREEK_BLOCK_START>(table, primaries, options,
+                                                   left, leftLength, right, rightLength);
+    } else if(scriptTable == CYRILLIC_TABLE) {
+        return compareBlockUTF8<CYRILLIC_BLOCK_START>(table, primaries, options,
+                                                      left, leftLength, right, rightLength);
+    } else {
+        return compareBlockUTF8<FULLWIDTH_BLOCK_START>(table, primaries, options,
+                                                       left, leftLength, right, rightLength);
+    }
+}
+
+int32_t
+CollationFastLatin::findScriptTable(const UChar *s, int32_t length) {
+    for(int32_t i = 0; i != length; ++i) {
+        UChar c = s[i];
+        if(c >= 0x80) {
+            if(0x370 <= c && c < 0x400) {
+                return GREEK_TABLE;
+            } else if(0x400 <= c && c < 0x500) {
+                return CYRILLIC_TABLE;
+            } else if(c >= FULLWIDTH_BLOCK_START) {
+                return FULLWIDTH_TABLE;
+            }
+            return -1;
+        } else if(c == 0 && length < 0) {
+            break;
+        }
+    }
+    return ALL_ASCII;
+}
+
+int32_t
+CollationFastLatin::findScriptTableUTF8(const uint8_t *s, int32_t length) {
+    for(int32_t i = 0; i != length; ++i) {
+        uint8_t b = s[i];
+        if(b >= 0x80) {
+            if(0xcd <= b && b <= 0xcf) {
+                return GREEK_TABLE;  // U+0340..U+03FF
+            } else if(0xd0 <= b && b <= 0xd3) {
+                return CYRILLIC_TABLE;  // U+0400..U+04FF
+            } else if(b == 0xef && (i + 1 < length || length < 0) &&
+                    0xbc <= s[i + 1] && s[i + 1] <= 0xbf) {
+                return FULLWIDTH_TABLE;  // U+FF00..U+FFFF
+            }
+            return -1;
+        } else if(b == 0 && length < 0) {
+            break;
+        }
+    }
+    return ALL_ASCII;
+}
+
 uint32_t
 CollationFastLatin::lookup(const uint16_t *table, UChar32 c) {
-    U_ASSERT(c > LATIN_MAX);
+    U_ASSERT(c > 0x7f);
     if(PUNCT_START <= c && c < PUNCT_LIMIT) {
         return table[c - PUNCT_START + LATIN_LIMIT];
     } else if(c == 0xfffe) {
@@ -796,7 +962,7 @@ CollationFastLatin::lookup(const uint16_t *table, UChar32 c) {
 uint32_t
 CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 c,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength) {
-    // The caller handled ASCII and valid/supported Latin.
+    // The caller handled ASCII and valid/supported block characters.
     U_ASSERT(c > 0x7f);
     int32_t i2 = sIndex + 1;
     if(i2 < sLength || sLength < 0) {
@@ -816,16 +982,23 @@ CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 c,
     return BAIL_OUT;
 }
 
+template<int32_t blockStart>
 uint32_t
 CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
                                      const uint8_t *s8, int32_t &sIndex) {
     // The caller handled ASCII.
     // The string is well-formed and contains only supported characters.
     U_ASSERT(c > 0x7f);
-    if(c <= LATIN_MAX_UTF8_LEAD) {
-        return table[((c - 0xc2) << 6) + s8[sIndex++]];  // 0080..017F
+    if(blockStart < 0x800 && c <= 0xc0 + ((blockStart + BLOCK_LENGTH - 1) >> 6)) {
+        return table[((c - 0xc0) << 6) + s8[sIndex++] - blockStart];  // block -> 0080..017F
     }
     uint8_t t2 = s8[sIndex + 1];
+    if(blockStart >= 0x800 && c != 0xe2) {
+        // block -> 0080..017F
+        uint32_t ce = table[blockIndexUTF8<blockStart>(c, s8[sIndex], t2)];
+        sIndex += 2;
+        return ce;
+    }
     sIndex += 2;
     if(c == 0xe2) {
         return table[(LATIN_LIMIT - 0x80) + t2];  // 2000..203F -> 0180..01BF
@@ -836,6 +1009,7 @@ CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
     }
 }
 
+template<int32_t blockStart>
 uint32_t
 CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength) {
@@ -858,27 +1032,33 @@ CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
             int32_t nextIndex = sIndex;
             if(s16 != NULL) {
                 c2 = s16[nextIndex++];
-                if(c2 > LATIN_MAX) {
-                    if(PUNCT_START <= c2 && c2 < PUNCT_LIMIT) {
-                        c2 = c2 - PUNCT_START + LATIN_LIMIT;  // 2000..203F -> 0180..01BF
-                    } else if(c2 == 0xfffe || c2 == 0xffff) {
-                        c2 = -1;  // U+FFFE & U+FFFF cannot occur in contractions.
-                    } else {
-                        return BAIL_OUT;
-                    }
+                if(isBlockChar<blockStart>(c2)) {
+                    c2 = blockIndex<blockStart>(c2);
+                } else if(PUNCT_START <= c2 && c2 < PUNCT_LIMIT) {
+                    c2 = c2 - PUNCT_START + LATIN_LIMIT;  // 2000..203F -> 0180..01BF
+                } else if(c2 == 0xfffe || c2 == 0xffff) {
+                    c2 = -1;  // U+FFFE & U+FFFF cannot occur in contractions.
+                } else {
+                    return BAIL_OUT;
                 }
             } else {
                 c2 = s8[nextIndex++];
                 if(c2 > 0x7f) {
                     uint8_t t;
-                    if(c2 <= 0xc5 && 0xc2 <= c2 && nextIndex != sLength &&
+                    if(blockStart < 0x800 &&
+                            c2 <= 0xc0 + ((blockStart + BLOCK_LENGTH - 1) >> 6) &&
+                            0xc0 + (blockStart >> 6) <= c2 && nextIndex != sLength &&
                             0x80 <= (t = s8[nextIndex]) && t <= 0xbf) {
-                        c2 = ((c2 - 0xc2) << 6) + t;  // 0080..017F
+                        c2 = ((c2 - 0xc0) << 6) + t - blockStart;  // block -> 0080..017F
                         ++nextIndex;
                     } else {
                         int32_t i2 = nextIndex + 1;
                         if(i2 < sLength || sLength < 0) {
-                            if(c2 == 0xe2 && s8[nextIndex] == 0x80 &&
+                            int32_t i;
+                            if(blockStart >= 0x800 &&
+                                    (i = blockIndexUTF8<blockStart>(c2, s8[nextIndex], s8[i2])) >= 0) {
+                                c2 = i;  // block -> 0080..017F
+                            } else if(c2 == 0xe2 && s8[nextIndex] == 0x80 &&
                                     0x80 <= (t = s8[i2]) && t <= 0xbf) {
                                 c2 = (LATIN_LIMIT - 0x80) + t;  // 2000..203F -> 0180..01BF
                             } else if(c2 == 0xef && s8[nextIndex] == 0xbf &&
@@ -44,6 +44,34 @@ public:
     // excludes U+FFFE & U+FFFF
     static const int32_t NUM_FAST_CHARS = LATIN_LIMIT + (PUNCT_LIMIT - PUNCT_START);
 
+    /**
+     * Fast script tables use the same format as the fast Latin table,
+     * but their char indexes 0080..017F map to the BLOCK_LENGTH characters
+     * starting at the script's block start rather than to U+0080..U+017F.
+     * The Latin table is equivalent to a "script" table with LATIN_BLOCK_START.
+     *
+     * Script tables are not stored in the data files.
+     * They are built at load time by the CollationFastLatinBuilder.
+     */
+    static const int32_t BLOCK_LENGTH = 0x100;
+    static const int32_t LATIN_BLOCK_START = 0x80;
+    /**
+     * Block starts are multiples of 0x40 so that UTF-8 lead bytes
+     * (or the second bytes of three-byte characters) map to whole sub-ranges.
+     */
+    static const int32_t GREEK_BLOCK_START = 0x340;
+    static const int32_t CYRILLIC_BLOCK_START = 0x400;
+    /** Halfwidth and Fullwidth Forms; only the full-width ASCII variants & signs get mini CEs. */
+    static const int32_t FULLWIDTH_BLOCK_START = 0xff00;
+
+    static const int32_t GREEK_TABLE = 0;
+    static const int32_t CYRILLIC_TABLE = 1;
+    /** Latin letters, digits and punctuation in full-width forms, with the Latin primaries. */
+    static const int32_t FULLWIDTH_TABLE = 2;
+    static const int32_t NUM_SCRIPT_TABLES = 3;
+    /** findScriptTable() value for a string without non-ASCII characters. */
+    static const int32_t ALL_ASCII = NUM_SCRIPT_TABLES;
+
     // Note on the supported weight ranges:
     // Analysis of UCA 6.3 and CLDR 23 non-search tailorings shows that
     // the CEs for characters in the above ranges, excluding expansions with length >2,
@@ -199,6 +227,38 @@ public:
         }
     }
 
+    /**
+     * Like getCharIndex() but for the table whose block starts at blockStart.
+     */
+    static inline int32_t getCharIndex(UChar c, int32_t blockStart) {
+        if(c < 0x80) {
+            return c;
+        } else if((uint32_t)(c - blockStart) < (uint32_t)BLOCK_LENGTH) {
+            return c - blockStart + 0x80;
+        } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
+            return c - (PUNCT_START - LATIN_LIMIT);
+        } else {
+            return -1;
+        }
+    }
+
+    /**
+     * Returns the block start for a fast script table index.
+     */
+    static inline int32_t getBlockStart(int32_t scriptTable) {
+        return scriptTable == GREEK_TABLE ? GREEK_BLOCK_START :
+                scriptTable == CYRILLIC_TABLE ? CYRILLIC_BLOCK_START : FULLWIDTH_BLOCK_START;
+    }
+
+    /**
+     * Returns the fast script table index for the first non-ASCII character
+     * in the string, -1 if it is not Greek, Cyrillic or in the full-width block,
+     * or ALL_ASCII if there is no non-ASCII character.
+     * The length can be negative for a NUL-terminated string.
+     */
+    static int32_t findScriptTable(const UChar *s, int32_t length);
+    static int32_t findScriptTableUTF8(const uint8_t *s, int32_t length);
+
     /**
      * Computes the options value for the compare functions
      * and writes the precomputed primary weights.
@@ -216,13 +276,106 @@ public:
                                const uint8_t *left, int32_t leftLength,
                                const uint8_t *right, int32_t rightLength);
 
+    /**
+     * Like getOptions() but for the fast script table with the given index.
+     * Returns -1 if there is no such table, or if reordering changes the order
+     * of the special groups, digits and the script relative to each other.
+     */
+    static int32_t getScriptOptions(const CollationData *data, const CollationSettings &settings,
+                                    int32_t scriptTable,
+                                    uint16_t *primaries, int32_t capacity);
+
+    /**
+     * Computes the options and primaries for all fast script tables
+     * and stores them in the settings.
+     */
+    static void setScriptOptions(const CollationData *data, CollationSettings &settings);
+
+    /**
+     * Returns TRUE if the settings already contain the fast script options and primaries
+     * which setScriptOptions() would compute for the data.
+     */
+    static UBool hasScriptOptions(const CollationData *data, const CollationSettings &settings);
+
+    static int32_t compareScriptUTF16(int32_t scriptTable,
+                                      const uint16_t *table, const uint16_t *primaries,
+                                      int32_t options,
+                                      const UChar *left, int32_t leftLength,
+                                      const UChar *right, int32_t rightLength);
+
+    static int32_t compareScriptUTF8(int32_t scriptTable,
+                                     const uint16_t *table, const uint16_t *primaries,
+                                     int32_t options,
+                                     const uint8_t *left, int32_t leftLength,
+                                     const uint8_t *right, int32_t rightLength);
+
 private:
+    static int32_t getOptions(const CollationData *data, const uint16_t *table, int32_t script,
+                              const CollationSettings &settings,
+                              uint16_t *primaries, int32_t capacity);
+
+    template<int32_t blockStart>
+    static int32_t compareBlockUTF16(const uint16_t *table, const uint16_t *primaries,
+                                     int32_t options,
+                                     const UChar *left, int32_t leftLength,
+                                     const UChar *right, int32_t rightLength);
+    template<int32_t blockStart>
+    static int32_t compareBlockUTF8(const uint16_t *table, const uint16_t *primaries,
+                                    int32_t options,
+                                    const uint8_t *left, int32_t leftLength,
+                                    const uint8_t *right, int32_t rightLength);
+
+    /** TRUE if c is ASCII or in the block, with the char index = blockIndex(c). */
+    template<int32_t blockStart>
+    static inline UBool isBlockChar(UChar32 c) {
+        if(blockStart == LATIN_BLOCK_START) { return c <= LATIN_MAX; }
+        return c < 0x80 || (uint32_t)(c - blockStart) < (uint32_t)BLOCK_LENGTH;
+    }
+    template<int32_t blockStart>
+    static inline int32_t blockIndex(UChar32 c) {
+        if(blockStart == LATIN_BLOCK_START || c < 0x80) { return c; }
+        return c - (blockStart - 0x80);
+    }
+
+    /**
+     * Returns the char index for the three-byte character c t1 t2
+     * if the block consists of three-byte characters and contains it, otherwise -1.
+     * The trail bytes need not be valid.
+     */
+    template<int32_t blockStart>
+    static inline int32_t blockIndexUTF8(UChar32 c, uint8_t t1, uint8_t t2) {
+        if(blockStart < 0x800 || c != (0xe0 | (blockStart >> 12)) ||
+                t1 < (0x80 | ((blockStart >> 6) & 0x3f)) ||
+                (0x80 | (((blockStart + BLOCK_LENGTH - 1) >> 6) & 0x3f)) < t1 ||
+                t2 < 0x80 || 0xbf < t2) {
+            return -1;
+        }
+        return ((((c & 0xf) << 12) | ((t1 & 0x3f) << 6) | (t2 & 0x3f)) - (blockStart - 0x80));
+    }
+
     static uint32_t lookup(const uint16_t *table, UChar32 c);
     static uint32_t lookupUTF8(const uint16_t *table, UChar32 c,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength);
+    /** Like lookupUTF8() but also for the characters of a three-byte block. */
+    template<int32_t blockStart>
+    static inline uint32_t lookupBlockUTF8(const uint16_t *table, UChar32 c,
+                                           const uint8_t *s8, int32_t &sIndex, int32_t sLength) {
+        if(blockStart >= 0x800) {
+            int32_t i2 = sIndex + 1;
+            int32_t i;
+            if((i2 < sLength || sLength < 0) &&
+                    (i = blockIndexUTF8<blockStart>(c, s8[sIndex], s8[i2])) >= 0) {
+                sIndex += 2;
+                return table[i];  // includes U+FFFE & U+FFFF in the full-width block
+            }
+        }
+        return lookupUTF8(table, c, s8, sIndex, sLength);
+    }
+    template<int32_t blockStart>
     static uint32_t lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
                                      const uint8_t *s8, int32_t &sIndex);
 
+    template<int32_t blockStart>
     static uint32_t nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength);
 
@@ -270,6 +423,8 @@ private:
  *
  * uint16_t miniCEs[0x1c0]
  *   A mini collation element for each character U+0000..U+017F and U+2000..U+203F.
+ *   (In a fast script table, U+0080..U+017F are replaced by the script's block,
+ *   see BLOCK_LENGTH.)
  *   Each value encodes one or two mini CEs (two are possible if the first one
  *   has a short mini primary and the second one is a secondary CE, i.e., primary == 0),
  *   or points to an expansion or to a contraction table.
@@ -32,6 +32,8 @@
 #include "uassert.h"
 #include "uvectr64.h"
 
+#define LENGTHOF(array) (int32_t)(sizeof(array)/sizeof((array)[0]))
+
 U_NAMESPACE_BEGIN
 
 struct CollationData;
@@ -82,13 +84,36 @@ binarySearch(const int64_t list[], int32_t limit, int64_t ce) {
     }
 }
 
+/**
+ * Characters of a fast script table's block which get mini CEs.
+ * The number of short mini primaries does not suffice for whole blocks.
+ */
+struct FastScript {
+    int32_t script;
+    UChar32 start1, limit1;
+    UChar32 start2, limit2;
+};
+
+const FastScript fastScripts[CollationFastLatin::NUM_SCRIPT_TABLES] = {
+    // Greek and Coptic without the combining marks.
+    { USCRIPT_GREEK, 0x370, 0x400, 0, 0 },
+    // Basic Cyrillic, plus Ukrainian ghe with upturn.
+    { USCRIPT_CYRILLIC, 0x400, 0x460, 0x490, 0x492 },
+    // Full-width ASCII variants and brackets, and full-width signs;
+    // not the halfwidth Katakana & Hangul, nor U+FFFE & U+FFFF.
+    { USCRIPT_LATIN, 0xff01, 0xff61, 0xffe0, 0xffe7 }
+};
+
 }  // namespace
 
 CollationFastLatinBuilder::CollationFastLatinBuilder(UErrorCode &errorCode)
         : ce0(0), ce1(0),
           contractionCEs(errorCode), uniqueCEs(errorCode),
           miniCEs(NULL),
-          firstDigitPrimary(0), firstLatinPrimary(0), lastLatinPrimary(0),
+          script(USCRIPT_LATIN), blockStart(CollationFastLatin::LATIN_BLOCK_START),
+          scriptTable(-1),
+          firstDigitPrimary(0), lastDigitPrimary(0),
+          firstScriptPrimary(0), lastScriptPrimary(0),
           firstShortPrimary(0), shortPrimaryOverflow(FALSE),
           headerLength(0) {
 }
@@ -99,6 +124,52 @@ CollationFastLatinBuilder::~CollationFastLatinBuilder() {
 
 UBool
 CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorCode) {
+    return build(data, errorCode);
+}
+
+UBool
+CollationFastLatinBuilder::forScript(const CollationData &data, int32_t scriptTable,
+                                     UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    if(scriptTable < 0 || CollationFastLatin::NUM_SCRIPT_TABLES <= scriptTable) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    this->scriptTable = scriptTable;
+    script = fastScripts[scriptTable].script;
+    blockStart = CollationFastLatin::getBlockStart(scriptTable);
+    return build(data, errorCode);
+}
+
+UBool
+CollationFastLatinBuilder::tailorsScriptTable(const CollationData &data, int32_t scriptTable) {
+    U_ASSERT(0 <= scriptTable && scriptTable < CollationFastLatin::NUM_SCRIPT_TABLES);
+    const FastScript &fs = fastScripts[scriptTable];
+    // The same characters as in getCEs() which isFastChar() does not exclude.
+    const UChar32 ranges[] = {
+        0, 0x80, fs.start1, fs.limit1, fs.start2, fs.limit2,
+        CollationFastLatin::PUNCT_START, CollationFastLatin::PUNCT_LIMIT
+    };
+    const CollationData *baseData = data.base;
+    for(int32_t i = 0; i < LENGTHOF(ranges); i += 2) {
+        for(UChar32 c = ranges[i]; c < ranges[i + 1]; ++c) {
+            // getFinalCE32() fetches the normal ce32 for U+0000, which always has a U0000_TAG.
+            uint32_t ce32 = data.getFinalCE32(data.getCE32(c));
+            if(ce32 == Collation::FALLBACK_CE32) { continue; }
+            // A self-contained ce32 which is the same as the base's yields the same CE.
+            // (For example, U+0000 maps to 0 in every data.)
+            if(baseData != NULL && Collation::isSimpleOrLongCE32(ce32) &&
+                    ce32 == baseData->getFinalCE32(baseData->getCE32(c))) {
+                continue;
+            }
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+UBool
+CollationFastLatinBuilder::build(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     if(!result.isEmpty()) {  // This builder is not reusable.
         errorCode = U_INVALID_STATE_ERROR;
@@ -113,7 +184,7 @@ CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorC
     if(shortPrimaryOverflow) {
         // Give digits long mini primaries,
         // so that there are more short primaries for letters.
-        firstShortPrimary = firstLatinPrimary;
+        firstShortPrimary = firstScriptPrimary;
         resetCEs();
         getCEs(data, errorCode);
         if(!encodeUniqueCEs(errorCode)) { return FALSE; }
@@ -139,9 +210,10 @@ CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &err
     result.append(0);  // reserved for version & headerLength
     // The first few reordering groups should be special groups
     // (space, punct, ..., digit) followed by Latn, then Grek and other scripts.
+    // The groups between the digits and the table's script are skipped.
     for(int32_t i = 0;;) {
         if(i >= data.scriptsLength) {
-            // no Latn script
+            // no Latn (or other table) script
             errorCode = U_INTERNAL_PROGRAM_ERROR;
             return FALSE;
         }
@@ -150,17 +222,18 @@ CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &err
         int32_t group = data.scripts[i + 2];
         if(group == UCOL_REORDER_CODE_DIGIT) {
             firstDigitPrimary = (head & 0xff00) << 16;
+            lastDigitPrimary = (lastByte << 24) | 0xffffff;
             headerLength = result.length();
             uint32_t r0 = (CollationFastLatin::VERSION << 8) | headerLength;
             result.setCharAt(0, (UChar)r0);
-        } else if(group == USCRIPT_LATIN) {
+        } else if(group == script) {
             if(firstDigitPrimary == 0) {
                 // no digit group
                 errorCode = U_INTERNAL_PROGRAM_ERROR;
                 return FALSE;
             }
-            firstLatinPrimary = (head & 0xff00) << 16;
-            lastLatinPrimary = (lastByte << 24) | 0xffffff;
+            firstScriptPrimary = (head & 0xff00) << 16;
+            lastScriptPrimary = (lastByte << 24) | 0xffffff;
             break;
         } else if(firstDigitPrimary == 0) {
             // a group below digits
@@ -209,6 +282,20 @@ CollationFastLatinBuilder::inSameGroup(uint32_t p, uint32_t q) const {
     }
 }
 
+UBool
+CollationFastLatinBuilder::isFastChar(const CollationData &data, UChar32 c) const {
+    if(scriptTable >= 0 && 0x80 <= c &&
+            (uint32_t)(c - blockStart) < (uint32_t)CollationFastLatin::BLOCK_LENGTH) {
+        const FastScript &fs = fastScripts[scriptTable];
+        if(!((fs.start1 <= c && c < fs.limit1) || (fs.start2 <= c && c < fs.limit2))) {
+            return FALSE;
+        }
+    }
+    // A character with a non-zero lead combining class could need FCD normalization
+    // which the fast path does not perform.
+    return data.getFCD16(c) <= 0xff;
+}
+
 void
 CollationFastLatinBuilder::resetCEs() {
     contractionCEs.removeAllElements();
@@ -221,12 +308,21 @@ void
 CollationFastLatinBuilder::getCEs(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return; }
     int32_t i = 0;
-    for(UChar c = 0;; ++i, ++c) {
-        if(c == CollationFastLatin::LATIN_LIMIT) {
+    // UChar32 so that the full-width block does not wrap around after U+FFFF.
+    for(UChar32 c = 0;; ++i, ++c) {
+        if(c == 0x80) {
+            c = blockStart;
+        } else if(c == blockStart + CollationFastLatin::BLOCK_LENGTH) {
             c = CollationFastLatin::PUNCT_START;
         } else if(c == CollationFastLatin::PUNCT_LIMIT) {
             break;
         }
+        if(!isFastChar(data, c)) {
+            // bail out for c
+            charCEs[i][0] = Collation::NO_CE;
+            charCEs[i][1] = 0;
+            continue;
+        }
         const CollationData *d;
         uint32_t ce32 = data.getCE32(c);
         if(ce32 == Collation::FALLBACK_CE32) {
@@ -319,8 +415,8 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
     // We do not support an ignorable ce0 unless it is completely ignorable.
     uint32_t p0 = (uint32_t)(ce0 >> 32);
     if(p0 == 0) { return FALSE; }
-    // We only support primaries up to the Latin script.
-    if(p0 > lastLatinPrimary) { return FALSE; }
+    // We only support primaries of the special groups, digits and the table's script.
+    if(!isSupportedPrimary(p0)) { return FALSE; }
     // We support non-common secondary and case weights only together with short primaries.
     uint32_t lower32_0 = (uint32_t)ce0;
     if(p0 < firstShortPrimary) {
@@ -337,6 +433,7 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
         // and determine for both whether they are variable.
         uint32_t p1 = (uint32_t)(ce1 >> 32);
         if(p1 == 0 ? p0 < firstShortPrimary : !inSameGroup(p0, p1)) { return FALSE; }
+        if(p1 != 0 && !isSupportedPrimary(p1)) { return FALSE; }
         uint32_t lower32_1 = (uint32_t)ce1;
         // No tertiary CEs.
         if((lower32_1 >> 16) == 0) { return FALSE; }
@@ -377,7 +474,8 @@ CollationFastLatinBuilder::getCEsFromContractionCE32(const CollationData &data,
     UCharsTrie::Iterator suffixes(p + 2, 0, errorCode);
     while(suffixes.next(errorCode)) {
         const UnicodeString &suffix = suffixes.getString();
-        int32_t x = CollationFastLatin::getCharIndex(suffix.charAt(0));
+        UChar c = suffix.charAt(0);
+        int32_t x = CollationFastLatin::getCharIndex(c, blockStart);
         if(x < 0) { continue; }  // ignore anything but fast Latin text
         if(x == prevX) {
             if(addContraction) {
@@ -391,7 +489,8 @@ CollationFastLatinBuilder::getCEsFromContractionCE32(const CollationData &data,
             addContractionEntry(prevX, ce0, ce1, errorCode);
         }
         ce32 = (uint32_t)suffixes.getValue();
-        if(suffix.length() == 1 && getCEsFromCE32(data, U_SENTINEL, ce32, errorCode)) {
+        if(suffix.length() == 1 && data.getFCD16(c) <= 0xff &&
+                getCEsFromCE32(data, U_SENTINEL, ce32, errorCode)) {
             addContraction = TRUE;
         } else {
             addContractionEntry(x, Collation::NO_CE, 0, errorCode);
@@ -582,13 +681,17 @@ UBool
 CollationFastLatinBuilder::encodeCharCEs(UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     int32_t miniCEsStart = result.length();
-    for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
-        result.append(0);  // initialize to completely ignorable
-    }
+    // Reserve the mini CEs so that expansions are appended after them,
+    // and write them all at once at the end.
+    result.padTrailing(miniCEsStart + CollationFastLatin::NUM_FAST_CHARS, 0);
     int32_t indexBase = result.length();
+    UChar charMiniCEs[CollationFastLatin::NUM_FAST_CHARS];
     for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
         int64_t ce = charCEs[i][0];
-        if(isContractionCharCE(ce)) { continue; }  // defer contraction
+        if(isContractionCharCE(ce)) {
+            charMiniCEs[i] = 0;  // completely ignorable until encodeContractions()
+            continue;
+        }
         uint32_t miniCE = encodeTwoCEs(ce, charCEs[i][1]);
         if(miniCE > 0xffff) {
             // Note: There is a chance that this new expansion is the same as a previous one,
@@ -602,8 +705,10 @@ CollationFastLatinBuilder::encodeCharCEs(UErrorCode &errorCode) {
                 miniCE = CollationFastLatin::EXPANSION | expansionIndex;
             }
         }
-        result.setCharAt(miniCEsStart + i, (UChar)miniCE);
+        charMiniCEs[i] = (UChar)miniCE;
     }
+    result.replace(miniCEsStart, CollationFastLatin::NUM_FAST_CHARS,
+                   charMiniCEs, 0, CollationFastLatin::NUM_FAST_CHARS);
     return U_SUCCESS(errorCode);
 }
 
@@ -667,6 +772,8 @@ CollationFastLatinBuilder::encodeContractions(UErrorCode &errorCode) {
         UChar32 c = i - headerLength;
         if(c >= CollationFastLatin::LATIN_LIMIT) {
             c = CollationFastLatin::PUNCT_START + c - CollationFastLatin::LATIN_LIMIT;
+        } else if(c >= 0x80) {
+            c += blockStart - 0x80;
         }
         printf("\n %04x:", c);
         for(int32_t j = 0; j < 16; ++j) {
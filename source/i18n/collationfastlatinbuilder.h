@@ -32,6 +32,21 @@ public:
     ~CollationFastLatinBuilder();
 
     UBool forData(const CollationData &data, UErrorCode &errorCode);
+    /**
+     * Builds a fast script table (see CollationFastLatin::GREEK_TABLE etc.).
+     * Only the script's common letters (or the full-width ASCII variants & signs)
+     * get mini CEs, other characters in its block bail out,
+     * so that the short mini primaries suffice.
+     */
+    UBool forScript(const CollationData &data, int32_t scriptTable, UErrorCode &errorCode);
+
+    /**
+     * Returns TRUE if the tailoring data has its own mappings for any of the characters
+     * which can get mini CEs in the fast script table.
+     * If not, and if the data shares the base data's scripts,
+     * then forScript() would build the same table as for the base data.
+     */
+    static UBool tailorsScriptTable(const CollationData &data, int32_t scriptTable);
 
     const uint16_t *getTable() const {
         return reinterpret_cast<const uint16_t *>(result.getBuffer());
@@ -39,8 +54,13 @@ public:
     int32_t lengthOfTable() const { return result.length(); }
 
 private:
+    UBool build(const CollationData &data, UErrorCode &errorCode);
     UBool loadGroups(const CollationData &data, UErrorCode &errorCode);
     UBool inSameGroup(uint32_t p, uint32_t q) const;
+    UBool isSupportedPrimary(uint32_t p) const {
+        return p <= lastDigitPrimary || (firstScriptPrimary <= p && p <= lastScriptPrimary);
+    }
+    UBool isFastChar(const CollationData &data, UChar32 c) const;
 
     void resetCEs();
     void getCEs(const CollationData &data, UErrorCode &errorCode);
@@ -73,10 +93,18 @@ private:
     /** One 16-bit mini CE per unique CE. */
     uint16_t *miniCEs;
 
+    /** USCRIPT_LATIN or the script of a fast script table. */
+    int32_t script;
+    /** CollationFastLatin::LATIN_BLOCK_START or the block start of a fast script table. */
+    int32_t blockStart;
+    /** Index into the fast script definitions, or -1 for Latin. */
+    int32_t scriptTable;
+
     // These are constant for a given list of CollationData.scripts.
     uint32_t firstDigitPrimary;
-    uint32_t firstLatinPrimary;
-    uint32_t lastLatinPrimary;
+    uint32_t lastDigitPrimary;
+    uint32_t firstScriptPrimary;
+    uint32_t lastScriptPrimary;
     // This determines the first normal primary weight which is mapped to
     // a short mini primary. It must be >=firstDigitPrimary.
     uint32_t firstShortPrimary;
@@ -15,6 +15,7 @@
 
 #include "unicode/bytestream.h"
 #include "collation.h"
+#include "collationdata.h"
 #include "collationiterator.h"
 #include "collationkeys.h"
 #include "collationsettings.h"
@@ -690,6 +691,185 @@ CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
     }
 }
 
+UBool
+CollationKeys::writeFastSortKey(const CollationData &data,
+                                const CollationSettings &settings,
+                                const UChar *s, const UChar *limit,
+                                SortKeyByteSink &sink, UErrorCode &errorCode) {
+    // This is a reduced copy of writeSortKeyUpToQuaternary()
+    // for strings of characters with at most two context-free CEs each.
+    // Keep them in sync!
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    const int64_t *table = data.fastKeyCEs;
+    if(table == NULL) { return FALSE; }
+
+    int32_t options = settings.options;
+    int32_t strength = CollationSettings::getStrength(options);
+    if(strength > UCOL_TERTIARY ||
+            (options & (CollationSettings::NUMERIC | CollationSettings::CASE_LEVEL |
+                        CollationSettings::BACKWARD_SECONDARY)) != 0 ||
+            (strength == UCOL_TERTIARY && (options & CollationSettings::CASE_FIRST) != 0)) {
+        return FALSE;
+    }
+    uint32_t levels = levelMasks[strength];
+
+    uint32_t variableTop;
+    if((options & CollationSettings::ALTERNATE_MASK) == 0) {
+        variableTop = 0;
+    } else {
+        // +1 so that we can use "<" and primary ignorables test out early.
+        variableTop = settings.variableTop + 1;
+    }
+    const uint8_t *reorderTable = settings.reorderTable;
+    const UBool *compressibleBytes = data.compressibleBytes;
+
+    // The primary level is buffered too so that we can bail out
+    // without having written anything.
+    SortKeyLevel primaries;
+    SortKeyLevel secondaries;
+    SortKeyLevel tertiaries;
+
+    uint32_t compressedP1 = 0;  // 0==no compression; otherwise reordered compressible lead byte
+    int32_t commonSecondaries = 0;
+    int32_t commonTertiaries = 0;
+
+    int64_t nextCE = 0;  // second CE of the current character, if any
+    UBool skipIgnorables = FALSE;  // after a variable CE, which is not written at all
+
+    for(;;) {
+        int64_t ce;
+        if(nextCE != 0) {
+            ce = nextCE;
+            nextCE = 0;
+        } else if(s == limit || (limit == NULL && *s == 0)) {
+            // s == limit == NULL for an empty string without a buffer.
+            ce = Collation::NO_CE;
+        } else {
+            UChar c = *s++;
+            if(c >= CollationData::FAST_KEY_LIMIT) { return FALSE; }
+            const int64_t *ces = table + 2 * c;
+            ce = ces[0];
+            if(ce == Collation::NO_CE) { return FALSE; }
+            nextCE = ces[1];
+        }
+        uint32_t p = (uint32_t)(ce >> 32);
+        if(p == 0) {
+            if(skipIgnorables) { continue; }
+        } else if(p < variableTop && p > Collation::MERGE_SEPARATOR_PRIMARY) {
+            // Variable CE, shifted to the quaternary level which is not written here.
+            // Ignore all following primary ignorables.
+            skipIgnorables = TRUE;
+            continue;
+        } else {
+            skipIgnorables = FALSE;
+        }
+        if(p > Collation::NO_CE_PRIMARY) {
+            uint32_t p1 = p >> 24;
+            if(reorderTable != NULL) { p1 = reorderTable[p1]; }
+            if(p1 != compressedP1) {
+                if(compressedP1 != 0) {
+                    if(p1 < compressedP1) {
+                        // No primary compression terminator
+                        // at the end of the level or merged segment.
+                        if(p1 > Collation::MERGE_SEPARATOR_BYTE) {
+                            primaries.appendByte(Collation::PRIMARY_COMPRESSION_LOW_BYTE);
+                        }
+                    } else {
+                        primaries.appendByte(Collation::PRIMARY_COMPRESSION_HIGH_BYTE);
+                    }
+                }
+                primaries.appendByte(p1);
+                // Test the un-reordered lead byte for compressibility but
+                // remember the reordered lead byte.
+                if(compressibleBytes[p >> 24]) {
+                    compressedP1 = p1;
+                } else {
+                    compressedP1 = 0;
+                }
+            }
+            if((p & 0xff0000) != 0) {
+                // Appends the second primary byte and any non-zero bytes after it.
+                primaries.appendWeight32(p << 8);
+            }
+        }
+
+        uint32_t lower32 = (uint32_t)ce;
+        if(lower32 == 0) { continue; }  // completely ignorable, no secondary/tertiary
+
+        if((levels & Collation::SECONDARY_LEVEL_FLAG) != 0) {
+            uint32_t sw = lower32 >> 16;
+            if(sw == 0) {
+                // secondary ignorable
+            } else if(sw == Collation::COMMON_WEIGHT16) {
+                ++commonSecondaries;
+            } else {
+                if(commonSecondaries != 0) {
+                    --commonSecondaries;
+                    while(commonSecondaries >= SEC_COMMON_MAX_COUNT) {
+                        secondaries.appendByte(SEC_COMMON_MIDDLE);
+                        commonSecondaries -= SEC_COMMON_MAX_COUNT;
+                    }
+                    uint32_t b;
+                    if(sw < Collation::COMMON_WEIGHT16) {
+                        b = SEC_COMMON_LOW + commonSecondaries;
+                    } else {
+                        b = SEC_COMMON_HIGH - commonSecondaries;
+                    }
+                    secondaries.appendByte(b);
+                    commonSecondaries = 0;
+                }
+                secondaries.appendWeight16(sw);
+            }
+        }
+
+        if((levels & Collation::TERTIARY_LEVEL_FLAG) != 0) {
+            // Tertiary weights without case bits.
+            uint32_t t = lower32 & Collation::ONLY_TERTIARY_MASK;
+            if(t == Collation::COMMON_WEIGHT16) {
+                ++commonTertiaries;
+            } else {
+                if(commonTertiaries != 0) {
+                    --commonTertiaries;
+                    while(commonTertiaries >= TER_ONLY_COMMON_MAX_COUNT) {
+                        tertiaries.appendByte(TER_ONLY_COMMON_MIDDLE);
+                        commonTertiaries -= TER_ONLY_COMMON_MAX_COUNT;
+                    }
+                    uint32_t b;
+                    if(t < Collation::COMMON_WEIGHT16) {
+                        b = TER_ONLY_COMMON_LOW + commonTertiaries;
+                    } else {
+                        b = TER_ONLY_COMMON_HIGH - commonTertiaries;
+                    }
+                    tertiaries.appendByte(b);
+                    commonTertiaries = 0;
+                }
+                if(t > Collation::COMMON_WEIGHT16) { t += 0xc000; }
+                tertiaries.appendWeight16(t);
+            }
+        }
+
+        if((lower32 >> 24) == Collation::LEVEL_SEPARATOR_BYTE) { break; }  // ce == NO_CE
+    }
+
+    UBool ok = primaries.isOk();
+    sink.Append(reinterpret_cast<const char *>(primaries.data()), primaries.length());
+    if((levels & Collation::SECONDARY_LEVEL_FLAG) != 0) {
+        ok &= secondaries.isOk();
+        sink.Append(Collation::LEVEL_SEPARATOR_BYTE);
+        // Ignore the trailing NO_CE.
+        sink.Append(reinterpret_cast<const char *>(secondaries.data()), secondaries.length() - 1);
+    }
+    if((levels & Collation::TERTIARY_LEVEL_FLAG) != 0) {
+        ok &= tertiaries.isOk();
+        sink.Append(Collation::LEVEL_SEPARATOR_BYTE);
+        tertiaries.appendTo(sink);
+    }
+    if(!ok || !sink.IsOk()) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+    }
+    return TRUE;
+}
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_COLLATION
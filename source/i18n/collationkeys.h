@@ -24,6 +24,7 @@
 U_NAMESPACE_BEGIN
 
 class CollationIterator;
+struct CollationData;
 struct CollationDataReader;
 struct CollationSettings;
 
@@ -111,6 +112,23 @@ public:
                                            SortKeyByteSink &sink,
                                            Collation::Level minLevel, LevelCallback &callback,
                                            UBool preflight, UErrorCode &errorCode);
+
+    /**
+     * Fast path for writeSortKeyUpToQuaternary() with minLevel=PRIMARY_LEVEL:
+     * Writes the sort key bytes up to the tertiary level
+     * for a string of characters that have data.fastKeyCEs,
+     * looking up their CEs directly without a CollationIterator.
+     * Supports fewer settings than the general function.
+     *
+     * @param limit the end of the string, or NULL if s is NUL-terminated
+     * @return TRUE if the sort key was written;
+     *         FALSE if nothing was written because the string or the settings
+     *         are not supported
+     */
+    static UBool writeFastSortKey(const CollationData &data,
+                                  const CollationSettings &settings,
+                                  const UChar *s, const UChar *limit,
+                                  SortKeyByteSink &sink, UErrorCode &errorCode);
 private:
     friend struct CollationDataReader;
 
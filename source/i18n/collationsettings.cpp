@@ -43,6 +43,13 @@ CollationSettings::CollationSettings(const CollationSettings &other)
     if(fastLatinOptions >= 0) {
         uprv_memcpy(fastLatinPrimaries, other.fastLatinPrimaries, sizeof(fastLatinPrimaries));
     }
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_TABLES; ++i) {
+        fastScriptOptions[i] = other.fastScriptOptions[i];
+        if(fastScriptOptions[i] >= 0) {
+            uprv_memcpy(fastScriptPrimaries[i], other.fastScriptPrimaries[i],
+                        sizeof(fastScriptPrimaries[i]));
+        }
+    }
 }
 
 CollationSettings::~CollationSettings() {
@@ -18,6 +18,7 @@
 
 #include "unicode/ucol.h"
 #include "collation.h"
+#include "collationfastlatin.h"
 #include "sharedobject.h"
 #include "umutex.h"
 
@@ -104,7 +105,11 @@ struct U_I18N_API CollationSettings : public SharedObject {
               variableTop(0),
               reorderTable(NULL),
               reorderCodes(NULL), reorderCodesLength(0), reorderCodesCapacity(0),
-              fastLatinOptions(-1) {}
+              fastLatinOptions(-1) {
+        for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_TABLES; ++i) {
+            fastScriptOptions[i] = -1;
+        }
+    }
 
     CollationSettings(const CollationSettings &other);
     virtual ~CollationSettings();
@@ -211,6 +216,9 @@ struct U_I18N_API CollationSettings : public SharedObject {
     /** Options for CollationFastLatin. Negative if disabled. */
     int32_t fastLatinOptions;
     uint16_t fastLatinPrimaries[0x180];
+    /** Options for the CollationFastLatin script tables. Negative if disabled. */
+    int32_t fastScriptOptions[CollationFastLatin::NUM_SCRIPT_TABLES];
+    uint16_t fastScriptPrimaries[CollationFastLatin::NUM_SCRIPT_TABLES][0x180];
 };
 
 U_NAMESPACE_END
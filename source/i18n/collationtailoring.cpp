@@ -20,6 +20,7 @@
 #include "unicode/uvernum.h"
 #include "cmemory.h"
 #include "collationdata.h"
+#include "collationfastlatinbuilder.h"
 #include "collationsettings.h"
 #include "collationtailoring.h"
 #include "normalizer2impl.h"
@@ -36,7 +37,7 @@ CollationTailoring::CollationTailoring(const CollationSettings *baseSettings)
           ownedData(NULL),
           builder(NULL), memory(NULL), bundle(NULL),
           trie(NULL), unsafeBackwardSet(NULL),
-          maxExpansions(NULL) {
+          maxExpansions(NULL), fastKeyCEs(NULL) {
     if(baseSettings != NULL) {
         U_ASSERT(baseSettings->reorderCodesLength == 0);
         U_ASSERT(baseSettings->reorderTable == NULL);
@@ -61,6 +62,7 @@ CollationTailoring::~CollationTailoring() {
     delete unsafeBackwardSet;
     uhash_close(maxExpansions);
     maxExpansionsInitOnce.reset();
+    uprv_free(fastKeyCEs);
 }
 
 UBool
@@ -79,6 +81,135 @@ CollationTailoring::ensureOwnedData(UErrorCode &errorCode) {
     return TRUE;
 }
 
+void
+CollationTailoring::buildFastScriptTables(UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode) || ownedData == NULL) { return; }
+    const CollationData *baseData = ownedData->base;
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_TABLES; ++i) {
+        ownedData->fastScriptTables[i] = NULL;
+        ownedData->fastScriptTableLengths[i] = 0;
+        fastScriptTables[i].remove();
+        if(baseData != NULL && ownedData->scripts == baseData->scripts &&
+                !CollationFastLatinBuilder::tailorsScriptTable(*ownedData, i)) {
+            // Building the table would yield the base table, share that without building it.
+            ownedData->fastScriptTables[i] = baseData->fastScriptTables[i];
+            ownedData->fastScriptTableLengths[i] = baseData->fastScriptTableLengths[i];
+            continue;
+        }
+        CollationFastLatinBuilder fastBuilder(errorCode);
+        if(!fastBuilder.forScript(*ownedData, i, errorCode)) { continue; }
+        const uint16_t *table = fastBuilder.getTable();
+        int32_t length = fastBuilder.lengthOfTable();
+        ownedData->fastScriptTableLengths[i] = length;
+        if(baseData != NULL && length == baseData->fastScriptTableLengths[i] &&
+                uprv_memcmp(table, baseData->fastScriptTables[i], length * 2) == 0) {
+            // Same table as in the base, use that one instead.
+            ownedData->fastScriptTables[i] = baseData->fastScriptTables[i];
+        } else {
+            fastScriptTables[i].setTo(reinterpret_cast<const UChar *>(table), length);
+            if(fastScriptTables[i].isBogus()) {
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+                return;
+            }
+            ownedData->fastScriptTables[i] =
+                reinterpret_cast<const uint16_t *>(fastScriptTables[i].getBuffer());
+        }
+    }
+}
+
+namespace {
+
+/**
+ * Sets ces[0..1] to the one or two CEs for c,
+ * or ces[0] to NO_CE if c is not suitable for the sort key fast path.
+ */
+void
+getFastKeyCEs(const CollationData *d, UChar32 c, int64_t ces[2]) {
+    ces[0] = Collation::NO_CE;
+    ces[1] = 0;
+    // With lccc=0 the FCD check passes for any sequence of such characters.
+    // U+0000 has special handling for NUL-terminated strings.
+    if(c == 0 || (d->getFCD16(c) >> 8) != 0) { return; }
+    uint32_t ce32 = d->getCE32(c);
+    if(ce32 == Collation::FALLBACK_CE32) {
+        d = d->base;
+        if(d == NULL) { return; }
+        ce32 = d->getCE32(c);
+    }
+    if(Collation::hasCE32Tag(ce32, Collation::DIGIT_TAG)) {
+        // Numeric collation does not use the fast path.
+        ce32 = d->ce32s[Collation::indexFromCE32(ce32)];
+    } else if(Collation::hasCE32Tag(ce32, Collation::CONTRACTION_TAG) &&
+            (ce32 & Collation::CONTRACT_NEXT_CCC) != 0) {
+        // All contraction suffixes start with characters with lccc!=0
+        // but all fast path characters have lccc==0, so the default mapping applies.
+        ce32 = CollationData::readCE32(d->contexts + Collation::indexFromCE32(ce32));
+    }
+    if(!Collation::isSpecialCE32(ce32)) {
+        ces[0] = Collation::ceFromSimpleCE32(ce32);
+        return;
+    }
+    switch(Collation::tagFromCE32(ce32)) {
+    case Collation::LONG_PRIMARY_TAG:
+    case Collation::LONG_SECONDARY_TAG:
+        ces[0] = Collation::ceFromCE32(ce32);
+        break;
+    case Collation::LATIN_EXPANSION_TAG:
+        ces[0] = Collation::latinCE0FromCE32(ce32);
+        ces[1] = Collation::latinCE1FromCE32(ce32);
+        break;
+    case Collation::EXPANSION32_TAG: {
+        int32_t length = Collation::lengthFromCE32(ce32);
+        if(length <= 2) {
+            const uint32_t *ce32s = d->ce32s + Collation::indexFromCE32(ce32);
+            ces[0] = Collation::ceFromCE32(ce32s[0]);
+            if(length == 2) { ces[1] = Collation::ceFromCE32(ce32s[1]); }
+        }
+        break;
+    }
+    case Collation::EXPANSION_TAG: {
+        int32_t length = Collation::lengthFromCE32(ce32);
+        if(length <= 2) {
+            const int64_t *ces64 = d->ces + Collation::indexFromCE32(ce32);
+            ces[0] = ces64[0];
+            if(length == 2) { ces[1] = ces64[1]; }
+        }
+        break;
+    }
+    default:
+        // contexts, Hangul, implicit weights etc.
+        break;
+    }
+}
+
+}  // namespace
+
+void
+CollationTailoring::buildFastKeyTable(UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode) || ownedData == NULL) { return; }
+    ownedData->fastKeyCEs = NULL;
+    uprv_free(fastKeyCEs);
+    int32_t length = 2 * CollationData::FAST_KEY_LIMIT;
+    fastKeyCEs = (int64_t *)uprv_malloc(length * 8);
+    if(fastKeyCEs == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for(UChar32 c = 0; c < CollationData::FAST_KEY_LIMIT; ++c) {
+        getFastKeyCEs(ownedData, c, fastKeyCEs + 2 * c);
+    }
+    const CollationData *baseData = ownedData->base;
+    if(baseData != NULL && baseData->fastKeyCEs != NULL &&
+            uprv_memcmp(fastKeyCEs, baseData->fastKeyCEs, length * 8) == 0) {
+        // Same table as in the base, use that one instead.
+        uprv_free(fastKeyCEs);
+        fastKeyCEs = NULL;
+        ownedData->fastKeyCEs = baseData->fastKeyCEs;
+    } else {
+        ownedData->fastKeyCEs = fastKeyCEs;
+    }
+}
+
 void
 CollationTailoring::makeBaseVersion(const UVersionInfo ucaVersion, UVersionInfo version) {
     version[0] = UCOL_BUILDER_VERSION;
@@ -101,6 +232,10 @@ CollationTailoring::getUCAVersion() const {
     return ((int32_t)version[1] << 4) | (version[2] >> 6);
 }
 
+CollationCacheEntry::~CollationCacheEntry() {
+    SharedObject::clearPtr(tailoring);
+}
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_COLLATION
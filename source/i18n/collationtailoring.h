@@ -19,6 +19,7 @@
 #include "unicode/locid.h"
 #include "unicode/unistr.h"
 #include "unicode/uversion.h"
+#include "collationfastlatin.h"
 #include "collationsettings.h"
 #include "uhash.h"
 #include "umutex.h"
@@ -54,6 +55,18 @@ struct U_I18N_API CollationTailoring : public SharedObject {
 
     UBool ensureOwnedData(UErrorCode &errorCode);
 
+    /**
+     * Builds the fast script tables for the ownedData.
+     * Tables that are identical to the base data's are shared with the base.
+     */
+    void buildFastScriptTables(UErrorCode &errorCode);
+
+    /**
+     * Builds the sort key fast path table for the ownedData.
+     * The table is shared with the base data if they are identical.
+     */
+    void buildFastKeyTable(UErrorCode &errorCode);
+
     static void makeBaseVersion(const UVersionInfo ucaVersion, UVersionInfo version);
     void setVersion(const UVersionInfo baseVersion, const UVersionInfo rulesVersion);
     int32_t getUCAVersion() const;
@@ -81,6 +94,8 @@ struct U_I18N_API CollationTailoring : public SharedObject {
     UnicodeSet *unsafeBackwardSet;
     mutable UHashtable *maxExpansions;
     mutable UInitOnce maxExpansionsInitOnce;
+    UnicodeString fastScriptTables[CollationFastLatin::NUM_SCRIPT_TABLES];
+    int64_t *fastKeyCEs;
 
 private:
     /**
@@ -90,6 +105,24 @@ private:
     CollationTailoring(const CollationTailoring &other);
 };
 
+/**
+ * A tailoring as loaded for a locale ID, with the valid locale and
+ * the warning status from loading it.
+ * Shared between the collation tailoring cache and its users.
+ */
+struct CollationCacheEntry : public SharedObject {
+    CollationCacheEntry(const Locale &loc, const CollationTailoring *t, UErrorCode warning)
+            : validLocale(loc), tailoring(t), status(warning) {
+        t->addRef();
+    }
+    virtual ~CollationCacheEntry();
+
+    Locale validLocale;
+    const CollationTailoring *tailoring;
+    // U_ZERO_ERROR or a warning like U_USING_DEFAULT_WARNING.
+    UErrorCode status;
+};
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_COLLATION
@@ -20,12 +20,10 @@
 #include "quantityformatter.h"
 #include "unicode/plurrule.h"
 #include "unicode/decimfmt.h"
-#include "lrucache.h"
+#include "unifiedcache.h"
 #include "uresimp.h"
 #include "unicode/ures.h"
 #include "cstring.h"
-#include "mutex.h"
-#include "ucln_in.h"
 #include "unicode/listformatter.h"
 #include "charstr.h"
 #include "unicode/putil.h"
@@ -38,21 +36,6 @@
 #define MEAS_UNIT_COUNT 46
 #define WIDTH_INDEX_COUNT (UMEASFMT_WIDTH_NARROW + 1)
 
-static icu::LRUCache *gCache = NULL;
-static UMutex gCacheMutex = U_MUTEX_INITIALIZER;
-static icu::UInitOnce gCacheInitOnce = U_INITONCE_INITIALIZER;
-
-U_CDECL_BEGIN
-static UBool U_CALLCONV measfmt_cleanup() {
-    gCacheInitOnce.reset();
-    if (gCache) {
-        delete gCache;
-        gCache = NULL;
-    }
-    return TRUE;
-}
-U_CDECL_END
-
 U_NAMESPACE_BEGIN
 
 UOBJECT_DEFINE_RTTI_IMPLEMENTATION(MeasureFormat)
@@ -305,6 +288,7 @@ static NumericDateFormatters *loadNumericDateFormatters(
 // Creates the MeasureFormatCacheData for a particular locale
 static SharedObject *U_CALLCONV createData(
         const char *localeId, UErrorCode &status) {
+    U_ASSERT(MeasureUnit::getIndexCount() == MEAS_UNIT_COUNT);
     LocalUResourceBundlePointer topLevel(ures_open(NULL, localeId, &status));
     static UNumberFormatStyle currencyStyles[] = {
             UNUM_CURRENCY_PLURAL, UNUM_CURRENCY_ISO, UNUM_CURRENCY};
@@ -349,27 +333,18 @@ static SharedObject *U_CALLCONV createData(
     return result.orphan();
 }
 
-static void U_CALLCONV cacheInit(UErrorCode &status) {
-    U_ASSERT(gCache == NULL);
-    U_ASSERT(MeasureUnit::getIndexCount() == MEAS_UNIT_COUNT);
-    ucln_i18n_registerCleanup(UCLN_I18N_MEASFMT, measfmt_cleanup);
-    gCache = new SimpleLRUCache(100, &createData, status);
-    if (U_FAILURE(status)) {
-        delete gCache;
-        gCache = NULL;
-    }
-}
+static const UnifiedCacheType gCacheType =
+        U_UNIFIEDCACHE_TYPE_INITIALIZER("MeasureFormat", &createData);
 
 static UBool getFromCache(
         const char *locale,
         const MeasureFormatCacheData *&ptr,
         UErrorCode &status) {
-    umtx_initOnce(gCacheInitOnce, &cacheInit, status);
+    UnifiedCache *cache = UnifiedCache::getInstance(status);
     if (U_FAILURE(status)) {
         return FALSE;
     }
-    Mutex lock(&gCacheMutex);
-    gCache->get(locale, ptr, status);
+    cache->get(gCacheType, locale, ptr, status);
     return U_SUCCESS(status);
 }
 
@@ -40,7 +40,7 @@
 #include "charstr.h"
 #include "winnmfmt.h"
 #include "uresimp.h"
-#include "uhash.h"
+#include "hash.h"
 #include "cmemory.h"
 #include "servloc.h"
 #include "ucln_in.h"
@@ -52,7 +52,7 @@
 #include "digitlst.h"
 #include <float.h>
 #include "sharednumberformat.h"
-#include "lrucache.h"
+#include "unifiedcache.h"
 
 //#define FMT_DEBUG
 
@@ -146,13 +146,9 @@ static const char *gFormatKeys[UNUM_FORMAT_STYLE_COUNT] = {
     "accountingFormat"  // UNUM_CURRENCY_ACCOUNTING
 };
 
-static icu::LRUCache *gNumberFormatCache = NULL;
-static UMutex gNumberFormatCacheMutex = U_MUTEX_INITIALIZER;
-static icu::UInitOnce gNumberFormatCacheInitOnce = U_INITONCE_INITIALIZER;
-
 // Static hashtable cache of NumberingSystem objects used by NumberFormat
-static UHashtable * NumberingSystem_cache = NULL;
-static UMutex nscacheMutex = U_MUTEX_INITIALIZER;
+static icu::HashMap<int32_t, icu::NumberingSystem> * NumberingSystem_cache = NULL;
+static URWLock nscacheLock = U_RWLOCK_INITIALIZER;
 static icu::UInitOnce gNSCacheInitOnce = U_INITONCE_INITIALIZER;
 
 #if !UCONFIG_NO_SERVICE
@@ -164,11 +160,6 @@ static icu::UInitOnce gServiceInitOnce = U_INITONCE_INITIALIZER;
  * Release all static memory held by Number Format.
  */
 U_CDECL_BEGIN
-static void U_CALLCONV
-deleteNumberingSystem(void *obj) {
-    delete (icu::NumberingSystem *)obj;
-}
-
 static UBool U_CALLCONV numfmt_cleanup(void) {
 #if !UCONFIG_NO_SERVICE
     gServiceInitOnce.reset();
@@ -178,16 +169,8 @@ static UBool U_CALLCONV numfmt_cleanup(void) {
     }
 #endif
     gNSCacheInitOnce.reset();
-    if (NumberingSystem_cache) {
-        // delete NumberingSystem_cache;
-        uhash_close(NumberingSystem_cache);
-        NumberingSystem_cache = NULL;
-    }
-    gNumberFormatCacheInitOnce.reset();
-    if (gNumberFormatCache) {
-        delete gNumberFormatCache;
-        gNumberFormatCache = NULL;
-    }
+    delete NumberingSystem_cache;
+    NumberingSystem_cache = NULL;
     return TRUE;
 }
 U_CDECL_END
@@ -1229,16 +1212,12 @@ static void U_CALLCONV nscacheInit() {
     U_ASSERT(NumberingSystem_cache == NULL);
     ucln_i18n_registerCleanup(UCLN_I18N_NUMFMT, numfmt_cleanup);
     UErrorCode status = U_ZERO_ERROR;
-    NumberingSystem_cache = uhash_open(uhash_hashLong,
-                                       uhash_compareLong,
-                                       NULL,
-                                       &status);
-    if (U_FAILURE(status)) {
+    NumberingSystem_cache = new HashMap<int32_t, NumberingSystem>(TRUE, status);
+    if (NumberingSystem_cache == NULL || U_FAILURE(status)) {
         // Number Format code will run with no cache if creation fails.
+        delete NumberingSystem_cache;
         NumberingSystem_cache = NULL;
-        return;
     }
-    uhash_setValueDeleter(NumberingSystem_cache, deleteNumberingSystem);
 }
 
 static SharedObject *U_CALLCONV createSharedNumberFormat(
@@ -1260,26 +1239,18 @@ static SharedObject *U_CALLCONV createSharedNumberFormat(
     return result;
 }
 
-static void U_CALLCONV numberFormatCacheInit(UErrorCode &status) {
-    U_ASSERT(gNumberFormatCache == NULL);
-    ucln_i18n_registerCleanup(UCLN_I18N_NUMFMT, numfmt_cleanup);
-    gNumberFormatCache = new SimpleLRUCache(100, &createSharedNumberFormat, status);
-    if (U_FAILURE(status)) {
-        delete gNumberFormatCache;
-        gNumberFormatCache = NULL;
-    }
-}
+static const UnifiedCacheType gNumberFormatCacheType =
+        U_UNIFIEDCACHE_TYPE_INITIALIZER("NumberFormat", &createSharedNumberFormat);
 
 static void getSharedNumberFormatFromCache(
         const char *locale,
         const SharedNumberFormat *&ptr,
         UErrorCode &status) {
-    umtx_initOnce(gNumberFormatCacheInitOnce, &numberFormatCacheInit, status);
+    UnifiedCache *cache = UnifiedCache::getInstance(status);
     if (U_FAILURE(status)) {
         return;
     }
-    Mutex lock(&gNumberFormatCacheMutex);
-    gNumberFormatCache->get(locale, ptr, status);
+    cache->get(gNumberFormatCacheType, locale, ptr, status);
 }
 
 const SharedNumberFormat* U_EXPORT2
@@ -1374,11 +1345,17 @@ NumberFormat::makeInstance(const Locale& desiredLocale,
         // TODO: Bad hash key usage, see ticket #8504.
         int32_t hashKey = desiredLocale.hashCode();
 
-        Mutex lock(&nscacheMutex);
-        ns = (NumberingSystem *)uhash_iget(NumberingSystem_cache, hashKey);
+        {
+            ReadLock lock(&nscacheLock);
+            ns = NumberingSystem_cache->get(hashKey);
+        }
         if (ns == NULL) {
-            ns = NumberingSystem::createInstance(desiredLocale,status);
-            uhash_iput(NumberingSystem_cache, hashKey, (void*)ns, &status);
+            WriteLock lock(&nscacheLock);
+            ns = NumberingSystem_cache->get(hashKey);
+            if (ns == NULL) {
+                ns = NumberingSystem::createInstance(desiredLocale,status);
+                NumberingSystem_cache->put(hashKey, ns, status);
+            }
         }
     } else {
         ownedNs.adoptInstead(NumberingSystem::createInstance(desiredLocale,status));
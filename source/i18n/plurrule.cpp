@@ -25,30 +25,14 @@
 #include "patternprops.h"
 #include "plurrule_impl.h"
 #include "putilimp.h"
-#include "ucln_in.h"
 #include "ustrfmt.h"
 #include "uassert.h"
 #include "uvectr32.h"
 #include "sharedpluralrules.h"
-#include "lrucache.h"
+#include "unifiedcache.h"
 
 #if !UCONFIG_NO_FORMATTING
 
-static icu::LRUCache *gPluralRulesCache = NULL;
-static UMutex gPluralRulesCacheMutex = U_MUTEX_INITIALIZER;
-static icu::UInitOnce gPluralRulesCacheInitOnce = U_INITONCE_INITIALIZER;
-
-U_CDECL_BEGIN
-static UBool U_CALLCONV plurrules_cleanup(void) {
-    gPluralRulesCacheInitOnce.reset();
-    if (gPluralRulesCache) {
-        delete gPluralRulesCache;
-        gPluralRulesCache = NULL;
-    }
-    return TRUE;
-}
-U_CDECL_END
-
 U_NAMESPACE_BEGIN
 
 #define ARRAY_SIZE(array) (int32_t)(sizeof array  / sizeof array[0])
@@ -174,26 +158,18 @@ static SharedObject *U_CALLCONV createSharedPluralRules(
     return result;
 }
 
-static void U_CALLCONV pluralRulesCacheInit(UErrorCode &status) {
-    U_ASSERT(gPluralRulesCache == NULL);
-    ucln_i18n_registerCleanup(UCLN_I18N_PLURAL_RULE, plurrules_cleanup);
-    gPluralRulesCache = new SimpleLRUCache(100, &createSharedPluralRules, status);
-    if (U_FAILURE(status)) {
-        delete gPluralRulesCache;
-        gPluralRulesCache = NULL;
-    }
-}
+static const UnifiedCacheType gPluralRulesCacheType =
+        U_UNIFIEDCACHE_TYPE_INITIALIZER("PluralRules", &createSharedPluralRules);
 
 static void getSharedPluralRulesFromCache(
         const char *locale,
         const SharedPluralRules *&ptr,
         UErrorCode &status) {
-    umtx_initOnce(gPluralRulesCacheInitOnce, &pluralRulesCacheInit, status);
+    UnifiedCache *cache = UnifiedCache::getInstance(status);
     if (U_FAILURE(status)) {
         return;
     }
-    Mutex lock(&gPluralRulesCacheMutex);
-    gPluralRulesCache->get(locale, ptr, status);
+    cache->get(gPluralRulesCacheType, locale, ptr, status);
 }
 
 
@@ -18,12 +18,10 @@
 #include "unicode/msgfmt.h"
 #include "unicode/decimfmt.h"
 #include "unicode/numfmt.h"
-#include "lrucache.h"
+#include "unifiedcache.h"
 #include "uresimp.h"
 #include "unicode/ures.h"
 #include "cstring.h"
-#include "ucln_in.h"
-#include "mutex.h"
 #include "charstr.h"
 
 #include "sharedptr.h"
@@ -33,21 +31,6 @@
 // Copied from uscript_props.cpp
 #define LENGTHOF(array) (int32_t)(sizeof(array)/sizeof((array)[0]))
 
-static icu::LRUCache *gCache = NULL;
-static UMutex gCacheMutex = U_MUTEX_INITIALIZER;
-static icu::UInitOnce gCacheInitOnce = U_INITONCE_INITIALIZER;
-
-U_CDECL_BEGIN
-static UBool U_CALLCONV reldatefmt_cleanup() {
-    gCacheInitOnce.reset();
-    if (gCache) {
-        delete gCache;
-        gCache = NULL;
-    }
-    return TRUE;
-}
-U_CDECL_END
-
 U_NAMESPACE_BEGIN
 
 // RelativeDateTimeFormatter specific data for a single locale
@@ -499,26 +482,18 @@ static SharedObject *U_CALLCONV createData(
     return result.orphan();
 }
 
-static void U_CALLCONV cacheInit(UErrorCode &status) {
-    U_ASSERT(gCache == NULL);
-    ucln_i18n_registerCleanup(UCLN_I18N_RELDATEFMT, reldatefmt_cleanup);
-    gCache = new SimpleLRUCache(100, &createData, status);
-    if (U_FAILURE(status)) {
-        delete gCache;
-        gCache = NULL;
-    }
-}
+static const UnifiedCacheType gCacheType =
+        U_UNIFIEDCACHE_TYPE_INITIALIZER("RelativeDateTimeFormatter", &createData);
 
 static UBool getFromCache(
         const char *locale,
         const RelativeDateTimeCacheData *&ptr,
         UErrorCode &status) {
-    umtx_initOnce(gCacheInitOnce, &cacheInit, status);
+    UnifiedCache *cache = UnifiedCache::getInstance(status);
     if (U_FAILURE(status)) {
         return FALSE;
     }
-    Mutex lock(&gCacheMutex);
-    gCache->get(locale, ptr, status);
+    cache->get(gCacheType, locale, ptr, status);
     return U_SUCCESS(status);
 }
 
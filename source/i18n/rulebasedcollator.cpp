@@ -44,11 +44,13 @@
 #include "collationsettings.h"
 #include "collationtailoring.h"
 #include "cstring.h"
+#include "uarrsort.h"
 #include "uassert.h"
 #include "ucol_imp.h"
 #include "uhash.h"
 #include "uitercollationiterator.h"
 #include "ustr_imp.h"
+#include "ustrsimd.h"
 #include "utf16collationiterator.h"
 #include "utf8collationiterator.h"
 #include "uvectr64.h"
@@ -689,6 +691,7 @@ RuleBasedCollator::setFastLatinOptions(CollationSettings &ownedSettings) const {
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
             data, ownedSettings,
             ownedSettings.fastLatinPrimaries, LENGTHOF(ownedSettings.fastLatinPrimaries));
+    CollationFastLatin::setScriptOptions(data, ownedSettings);
 }
 
 UCollationResult
@@ -983,15 +986,11 @@ RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
     } else {
         leftLimit = left + leftLength;
         rightLimit = right + rightLength;
-        for(;;) {
-            if(equalPrefixLength == leftLength) {
-                if(equalPrefixLength == rightLength) { return UCOL_EQUAL; }
-                break;
-            } else if(equalPrefixLength == rightLength ||
-                      left[equalPrefixLength] != right[equalPrefixLength]) {
-                break;
-            }
-            ++equalPrefixLength;
+        // Long equal prefixes (paths, URLs, ...) are skipped in blocks of code units.
+        equalPrefixLength = uprv_findUCharsDifference(
+            left, right, leftLength <= rightLength ? leftLength : rightLength);
+        if(equalPrefixLength == leftLength && equalPrefixLength == rightLength) {
+            return UCOL_EQUAL;
         }
     }
 
@@ -1039,6 +1038,31 @@ RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
     } else {
         result = CollationFastLatin::BAIL_OUT_RESULT;
     }
+    if(result == CollationFastLatin::BAIL_OUT_RESULT) {
+        // Try the fast Greek, Cyrillic or full-width table for the script
+        // of the first non-ASCII character after the identical prefix.
+        const UChar *leftRest = left + equalPrefixLength;
+        const UChar *rightRest = right + equalPrefixLength;
+        int32_t leftRestLength = leftLength >= 0 ? leftLength - equalPrefixLength : -1;
+        int32_t rightRestLength = leftLength >= 0 ? rightLength - equalPrefixLength : -1;
+        int32_t scriptTable = CollationFastLatin::findScriptTable(leftRest, leftRestLength);
+        if(scriptTable == CollationFastLatin::ALL_ASCII) {
+            scriptTable = CollationFastLatin::findScriptTable(rightRest, rightRestLength);
+        }
+        if(scriptTable == CollationFastLatin::ALL_ASCII) {
+            // Any script table handles ASCII digits, spaces and punctuation.
+            scriptTable = settings->fastScriptOptions[CollationFastLatin::CYRILLIC_TABLE] >= 0 ?
+                    CollationFastLatin::CYRILLIC_TABLE : CollationFastLatin::GREEK_TABLE;
+        }
+        if(scriptTable >= 0 && settings->fastScriptOptions[scriptTable] >= 0) {
+            result = CollationFastLatin::compareScriptUTF16(scriptTable,
+                                                            data->fastScriptTables[scriptTable],
+                                                            settings->fastScriptPrimaries[scriptTable],
+                                                            settings->fastScriptOptions[scriptTable],
+                                                            leftRest, leftRestLength,
+                                                            rightRest, rightRestLength);
+        }
+    }
 
     if(result == CollationFastLatin::BAIL_OUT_RESULT) {
         if(settings->dontCheckFCD()) {
@@ -1096,15 +1120,10 @@ RuleBasedCollator::doCompare(const uint8_t *left, int32_t leftLength,
             ++equalPrefixLength;
         }
     } else {
-        for(;;) {
-            if(equalPrefixLength == leftLength) {
-                if(equalPrefixLength == rightLength) { return UCOL_EQUAL; }
-                break;
-            } else if(equalPrefixLength == rightLength ||
-                      left[equalPrefixLength] != right[equalPrefixLength]) {
-                break;
-            }
-            ++equalPrefixLength;
+        equalPrefixLength = uprv_findBytesDifference(
+            left, right, leftLength <= rightLength ? leftLength : rightLength);
+        if(equalPrefixLength == leftLength && equalPrefixLength == rightLength) {
+            return UCOL_EQUAL;
         }
     }
     // Back up to the start of a partially-equal code point.
@@ -1168,6 +1187,30 @@ RuleBasedCollator::doCompare(const uint8_t *left, int32_t leftLength,
     } else {
         result = CollationFastLatin::BAIL_OUT_RESULT;
     }
+    if(result == CollationFastLatin::BAIL_OUT_RESULT) {
+        // See the notes in the UTF-16 version.
+        const uint8_t *leftRest = left + equalPrefixLength;
+        const uint8_t *rightRest = right + equalPrefixLength;
+        int32_t leftRestLength = leftLength >= 0 ? leftLength - equalPrefixLength : -1;
+        int32_t rightRestLength = leftLength >= 0 ? rightLength - equalPrefixLength : -1;
+        int32_t scriptTable = CollationFastLatin::findScriptTableUTF8(leftRest, leftRestLength);
+        if(scriptTable == CollationFastLatin::ALL_ASCII) {
+            scriptTable = CollationFastLatin::findScriptTableUTF8(rightRest, rightRestLength);
+        }
+        if(scriptTable == CollationFastLatin::ALL_ASCII) {
+            // Any script table handles ASCII digits, spaces and punctuation.
+            scriptTable = settings->fastScriptOptions[CollationFastLatin::CYRILLIC_TABLE] >= 0 ?
+                    CollationFastLatin::CYRILLIC_TABLE : CollationFastLatin::GREEK_TABLE;
+        }
+        if(scriptTable >= 0 && settings->fastScriptOptions[scriptTable] >= 0) {
+            result = CollationFastLatin::compareScriptUTF8(scriptTable,
+                                                           data->fastScriptTables[scriptTable],
+                                                           settings->fastScriptPrimaries[scriptTable],
+                                                           settings->fastScriptOptions[scriptTable],
+                                                           leftRest, leftRestLength,
+                                                           rightRest, rightRestLength);
+        }
+    }
 
     if(result == CollationFastLatin::BAIL_OUT_RESULT) {
         if(settings->dontCheckFCD()) {
@@ -1328,15 +1371,17 @@ RuleBasedCollator::writeSortKey(const UChar *s, int32_t length,
                                 SortKeyByteSink &sink, UErrorCode &errorCode) const {
     if(U_FAILURE(errorCode)) { return; }
     const UChar *limit = (length >= 0) ? s + length : NULL;
-    UBool numeric = settings->isNumeric();
-    CollationKeys::LevelCallback callback;
-    if(settings->dontCheckFCD()) {
-        UTF16CollationIterator iter(data, numeric, s, s, limit);
+    if(CollationKeys::writeFastSortKey(*data, *settings, s, limit, sink, errorCode)) {
+        // Simple characters only, their CEs were looked up directly.
+    } else if(settings->dontCheckFCD()) {
+        UTF16CollationIterator iter(data, settings->isNumeric(), s, s, limit);
+        CollationKeys::LevelCallback callback;
         CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
                                                   sink, Collation::PRIMARY_LEVEL,
                                                   callback, TRUE, errorCode);
     } else {
-        FCDUTF16CollationIterator iter(data, numeric, s, s, limit);
+        FCDUTF16CollationIterator iter(data, settings->isNumeric(), s, s, limit);
+        CollationKeys::LevelCallback callback;
         CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
                                                   sink, Collation::PRIMARY_LEVEL,
                                                   callback, TRUE, errorCode);
@@ -1385,16 +1430,19 @@ namespace {
  *
  * When internalNextSortKeyPart() is called again, it restarts with the last level
  * and ignores as many bytes as were written previously for that level.
+ *
+ * writeSortKeyPrefix() also uses it to stop before levels after maxLevel.
  */
 class PartLevelCallback : public CollationKeys::LevelCallback {
 public:
-    PartLevelCallback(const SortKeyByteSink &s)
-            : sink(s), level(Collation::PRIMARY_LEVEL) {
+    PartLevelCallback(const SortKeyByteSink &s,
+                      Collation::Level max = Collation::IDENTICAL_LEVEL)
+            : sink(s), level(Collation::PRIMARY_LEVEL), maxLevel(max) {
         levelCapacity = sink.GetRemainingCapacity();
     }
     virtual ~PartLevelCallback() {}
     virtual UBool needToWrite(Collation::Level l) {
-        if(!sink.Overflowed()) {
+        if(!sink.Overflowed() && l <= maxLevel) {
             // Remember a level that will be at least partially written.
             level = l;
             levelCapacity = sink.GetRemainingCapacity();
@@ -1409,6 +1457,7 @@ public:
 private:
     const SortKeyByteSink &sink;
     Collation::Level level;
+    Collation::Level maxLevel;
     int32_t levelCapacity;
 };
 
@@ -1482,6 +1531,424 @@ RuleBasedCollator::internalNextSortKeyPart(UCharIterator *iter, uint32_t state[2
     return length;
 }
 
+namespace {
+
+// Sorting works with sort key prefixes of SORT_KEY_PREFIX_WORDS*8 bytes.
+const int32_t SORT_KEY_PREFIX_WORDS = 3;
+const int32_t SORT_KEY_PREFIX_LENGTH = SORT_KEY_PREFIX_WORDS * 8;
+
+struct SortKeyPrefix {
+    // Big-endian sort key bytes, padded with 00 bytes.
+    uint64_t words[SORT_KEY_PREFIX_WORDS];
+    int32_t index;
+};
+
+void
+setSortKeyPrefix(SortKeyPrefix &item, const uint8_t *bytes, int32_t length) {
+    for(int32_t w = 0; w < SORT_KEY_PREFIX_WORDS; ++w) {
+        uint64_t word = 0;
+        for(int32_t i = w * 8; i < (w + 1) * 8; ++i) {
+            word <<= 8;
+            if(i < length) { word |= bytes[i]; }
+        }
+        item.words[w] = word;
+    }
+}
+
+}  // namespace
+
+int32_t
+RuleBasedCollator::writeSortKeyPrefix(const UChar *s, int32_t length,
+                                      int32_t maxLevel,
+                                      uint8_t *dest, int32_t capacity,
+                                      UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    static const UChar empty = 0;
+    if(s == NULL) { s = &empty; }  // bogus UnicodeString
+    const UChar *limit = s + length;
+    FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest), capacity);
+    UBool numeric = settings->isNumeric();
+    // Stops writing levels as soon as the sink is full.
+    PartLevelCallback callback(sink, (Collation::Level)maxLevel);
+    if(settings->dontCheckFCD()) {
+        UTF16CollationIterator iter(data, numeric, s, s, limit);
+        CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                  sink, Collation::PRIMARY_LEVEL,
+                                                  callback, FALSE, errorCode);
+    } else {
+        FCDUTF16CollationIterator iter(data, numeric, s, s, limit);
+        CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                  sink, Collation::PRIMARY_LEVEL,
+                                                  callback, FALSE, errorCode);
+    }
+    if(settings->getStrength() == UCOL_IDENTICAL && maxLevel >= Collation::IDENTICAL_LEVEL &&
+            !sink.Overflowed()) {
+        writeIdenticalLevel(s, limit, sink, errorCode);
+    }
+    if(U_FAILURE(errorCode)) { return 0; }
+    return sink.NumberOfBytesAppended();
+}
+
+int32_t
+RuleBasedCollator::writeSortKeyPrefixUTF8(const uint8_t *s, int32_t length,
+                                          int32_t maxLevel,
+                                          uint8_t *dest, int32_t capacity,
+                                          UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest), capacity);
+    UBool numeric = settings->isNumeric();
+    PartLevelCallback callback(sink, (Collation::Level)maxLevel);
+    if(settings->dontCheckFCD()) {
+        UTF8CollationIterator iter(data, numeric, s, 0, length);
+        CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                  sink, Collation::PRIMARY_LEVEL,
+                                                  callback, FALSE, errorCode);
+    } else {
+        FCDUTF8CollationIterator iter(data, numeric, s, 0, length);
+        CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                  sink, Collation::PRIMARY_LEVEL,
+                                                  callback, FALSE, errorCode);
+    }
+    if(settings->getStrength() == UCOL_IDENTICAL && maxLevel >= Collation::IDENTICAL_LEVEL &&
+            !sink.Overflowed()) {
+        // Convert to UTF-16 the same way as the UTF-8 identical-level comparison.
+        UnicodeString s16;
+        for(int32_t i = 0; i < length;) {
+            UChar32 c;
+            U8_NEXT_OR_FFFD(s, i, length, c);
+            s16.append(c);
+        }
+        const UChar *sArray = s16.getBuffer();
+        writeIdenticalLevel(sArray, sArray + s16.length(), sink, errorCode);
+    }
+    if(U_FAILURE(errorCode)) { return 0; }
+    return sink.NumberOfBytesAppended();
+}
+
+namespace {
+
+/**
+ * @return the last sort key level for the strength,
+ *         or NO_LEVEL if it is not a valid strength
+ */
+Collation::Level
+getLastLevel(UColAttributeValue strength) {
+    switch(strength) {
+    case UCOL_PRIMARY: return Collation::PRIMARY_LEVEL;
+    case UCOL_SECONDARY: return Collation::SECONDARY_LEVEL;
+    case UCOL_TERTIARY: return Collation::TERTIARY_LEVEL;
+    case UCOL_QUATERNARY: return Collation::QUATERNARY_LEVEL;
+    case UCOL_IDENTICAL:
+    case UCOL_DEFAULT:
+        return Collation::IDENTICAL_LEVEL;
+    default: return Collation::NO_LEVEL;
+    }
+}
+
+/**
+ * Pads the sort key prefix with 00 bytes up to the capacity
+ * and returns the length of the prefix without the padding.
+ */
+int32_t
+padSortKeyPrefix(uint8_t *dest, int32_t capacity, int32_t length, UBool &isTruncated) {
+    if(length > capacity) {
+        isTruncated = TRUE;
+        return capacity;
+    }
+    for(int32_t i = length; i < capacity; ++i) { dest[i] = 0; }
+    return length;
+}
+
+}  // namespace
+
+int32_t
+RuleBasedCollator::getSortKeyPrefix(const UnicodeString &s, UColAttributeValue strength,
+                                    uint8_t *dest, int32_t capacity,
+                                    UBool &isTruncated, UErrorCode &errorCode) const {
+    isTruncated = FALSE;
+    if(U_FAILURE(errorCode)) { return 0; }
+    Collation::Level maxLevel = getLastLevel(strength);
+    if(maxLevel == Collation::NO_LEVEL || capacity < 0 || (dest == NULL && capacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    uint8_t noDest[1] = { 0 };
+    if(dest == NULL) { dest = noDest; }
+    int32_t length = writeSortKeyPrefix(s.getBuffer(), s.length(), maxLevel,
+                                        dest, capacity, errorCode);
+    if(U_FAILURE(errorCode)) { return 0; }
+    return padSortKeyPrefix(dest, capacity, length, isTruncated);
+}
+
+int32_t
+RuleBasedCollator::getSortKeyPrefixUTF8(const StringPiece &s, UColAttributeValue strength,
+                                        uint8_t *dest, int32_t capacity,
+                                        UBool &isTruncated, UErrorCode &errorCode) const {
+    isTruncated = FALSE;
+    if(U_FAILURE(errorCode)) { return 0; }
+    Collation::Level maxLevel = getLastLevel(strength);
+    if(maxLevel == Collation::NO_LEVEL || capacity < 0 || (dest == NULL && capacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    uint8_t noDest[1] = { 0 };
+    if(dest == NULL) { dest = noDest; }
+    int32_t length = writeSortKeyPrefixUTF8(reinterpret_cast<const uint8_t *>(s.data()),
+                                            s.length(), maxLevel,
+                                            dest, capacity, errorCode);
+    if(U_FAILURE(errorCode)) { return 0; }
+    return padSortKeyPrefix(dest, capacity, length, isTruncated);
+}
+
+namespace {
+
+// Smaller ranges are insertion-sorted rather than radix-sorted.
+const int32_t MIN_RADIX_SORT_LENGTH = 64;
+
+/**
+ * Stable sort of the items by one of their prefix words.
+ * LSD radix sort, one byte per pass, skipping the passes for byte positions
+ * where all items have the same value.
+ */
+void
+sortByPrefixWord(SortKeyPrefix *items, SortKeyPrefix *temp, int32_t length, int32_t w) {
+    if(length < MIN_RADIX_SORT_LENGTH) {
+        for(int32_t i = 1; i < length; ++i) {
+            uint64_t word = items[i].words[w];
+            if(items[i - 1].words[w] <= word) { continue; }
+            SortKeyPrefix item = items[i];
+            int32_t j = i;
+            do {
+                items[j] = items[j - 1];
+            } while(--j > 0 && items[j - 1].words[w] > word);
+            items[j] = item;
+        }
+        return;
+    }
+    int32_t counts[8][256];
+    uprv_memset(counts, 0, sizeof(counts));
+    for(int32_t i = 0; i < length; ++i) {
+        uint64_t word = items[i].words[w];
+        for(int32_t b = 0; b < 8; ++b) {
+            ++counts[b][(int32_t)(word >> (b * 8)) & 0xff];
+        }
+    }
+    SortKeyPrefix *src = items;
+    SortKeyPrefix *dest = temp;
+    for(int32_t b = 0; b < 8; ++b) {
+        int32_t *count = counts[b];
+        int32_t shift = b * 8;
+        if(count[(int32_t)(src[0].words[w] >> shift) & 0xff] == length) { continue; }
+        int32_t start = 0;
+        for(int32_t v = 0; v < 256; ++v) {
+            int32_t c = count[v];
+            count[v] = start;
+            start += c;
+        }
+        for(int32_t i = 0; i < length; ++i) {
+            const SortKeyPrefix &item = src[i];
+            dest[count[(int32_t)(item.words[w] >> shift) & 0xff]++] = item;
+        }
+        SortKeyPrefix *t = src;
+        src = dest;
+        dest = t;
+    }
+    if(src != items) {
+        uprv_memcpy(items, src, length * sizeof(SortKeyPrefix));
+    }
+}
+
+/**
+ * Sorts the items by their prefix words starting with words[w],
+ * and writes their indexes in sorted order.
+ * Runs of items with equal prefixes are sorted with the comparator.
+ *
+ * Sort key bytes are never 00 except for the terminator,
+ * so a prefix word ending with a 00 byte contains the rest of the sort key:
+ * Runs of such items need not be sorted further.
+ */
+void
+sortIndexesByPrefixes(SortKeyPrefix *items, SortKeyPrefix *temp, int32_t length, int32_t w,
+                      int32_t *indexes, UComparator *cmp, const void *context,
+                      UErrorCode &errorCode) {
+    sortByPrefixWord(items, temp, length, w);
+    for(int32_t start = 0; start < length && U_SUCCESS(errorCode);) {
+        uint64_t word = items[start].words[w];
+        int32_t limit = start + 1;
+        while(limit < length && items[limit].words[w] == word) { ++limit; }
+        if((limit - start) > 1 && (word & 0xff) != 0 && (w + 1) < SORT_KEY_PREFIX_WORDS) {
+            sortIndexesByPrefixes(items + start, temp + start, limit - start, w + 1,
+                                  indexes + start, cmp, context, errorCode);
+        } else {
+            for(int32_t i = start; i < limit; ++i) {
+                indexes[i] = items[i].index;
+            }
+            if((limit - start) > 1 && (word & 0xff) != 0) {
+                uprv_sortArray(indexes + start, limit - start, (int32_t)sizeof(int32_t),
+                               cmp, context, TRUE, &errorCode);
+            }
+        }
+        start = limit;
+    }
+}
+
+/**
+ * Moves items[indexes[i]] to items[i] for all i.
+ * Follows the cycles of the permutation, resetting indexes[i]=i along the way.
+ */
+template<typename T>
+void
+permuteInPlace(T *items, int32_t *indexes, int32_t length) {
+    for(int32_t i = 0; i < length; ++i) {
+        if(indexes[i] == i) { continue; }
+        T temp(items[i]);
+        int32_t j = i;
+        for(;;) {
+            int32_t k = indexes[j];
+            indexes[j] = j;
+            if(k == i) {
+                items[j] = temp;
+                break;
+            }
+            items[j] = items[k];
+            j = k;
+        }
+    }
+}
+
+struct CollatorAndUnicodeStrings {
+    const RuleBasedCollator &coll;
+    const UnicodeString *strings;
+};
+
+int32_t U_CALLCONV
+compareUnicodeStringIndexes(const void *context, const void *left, const void *right) {
+    const CollatorAndUnicodeStrings &cs = *static_cast<const CollatorAndUnicodeStrings *>(context);
+    UErrorCode errorCode = U_ZERO_ERROR;
+    return cs.coll.compare(cs.strings[*static_cast<const int32_t *>(left)],
+                           cs.strings[*static_cast<const int32_t *>(right)], errorCode);
+}
+
+struct CollatorAndStringPieces {
+    const RuleBasedCollator &coll;
+    const StringPiece *strings;
+};
+
+int32_t U_CALLCONV
+compareStringPieceIndexes(const void *context, const void *left, const void *right) {
+    const CollatorAndStringPieces &cs = *static_cast<const CollatorAndStringPieces *>(context);
+    UErrorCode errorCode = U_ZERO_ERROR;
+    return cs.coll.compareUTF8(cs.strings[*static_cast<const int32_t *>(left)],
+                               cs.strings[*static_cast<const int32_t *>(right)], errorCode);
+}
+
+}  // namespace
+
+void
+RuleBasedCollator::sort(UnicodeString *strings, int32_t length, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return; }
+    if(length < 0 || (strings == NULL && length > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if(length <= 1) { return; }
+    LocalMemory<int32_t> indexes;
+    if(indexes.allocateInsteadAndCopy(length) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    sortIndexes(strings, length, indexes.getAlias(), errorCode);
+    if(U_FAILURE(errorCode)) { return; }
+    permuteInPlace(strings, indexes.getAlias(), length);
+}
+
+void
+RuleBasedCollator::sortIndexes(const UnicodeString *strings, int32_t length,
+                               int32_t *indexes, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return; }
+    if(length < 0 || (length > 0 && (strings == NULL || indexes == NULL))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if(length <= 1) {
+        if(length == 1) { indexes[0] = 0; }
+        return;
+    }
+    LocalMemory<SortKeyPrefix> items;
+    LocalMemory<SortKeyPrefix> temp;
+    if(items.allocateInsteadAndCopy(length) == NULL ||
+            temp.allocateInsteadAndCopy(length) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    uint8_t bytes[SORT_KEY_PREFIX_LENGTH];
+    for(int32_t i = 0; i < length; ++i) {
+        const UnicodeString &s = strings[i];
+        int32_t bytesLength = writeSortKeyPrefix(s.getBuffer(), s.length(),
+                                                 Collation::IDENTICAL_LEVEL,
+                                                 bytes, SORT_KEY_PREFIX_LENGTH, errorCode);
+        setSortKeyPrefix(items[i], bytes, bytesLength);
+        items[i].index = i;
+    }
+    if(U_FAILURE(errorCode)) { return; }
+    CollatorAndUnicodeStrings context = { *this, strings };
+    sortIndexesByPrefixes(items.getAlias(), temp.getAlias(), length, 0, indexes,
+                          compareUnicodeStringIndexes, &context, errorCode);
+}
+
+void
+RuleBasedCollator::sortUTF8(StringPiece *strings, int32_t length, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return; }
+    if(length < 0 || (strings == NULL && length > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if(length <= 1) { return; }
+    LocalMemory<int32_t> indexes;
+    if(indexes.allocateInsteadAndCopy(length) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    sortIndexesUTF8(strings, length, indexes.getAlias(), errorCode);
+    if(U_FAILURE(errorCode)) { return; }
+    permuteInPlace(strings, indexes.getAlias(), length);
+}
+
+void
+RuleBasedCollator::sortIndexesUTF8(const StringPiece *strings, int32_t length,
+                                   int32_t *indexes, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return; }
+    if(length < 0 || (length > 0 && (strings == NULL || indexes == NULL))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if(length <= 1) {
+        if(length == 1) { indexes[0] = 0; }
+        return;
+    }
+    LocalMemory<SortKeyPrefix> items;
+    LocalMemory<SortKeyPrefix> temp;
+    if(items.allocateInsteadAndCopy(length) == NULL ||
+            temp.allocateInsteadAndCopy(length) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    uint8_t bytes[SORT_KEY_PREFIX_LENGTH];
+    for(int32_t i = 0; i < length; ++i) {
+        const StringPiece &s = strings[i];
+        int32_t bytesLength = writeSortKeyPrefixUTF8(reinterpret_cast<const uint8_t *>(s.data()),
+                                                     s.length(),
+                                                     Collation::IDENTICAL_LEVEL,
+                                                     bytes, SORT_KEY_PREFIX_LENGTH, errorCode);
+        setSortKeyPrefix(items[i], bytes, bytesLength);
+        items[i].index = i;
+    }
+    if(U_FAILURE(errorCode)) { return; }
+    CollatorAndStringPieces context = { *this, strings };
+    sortIndexesByPrefixes(items.getAlias(), temp.getAlias(), length, 0, indexes,
+                          compareStringPieceIndexes, &context, errorCode);
+}
+
 void
 RuleBasedCollator::internalGetCEs(const UnicodeString &str, UVector64 &ces,
                                   UErrorCode &errorCode) const {
@@ -43,6 +43,17 @@
 U_INTERNAL UBool U_EXPORT2
 ucol_equals(const UCollator *source, const UCollator *target);
 
+/**
+ * Gets statistics for the cache of tailorings loaded by ucol_open() and
+ * Collator::createInstance().
+ * The counts are cumulative since the cache was created.
+ * @param hits fills in the number of tailorings that were found in the cache
+ * @param misses fills in the number of tailorings that were loaded from resource bundles
+ * @internal ICU 54
+ */
+U_INTERNAL void U_EXPORT2
+ucol_getTailoringCacheStatistics(int32_t *hits, int32_t *misses);
+
 /**
  * Convenience string denoting the Collation data tree
  */
@@ -52,6 +63,7 @@ ucol_equals(const UCollator *source, const UCollator *target);
 
 U_NAMESPACE_BEGIN
 
+struct CollationCacheEntry;
 struct CollationTailoring;
 
 class Locale;
@@ -63,12 +75,20 @@ public:
     static void appendRootRules(UnicodeString &s);
     static UnicodeString *loadRules(const char *localeID, const char *collationType,
                                     UErrorCode &errorCode);
-    static const CollationTailoring *loadTailoring(const Locale &locale, Locale &validLocale,
-                                                   UErrorCode &errorCode);
+    /**
+     * Returns the tailoring for the locale, from the tailoring cache if possible.
+     * The caller owns one reference to the returned entry and must removeRef() it.
+     * Sets errorCode to a warning like U_USING_DEFAULT_WARNING as appropriate.
+     */
+    static const CollationCacheEntry *loadTailoring(const Locale &locale, UErrorCode &errorCode);
 
 private:
     CollationLoader();  // not implemented, all methods are static
     static void loadRootRules(UErrorCode &errorCode);
+    static void initTailoringCache(UErrorCode &errorCode);
+    static const CollationTailoring *loadTailoringFromBundle(
+            const Locale &locale, Locale &validLocale, UBool &isCacheable,
+            UErrorCode &errorCode);
 };
 
 U_NAMESPACE_END
@@ -34,6 +34,7 @@
 #include "unicode/uloc.h"
 #include "unicode/unistr.h"
 #include "unicode/ures.h"
+#include "charstr.h"
 #include "cmemory.h"
 #include "cstring.h"
 #include "collationdatareader.h"
@@ -45,6 +46,8 @@
 #include "ucol_imp.h"
 #include "uenumimp.h"
 #include "ulist.h"
+#include "lrucache.h"
+#include "mutex.h"
 #include "umutex.h"
 #include "uresimp.h"
 #include "ustrenum.h"
@@ -61,6 +64,42 @@ static int32_t rootRulesLength = 0;
 static UResourceBundle *rootBundle = NULL;
 static UInitOnce gInitOnce = U_INITONCE_INITIALIZER;
 
+/**
+ * Maximum number of tailorings in the cache.
+ * The least recently used one is evicted when another one is added.
+ */
+static const int32_t TAILORING_CACHE_SIZE = 100;
+
+/**
+ * Cache of CollationCacheEntry objects,
+ * keyed by locale base name plus collation type.
+ *
+ * Tailorings are loaded without holding the cache mutex,
+ * and then added with LRUCache::put() under the mutex.
+ * Entries are only looked up after contains() returned TRUE,
+ * so the cache never creates any.
+ */
+class CollationCache : public LRUCache {
+public:
+    CollationCache(int32_t maxSize, UErrorCode &errorCode)
+            : LRUCache(maxSize, errorCode) {}
+    virtual ~CollationCache();
+
+protected:
+    virtual SharedObject *create(const char * /*localeId*/, UErrorCode &errorCode) {
+        errorCode = U_UNSUPPORTED_ERROR;
+        return NULL;
+    }
+};
+
+CollationCache::~CollationCache() {}
+
+static CollationCache *gCache = NULL;
+static UInitOnce gCacheInitOnce = U_INITONCE_INITIALIZER;
+static UMutex gCacheMutex = U_MUTEX_INITIALIZER;
+static int32_t gCacheHits = 0;    // guarded by gCacheMutex
+static int32_t gCacheMisses = 0;  // guarded by gCacheMutex
+
 }  // namespace
 
 U_CDECL_BEGIN
@@ -72,6 +111,10 @@ ucol_res_cleanup() {
     ures_close(rootBundle);
     rootBundle = NULL;
     gInitOnce.reset();
+    delete gCache;
+    gCache = NULL;
+    gCacheHits = gCacheMisses = 0;
+    gCacheInitOnce.reset();
     return TRUE;
 }
 
@@ -123,8 +166,88 @@ CollationLoader::loadRules(const char *localeID, const char *collationType, UErr
     return rules;
 }
 
+void
+CollationLoader::initTailoringCache(UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return; }
+    gCache = new CollationCache(TAILORING_CACHE_SIZE, errorCode);
+    if(gCache == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    if(U_FAILURE(errorCode)) {
+        delete gCache;
+        gCache = NULL;
+        return;
+    }
+    ucln_i18n_registerCleanup(UCLN_I18N_UCOL_RES, ucol_res_cleanup);
+}
+
+const CollationCacheEntry *
+CollationLoader::loadTailoring(const Locale &locale, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return NULL; }
+
+    // The tailoring depends only on the base name and the collation type.
+    char type[16];
+    int32_t typeLength = locale.getKeywordValue("collation", type, LENGTHOF(type) - 1, errorCode);
+    if(U_FAILURE(errorCode)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    type[typeLength] = 0;  // in case of U_NOT_TERMINATED_WARNING
+    CharString key;
+    key.append(locale.getBaseName(), errorCode);
+    if(typeLength != 0) {
+        key.append("@collation=", errorCode).append(type, typeLength, errorCode);
+    }
+    umtx_initOnce(gCacheInitOnce, CollationLoader::initTailoringCache, errorCode);
+    if(U_FAILURE(errorCode)) { return NULL; }
+
+    const CollationCacheEntry *entry = NULL;
+    {
+        Mutex lock(&gCacheMutex);
+        if(gCache->contains(key.data())) {
+            gCache->get(key.data(), entry, errorCode);
+            ++gCacheHits;
+        } else {
+            ++gCacheMisses;
+        }
+    }
+    if(U_FAILURE(errorCode)) { return NULL; }
+    if(entry != NULL) {
+        if(entry->status != U_ZERO_ERROR) {
+            errorCode = entry->status;
+        }
+        return entry;
+    }
+
+    Locale validLocale("");
+    UBool isCacheable = TRUE;
+    const CollationTailoring *t = loadTailoringFromBundle(locale, validLocale, isCacheable, errorCode);
+    if(U_FAILURE(errorCode)) {
+        if(t != NULL) {
+            t->deleteIfZeroRefCount();
+        }
+        return NULL;
+    }
+    CollationCacheEntry *newEntry = new CollationCacheEntry(validLocale, t, errorCode);
+    if(newEntry == NULL) {
+        t->deleteIfZeroRefCount();
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    newEntry->addRef();
+    if(isCacheable) {
+        // Failure to cache the entry is not an error for the caller.
+        UErrorCode internalErrorCode = U_ZERO_ERROR;
+        Mutex lock(&gCacheMutex);
+        gCache->put(key.data(), newEntry, internalErrorCode);
+    }
+    return newEntry;
+}
+
 const CollationTailoring *
-CollationLoader::loadTailoring(const Locale &locale, Locale &validLocale, UErrorCode &errorCode) {
+CollationLoader::loadTailoringFromBundle(const Locale &locale, Locale &validLocale,
+                                         UBool &isCacheable, UErrorCode &errorCode) {
     const CollationTailoring *root = CollationRoot::getRoot(errorCode);
     if(U_FAILURE(errorCode)) { return NULL; }
     const char *name = locale.getName();
@@ -139,6 +262,11 @@ CollationLoader::loadTailoring(const Locale &locale, Locale &validLocale, UError
         validLocale = Locale::getRoot();
         return root;
     }
+    if(errorCode == U_USING_DEFAULT_WARNING) {
+        // The bundle fell back to the default locale,
+        // which can change between calls.
+        isCacheable = FALSE;
+    }
     const char *vLocale = ures_getLocaleByType(bundle.getAlias(), ULOC_ACTUAL_LOCALE, &errorCode);
     if(U_FAILURE(errorCode)) { return NULL; }
     validLocale = Locale(vLocale);
@@ -301,6 +429,13 @@ U_NAMESPACE_END
 
 U_NAMESPACE_USE
 
+U_CAPI void U_EXPORT2
+ucol_getTailoringCacheStatistics(int32_t *hits, int32_t *misses) {
+    Mutex lock(&gCacheMutex);
+    *hits = gCacheHits;
+    *misses = gCacheMisses;
+}
+
 U_CAPI UCollator*
 ucol_open(const char *loc,
           UErrorCode *status)
@@ -670,6 +670,115 @@ public:
                                   int32_t reorderCodesLength,
                                   UErrorCode& status) ;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Sorts an array of strings according to this collator.
+     * The result is the same as for a stable sort with compare(),
+     * but for larger arrays this is usually much faster:
+     * The strings are first sorted by fixed-length sort key prefixes,
+     * and only strings with equal prefixes are compared fully.
+     * @param strings array of strings, sorted in place
+     * @param length number of strings
+     * @param errorCode ICU error code
+     * @draft ICU 54
+     */
+    void sort(UnicodeString *strings, int32_t length, UErrorCode &errorCode) const;
+
+    /**
+     * Sorts the indexes of an array of strings according to this collator.
+     * Same as sort() but leaves the strings unchanged.
+     * @param strings array of strings
+     * @param length number of strings
+     * @param indexes output array with length elements; receives
+     *        the indexes of the strings in sorted order.
+     *        Equal strings keep their original relative order.
+     * @param errorCode ICU error code
+     * @draft ICU 54
+     */
+    void sortIndexes(const UnicodeString *strings, int32_t length,
+                     int32_t *indexes, UErrorCode &errorCode) const;
+
+    /**
+     * Sorts an array of UTF-8 strings according to this collator.
+     * The result is the same as for a stable sort with compareUTF8().
+     * @param strings array of UTF-8 strings, sorted in place
+     * @param length number of strings
+     * @param errorCode ICU error code
+     * @see sort
+     * @draft ICU 54
+     */
+    void sortUTF8(StringPiece *strings, int32_t length, UErrorCode &errorCode) const;
+
+    /**
+     * Sorts the indexes of an array of UTF-8 strings according to this collator.
+     * Same as sortUTF8() but leaves the strings unchanged.
+     * @param strings array of UTF-8 strings
+     * @param length number of strings
+     * @param indexes output array with length elements; receives
+     *        the indexes of the strings in sorted order.
+     *        Equal strings keep their original relative order.
+     * @param errorCode ICU error code
+     * @draft ICU 54
+     */
+    void sortIndexesUTF8(const StringPiece *strings, int32_t length,
+                         int32_t *indexes, UErrorCode &errorCode) const;
+
+    /**
+     * Writes a fixed-length, order-preserving prefix of the sort key for the string,
+     * for example for a database index column.
+     *
+     * dest receives exactly capacity bytes: the first bytes of the sort key
+     * (without its terminating 00 byte) for the levels up to the given strength,
+     * followed by 00 bytes if the key is shorter than capacity.
+     * Such prefixes can be compared with memcmp() over capacity bytes,
+     * and prefixes for multiple fields can be concatenated.
+     *
+     * For strings a and b with prefixes pa and pb, memcmp(pa, pb) < 0 implies
+     * compare(a, b) < 0 at the given strength.
+     * If the prefixes are equal and either one isTruncated,
+     * then the caller must use compare() to order the strings.
+     * If they are equal and neither isTruncated, then the strings are equal
+     * at the given strength.
+     *
+     * Only the necessary part of the sort key is computed.
+     *
+     * @param s the string
+     * @param strength the last level to be written, UCOL_PRIMARY to UCOL_IDENTICAL,
+     *        or UCOL_DEFAULT for all of the levels of the collator.
+     *        Levels beyond the collator's own strength are never written.
+     *        The case level (if turned on) is written together with the tertiary level.
+     * @param dest output buffer with at least capacity bytes
+     * @param capacity the fixed length of the prefix
+     * @param isTruncated set to TRUE if the sort key for these levels
+     *        is longer than capacity bytes
+     * @param errorCode ICU error code
+     * @return the number of sort key bytes before the 00 padding, at most capacity
+     * @draft ICU 54
+     */
+    int32_t getSortKeyPrefix(const UnicodeString &s, UColAttributeValue strength,
+                             uint8_t *dest, int32_t capacity,
+                             UBool &isTruncated, UErrorCode &errorCode) const;
+
+    /**
+     * Writes a fixed-length, order-preserving prefix of the sort key for the UTF-8 string.
+     * Same as getSortKeyPrefix() but for UTF-8 input,
+     * consistent with compareUTF8().
+     * @param s the UTF-8 string
+     * @param strength the last level to be written, see getSortKeyPrefix()
+     * @param dest output buffer with at least capacity bytes
+     * @param capacity the fixed length of the prefix
+     * @param isTruncated set to TRUE if the sort key for these levels
+     *        is longer than capacity bytes
+     * @param errorCode ICU error code
+     * @return the number of sort key bytes before the 00 padding, at most capacity
+     * @see getSortKeyPrefix
+     * @draft ICU 54
+     */
+    int32_t getSortKeyPrefixUTF8(const StringPiece &s, UColAttributeValue strength,
+                                 uint8_t *dest, int32_t capacity,
+                                 UBool &isTruncated, UErrorCode &errorCode) const;
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
      * Implements ucol_strcollUTF8().
      * @internal
@@ -822,6 +931,19 @@ private:
     void writeIdenticalLevel(const UChar *s, const UChar *limit,
                              SortKeyByteSink &sink, UErrorCode &errorCode) const;
 
+    // Writes up to capacity bytes of the sort key, without the terminator.
+    // Stops early when dest is full. Returns the number of bytes written (<=capacity)
+    // or capacity+1 or more if the sort key is longer.
+    // Writes only the levels up to maxLevel (a Collation::Level value).
+    int32_t writeSortKeyPrefix(const UChar *s, int32_t length,
+                               int32_t maxLevel,
+                               uint8_t *dest, int32_t capacity,
+                               UErrorCode &errorCode) const;
+    int32_t writeSortKeyPrefixUTF8(const uint8_t *s, int32_t length,
+                                   int32_t maxLevel,
+                                   uint8_t *dest, int32_t capacity,
+                                   UErrorCode &errorCode) const;
+
     const CollationSettings &getDefaultSettings() const;
 
     void setAttributeDefault(int32_t attribute) {
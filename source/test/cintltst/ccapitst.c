@@ -52,6 +52,7 @@ cnv_open(const char *name, UErrorCode *pErrorCode) {
 
 static void ListNames(void);
 static void TestFlushCache(void);
+static void TestConverterPool(void);
 static void TestDuplicateAlias(void);
 static void TestCCSID(void);
 static void TestJ932(void);
@@ -68,6 +69,8 @@ static void TestEBCDICSwapLFNL(void);
 static void TestConvertEx(void);
 static void TestConvertExFromUTF8(void);
 static void TestConvertExFromUTF8_C5F0(void);
+static void TestConvertExToUTF8(void);
+static void TestParallelConversion(void);
 static void TestConvertAlgorithmic(void);
        void TestDefaultConverterError(void);    /* defined in cctest.c */
        void TestDefaultConverterSet(void);    /* defined in cctest.c */
@@ -87,6 +90,7 @@ void addTestConvert(TestNode** root)
     addTest(root, &ListNames,                   "tsconv/ccapitst/ListNames");
     addTest(root, &TestConvert,                 "tsconv/ccapitst/TestConvert");
     addTest(root, &TestFlushCache,              "tsconv/ccapitst/TestFlushCache"); 
+    addTest(root, &TestConverterPool,           "tsconv/ccapitst/TestConverterPool");
     addTest(root, &TestAlias,                   "tsconv/ccapitst/TestAlias"); 
     addTest(root, &TestDuplicateAlias,          "tsconv/ccapitst/TestDuplicateAlias"); 
     addTest(root, &TestConvertSafeClone,        "tsconv/ccapitst/TestConvertSafeClone");
@@ -103,6 +107,8 @@ void addTestConvert(TestNode** root)
     addTest(root, &TestConvertEx,               "tsconv/ccapitst/TestConvertEx");
     addTest(root, &TestConvertExFromUTF8,       "tsconv/ccapitst/TestConvertExFromUTF8");
     addTest(root, &TestConvertExFromUTF8_C5F0,  "tsconv/ccapitst/TestConvertExFromUTF8_C5F0");
+    addTest(root, &TestConvertExToUTF8,         "tsconv/ccapitst/TestConvertExToUTF8");
+    addTest(root, &TestParallelConversion,      "tsconv/ccapitst/TestParallelConversion");
     addTest(root, &TestConvertAlgorithmic,      "tsconv/ccapitst/TestConvertAlgorithmic");
     addTest(root, &TestDefaultConverterError,   "tsconv/ccapitst/TestDefaultConverterError");
     addTest(root, &TestDefaultConverterSet,     "tsconv/ccapitst/TestDefaultConverterSet");
@@ -1135,6 +1141,116 @@ static void TestFlushCache(void) {
 #endif
 }
 
+static void TestConverterPool(void) {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const UChar lead = 0xd800;
+    static const char sub[1] = { 0x6f };
+    UErrorCode err = U_ZERO_ERROR;
+    UConverter *cnv, *cnv2;
+    const UChar *source;
+    char bytes[8], *target;
+    int32_t hits, misses, hits2, misses2;
+
+    /* flush the converter cache and the pool to get a consistent state */
+    ucnv_flushCache();
+    ucnv_release(NULL);  /* no-op */
+    ucnv_getPoolCounts(&hits, &misses);
+
+    cnv = ucnv_acquire("ibm-1047", &err);
+    if (U_FAILURE(err)) {
+        log_data_err("ucnv_acquire(ibm-1047) failed - %s\n", u_errorName(err));
+        return;
+    }
+    /* leave some conversion state, which ucnv_release() must reset */
+    source = &lead;
+    target = bytes;
+    ucnv_fromUnicode(cnv, &target, bytes + sizeof(bytes), &source, &lead + 1, NULL, FALSE, &err);
+    if (U_FAILURE(err) || ucnv_fromUCountPending(cnv, &err) != 1) {
+        log_err("ibm-1047 fromUnicode() did not keep a pending lead surrogate - %s\n", u_errorName(err));
+    }
+    ucnv_release(cnv);
+
+    /* an alias shares the pooled converter */
+    cnv2 = ucnv_acquire("IBM1047", &err);
+    if (U_FAILURE(err) || cnv2 != cnv) {
+        log_err("ucnv_acquire(IBM1047) did not return the pooled ibm-1047 converter - %s\n", u_errorName(err));
+    } else if (ucnv_fromUCountPending(cnv2, &err) != 0) {
+        log_err("ucnv_acquire(IBM1047) returned a converter that was not reset\n");
+    }
+    ucnv_getPoolCounts(&hits2, &misses2);
+    if (hits2 != hits + 1 || misses2 != misses + 1) {
+        log_err("pool counts: expected %d hits, %d misses; got %d, %d\n",
+                hits + 1, misses + 1, hits2, misses2);
+    }
+
+    /* a converter with custom substitution characters is not pooled */
+    ucnv_setSubstChars(cnv2, sub, 1, &err);
+    ucnv_release(cnv2);
+    cnv = ucnv_acquire("ibm-1047", &err);
+    if (U_FAILURE(err)) {
+        log_err("ucnv_acquire(ibm-1047) failed - %s\n", u_errorName(err));
+    } else {
+        int8_t length = (int8_t)sizeof(bytes);
+        ucnv_getSubstChars(cnv, bytes, &length, &err);
+        if (U_FAILURE(err) || length != 1 || bytes[0] != 0x3f) {
+            log_err("ucnv_acquire(ibm-1047) returned a converter with custom substitution characters\n");
+        }
+    }
+
+    /* converter options are part of the pool key */
+    cnv2 = ucnv_acquire("ibm-1047,swaplfnl", &err);
+    if (U_FAILURE(err)) {
+        log_err("ucnv_acquire(ibm-1047,swaplfnl) failed - %s\n", u_errorName(err));
+    }
+    ucnv_release(cnv);
+    ucnv_release(cnv2);
+    cnv = ucnv_acquire("ibm-1047", &err);
+    if (U_FAILURE(err) || cnv == cnv2) {
+        log_err("ucnv_acquire(ibm-1047) returned the swaplfnl converter - %s\n", u_errorName(err));
+    }
+    ucnv_release(cnv);
+
+    /* an alias whose canonical name contains options */
+    cnv = ucnv_acquire("ISO-2022-JP", &err);
+    ucnv_release(cnv);
+    cnv2 = ucnv_acquire("csISO2022JP", &err);
+    if (U_FAILURE(err) || cnv2 != cnv) {
+        log_err("ucnv_acquire(csISO2022JP) did not return the pooled ISO-2022-JP converter - %s\n",
+                u_errorName(err));
+    }
+    ucnv_release(cnv2);
+
+    /* a converter from a custom package is not pooled under its name */
+    err = U_ZERO_ERROR;
+    cnv = ucnv_openPackage(loadTestData(&err), "test3", &err);
+    if (U_FAILURE(err)) {
+        log_data_err("ucnv_openPackage(testdata, test3) failed - %s\n", u_errorName(err));
+    } else {
+        UConverter *pkgCnv = cnv;
+        ucnv_release(cnv);
+        cnv = ucnv_acquire("test3", &err);
+        if (cnv == pkgCnv) {
+            log_err("ucnv_acquire(test3) returned the released converter from the testdata package\n");
+        }
+        ucnv_release(cnv);
+    }
+    err = U_ZERO_ERROR;
+
+    /* ucnv_flushCache() closes the pooled converters and unloads their data */
+    if (ucnv_flushCache() < 2) {
+        log_err("ucnv_flushCache() did not unload the data of pooled converters\n");
+    }
+    ucnv_getPoolCounts(&hits, &misses);
+    cnv = ucnv_acquire("ibm-1047", &err);
+    ucnv_getPoolCounts(&hits2, &misses2);
+    if (U_FAILURE(err) || hits2 != hits || misses2 != misses + 1) {
+        log_err("ucnv_acquire(ibm-1047) after ucnv_flushCache() was not a pool miss - %s\n",
+                u_errorName(err));
+    }
+    ucnv_close(cnv);
+#endif
+}
+
 /**
  * Test the converter alias API, specifically the fuzzy matching of
  * alias names and the alias table integrity.  Make sure each
@@ -2735,6 +2851,399 @@ static void TestConvertExFromUTF8_C5F0() {
     ucnv_close(utf8Cnv);
 }
 
+/*
+ * Convert from a charset to UTF-8 with ucnv_convertEx(),
+ * in chunks of srcChunk input bytes and targetChunk output bytes,
+ * and return the output length.
+ */
+static int32_t
+convertExToUTF8(UConverter *utf8Cnv, UConverter *cnv,
+                char *dest, int32_t destCapacity,
+                const char *src, int32_t srcLength,
+                int32_t srcChunk, int32_t targetChunk,
+                UErrorCode *pErrorCode) {
+    UChar pivotBuffer[100];
+    UChar *pivotSource, *pivotTarget;
+    const char *srcLimit, *srcChunkLimit;
+    char *target, *targetChunkLimit, *destLimit;
+    UBool flush;
+
+    ucnv_reset(cnv);
+    ucnv_reset(utf8Cnv);
+    pivotSource=pivotTarget=pivotBuffer;
+    srcLimit=src+srcLength;
+    target=dest;
+    destLimit=dest+destCapacity;
+    do {
+        srcChunkLimit= (srcLimit-src)>srcChunk ? src+srcChunk : srcLimit;
+        targetChunkLimit= (destLimit-target)>targetChunk ? target+targetChunk : destLimit;
+        flush=(UBool)(srcChunkLimit==srcLimit);
+        ucnv_convertEx(utf8Cnv, cnv,
+                       &target, targetChunkLimit,
+                       &src, srcChunkLimit,
+                       pivotBuffer, &pivotSource, &pivotTarget, pivotBuffer+LENGTHOF(pivotBuffer),
+                       FALSE, flush, pErrorCode);
+        if(*pErrorCode==U_BUFFER_OVERFLOW_ERROR && targetChunkLimit<destLimit) {
+            *pErrorCode=U_ZERO_ERROR;
+            flush=FALSE;  /* more output to come */
+        }
+    } while(U_SUCCESS(*pErrorCode) && !(flush && src==srcLimit));
+    return (int32_t)(target-dest);
+}
+
+/*
+ * Test conversion from MBCS charsets to UTF-8 with ucnv_convertEx().
+ * These use a direct conversion without a UTF-16 pivot for most characters.
+ * The results must be the same as with pivoting through UTF-16,
+ * including for fallbacks, illegal and unmappable sequences,
+ * truncated input and small output buffers.
+ */
+static void TestConvertExToUTF8() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const char *const converterNames[]={
+        "windows-1252",
+        "ibm-1047",
+        "ibm-1047,swaplfnl",
+        "shift-jis",
+        "windows-936",
+        "ibm-970",
+        "gb18030",
+        "ibm-930",
+        "euc-jp",  /* 3-byte sequences via a transition on the lead byte 0x8f */
+        "ibm-964"  /* EUC-TW, 4-byte sequences */
+    };
+    static const char *const text=
+        "Aa\\u00e4\\u00df\\u0416\\u03a9 \\u3042\\u30a2\\u4e00\\u4e8c\\uac00\\uff21\\uff71\\n"
+        "\\u20ac\\u2116\\u4e02\\u4e42\\U00020000\\U0001f600 end\\r\\n";
+    /* illegal and unmappable bytes in most charsets, and a lead byte at the end */
+    static const char badBytes[]={ (char)0x80, (char)0xa0, (char)0xff, (char)0x0e, 0x41, 0x0f, (char)0xfe };
+    static const int32_t chunks[][2]={
+        { 0x7fffffff, 0x7fffffff },
+        { 1, 0x7fffffff },
+        { 3, 1 },
+        { 0x7fffffff, 1 },
+        { 0x7fffffff, 2 },
+        { 0x7fffffff, 5 }
+    };
+
+    UChar unicode[100], roundtrip[400];
+    char bytes[400], expected[800], actual[800];
+    int32_t unicodeLength, bytesLength, roundtripLength, expectedLength, actualLength;
+    UConverter *utf8Cnv, *cnv;
+    UErrorCode errorCode;
+    int32_t i, j, k;
+
+    unicodeLength=u_unescape(text, unicode, LENGTHOF(unicode));
+
+    errorCode=U_ZERO_ERROR;
+    utf8Cnv=ucnv_open("UTF-8", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("unable to open UTF-8 converter - %s\n", u_errorName(errorCode));
+        return;
+    }
+
+    for(i=0; i<LENGTHOF(converterNames); ++i) {
+        errorCode=U_ZERO_ERROR;
+        cnv=ucnv_open(converterNames[i], &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("unable to open %s converter - %s\n", converterNames[i], u_errorName(errorCode));
+            continue;
+        }
+
+        /* test text, bad bytes, test text, bad bytes */
+        bytesLength=ucnv_fromUChars(cnv, bytes, LENGTHOF(bytes), unicode, unicodeLength, &errorCode);
+        uprv_memcpy(bytes+bytesLength, badBytes, sizeof(badBytes));
+        bytesLength+=(int32_t)sizeof(badBytes);
+        uprv_memcpy(bytes+bytesLength, bytes, bytesLength);
+        bytesLength*=2;
+
+        for(k=0; k<2; ++k) {
+            /* k==0: all of the input; k==1: without the trailing lead byte */
+            int32_t length=bytesLength-k;
+
+            /* expected results: pivot through UTF-16 */
+            roundtripLength=ucnv_toUChars(cnv, roundtrip, LENGTHOF(roundtrip), bytes, length, &errorCode);
+            u_strToUTF8(expected, LENGTHOF(expected), &expectedLength, roundtrip, roundtripLength, &errorCode);
+            if(U_FAILURE(errorCode)) {
+                log_err("%s: ucnv_toUChars()+u_strToUTF8() failed - %s\n",
+                        converterNames[i], u_errorName(errorCode));
+                break;
+            }
+
+            for(j=0; j<LENGTHOF(chunks); ++j) {
+                actualLength=convertExToUTF8(utf8Cnv, cnv, actual, LENGTHOF(actual),
+                                             bytes, length, chunks[j][0], chunks[j][1],
+                                             &errorCode);
+                if(U_FAILURE(errorCode)) {
+                    log_err("%s->UTF-8 ucnv_convertEx(chunks %ld/%ld) failed - %s\n",
+                            converterNames[i], (long)chunks[j][0], (long)chunks[j][1],
+                            u_errorName(errorCode));
+                    errorCode=U_ZERO_ERROR;
+                } else if(actualLength!=expectedLength || 0!=uprv_memcmp(actual, expected, actualLength)) {
+                    log_err("%s->UTF-8 ucnv_convertEx(chunks %ld/%ld) differs from pivoting through UTF-16\n",
+                            converterNames[i], (long)chunks[j][0], (long)chunks[j][1]);
+                }
+            }
+        }
+
+        /*
+         * With the stop callback, the conversion must end at the first bad sequence.
+         * The UTF-8 output plus the UTF-16 text remaining in the pivot buffer
+         * must be the same as the toUnicode output.
+         * (Single-byte charsets might not have any bad sequences.)
+         */
+        ucnv_setToUCallBack(cnv, UCNV_TO_U_CALLBACK_STOP, NULL, NULL, NULL, &errorCode);
+        {
+            UChar *uTarget=roundtrip;
+            const char *uSrc=bytes;
+            ucnv_resetToUnicode(cnv);
+            ucnv_toUnicode(cnv, &uTarget, roundtrip+LENGTHOF(roundtrip),
+                           &uSrc, bytes+bytesLength, NULL, TRUE, &errorCode);
+            roundtripLength=(int32_t)(uTarget-roundtrip);
+        }
+        if(errorCode==U_ILLEGAL_CHAR_FOUND || errorCode==U_INVALID_CHAR_FOUND) {
+            UErrorCode expectedErrorCode=errorCode;
+            char *target=actual;
+            const char *src=bytes;
+            UChar pivotBuffer[100];
+            UChar *pivotSource=pivotBuffer, *pivotTarget=pivotBuffer;
+
+            errorCode=U_ZERO_ERROR;
+            u_strToUTF8(expected, LENGTHOF(expected), &expectedLength, roundtrip, roundtripLength, &errorCode);
+
+            ucnv_reset(cnv);
+            ucnv_reset(utf8Cnv);
+            ucnv_convertEx(utf8Cnv, cnv,
+                           &target, actual+LENGTHOF(actual),
+                           &src, bytes+bytesLength,
+                           pivotBuffer, &pivotSource, &pivotTarget, pivotBuffer+LENGTHOF(pivotBuffer),
+                           TRUE, TRUE, &errorCode);
+            if(errorCode==expectedErrorCode) {
+                /* append the unconverted pivot buffer contents */
+                UErrorCode pivotErrorCode=U_ZERO_ERROR;
+                int32_t pivotLength;
+                u_strToUTF8(target, (int32_t)(actual+LENGTHOF(actual)-target), &pivotLength,
+                            pivotSource, (int32_t)(pivotTarget-pivotSource), &pivotErrorCode);
+                target+=pivotLength;
+            }
+            actualLength=(int32_t)(target-actual);
+            if( errorCode!=expectedErrorCode ||
+                actualLength!=expectedLength || 0!=uprv_memcmp(actual, expected, actualLength)
+            ) {
+                log_err("%s->UTF-8 ucnv_convertEx(stop) got %s and %ld bytes, expected %s and %ld bytes\n",
+                        converterNames[i], u_errorName(errorCode), (long)actualLength,
+                        u_errorName(expectedErrorCode), (long)expectedLength);
+            }
+        } else if(U_FAILURE(errorCode)) {
+            log_err("%s: ucnv_toUnicode(stop) failed - %s\n", converterNames[i], u_errorName(errorCode));
+        }
+        ucnv_close(cnv);
+    }
+    ucnv_close(utf8Cnv);
+#endif
+}
+
+/*
+ * Task runner for TestParallelConversion(): runs the tasks serially in reverse order,
+ * to make sure that the chunks do not depend on each other,
+ * and counts them in *(int32_t *)context.
+ */
+static void U_EXPORT2
+reverseTaskRunner(const void *context, UConverterTask task, void *taskContext, int32_t count) {
+    *(int32_t *)context+=count;
+    while(count>0) {
+        task(taskContext, --count);
+    }
+}
+
+/*
+ * Test chunked conversion with ucnv_toUCharsParallel() etc.
+ * The results must be the same as with ucnv_toUChars() and ucnv_fromUChars(),
+ * for any chunk length. Stateful converters must be converted serially.
+ */
+static void TestParallelConversion() {
+    static const struct {
+        const char *name;
+        UBool canSplitToU, canSplitFromU;
+    } converters[]={
+        { "UTF-8", TRUE, TRUE },
+        { "CESU-8", TRUE, TRUE },
+        { "UTF-16BE", TRUE, TRUE },
+        { "UTF-16LE", TRUE, TRUE },
+        { "UTF-32BE", TRUE, TRUE },
+        { "US-ASCII", TRUE, TRUE },
+        { "ISO-8859-1", TRUE, TRUE },
+        { "UTF-16", FALSE, FALSE },
+        { "UTF-7", FALSE, FALSE },
+#if !UCONFIG_NO_LEGACY_CONVERSION
+        { "windows-1252", TRUE, TRUE },
+        { "shift-jis", TRUE, TRUE },
+        { "ibm-970", TRUE, TRUE },
+        { "gb18030", TRUE, TRUE },
+        { "ISO-2022-JP", FALSE, FALSE },
+        { "ibm-930", FALSE, FALSE }
+#endif
+    };
+    static const char *const text=
+        "Aa\\u00e4\\u00df\\u0416\\u03a9 \\u3042\\u30a2\\u4e00\\u4e8c\\uac00\\uff21\\uff71\\n"
+        "\\u20ac\\u2116\\u4e02\\u4e42\\U00020000\\U0001f600 end\\r\\n";
+    /* illegal bytes in most charsets, and an unpaired surrogate */
+    static const char badBytes[]={ (char)0x80, (char)0xff, 0x31, (char)0xfe, 0x32, (char)0x81 };
+    static const UChar badUChars[]={ 0x61, 0xd800, 0x62 };
+    static const int32_t chunkLengths[]={ 1, 2, 5, 16, 0 };
+
+    UChar unicode[100], uSource[1000], expectedU[2000], actualU[2000];
+    char bytes[4000], expected[5000], actual[5000];
+    int32_t unicodeLength, uSourceLength, bytesLength, expectedLength, actualLength, length;
+    UConverter *cnv;
+    UConverterSegment *segments;
+    UErrorCode errorCode;
+    int32_t i, j, k, count, taskCount;
+
+    unicodeLength=u_unescape(text, unicode, LENGTHOF(unicode));
+    for(uSourceLength=0; uSourceLength+unicodeLength+LENGTHOF(badUChars)<=LENGTHOF(uSource);) {
+        u_memcpy(uSource+uSourceLength, unicode, unicodeLength);
+        uSourceLength+=unicodeLength;
+        u_memcpy(uSource+uSourceLength, badUChars, LENGTHOF(badUChars));
+        uSourceLength+=LENGTHOF(badUChars);
+    }
+
+    for(i=0; i<LENGTHOF(converters); ++i) {
+        const char *name=converters[i].name;
+
+        errorCode=U_ZERO_ERROR;
+        cnv=ucnv_open(name, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("unable to open %s converter - %s\n", name, u_errorName(errorCode));
+            continue;
+        }
+
+        /* several copies of: test text, bad bytes */
+        bytesLength=0;
+        for(k=0; k<20; ++k) {
+            bytesLength+=ucnv_fromUChars(cnv, bytes+bytesLength, LENGTHOF(bytes)-bytesLength,
+                                         unicode, unicodeLength, &errorCode);
+            uprv_memcpy(bytes+bytesLength, badBytes, sizeof(badBytes));
+            bytesLength+=(int32_t)sizeof(badBytes);
+        }
+        if(U_FAILURE(errorCode) && errorCode!=U_STRING_NOT_TERMINATED_WARNING) {
+            log_err("%s: ucnv_fromUChars() failed - %s\n", name, u_errorName(errorCode));
+            ucnv_close(cnv);
+            continue;
+        }
+        errorCode=U_ZERO_ERROR;
+
+        /* toUnicode */
+        expectedLength=ucnv_toUChars(cnv, expectedU, LENGTHOF(expectedU), bytes, bytesLength, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("%s: ucnv_toUChars() failed - %s\n", name, u_errorName(errorCode));
+            ucnv_close(cnv);
+            continue;
+        }
+        for(j=0; j<LENGTHOF(chunkLengths); ++j) {
+            taskCount=0;
+            actualLength=ucnv_toUCharsParallel(cnv, actualU, LENGTHOF(actualU), bytes, bytesLength,
+                                               chunkLengths[j], reverseTaskRunner, &taskCount, &errorCode);
+            if(U_FAILURE(errorCode)) {
+                log_err("%s: ucnv_toUCharsParallel(chunk length %ld) failed - %s\n",
+                        name, (long)chunkLengths[j], u_errorName(errorCode));
+                errorCode=U_ZERO_ERROR;
+            } else if(actualLength!=expectedLength || 0!=u_memcmp(actualU, expectedU, actualLength)) {
+                log_err("%s: ucnv_toUCharsParallel(chunk length %ld) differs from ucnv_toUChars()\n",
+                        name, (long)chunkLengths[j]);
+            }
+            if(chunkLengths[j]!=0 && (taskCount>1)!=converters[i].canSplitToU) {
+                log_err("%s: ucnv_toUCharsParallel(chunk length %ld) ran %ld tasks\n",
+                        name, (long)chunkLengths[j], (long)taskCount);
+            }
+        }
+
+        /* toUnicode preflighting and segments */
+        length=ucnv_toUCharsParallel(cnv, NULL, 0, bytes, bytesLength,
+                                     5, reverseTaskRunner, &taskCount, &errorCode);
+        if(errorCode!=U_BUFFER_OVERFLOW_ERROR || length!=expectedLength) {
+            log_err("%s: ucnv_toUCharsParallel(preflighting) got %s and length %ld, expected %ld\n",
+                    name, u_errorName(errorCode), (long)length, (long)expectedLength);
+        }
+        errorCode=U_ZERO_ERROR;
+        count=ucnv_toUSegmentsParallel(cnv, bytes, bytesLength,
+                                       5, reverseTaskRunner, &taskCount, &segments, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("%s: ucnv_toUSegmentsParallel() failed - %s\n", name, u_errorName(errorCode));
+            errorCode=U_ZERO_ERROR;
+        } else {
+            actualLength=length=0;
+            for(k=0; k<count; ++k) {
+                if(segments[k].sourceIndex!=length || segments[k].sourceLength<=0) {
+                    log_err("%s: ucnv_toUSegmentsParallel() segment %ld does not continue the source\n",
+                            name, (long)k);
+                    break;
+                }
+                length+=segments[k].sourceLength;
+                u_memcpy(actualU+actualLength, (const UChar *)segments[k].target, segments[k].targetLength);
+                actualLength+=segments[k].targetLength;
+            }
+            if( length!=bytesLength ||
+                actualLength!=expectedLength || 0!=u_memcmp(actualU, expectedU, actualLength)
+            ) {
+                log_err("%s: ucnv_toUSegmentsParallel() differs from ucnv_toUChars()\n", name);
+            }
+            ucnv_closeSegments(segments, count);
+        }
+
+        /* fromUnicode */
+        expectedLength=ucnv_fromUChars(cnv, expected, LENGTHOF(expected), uSource, uSourceLength, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("%s: ucnv_fromUChars() failed - %s\n", name, u_errorName(errorCode));
+            ucnv_close(cnv);
+            continue;
+        }
+        for(j=0; j<LENGTHOF(chunkLengths); ++j) {
+            taskCount=0;
+            actualLength=ucnv_fromUCharsParallel(cnv, actual, LENGTHOF(actual), uSource, uSourceLength,
+                                                 chunkLengths[j], reverseTaskRunner, &taskCount, &errorCode);
+            if(U_FAILURE(errorCode)) {
+                log_err("%s: ucnv_fromUCharsParallel(chunk length %ld) failed - %s\n",
+                        name, (long)chunkLengths[j], u_errorName(errorCode));
+                errorCode=U_ZERO_ERROR;
+            } else if(actualLength!=expectedLength || 0!=uprv_memcmp(actual, expected, actualLength)) {
+                log_err("%s: ucnv_fromUCharsParallel(chunk length %ld) differs from ucnv_fromUChars()\n",
+                        name, (long)chunkLengths[j]);
+            }
+            if(chunkLengths[j]!=0 && (taskCount>1)!=converters[i].canSplitFromU) {
+                log_err("%s: ucnv_fromUCharsParallel(chunk length %ld) ran %ld tasks\n",
+                        name, (long)chunkLengths[j], (long)taskCount);
+            }
+        }
+        count=ucnv_fromUSegmentsParallel(cnv, uSource, uSourceLength,
+                                         3, reverseTaskRunner, &taskCount, &segments, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("%s: ucnv_fromUSegmentsParallel() failed - %s\n", name, u_errorName(errorCode));
+        } else {
+            actualLength=0;
+            for(k=0; k<count; ++k) {
+                uprv_memcpy(actual+actualLength, segments[k].target, segments[k].targetLength);
+                actualLength+=segments[k].targetLength;
+            }
+            if(actualLength!=expectedLength || 0!=uprv_memcmp(actual, expected, actualLength)) {
+                log_err("%s: ucnv_fromUSegmentsParallel() differs from ucnv_fromUChars()\n", name);
+            }
+            ucnv_closeSegments(segments, count);
+        }
+
+        /* without a runner, the conversion is serial */
+        errorCode=U_ZERO_ERROR;
+        count=ucnv_fromUSegmentsParallel(cnv, uSource, uSourceLength,
+                                         3, NULL, NULL, &segments, &errorCode);
+        if(U_FAILURE(errorCode) || count!=1 || segments[0].targetLength!=expectedLength) {
+            log_err("%s: ucnv_fromUSegmentsParallel(no runner) got %s and %ld segments\n",
+                    name, u_errorName(errorCode), (long)count);
+        }
+        ucnv_closeSegments(segments, count);
+        ucnv_close(cnv);
+    }
+}
+
 static void
 TestConvertAlgorithmic() {
 #if !UCONFIG_NO_LEGACY_CONVERSION
@@ -22,9 +22,14 @@
 static void TestBasic(void);
 static void TestOtherAPI(void);
 static void hashIChars(void);
+static void TestManyElements(void);
+static void TestFixedSize(void);
+static void TestFastHash(void);
 
 static int32_t U_EXPORT2 U_CALLCONV hashChars(const UHashTok key);
 
+static int32_t U_EXPORT2 U_CALLCONV hashConstant(const UHashTok key);
+
 static UBool U_EXPORT2 U_CALLCONV isEqualChars(const UHashTok key1, const UHashTok key2);
 
 static void _put(UHashtable* hash,
@@ -87,6 +92,9 @@ void addHashtableTest(TestNode** root) {
     addTest(root, &TestBasic,   "tsutil/chashtst/TestBasic");
     addTest(root, &TestOtherAPI, "tsutil/chashtst/TestOtherAPI");
     addTest(root, &hashIChars, "tsutil/chashtst/hashIChars");
+    addTest(root, &TestManyElements, "tsutil/chashtst/TestManyElements");
+    addTest(root, &TestFixedSize, "tsutil/chashtst/TestFixedSize");
+    addTest(root, &TestFastHash, "tsutil/chashtst/TestFastHash");
     
 }
 
@@ -310,6 +318,229 @@ static void hashIChars(void) {
     uhash_close(hash);
 }
 
+/*
+ * Checks that keys 0..limit-1 are in the table exactly if
+ * isIn(key), with value key+1.
+ */
+static void _checkRange(const UHashtable *hash, int32_t limit,
+                        UBool (*isIn)(int32_t), const char *name) {
+    int32_t i, errors = 0;
+    for (i = 0; i < limit; ++i) {
+        int32_t value = uhash_igeti(hash, i * 0x10000);
+        if (value != (isIn(i) ? i + 1 : 0)) {
+            if (++errors < 5) {
+                log_err("FAIL: %s: uhash_igeti(%ld) returned %ld\n",
+                        name, (long)(i * 0x10000), (long)value);
+            }
+        }
+    }
+}
+
+static UBool _isEven(int32_t i) { return (UBool)((i & 1) == 0); }
+static UBool _isOddOrMultipleOf4(int32_t i) { return (UBool)((i & 1) != 0 || (i & 3) == 0); }
+static UBool _isOddMultipleOf4(int32_t i) { return (UBool)(i != 0 && (i & 3) == 0 && ((i >> 2) & 1) != 0); }
+
+/* LIMIT must be a multiple of 8. */
+static void _testManyElements(UHashtable *hash, int32_t LIMIT, const char *name) {
+    UErrorCode status = U_ZERO_ERROR;
+    const UHashElement *e;
+    int32_t i, pos, count;
+
+    /* Keys that differ only in their high bits. */
+    for (i = 0; i < LIMIT; ++i) {
+        uhash_iputi(hash, i * 0x10000, i + 1, &status);
+    }
+    if (U_FAILURE(status) || uhash_count(hash) != LIMIT) {
+        log_err("FAIL: %s: uhash_iputi() %s, count %ld\n",
+                name, u_errorName(status), (long)uhash_count(hash));
+        return;
+    }
+
+    /* Remove the odd keys while iterating. */
+    pos = -1;
+    count = 0;
+    while ((e = uhash_nextElement(hash, &pos)) != NULL) {
+        ++count;
+        if ((e->key.integer / 0x10000) & 1) {
+            uhash_removeElement(hash, e);
+        }
+    }
+    if (count != LIMIT || uhash_count(hash) != LIMIT / 2) {
+        log_err("FAIL: %s: iterated over %ld elements, count %ld\n",
+                name, (long)count, (long)uhash_count(hash));
+    }
+    _checkRange(hash, LIMIT, _isEven, name);
+
+    /* Put the odd keys back, and remove the even ones that are not multiples of 4. */
+    for (i = 1; i < LIMIT; i += 2) {
+        uhash_iputi(hash, i * 0x10000, i + 1, &status);
+    }
+    for (i = 2; i < LIMIT; i += 4) {
+        if (uhash_iremovei(hash, i * 0x10000) != i + 1) {
+            log_err("FAIL: %s: uhash_iremovei(%ld) failed\n", name, (long)(i * 0x10000));
+            break;
+        }
+    }
+    _checkRange(hash, LIMIT, _isOddOrMultipleOf4, name);
+
+    /* Shrink down to a few elements. */
+    for (i = 0; i < LIMIT; ++i) {
+        if (!_isOddMultipleOf4(i)) {
+            uhash_iremovei(hash, i * 0x10000);
+        }
+    }
+    _checkRange(hash, LIMIT, _isOddMultipleOf4, name);
+    if (uhash_count(hash) != LIMIT / 8) {
+        log_err("FAIL: %s: count %ld after removing\n", name, (long)uhash_count(hash));
+    }
+    uhash_removeAll(hash);
+    if (uhash_count(hash) != 0 || uhash_igeti(hash, 4 * 0x10000) != 0) {
+        log_err("FAIL: %s: uhash_removeAll() failed\n", name);
+    }
+}
+
+static void TestManyElements(void) {
+    UErrorCode status = U_ZERO_ERROR;
+    UHashtable *hash = uhash_open(uhash_hashLong, uhash_compareLong, NULL, &status);
+    if (U_FAILURE(status)) {
+        log_err("FAIL: uhash_open failed with %s\n", u_errorName(status));
+        return;
+    }
+    _testManyElements(hash, 20000, "U_GROW");
+    uhash_setResizePolicy(hash, U_GROW_AND_SHRINK);
+    _testManyElements(hash, 20000, "U_GROW_AND_SHRINK");
+    uhash_close(hash);
+
+    /* All keys collide. */
+    hash = uhash_openSize(hashConstant, uhash_compareLong, NULL, 8, &status);
+    if (U_FAILURE(status)) {
+        log_err("FAIL: uhash_openSize failed with %s\n", u_errorName(status));
+        return;
+    }
+    _testManyElements(hash, 512, "constant hash");
+    uhash_close(hash);
+}
+
+static void TestFixedSize(void) {
+    UErrorCode status = U_ZERO_ERROR;
+    UHashtable *hash = uhash_openSize(uhash_hashLong, uhash_compareLong, NULL, 16, &status);
+    int32_t i, length;
+    if (U_FAILURE(status)) {
+        log_err("FAIL: uhash_openSize failed with %s\n", u_errorName(status));
+        return;
+    }
+    uhash_setResizePolicy(hash, U_FIXED);
+    for (i = 1; U_SUCCESS(status) && i < 1000; ++i) {
+        uhash_iputi(hash, i, i, &status);
+    }
+    /* One slot stays free. */
+    length = uhash_count(hash) + 1;
+    if (status != U_MEMORY_ALLOCATION_ERROR || length < 16 || length > 1000) {
+        log_err("FAIL: U_FIXED table took %ld elements, status %s\n",
+                (long)uhash_count(hash), u_errorName(status));
+        uhash_close(hash);
+        return;
+    }
+    /* Replacing values and reusing removed slots still works in a full table. */
+    status = U_ZERO_ERROR;
+    uhash_iputi(hash, 1, 100, &status);
+    for (i = 1; i < length; i += 2) {
+        uhash_iremovei(hash, i);
+    }
+    for (i = 1; i < length; i += 2) {
+        uhash_iputi(hash, i + 5000, i, &status);
+    }
+    if (U_FAILURE(status) || uhash_count(hash) != length - 1 ||
+            uhash_igeti(hash, 5001) != 1 || uhash_igeti(hash, 2) != 2 ||
+            uhash_igeti(hash, 1) != 0) {
+        log_err("FAIL: U_FIXED table: %s, count %ld\n",
+                u_errorName(status), (long)uhash_count(hash));
+    }
+    uhash_close(hash);
+}
+
+static void TestFastHash(void) {
+    enum { LENGTH = 100 };
+    char path[LENGTH + 1], copy[LENGTH + 1];
+    UChar upath[LENGTH + 1];
+    int32_t hashes[LENGTH];
+    UHashTok key;
+    UHashtable *hash;
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t i, j, collisions;
+
+    /* Equal strings in different buffers hash equally. */
+    uprv_strcpy(path, "root/calendar/gregorian/dayNames/format/wide");
+    uprv_strcpy(copy, path);
+    u_uastrcpy(upath, path);
+    key.pointer = path;
+    i = uhash_fastHashChars(key);
+    key.pointer = copy;
+    if (i != uhash_fastHashChars(key)) {
+        log_err("FAIL: uhash_fastHashChars() differs for equal strings\n");
+    }
+    key.pointer = upath;
+    i = uhash_fastHashUChars(key);
+    u_uastrcpy(upath, copy);
+    if (i != uhash_fastHashUChars(key)) {
+        log_err("FAIL: uhash_fastHashUChars() differs for equal strings\n");
+    }
+    key.pointer = NULL;
+    if (uhash_fastHashChars(key) != 0 || uhash_fastHashUChars(key) != 0) {
+        log_err("FAIL: fast hash of NULL is not 0\n");
+    }
+
+    /*
+     * Long keys that differ in one character.
+     * The sampling uhash_hashChars() skips most of these positions.
+     */
+    uprv_memset(path, 'a', LENGTH);
+    path[LENGTH] = 0;
+    key.pointer = path;
+    for (i = 0; i < LENGTH; ++i) {
+        path[i] = 'b';
+        hashes[i] = uhash_fastHashChars(key);
+        path[i] = 'a';
+    }
+    collisions = 0;
+    for (i = 0; i < LENGTH; ++i) {
+        for (j = i + 1; j < LENGTH; ++j) {
+            if (hashes[i] == hashes[j]) {
+                ++collisions;
+            }
+        }
+    }
+    if (collisions != 0) {
+        log_err("FAIL: uhash_fastHashChars() has %ld collisions among %d similar keys\n",
+                (long)collisions, LENGTH);
+    }
+    /* Prefixes of each other, across the word boundaries. */
+    for (i = 0; i < 20; ++i) {
+        path[i] = 0;
+        hashes[i] = uhash_fastHashChars(key);
+        path[i] = 'a';
+        for (j = 0; j < i; ++j) {
+            if (hashes[i] == hashes[j]) {
+                log_err("FAIL: uhash_fastHashChars() same for lengths %ld and %ld\n",
+                        (long)j, (long)i);
+            }
+        }
+    }
+
+    hash = uhash_open(uhash_fastHashChars, uhash_compareChars, NULL, &status);
+    if (U_FAILURE(status)) {
+        log_err("FAIL: uhash_open failed with %s\n", u_errorName(status));
+        return;
+    }
+    _put(hash, "ISO-8859-1", 1, 0);
+    _put(hash, "UTF-8", 2, 0);
+    _put(hash, "ibm-5348_P100-1997", 3, 0);
+    _get(hash, "UTF-8", 2);
+    _get(hash, "ibm-5348_P100-1997", 3);
+    _get(hash, "UTF-16", 0);
+    _remove(hash, "ISO-8859-1", 1);
+    uhash_close(hash);
+}
 
 /**********************************************************************
  * uhash Callbacks
@@ -323,6 +554,14 @@ static int32_t U_EXPORT2 U_CALLCONV hashChars(const UHashTok key) {
     return *(const char*) key.pointer;
 }
 
+/**
+ * Maps all keys to one hash code.
+ */
+static int32_t U_EXPORT2 U_CALLCONV hashConstant(const UHashTok key) {
+    (void)key;
+    return 42;
+}
+
 static UBool U_EXPORT2 U_CALLCONV isEqualChars(const UHashTok key1, const UHashTok key2) {
     return (UBool)((key1.pointer != NULL) &&
         (key2.pointer != NULL) &&
@@ -182,6 +182,8 @@ static void TestCLDRStyleAliases(void);
 static void TestFallbackCodes(void);
 static void TestGetUTF8String(void);
 static void TestCLDRVersion(void);
+static void TestReopen(void);
+static void TestPathCache(void);
 
 /***************************************************************************************/
 
@@ -218,6 +220,8 @@ void addNEWResourceBundleTest(TestNode** root)
     addTest(root, &TestGetFunctionalEquivalent,"tsutil/creststn/TestGetFunctionalEquivalent");
     addTest(root, &TestJB3763,                "tsutil/creststn/TestJB3763");
     addTest(root, &TestStackReuse,            "tsutil/creststn/TestStackReuse");
+    addTest(root, &TestReopen,                "tsutil/creststn/TestReopen");
+    addTest(root, &TestPathCache,             "tsutil/creststn/TestPathCache");
 }
 
 
@@ -2858,6 +2862,139 @@ static void TestStackReuse(void) {
     ures_close(&table);
 }
 
+/*
+ * Opening the same bundle again must give the same status and actual locale,
+ * whether or not the result was served from the open cache,
+ * and fallbacks to the default locale must follow the current default locale.
+ */
+static void TestReopen(void) {
+    static const char *const locales[] = {
+        "en_US", "de_AT", "de_AT_XY", "zh_Hant_TW", "sr_Latn_BA", "no_NO_NY", "root", "", "xx_YY"
+    };
+    char defaultLocale[ULOC_FULLNAME_CAPACITY];
+    const char *actual;
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UResourceBundle *rb;
+    int32_t i;
+
+    for(i = 0; i < (int32_t)(sizeof(locales)/sizeof(locales[0])); ++i) {
+        UErrorCode status1 = U_ZERO_ERROR, status2 = U_ZERO_ERROR;
+        char actual1[ULOC_FULLNAME_CAPACITY];
+        UResourceBundle *rb1 = ures_open(NULL, locales[i], &status1);
+        UResourceBundle *rb2;
+        if(U_FAILURE(status1)) {
+            log_data_err("ures_open(%s) failed - %s\n", locales[i], u_errorName(status1));
+            continue;
+        }
+        uprv_strcpy(actual1, ures_getLocaleByType(rb1, ULOC_ACTUAL_LOCALE, &status1));
+        ures_close(rb1);
+        rb2 = ures_open(NULL, locales[i], &status2);
+        if(U_FAILURE(status2)) {
+            log_err("ures_open(%s) failed the second time - %s\n", locales[i], u_errorName(status2));
+            continue;
+        }
+        actual = ures_getLocaleByType(rb2, ULOC_ACTUAL_LOCALE, &status2);
+        if(status1 != status2 || uprv_strcmp(actual1, actual) != 0) {
+            log_err("ures_open(%s) gave %s/%s, then %s/%s\n", locales[i],
+                    actual1, u_errorName(status1), actual, u_errorName(status2));
+        }
+        ures_close(rb2);
+    }
+
+    uprv_strcpy(defaultLocale, uloc_getDefault());
+    uloc_setDefault("de", &errorCode);
+    rb = ures_open(NULL, "xx_YY", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("ures_open(xx_YY) failed - %s\n", u_errorName(errorCode));
+        uloc_setDefault(defaultLocale, &errorCode);
+        return;
+    }
+    ures_close(rb);
+    uloc_setDefault("fr", &errorCode);
+    rb = ures_open(NULL, "xx_YY", &errorCode);
+    actual = ures_getLocaleByType(rb, ULOC_ACTUAL_LOCALE, &errorCode);
+    if(errorCode != U_USING_DEFAULT_WARNING || uprv_strcmp(actual, "fr") != 0) {
+        log_err("ures_open(xx_YY) with default locale fr gave %s/%s\n", actual, u_errorName(errorCode));
+    }
+    ures_close(rb);
+    errorCode = U_ZERO_ERROR;
+    uloc_setDefault(defaultLocale, &errorCode);
+}
+
+/*
+ * Repeated ures_getByKeyWithFallback() lookups are answered from the
+ * resolved-path cache, and must give the same results as the first lookup.
+ * The buddhist DateTimePatterns are a "/LOCALE/" alias in root,
+ * which resolves to the requested locale's generic DateTimePatterns.
+ * The roc table is found in a parent bundle, where its DateTimePatterns
+ * are such an alias; it may resolve to the requested locale below that bundle.
+ */
+static void TestPathCache(void) {
+    static const char *const locales[] = { "de_AT", "de_CH", "de" };
+    int32_t i, j;
+
+    for(i = 0; i < (int32_t)(sizeof(locales)/sizeof(locales[0])); ++i) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        UResourceBundle *rb = ures_open(NULL, locales[i], &errorCode);
+        UResourceBundle *generic, *roc, *item;
+        const UChar *expected, *actual;
+        int32_t expectedLength, actualLength;
+        if(U_FAILURE(errorCode)) {
+            log_data_err("ures_open(%s) failed - %s\n", locales[i], u_errorName(errorCode));
+            continue;
+        }
+        generic = ures_getByKeyWithFallback(rb, "calendar/generic/DateTimePatterns", NULL, &errorCode);
+        expected = ures_getStringByIndex(generic, 4, &expectedLength, &errorCode);
+        roc = ures_getByKeyWithFallback(rb, "calendar/roc", NULL, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("%s calendar/generic/DateTimePatterns or calendar/roc - %s\n",
+                         locales[i], u_errorName(errorCode));
+            ures_close(roc);
+            ures_close(generic);
+            ures_close(rb);
+            continue;
+        }
+        for(j = 0; j < 2; ++j) {
+            int32_t hits, misses, hits2, misses2;
+            ures_getPathCacheStatistics(&hits, &misses);
+            errorCode = U_ZERO_ERROR;
+            item = ures_getByKeyWithFallback(rb, "calendar/buddhist/DateTimePatterns", NULL, &errorCode);
+            actual = ures_getStringByIndex(item, 4, &actualLength, &errorCode);
+            if(U_FAILURE(errorCode) || actualLength != expectedLength || u_strcmp(actual, expected) != 0) {
+                log_err("%s calendar/buddhist/DateTimePatterns[4] wrong in lookup %d - %s\n",
+                        locales[i], (int)j, u_errorName(errorCode));
+            }
+            ures_close(item);
+
+            errorCode = U_ZERO_ERROR;
+            item = ures_getByKeyWithFallback(rb, "calendar/buddhist/noSuchKey", NULL, &errorCode);
+            if(errorCode != U_MISSING_RESOURCE_ERROR) {
+                log_err("%s calendar/buddhist/noSuchKey in lookup %d - %s\n",
+                        locales[i], (int)j, u_errorName(errorCode));
+            }
+            ures_close(item);
+
+            errorCode = U_ZERO_ERROR;
+            item = ures_getByKeyWithFallback(roc, "DateTimePatterns", NULL, &errorCode);
+            actual = ures_getStringByIndex(item, 4, &actualLength, &errorCode);
+            if(U_FAILURE(errorCode) || actualLength != expectedLength || u_strcmp(actual, expected) != 0) {
+                log_err("%s calendar/roc + DateTimePatterns[4] wrong in lookup %d - %s\n",
+                        locales[i], (int)j, u_errorName(errorCode));
+            }
+            ures_close(item);
+
+            ures_getPathCacheStatistics(&hits2, &misses2);
+            if((hits2 - hits) + (misses2 - misses) != 3 || (j == 1 && hits2 - hits != 3)) {
+                log_err("%s path cache lookup %d: %d hits and %d misses\n",
+                        locales[i], (int)j, (int)(hits2 - hits), (int)(misses2 - misses));
+            }
+        }
+        ures_close(roc);
+        ures_close(generic);
+        ures_close(rb);
+    }
+}
+
 /* Test ures_getUTF8StringXYZ() --------------------------------------------- */
 
 /*
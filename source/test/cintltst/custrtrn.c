@@ -38,6 +38,8 @@ static void Test_strFromUTF32_surrogates(void);
 static void Test_UChar_UTF8_API(void);
 static void Test_FromUTF8(void);
 static void Test_FromUTF8Lenient(void);
+static void Test_FromUTF8ASCIIRuns(void);
+static void Test_ToUTF8ASCIIRuns(void);
 static void Test_UChar_WCHART_API(void);
 static void Test_widestrs(void);
 static void Test_WCHART_LongString(void);
@@ -55,6 +57,8 @@ addUCharTransformTest(TestNode** root)
    addTest(root, &Test_UChar_UTF8_API, "custrtrn/Test_UChar_UTF8_API");
    addTest(root, &Test_FromUTF8, "custrtrn/Test_FromUTF8");
    addTest(root, &Test_FromUTF8Lenient, "custrtrn/Test_FromUTF8Lenient");
+   addTest(root, &Test_FromUTF8ASCIIRuns, "custrtrn/Test_FromUTF8ASCIIRuns");
+   addTest(root, &Test_ToUTF8ASCIIRuns, "custrtrn/Test_ToUTF8ASCIIRuns");
    addTest(root, &Test_UChar_WCHART_API,  "custrtrn/Test_UChar_WCHART_API");
    addTest(root, &Test_widestrs,  "custrtrn/Test_widestrs");
 #if !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
@@ -927,6 +931,167 @@ Test_FromUTF8(void) {
     }
 }
 
+/*
+ * Test u_strFromUTF8WithSub() with ASCII runs of various lengths
+ * around multi-byte sequences and illegal bytes,
+ * to exercise the bulk ASCII code path and its handover points.
+ */
+static void
+Test_FromUTF8ASCIIRuns(void) {
+    static const uint8_t nonASCII[]={ 0xc3, 0xa9, 0xff, 0xe4, 0xb8, 0xad, 0xf0, 0x9f, 0x98, 0x80 };
+    static const UChar nonASCII16[]={ 0xe9, 0xfffd, 0x4e2d, 0xd83d, 0xde00 };
+    uint8_t src[200];
+    UChar expected[200], dest[200];
+    int32_t runLength, srcLength, expectedLength, destLength, numSubstitutions, i;
+    UErrorCode errorCode;
+
+    for(runLength=0; runLength<=40; ++runLength) {
+        /* runLength ASCII bytes, the non-ASCII sequences, runLength ASCII bytes */
+        srcLength=expectedLength=0;
+        for(i=0; i<runLength; ++i) {
+            src[srcLength++]=(uint8_t)(0x41+i%26);
+            expected[expectedLength++]=(UChar)(0x41+i%26);
+        }
+        for(i=0; i<LENGTHOF(nonASCII); ++i) {
+            src[srcLength++]=nonASCII[i];
+        }
+        for(i=0; i<LENGTHOF(nonASCII16); ++i) {
+            expected[expectedLength++]=nonASCII16[i];
+        }
+        for(i=0; i<runLength; ++i) {
+            src[srcLength++]=(uint8_t)(0x61+i%26);
+            expected[expectedLength++]=(UChar)(0x61+i%26);
+        }
+
+        errorCode=U_ZERO_ERROR;
+        u_strFromUTF8WithSub(dest, LENGTHOF(dest), &destLength,
+                             (const char *)src, srcLength,
+                             0xfffd, &numSubstitutions, &errorCode);
+        if( U_FAILURE(errorCode) || destLength!=expectedLength || numSubstitutions!=1 ||
+            0!=u_memcmp(dest, expected, expectedLength)
+        ) {
+            log_err("error: u_strFromUTF8WithSub(runLength=%ld) fails: destLength=%ld - %s\n",
+                    (long)runLength, (long)destLength, u_errorName(errorCode));
+        }
+
+        /* preflighting */
+        errorCode=U_ZERO_ERROR;
+        u_strFromUTF8WithSub(NULL, 0, &destLength,
+                             (const char *)src, srcLength,
+                             0xfffd, NULL, &errorCode);
+        if(errorCode!=U_BUFFER_OVERFLOW_ERROR || destLength!=expectedLength) {
+            log_err("error: u_strFromUTF8WithSub(preflight runLength=%ld) fails: destLength=%ld - %s\n",
+                    (long)runLength, (long)destLength, u_errorName(errorCode));
+        }
+
+        /* destination too short, partly filled then preflighted */
+        errorCode=U_ZERO_ERROR;
+        u_strFromUTF8WithSub(dest, runLength+1, &destLength,
+                             (const char *)src, srcLength,
+                             0xfffd, NULL, &errorCode);
+        if( errorCode!=U_BUFFER_OVERFLOW_ERROR || destLength!=expectedLength ||
+            0!=u_memcmp(dest, expected, runLength+1)
+        ) {
+            log_err("error: u_strFromUTF8WithSub(destCapacity=runLength+1=%ld) fails: destLength=%ld - %s\n",
+                    (long)(runLength+1), (long)destLength, u_errorName(errorCode));
+        }
+
+        /* no substitution character: the illegal byte is an error */
+        errorCode=U_ZERO_ERROR;
+        u_strFromUTF8(dest, LENGTHOF(dest), &destLength,
+                      (const char *)src, srcLength, &errorCode);
+        if(errorCode!=U_INVALID_CHAR_FOUND) {
+            log_err("error: u_strFromUTF8(runLength=%ld) with illegal byte: %s\n",
+                    (long)runLength, u_errorName(errorCode));
+        }
+    }
+}
+
+/*
+ * Test u_strToUTF8WithSub() with ASCII and BMP runs of various lengths
+ * around supplementary code points and an unpaired surrogate,
+ * to exercise the bulk code paths for conversion and preflighting.
+ */
+static void
+Test_ToUTF8ASCIIRuns(void) {
+    static const UChar nonASCII[]={ 0xe9, 0x4e2d, 0xd83d, 0xde00, 0xdc00, 0x7ff, 0x800 };
+    static const uint8_t nonASCII8[]={
+        0xc3, 0xa9, 0xe4, 0xb8, 0xad, 0xf0, 0x9f, 0x98, 0x80, 0xef, 0xbf, 0xbd,
+        0xdf, 0xbf, 0xe0, 0xa0, 0x80
+    };
+    UChar src[200];
+    char expected[400], dest[400];
+    int32_t runLength, srcLength, expectedLength, destLength, numSubstitutions, i;
+    UErrorCode errorCode;
+
+    for(runLength=0; runLength<=40; ++runLength) {
+        /* runLength ASCII, the non-ASCII code points, runLength CJK, runLength ASCII */
+        srcLength=expectedLength=0;
+        for(i=0; i<runLength; ++i) {
+            src[srcLength++]=(UChar)(0x41+i%26);
+            expected[expectedLength++]=(char)(0x41+i%26);
+        }
+        for(i=0; i<LENGTHOF(nonASCII); ++i) {
+            src[srcLength++]=nonASCII[i];
+        }
+        for(i=0; i<LENGTHOF(nonASCII8); ++i) {
+            expected[expectedLength++]=(char)nonASCII8[i];
+        }
+        for(i=0; i<runLength; ++i) {
+            src[srcLength++]=0x4e00;
+            expected[expectedLength++]=(char)0xe4;
+            expected[expectedLength++]=(char)0xb8;
+            expected[expectedLength++]=(char)0x80;
+        }
+        for(i=0; i<runLength; ++i) {
+            src[srcLength++]=(UChar)(0x61+i%26);
+            expected[expectedLength++]=(char)(0x61+i%26);
+        }
+
+        errorCode=U_ZERO_ERROR;
+        u_strToUTF8WithSub(dest, LENGTHOF(dest), &destLength,
+                           src, srcLength,
+                           0xfffd, &numSubstitutions, &errorCode);
+        if( U_FAILURE(errorCode) || destLength!=expectedLength || numSubstitutions!=1 ||
+            0!=uprv_memcmp(dest, expected, expectedLength)
+        ) {
+            log_err("error: u_strToUTF8WithSub(runLength=%ld) fails: destLength=%ld - %s\n",
+                    (long)runLength, (long)destLength, u_errorName(errorCode));
+        }
+
+        /* preflighting */
+        errorCode=U_ZERO_ERROR;
+        numSubstitutions=-1;
+        u_strToUTF8WithSub(NULL, 0, &destLength,
+                           src, srcLength,
+                           0xfffd, &numSubstitutions, &errorCode);
+        if(errorCode!=U_BUFFER_OVERFLOW_ERROR || destLength!=expectedLength || numSubstitutions!=1) {
+            log_err("error: u_strToUTF8WithSub(preflight runLength=%ld) fails: destLength=%ld - %s\n",
+                    (long)runLength, (long)destLength, u_errorName(errorCode));
+        }
+
+        /* destination too short, partly filled then preflighted */
+        errorCode=U_ZERO_ERROR;
+        u_strToUTF8WithSub(dest, runLength+1, &destLength,
+                           src, srcLength,
+                           0xfffd, NULL, &errorCode);
+        if( errorCode!=U_BUFFER_OVERFLOW_ERROR || destLength!=expectedLength ||
+            0!=uprv_memcmp(dest, expected, runLength)
+        ) {
+            log_err("error: u_strToUTF8WithSub(destCapacity=runLength+1=%ld) fails: destLength=%ld - %s\n",
+                    (long)(runLength+1), (long)destLength, u_errorName(errorCode));
+        }
+
+        /* no substitution character: the unpaired surrogate is an error */
+        errorCode=U_ZERO_ERROR;
+        u_strToUTF8(NULL, 0, &destLength, src, srcLength, &errorCode);
+        if(errorCode!=U_INVALID_CHAR_FOUND) {
+            log_err("error: u_strToUTF8(preflight runLength=%ld) with unpaired surrogate: %s\n",
+                    (long)runLength, u_errorName(errorCode));
+        }
+    }
+}
+
 /* test u_strFromUTF8Lenient() */
 static void
 Test_FromUTF8Lenient(void) {
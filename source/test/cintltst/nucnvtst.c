@@ -43,6 +43,8 @@ static void TestSignatureDetection(void);
 static void TestUTF7(void);
 static void TestIMAP(void);
 static void TestUTF8(void);
+static void TestUTF8ASCIIRuns(void);
+static void TestUTF8FromUnicodeASCIIRuns(void);
 static void TestCESU8(void);
 static void TestUTF16(void);
 static void TestUTF16BE(void);
@@ -259,6 +261,8 @@ void addTestNewConvert(TestNode** root)
    addTest(root, &TestUTF7, "tsconv/nucnvtst/TestUTF7");
    addTest(root, &TestIMAP, "tsconv/nucnvtst/TestIMAP");
    addTest(root, &TestUTF8, "tsconv/nucnvtst/TestUTF8");
+   addTest(root, &TestUTF8ASCIIRuns, "tsconv/nucnvtst/TestUTF8ASCIIRuns");
+   addTest(root, &TestUTF8FromUnicodeASCIIRuns, "tsconv/nucnvtst/TestUTF8FromUnicodeASCIIRuns");
 
    /* test ucnv_getNextUChar() for charsets that encode single surrogates with complete byte sequences */
    addTest(root, &TestCESU8, "tsconv/nucnvtst/TestCESU8");
@@ -1951,6 +1955,152 @@ static void TestUTF8() {
     ucnv_close(cnv);
 }
 
+/*
+ * Convert ASCII runs of various lengths around multi-byte sequences
+ * and an illegal byte, with offsets, into target buffers of various sizes,
+ * to exercise the bulk ASCII code path and its handover points.
+ */
+static void TestUTF8ASCIIRuns() {
+    static const uint8_t nonASCII[]={ 0xc3, 0xa9, 0xff, 0xf0, 0x9f, 0x98, 0x80 };
+    static const UChar nonASCII16[]={ 0xe9, 0xfffd, 0xd83d, 0xde00 };
+    static const int32_t nonASCIIOffsets[]={ 0, 2, 3, 3 };
+    static const int32_t chunkLengths[]={ 200, 1, 7, 17, 33 };
+    char src[200];
+    UChar expected[200], dest[200];
+    int32_t expectedOffsets[200], offsets[200];
+    int32_t runLength, srcLength, expectedLength, chunk, i;
+    UErrorCode errorCode=U_ZERO_ERROR;
+    UConverter *cnv=ucnv_open("UTF-8", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("Unable to open a UTF-8 converter: %s\n", u_errorName(errorCode));
+        return;
+    }
+
+    for(runLength=0; runLength<=40; ++runLength) {
+        srcLength=expectedLength=0;
+        for(i=0; i<runLength; ++i) {
+            expectedOffsets[expectedLength]=srcLength;
+            expected[expectedLength++]=(UChar)(0x41+i%26);
+            src[srcLength++]=(char)(0x41+i%26);
+        }
+        for(i=0; i<LENGTHOF(nonASCII16); ++i) {
+            expectedOffsets[expectedLength]=srcLength+nonASCIIOffsets[i];
+            expected[expectedLength++]=nonASCII16[i];
+        }
+        for(i=0; i<LENGTHOF(nonASCII); ++i) {
+            src[srcLength++]=(char)nonASCII[i];
+        }
+        for(i=0; i<runLength; ++i) {
+            expectedOffsets[expectedLength]=srcLength;
+            expected[expectedLength++]=(UChar)(0x61+i%26);
+            src[srcLength++]=(char)(0x61+i%26);
+        }
+
+        for(chunk=0; chunk<LENGTHOF(chunkLengths); ++chunk) {
+            const char *source=src;
+            UChar *target=dest;
+            int32_t *pOffsets=offsets;
+
+            ucnv_resetToUnicode(cnv);
+            errorCode=U_ZERO_ERROR;
+            do {
+                UChar *targetLimit=target+chunkLengths[chunk];
+                UChar *chunkStart=target;
+                if(targetLimit>dest+LENGTHOF(dest)) {
+                    targetLimit=dest+LENGTHOF(dest);
+                }
+                errorCode=U_ZERO_ERROR;
+                ucnv_toUnicode(cnv, &target, targetLimit, &source, src+srcLength,
+                               pOffsets, TRUE, &errorCode);
+                /* offsets are relative to the source at the start of each call, only checked for one chunk */
+                pOffsets+=target-chunkStart;
+            } while(errorCode==U_BUFFER_OVERFLOW_ERROR);
+            if( U_FAILURE(errorCode) || (target-dest)!=expectedLength ||
+                0!=u_memcmp(dest, expected, expectedLength)
+            ) {
+                log_err("UTF-8 toUnicode(runLength=%ld, chunk=%ld) fails: length=%ld - %s\n",
+                        (long)runLength, (long)chunkLengths[chunk], (long)(target-dest), u_errorName(errorCode));
+            } else if(chunkLengths[chunk]>=LENGTHOF(dest) &&
+                      0!=uprv_memcmp(offsets, expectedOffsets, expectedLength*(int32_t)sizeof(int32_t))) {
+                log_err("UTF-8 toUnicode(runLength=%ld) writes wrong offsets\n", (long)runLength);
+            }
+        }
+    }
+    ucnv_close(cnv);
+}
+
+/*
+ * Convert ASCII runs of various lengths around non-ASCII code points
+ * from Unicode, with offsets, into target buffers of various sizes.
+ */
+static void TestUTF8FromUnicodeASCIIRuns() {
+    static const UChar nonASCII[]={ 0xe9, 0xd83d, 0xde00, 0x4e2d };
+    static const uint8_t nonASCII8[]={ 0xc3, 0xa9, 0xf0, 0x9f, 0x98, 0x80, 0xe4, 0xb8, 0xad };
+    static const int32_t nonASCIIOffsets[]={ 0, 0, 1, 1, 1, 1, 3, 3, 3 };
+    static const int32_t chunkLengths[]={ 400, 1, 7, 17, 33 };
+    UChar src[200];
+    char expected[400], dest[400];
+    int32_t expectedOffsets[400], offsets[400];
+    int32_t runLength, srcLength, expectedLength, chunk, i;
+    UErrorCode errorCode=U_ZERO_ERROR;
+    UConverter *cnv=ucnv_open("UTF-8", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("Unable to open a UTF-8 converter: %s\n", u_errorName(errorCode));
+        return;
+    }
+
+    for(runLength=0; runLength<=40; ++runLength) {
+        srcLength=expectedLength=0;
+        for(i=0; i<runLength; ++i) {
+            expectedOffsets[expectedLength]=srcLength;
+            expected[expectedLength++]=(char)(0x41+i%26);
+            src[srcLength++]=(UChar)(0x41+i%26);
+        }
+        for(i=0; i<LENGTHOF(nonASCII8); ++i) {
+            expectedOffsets[expectedLength]=srcLength+nonASCIIOffsets[i];
+            expected[expectedLength++]=(char)nonASCII8[i];
+        }
+        for(i=0; i<LENGTHOF(nonASCII); ++i) {
+            src[srcLength++]=nonASCII[i];
+        }
+        for(i=0; i<runLength; ++i) {
+            expectedOffsets[expectedLength]=srcLength;
+            expected[expectedLength++]=(char)(0x61+i%26);
+            src[srcLength++]=(UChar)(0x61+i%26);
+        }
+
+        for(chunk=0; chunk<LENGTHOF(chunkLengths); ++chunk) {
+            const UChar *source=src;
+            char *target=dest;
+            int32_t *pOffsets=offsets;
+
+            ucnv_resetFromUnicode(cnv);
+            do {
+                char *targetLimit=target+chunkLengths[chunk];
+                char *chunkStart=target;
+                if(targetLimit>dest+LENGTHOF(dest)) {
+                    targetLimit=dest+LENGTHOF(dest);
+                }
+                errorCode=U_ZERO_ERROR;
+                ucnv_fromUnicode(cnv, &target, targetLimit, &source, src+srcLength,
+                                 pOffsets, TRUE, &errorCode);
+                /* offsets are relative to the source at the start of each call, only checked for one chunk */
+                pOffsets+=target-chunkStart;
+            } while(errorCode==U_BUFFER_OVERFLOW_ERROR);
+            if( U_FAILURE(errorCode) || (target-dest)!=expectedLength ||
+                0!=uprv_memcmp(dest, expected, expectedLength)
+            ) {
+                log_err("UTF-8 fromUnicode(runLength=%ld, chunk=%ld) fails: length=%ld - %s\n",
+                        (long)runLength, (long)chunkLengths[chunk], (long)(target-dest), u_errorName(errorCode));
+            } else if(chunkLengths[chunk]>=LENGTHOF(dest) &&
+                      0!=uprv_memcmp(offsets, expectedOffsets, expectedLength*(int32_t)sizeof(int32_t))) {
+                log_err("UTF-8 fromUnicode(runLength=%ld) writes wrong offsets\n", (long)runLength);
+            }
+        }
+    }
+    ucnv_close(cnv);
+}
+
 static void TestCESU8() {
     /* test input */
     static const uint8_t in[]={
@@ -28,6 +28,7 @@
 #include "cintltst.h"
 #include "ubrkimpl.h"
 #include "toolutil.h" /* for uprv_fileExists() */
+#include "pkg_gencmn.h" /* for createTOCIndex() */
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -72,6 +73,10 @@ static void TestICUDataName(void);
 static void PointerTableOfContents(void);
 static void SetBadCommonData(void);
 static void TestUDataFileAccess(void);
+static void TestTOCIndex(void);
+#if !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
+static void TestUDataWarmUp(void);
+#endif
 
 
 void addUDataTest(TestNode** root);
@@ -88,12 +93,14 @@ addUDataTest(TestNode** root)
     addTest(root, &TestErrorConditions, "udatatst/TestErrorConditions");
     addTest(root, &TestAppData, "udatatst/TestAppData" );
     addTest(root, &TestSwapData, "udatatst/TestSwapData" );
+    addTest(root, &TestUDataWarmUp, "udatatst/TestUDataWarmUp" );
 #endif
     addTest(root, &TestUDataSetAppData, "udatatst/TestUDataSetAppData" );
     addTest(root, &TestICUDataName, "udatatst/TestICUDataName" );
     addTest(root, &PointerTableOfContents, "udatatst/PointerTableOfContents" );
     addTest(root, &SetBadCommonData, "udatatst/SetBadCommonData" );
     addTest(root, &TestUDataFileAccess, "udatatst/TestUDataFileAccess" );
+    addTest(root, &TestTOCIndex, "udatatst/TestTOCIndex" );
 }
 
 #if 0
@@ -906,6 +913,190 @@ static void TestUDataGetMemory() {
 
 }
 
+#if !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
+static void TestUDataWarmUp() {
+    UErrorCode status=U_ZERO_ERROR;
+    int32_t count, count2;
+
+    const char* testPath = loadTestData(&status);
+    if(U_FAILURE(status)) {
+        log_data_err("Could not load testdata.dat, status = %s\n", u_errorName(status));
+        return;
+    }
+
+    udata_setMapOptions(0x80, &status);
+    if(status!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("FAIL: udata_setMapOptions(unknown bit) returned %s\n", myErrorName(status));
+    }
+    status=U_ZERO_ERROR;
+    udata_setMapOptions(UDATA_MAP_WILLNEED|UDATA_MAP_HUGEPAGE|UDATA_MAP_POPULATE, &status);
+    if(U_FAILURE(status)) {
+        log_err("FAIL: udata_setMapOptions(all hints) failed - %s\n", myErrorName(status));
+    }
+
+    /* the second warm-up must not find more non-resident pages than the first */
+    count=udata_warmUp(testPath, "icu", "test", &status);
+    count2=udata_warmUp(testPath, "icu", "test", &status);
+    if(U_FAILURE(status) || count<0 || count2<0 || count2>count) {
+        log_err("FAIL: udata_warmUp(test.icu) returned %ld then %ld pages - %s\n",
+                (long)count, (long)count2, myErrorName(status));
+    }
+    log_verbose("udata_warmUp(test.icu) faulted in %ld then %ld pages\n", (long)count, (long)count2);
+
+    count=udata_warmUp(NULL, "icu", "cnvalias", &status);
+    if(U_FAILURE(status) || count<0) {
+        log_data_err("FAIL: udata_warmUp(cnvalias.icu) returned %ld - %s\n", (long)count, myErrorName(status));
+    }
+
+    status=U_ZERO_ERROR;
+    count=udata_warmUp(testPath, "icu", "no_such_item", &status);
+    if(U_SUCCESS(status) || count!=0) {
+        log_err("FAIL: udata_warmUp(no_such_item.icu) returned %ld - %s\n", (long)count, myErrorName(status));
+    }
+
+    status=U_ZERO_ERROR;
+    udata_setMapOptions(0, &status);
+}
+#endif
+
+/* write a minimal 32-byte ICU data header */
+static void writeTestDataHeader(uint8_t *p, const uint8_t dataFormat[4]) {
+    UDataInfo *pInfo=(UDataInfo *)(p+4);
+    uprv_memset(p, 0, 32);
+    *(uint16_t *)p=32;
+    p[2]=0xda;
+    p[3]=0x27;
+    pInfo->size=(uint16_t)sizeof(UDataInfo);
+    pInfo->isBigEndian=U_IS_BIG_ENDIAN;
+    pInfo->charsetFamily=U_CHARSET_FAMILY;
+    pInfo->sizeofUChar=U_SIZEOF_UCHAR;
+    uprv_memcpy(pInfo->dataFormat, dataFormat, 4);
+    pInfo->formatVersion[0]=1;
+}
+
+/*
+ * Build a .dat package in memory with the item names sorted and prefixed by the package name.
+ * The ToC index is built for indexNames, which are the names in a possibly different order;
+ * if indexNames is NULL, then the package gets an unusable index.
+ * Returns the package length.
+ */
+static int32_t buildTOCIndexTestPackage(uint32_t *package, int32_t capacity,
+                                        const char *const names[], int32_t count,
+                                        int32_t indexNumber, const char *const indexNames[]) {
+    static const uint8_t cmndFormat[4]={ 0x43, 0x6d, 0x6e, 0x44 };  /* "CmnD" */
+    static const uint8_t testFormat[4]={ 0x54, 0x73, 0x74, 0x44 };  /* "TstD" */
+    uint8_t *bytes=(uint8_t *)package;
+    uint32_t *toc=package+8;  /* after the 32-byte header */
+    int32_t i, nameOffset, dataOffset, indexLength;
+
+    uprv_memset(package, 0, capacity);
+    writeTestDataHeader(bytes, cmndFormat);
+    toc[0]=count;
+    nameOffset=4+8*count;
+    dataOffset=nameOffset;
+    for(i=0; i<count; ++i) {
+        dataOffset+=(int32_t)uprv_strlen(names[i])+1;
+    }
+    dataOffset=(dataOffset+15)&~15;
+    indexLength=createTOCIndex(NULL, count, U_IS_BIG_ENDIAN, U_CHARSET_FAMILY, NULL, 0);
+    for(i=0; i<count; ++i) {
+        toc[1+2*i]=nameOffset;
+        toc[2+2*i]=dataOffset;
+        uprv_strcpy((char *)toc+nameOffset, names[i]);
+        nameOffset+=(int32_t)uprv_strlen(names[i])+1;
+        if(i==indexNumber) {
+            uint8_t *index=(uint8_t *)toc+dataOffset;
+            if(createTOCIndex(indexNames!=NULL ? indexNames : names, count, U_IS_BIG_ENDIAN, U_CHARSET_FAMILY,
+                              index, indexLength)!=indexLength) {
+                log_err("createTOCIndex() failed\n");
+            }
+            if(indexNames==NULL) {
+                /* an index for a different number of items is ignored */
+                ++((uint32_t *)(index+32))[UDATA_TOC_INDEX_COUNT];
+            }
+            dataOffset+=indexLength;
+        } else {
+            writeTestDataHeader((uint8_t *)toc+dataOffset, testFormat);
+            dataOffset+=32;
+        }
+    }
+    if((32+dataOffset)>capacity) {
+        log_err("TOC index test package too long\n");
+    }
+    return 32+dataOffset;
+}
+
+static void TestTOCIndex() {
+    static const char *const names[]={
+        "tocidx1/a.tst", "tocidx1/b.tst", "tocidx1/coll/c.tst", "tocidx1/tocindex.idx", "tocidx1/z.tst"
+    };
+    static const char *const names2[]={
+        "tocidx2/a.tst", "tocidx2/b.tst", "tocidx2/coll/c.tst", "tocidx2/tocindex.idx", "tocidx2/z.tst"
+    };
+    static const char *const names3[]={
+        "tocidx3/a.tst", "tocidx3/b.tst", "tocidx3/coll/c.tst", "tocidx3/tocindex.idx", "tocidx3/z.tst"
+    };
+    /* b and coll/c swapped: passes the loader's spot checks but misleads the hash for them */
+    static const char *const wrongIndexNames3[]={
+        "tocidx3/a.tst", "tocidx3/coll/c.tst", "tocidx3/b.tst", "tocidx3/tocindex.idx", "tocidx3/z.tst"
+    };
+    static const char *const found[]={ "a", "b", "coll/c", "z" };
+    static const char *const notFound[]={ "", "0", "aa", "c", "coll/b", "coll/c/", "tocindex2", "zz" };
+    static const uint8_t indexFormat[4]={ 0x54, 0x6f, 0x43, 0x48 };  /* "ToCH" */
+    static uint32_t package1[128], package2[128], package3[128];
+    const char *const packages[]={ "tocidx1", "tocidx2", "tocidx3" };
+    UDataMemory *pData;
+    UErrorCode errorCode;
+    int32_t i, p;
+
+    /*
+     * The loader must find the same items with the perfect hash and with the binary search,
+     * and with an index which is wrong for some of the items.
+     */
+    buildTOCIndexTestPackage(package1, (int32_t)sizeof(package1), names, LENGTHOF(names), 3, names);
+    buildTOCIndexTestPackage(package2, (int32_t)sizeof(package2), names2, LENGTHOF(names2), 3, NULL);
+    buildTOCIndexTestPackage(package3, (int32_t)sizeof(package3), names3, LENGTHOF(names3), 3,
+                             wrongIndexNames3);
+    errorCode=U_ZERO_ERROR;
+    udata_setAppData(packages[0], package1, &errorCode);
+    udata_setAppData(packages[1], package2, &errorCode);
+    udata_setAppData(packages[2], package3, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("udata_setAppData(TOC index test packages) failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+    for(p=0; p<LENGTHOF(packages); ++p) {
+        for(i=0; i<LENGTHOF(found); ++i) {
+            errorCode=U_ZERO_ERROR;
+            pData=udata_open(packages[p], "tst", found[i], &errorCode);
+            if(U_FAILURE(errorCode)) {
+                log_err("udata_open(%s, %s.tst) failed - %s\n", packages[p], found[i], u_errorName(errorCode));
+            } else {
+                udata_close(pData);
+            }
+        }
+        for(i=0; i<LENGTHOF(notFound); ++i) {
+            errorCode=U_ZERO_ERROR;
+            pData=udata_open(packages[p], "tst", notFound[i], &errorCode);
+            if(U_SUCCESS(errorCode)) {
+                log_err("udata_open(%s, %s.tst) succeeded but should have failed\n", packages[p], notFound[i]);
+                udata_close(pData);
+            }
+        }
+        errorCode=U_ZERO_ERROR;
+        pData=udata_open(packages[p], "idx", "tocindex", &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("udata_open(%s, tocindex.idx) failed - %s\n", packages[p], u_errorName(errorCode));
+        } else {
+            const UDataInfo *pInfo=&((const DataHeader *)udata_getRawMemory(pData))->info;
+            if(0!=uprv_memcmp(pInfo->dataFormat, indexFormat, 4)) {
+                log_err("%s/tocindex.idx does not have dataFormat ToCH\n", packages[p]);
+            }
+            udata_close(pData);
+        }
+    }
+}
+
 static void TestErrorConditions(){
 
     UDataMemory *result=NULL;
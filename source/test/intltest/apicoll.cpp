@@ -44,6 +44,7 @@
 
 #include "sfwdchit.h"
 #include "cmemory.h"
+#include "ucol_imp.h"
 #include <stdlib.h>
 
 #define LENGTHOF(array) (int32_t)(sizeof(array)/sizeof((array)[0]))
@@ -2402,6 +2403,345 @@ void CollationAPITest::TestIterNumeric() {
     assertEquals("40<72", (int32_t)UCOL_LESS, (int32_t)result);
 }
 
+void CollationAPITest::TestTailoringCache() {
+    IcuTestErrorCode errorCode(*this, "TestTailoringCache");
+    static const char *const locales[] = {
+        "de@collation=phonebook", "sv", "zh_Hant_TW", "de_AT@collation=nosuchtype", "root"
+    };
+    for(int32_t i = 0; i < LENGTHOF(locales); ++i) {
+        Locale locale(locales[i]);
+        UErrorCode status1 = U_ZERO_ERROR, status2 = U_ZERO_ERROR;
+        LocalPointer<Collator> coll1(Collator::createInstance(locale, status1));
+        if(U_FAILURE(status1)) {
+            dataerrln("Collator::createInstance(%s) failed - %s", locales[i], u_errorName(status1));
+            continue;
+        }
+        int32_t hits, misses, hits2, misses2;
+        ucol_getTailoringCacheStatistics(&hits, &misses);
+        LocalPointer<Collator> coll2(Collator::createInstance(locale, status2));
+        ucol_getTailoringCacheStatistics(&hits2, &misses2);
+        if(U_FAILURE(status2)) {
+            errln("Collator::createInstance(%s) failed the second time - %s",
+                  locales[i], u_errorName(status2));
+            continue;
+        }
+        assertEquals(UnicodeString(locales[i]) + " status", u_errorName(status1), u_errorName(status2));
+        assertEquals(UnicodeString(locales[i]) + " cache hits", 1, hits2 - hits);
+        assertEquals(UnicodeString(locales[i]) + " cache misses", 0, misses2 - misses);
+        assertTrue(UnicodeString(locales[i]) + " collators equal", *coll1 == *coll2);
+        assertEquals(UnicodeString(locales[i]) + " valid locale",
+                     coll1->getLocale(ULOC_VALID_LOCALE, errorCode).getName(),
+                     coll2->getLocale(ULOC_VALID_LOCALE, errorCode).getName());
+        assertEquals(UnicodeString(locales[i]) + " actual locale",
+                     coll1->getLocale(ULOC_ACTUAL_LOCALE, errorCode).getName(),
+                     coll2->getLocale(ULOC_ACTUAL_LOCALE, errorCode).getName());
+    }
+
+    // Tailorings that fell back to the default locale must not be cached.
+    Locale defaultLocale;
+    Locale::setDefault(Locale("sv"), errorCode);
+    LocalPointer<Collator> coll(Collator::createInstance(Locale("xx_YY"), errorCode));
+    if(errorCode.logDataIfFailureAndReset("Collator::createInstance(xx_YY)")) {
+        Locale::setDefault(defaultLocale, errorCode);
+        return;
+    }
+    assertEquals("xx_YY with default sv", "sv", coll->getLocale(ULOC_VALID_LOCALE, errorCode).getName());
+    Locale::setDefault(Locale("de"), errorCode);
+    coll.adoptInstead(Collator::createInstance(Locale("xx_YY"), errorCode));
+    if(errorCode.logIfFailureAndReset("Collator::createInstance(xx_YY)")) {
+        Locale::setDefault(defaultLocale, errorCode);
+        return;
+    }
+    assertEquals("xx_YY with default de", "de", coll->getLocale(ULOC_VALID_LOCALE, errorCode).getName());
+    Locale::setDefault(defaultLocale, errorCode);
+}
+
+namespace {
+
+// Reference: stable insertion sort of indexes with compare().
+void sortIndexesWithCompare(const Collator &coll, const UnicodeString *strings, int32_t length,
+                            int32_t *indexes, UErrorCode &errorCode) {
+    for(int32_t i = 0; i < length; ++i) {
+        int32_t j = i;
+        while(j > 0 && coll.compare(strings[indexes[j - 1]], strings[i], errorCode) > 0) {
+            indexes[j] = indexes[j - 1];
+            --j;
+        }
+        indexes[j] = i;
+    }
+}
+
+}  // namespace
+
+void CollationAPITest::TestBatchSort() {
+    IcuTestErrorCode errorCode(*this, "TestBatchSort");
+    // Pieces with different collation properties: case & accent variants,
+    // contractions, digits, variable characters, supplementary & ignorable code points.
+    static const char *const pieces[] = {
+        "a", "A", "\\u00E4", "b", "ch", "c", "\\u00DF", "ss", "-", " ", "1", "2", "10",
+        "\\u0308", "\\u0301", "\\u00E9", "\\u03B1", "\\u4E00", "\\U0001F600", "\\u00AD", "\\uFFFD"
+    };
+    static const int32_t LENGTH = 400;
+    UnicodeString strings[LENGTH];
+    uint32_t random = 1;
+    for(int32_t i = 0; i < LENGTH; ++i) {
+        if(i >= 10 && (i % 10) == 0) {
+            strings[i] = strings[i / 3];  // some duplicates
+            continue;
+        }
+        if((i % 7) == 3) {
+            // long common prefix, so that sort key prefixes are equal
+            strings[i].setTo(UnicodeString("Abcdefghijklmnopqrstuvwxyz Abcdefghijklmnopqrstuvwxyz"));
+        }
+        random = random * 1103515245 + 12345;
+        int32_t numPieces = (int32_t)((random >> 16) % 12);
+        for(int32_t j = 0; j < numPieces; ++j) {
+            random = random * 1103515245 + 12345;
+            strings[i].append(UnicodeString(pieces[(random >> 16) % LENGTHOF(pieces)], -1, US_INV).unescape());
+        }
+    }
+    // UTF-8 versions, with a few ill-formed sequences
+    // which must sort like in compareUTF8().
+    char utf8[LENGTH * 50];
+    StringPiece pieces8[LENGTH];
+    int32_t length8 = 0;
+    for(int32_t i = 0; i < LENGTH; ++i) {
+        int32_t start = length8;
+        if(i == 17) {
+            utf8[length8++] = (char)0xe4;
+            utf8[length8++] = (char)0xb8;
+        }
+        int32_t sLength8;
+        u_strToUTF8(utf8 + length8, LENGTHOF(utf8) - length8, &sLength8,
+                    strings[i].getBuffer(), strings[i].length(), errorCode);
+        length8 += sLength8;
+        if(i == 7) {
+            utf8[length8++] = (char)0xc3;
+        } else if(i == 27) {
+            utf8[length8++] = (char)0xf0;
+            utf8[length8++] = (char)0x9f;
+            utf8[length8++] = (char)0x98;
+        }
+        pieces8[i].set(utf8 + start, length8 - start);
+    }
+    if(errorCode.logIfFailureAndReset("u_strToUTF8()")) {
+        return;
+    }
+
+    static const struct {
+        const char *locale;
+        UColAttribute attr;
+        UColAttributeValue value;
+    } configs[] = {
+        { "root", UCOL_STRENGTH, UCOL_TERTIARY },
+        { "root", UCOL_STRENGTH, UCOL_PRIMARY },
+        { "root", UCOL_STRENGTH, UCOL_IDENTICAL },
+        { "root", UCOL_ALTERNATE_HANDLING, UCOL_SHIFTED },
+        { "root", UCOL_NUMERIC_COLLATION, UCOL_ON },
+        { "root", UCOL_CASE_FIRST, UCOL_UPPER_FIRST },
+        { "root", UCOL_NORMALIZATION_MODE, UCOL_ON },
+        { "de@collation=phonebook", UCOL_STRENGTH, UCOL_TERTIARY },
+        { "es@collation=traditional", UCOL_STRENGTH, UCOL_QUATERNARY },
+        { "fr_CA", UCOL_FRENCH_COLLATION, UCOL_ON }
+    };
+    for(int32_t c = 0; c < LENGTHOF(configs); ++c) {
+        UnicodeString name = UnicodeString(configs[c].locale) + " config " + c;
+        LocalPointer<Collator> coll(Collator::createInstance(Locale(configs[c].locale), errorCode));
+        if(errorCode.logDataIfFailureAndReset("Collator::createInstance(%s)", configs[c].locale)) {
+            continue;
+        }
+        coll->setAttribute(configs[c].attr, configs[c].value, errorCode);
+        if(configs[c].attr == UCOL_ALTERNATE_HANDLING) {
+            coll->setAttribute(UCOL_STRENGTH, UCOL_QUATERNARY, errorCode);
+        }
+        RuleBasedCollator *rbc = dynamic_cast<RuleBasedCollator *>(coll.getAlias());
+        if(rbc == NULL) {
+            errln(name + ": not a RuleBasedCollator");
+            continue;
+        }
+
+        int32_t expected[LENGTH], indexes[LENGTH];
+        sortIndexesWithCompare(*coll, strings, LENGTH, expected, errorCode);
+        rbc->sortIndexes(strings, LENGTH, indexes, errorCode);
+        if(errorCode.logIfFailureAndReset("sortIndexes()")) { continue; }
+        for(int32_t i = 0; i < LENGTH; ++i) {
+            if(indexes[i] != expected[i]) {
+                errln(name + ": sortIndexes() differs from compare() at [" + i + "]");
+                break;
+            }
+        }
+        UnicodeString sorted[LENGTH];
+        for(int32_t i = 0; i < LENGTH; ++i) { sorted[i] = strings[i]; }
+        rbc->sort(sorted, LENGTH, errorCode);
+        if(errorCode.logIfFailureAndReset("sort()")) { continue; }
+        for(int32_t i = 0; i < LENGTH; ++i) {
+            if(sorted[i] != strings[expected[i]]) {
+                errln(name + ": sort() differs from compare() at [" + i + "]");
+                break;
+            }
+        }
+
+        // UTF-8: Verify that adjacent strings are in order,
+        // and that equal strings keep their original order.
+        rbc->sortIndexesUTF8(pieces8, LENGTH, indexes, errorCode);
+        if(errorCode.logIfFailureAndReset("sortIndexesUTF8()")) { continue; }
+        for(int32_t i = 1; i < LENGTH; ++i) {
+            UCollationResult order = coll->compareUTF8(pieces8[indexes[i - 1]], pieces8[indexes[i]], errorCode);
+            if(order > 0 || (order == 0 && indexes[i - 1] > indexes[i])) {
+                errln(name + ": sortIndexesUTF8() out of order at [" + i + "]");
+                break;
+            }
+        }
+        StringPiece sorted8[LENGTH];
+        for(int32_t i = 0; i < LENGTH; ++i) { sorted8[i] = pieces8[i]; }
+        rbc->sortUTF8(sorted8, LENGTH, errorCode);
+        if(errorCode.logIfFailureAndReset("sortUTF8()")) { continue; }
+        for(int32_t i = 0; i < LENGTH; ++i) {
+            if(sorted8[i].data() != pieces8[indexes[i]].data()) {
+                errln(name + ": sortUTF8() differs from sortIndexesUTF8() at [" + i + "]");
+                break;
+            }
+        }
+    }
+
+    // Empty and single-element arrays.
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getRoot(), errorCode));
+    if(errorCode.logDataIfFailureAndReset("Collator::createInstance(root)")) {
+        return;
+    }
+    RuleBasedCollator *rbc = dynamic_cast<RuleBasedCollator *>(coll.getAlias());
+    int32_t index = -1;
+    rbc->sortIndexes(NULL, 0, NULL, errorCode);
+    rbc->sortIndexes(strings, 1, &index, errorCode);
+    errorCode.logIfFailureAndReset("sortIndexes() with 0 or 1 strings");
+    assertEquals("sortIndexes() with 1 string", 0, index);
+    rbc->sortIndexes(strings, -1, &index, errorCode);
+    assertEquals("sortIndexes() with negative length", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+}
+
+void CollationAPITest::TestSortKeyPrefix() {
+    IcuTestErrorCode errorCode(*this, "TestSortKeyPrefix");
+    static const char *const strs[] = {
+        "", "a", "A", "ab", "a-b", "a b", "\\u00E4b", "Ab", "abc", "ch", "cz",
+        "abcdefghijklmnopqrstuvwxyz", "abcdefghijklmnopqrstuvwxyZ", "abcdefghijklmnopqrstuvwxy\\u00E4",
+        "\\u03B1\\u03B2", "\\u0430\\u0431", "\\u4E00\\u4E8C", "a\\u0308", "\\u00AD"
+    };
+    static const UColAttributeValue strengths[] = {
+        UCOL_PRIMARY, UCOL_SECONDARY, UCOL_TERTIARY, UCOL_QUATERNARY, UCOL_IDENTICAL, UCOL_DEFAULT
+    };
+    static const int32_t capacities[] = { 1, 4, 12, 200 };
+    UnicodeString strings[LENGTHOF(strs)];
+    char utf8[LENGTHOF(strs) * 100];
+    StringPiece strings8[LENGTHOF(strs)];
+    int32_t length8 = 0;
+    for(int32_t i = 0; i < LENGTHOF(strs); ++i) {
+        strings[i] = UnicodeString(strs[i], -1, US_INV).unescape();
+        int32_t sLength8;
+        u_strToUTF8(utf8 + length8, LENGTHOF(utf8) - length8, &sLength8,
+                    strings[i].getBuffer(), strings[i].length(), errorCode);
+        strings8[i].set(utf8 + length8, sLength8);
+        length8 += sLength8;
+    }
+    if(errorCode.logIfFailureAndReset("u_strToUTF8()")) {
+        return;
+    }
+
+    for(int32_t config = 0; config < 3; ++config) {
+        LocalPointer<Collator> coll(Collator::createInstance(Locale::getRoot(), errorCode));
+        if(errorCode.logDataIfFailureAndReset("Collator::createInstance(root)")) {
+            return;
+        }
+        if(config == 1) {
+            coll->setAttribute(UCOL_ALTERNATE_HANDLING, UCOL_SHIFTED, errorCode);
+            coll->setAttribute(UCOL_STRENGTH, UCOL_QUATERNARY, errorCode);
+        } else if(config == 2) {
+            coll->setAttribute(UCOL_STRENGTH, UCOL_IDENTICAL, errorCode);
+        }
+        RuleBasedCollator *rbc = dynamic_cast<RuleBasedCollator *>(coll.getAlias());
+        for(int32_t si = 0; si < LENGTHOF(strengths); ++si) {
+            UColAttributeValue strength = strengths[si];
+            // Compare with a collator whose strength is capped at the requested one.
+            LocalPointer<Collator> capped(coll->clone());
+            if(strength != UCOL_DEFAULT && strength < coll->getAttribute(UCOL_STRENGTH, errorCode)) {
+                capped->setAttribute(UCOL_STRENGTH, strength, errorCode);
+            }
+            for(int32_t ci = 0; ci < LENGTHOF(capacities); ++ci) {
+                int32_t capacity = capacities[ci];
+                UnicodeString name = UnicodeString("config ") + config + " strength " + strength +
+                    " capacity " + capacity + ": ";
+                uint8_t prefixes[LENGTHOF(strs)][200];
+                UBool truncated[LENGTHOF(strs)];
+                for(int32_t i = 0; i < LENGTHOF(strs); ++i) {
+                    uprv_memset(prefixes[i], 0xff, 200);
+                    int32_t length = rbc->getSortKeyPrefix(strings[i], strength,
+                                                           prefixes[i], capacity,
+                                                           truncated[i], errorCode);
+                    if(errorCode.logIfFailureAndReset("getSortKeyPrefix()")) { return; }
+                    if(length > capacity || (truncated[i] && length != capacity)) {
+                        errln(name + "unexpected prefix length for [" + i + "]");
+                    }
+                    for(int32_t j = length; j < capacity; ++j) {
+                        if(prefixes[i][j] != 0) {
+                            errln(name + "prefix for [" + i + "] not padded with 00");
+                            break;
+                        }
+                    }
+                    if(capacity < 200 && prefixes[i][capacity] != 0xff) {
+                        errln(name + "prefix for [" + i + "] written beyond capacity");
+                    }
+                    // A complete prefix is the capped collator's sort key without its terminator.
+                    uint8_t key[200];
+                    int32_t keyLength = capped->getSortKey(strings[i], key, 200);
+                    if(!truncated[i] &&
+                            (keyLength != length + 1 || uprv_memcmp(key, prefixes[i], length) != 0)) {
+                        errln(name + "complete prefix differs from the sort key for [" + i + "]");
+                    }
+                    if(truncated[i] && (keyLength <= capacity ||
+                            uprv_memcmp(key, prefixes[i], capacity) != 0)) {
+                        errln(name + "truncated prefix differs from the sort key for [" + i + "]");
+                    }
+                    uint8_t prefix8[200];
+                    UBool truncated8;
+                    int32_t length8 = rbc->getSortKeyPrefixUTF8(strings8[i], strength,
+                                                                prefix8, capacity,
+                                                                truncated8, errorCode);
+                    if(errorCode.logIfFailureAndReset("getSortKeyPrefixUTF8()")) { return; }
+                    if(length8 != length || truncated8 != truncated[i] ||
+                            uprv_memcmp(prefix8, prefixes[i], capacity) != 0) {
+                        errln(name + "getSortKeyPrefixUTF8() differs from getSortKeyPrefix() for [" + i + "]");
+                    }
+                }
+                for(int32_t i = 0; i < LENGTHOF(strs); ++i) {
+                    for(int32_t j = 0; j < LENGTHOF(strs); ++j) {
+                        int32_t cmp = uprv_memcmp(prefixes[i], prefixes[j], capacity);
+                        UCollationResult order = capped->compare(strings[i], strings[j], errorCode);
+                        if((cmp < 0 && order >= 0) || (cmp > 0 && order <= 0) ||
+                                (cmp == 0 && !truncated[i] && !truncated[j] && order != 0)) {
+                            errln(name + "prefix order differs from compare() for [" +
+                                  i + "] vs. [" + j + "]");
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Argument checking.
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getRoot(), errorCode));
+    if(errorCode.logDataIfFailureAndReset("Collator::createInstance(root)")) {
+        return;
+    }
+    RuleBasedCollator *rbc = dynamic_cast<RuleBasedCollator *>(coll.getAlias());
+    UBool truncated;
+    assertEquals("getSortKeyPrefix(capacity 0)", 0,
+                 rbc->getSortKeyPrefix(strings[1], UCOL_DEFAULT, NULL, 0, truncated, errorCode));
+    assertTrue("getSortKeyPrefix(capacity 0) is truncated", truncated);
+    errorCode.logIfFailureAndReset("getSortKeyPrefix(capacity 0)");
+    uint8_t prefix[8];
+    rbc->getSortKeyPrefix(strings[1], UCOL_STRENGTH_LIMIT, prefix, 8, truncated, errorCode);
+    assertEquals("getSortKeyPrefix(bad strength)", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+}
+
  void CollationAPITest::dump(UnicodeString msg, RuleBasedCollator* c, UErrorCode& status) {
     const char* bigone = "One";
     const char* littleone = "one";
@@ -2442,6 +2782,9 @@ void CollationAPITest::runIndexedTest( int32_t index, UBool exec, const char* &n
     TESTCASE_AUTO(TestClone);
     TESTCASE_AUTO(TestCloneBinary);
     TESTCASE_AUTO(TestIterNumeric);
+    TESTCASE_AUTO(TestTailoringCache);
+    TESTCASE_AUTO(TestBatchSort);
+    TESTCASE_AUTO(TestSortKeyPrefix);
     TESTCASE_AUTO_END;
 }
 
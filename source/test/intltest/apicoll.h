@@ -170,6 +170,21 @@ public:
     void TestCloneBinary();
     void TestIterNumeric();
 
+    /**
+    * Tests that collators for the same locale share cached tailorings
+    */
+    void TestTailoringCache();
+
+    /**
+    * Tests that the batch sort functions order strings like compare()
+    */
+    void TestBatchSort();
+
+    /**
+    * Tests that fixed-length sort key prefixes are order-preserving
+    */
+    void TestSortKeyPrefix();
+
 private:
     // If this is too small for the test data, just increase it.
     // Just don't make it too large, otherwise the executable will get too big
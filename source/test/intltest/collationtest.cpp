@@ -74,6 +74,7 @@ public:
     void TestImplicits();
     void TestNulTerminated();
     void TestIllegalUTF8();
+    void TestLongEqualPrefix();
     void TestShortFCDData();
     void TestFCD();
     void TestCollationWeights();
@@ -142,6 +143,7 @@ void CollationTest::runIndexedTest(int32_t index, UBool exec, const char *&name,
     TESTCASE_AUTO(TestImplicits);
     TESTCASE_AUTO(TestNulTerminated);
     TESTCASE_AUTO(TestIllegalUTF8);
+    TESTCASE_AUTO(TestLongEqualPrefix);
     TESTCASE_AUTO(TestShortFCDData);
     TESTCASE_AUTO(TestFCD);
     TESTCASE_AUTO(TestCollationWeights);
@@ -308,6 +310,56 @@ void CollationTest::TestIllegalUTF8() {
     }
 }
 
+void CollationTest::TestLongEqualPrefix() {
+    IcuTestErrorCode errorCode(*this, "TestLongEqualPrefix");
+
+    // Czech "ch" is a contraction that sorts between h and i.
+    // The comparison must back up from the first difference (h vs. i)
+    // to the contraction starter c even after a long identical prefix.
+    LocalPointer<Collator> cs(Collator::createInstance(Locale("cs"), errorCode));
+    if(errorCode.logDataIfFailureAndReset("Collator::createInstance(cs)")) {
+        return;
+    }
+    // Path-like prefix characters, without c and h.
+    static const char alphabet[] = "abdefgklmnoprstuvwxyz/._-0123456789";
+    for(int32_t prefixLength = 0; prefixLength <= 70; ++prefixLength) {
+        UnicodeString prefix;
+        for(int32_t i = 0; i < prefixLength; ++i) {
+            prefix.append((UChar)alphabet[i % (LENGTHOF(alphabet) - 1)]);
+        }
+        static const char *const suffixes[][2] = {
+            // suffix pairs with expected order "<"
+            { "a", "b" }, { "", "a" }, { "ci", "ch" }, { "cz", "ch" }, { "ch", "i" },
+            { "h", "ch" }, { "a\\u00E9", "a\\u00E9b" }, { "e\\u0301", "f" }
+        };
+        for(int32_t j = 0; j < LENGTHOF(suffixes); ++j) {
+            UnicodeString left = prefix + UnicodeString(suffixes[j][0], -1, US_INV).unescape();
+            UnicodeString right = prefix + UnicodeString(suffixes[j][1], -1, US_INV).unescape();
+            char left8[200], right8[200];
+            int32_t left8Length, right8Length;
+            u_strToUTF8(left8, LENGTHOF(left8), &left8Length,
+                        left.getBuffer(), left.length(), errorCode);
+            u_strToUTF8(right8, LENGTHOF(right8), &right8Length,
+                        right.getBuffer(), right.length(), errorCode);
+            if(errorCode.logIfFailureAndReset("u_strToUTF8()")) { return; }
+            if(cs->compare(left, right, errorCode) != UCOL_LESS ||
+                    cs->compare(right, left, errorCode) != UCOL_GREATER ||
+                    cs->compare(left, left, errorCode) != UCOL_EQUAL) {
+                errln("compare(prefix length %d + %s, prefix + %s) wrong",
+                      (int)prefixLength, suffixes[j][0], suffixes[j][1]);
+            }
+            StringPiece leftPiece(left8, left8Length), rightPiece(right8, right8Length);
+            if(cs->compareUTF8(leftPiece, rightPiece, errorCode) != UCOL_LESS ||
+                    cs->compareUTF8(rightPiece, leftPiece, errorCode) != UCOL_GREATER ||
+                    cs->compareUTF8(leftPiece, leftPiece, errorCode) != UCOL_EQUAL) {
+                errln("compareUTF8(prefix length %d + %s, prefix + %s) wrong",
+                      (int)prefixLength, suffixes[j][0], suffixes[j][1]);
+            }
+            errorCode.logIfFailureAndReset("compare()");
+        }
+    }
+}
+
 namespace {
 
 void addLeadSurrogatesForSupplementary(const UnicodeSet &src, UnicodeSet &dest) {
@@ -0,0 +1,156 @@
+/*
+*******************************************************************************
+* Copyright (C) 2014, International Business Machines Corporation and         *
+* others. All Rights Reserved.                                                *
+*******************************************************************************
+*
+* File HASHMAPTEST.CPP
+*
+********************************************************************************
+*/
+#include "cstring.h"
+#include "intltest.h"
+#include "hash.h"
+
+class HashMapTest : public IntlTest {
+public:
+    HashMapTest() {
+    }
+    void runIndexedTest(int32_t index, UBool exec, const char *&name, char *par=0);
+private:
+    void TestIntKeys();
+    void TestCharsKeys();
+    void TestUCharsKeys();
+    void TestAdoptValues();
+    void TestGrowAndRemove();
+};
+
+void HashMapTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
+  TESTCASE_AUTO_BEGIN;
+  TESTCASE_AUTO(TestIntKeys);
+  TESTCASE_AUTO(TestCharsKeys);
+  TESTCASE_AUTO(TestUCharsKeys);
+  TESTCASE_AUTO(TestAdoptValues);
+  TESTCASE_AUTO(TestGrowAndRemove);
+  TESTCASE_AUTO_END;
+}
+
+void HashMapTest::TestIntKeys() {
+    UErrorCode status = U_ZERO_ERROR;
+    HashMap<int32_t, UnicodeString> map(FALSE, status);
+    if (U_FAILURE(status)) {
+        errln("HashMap() failed - %s", u_errorName(status));
+        return;
+    }
+    UnicodeString zero("zero"), minus("minus"), big("big"), other("other");
+    map.put(0, &zero, status);
+    map.put(-1, &minus, status);
+    map.put(0x7fffffff, &big, status);
+    assertSuccess("put", status);
+    assertEquals("count", 3, map.count());
+    assertTrue("get(0)", map.get(0) == &zero);
+    assertTrue("get(-1)", map.get(-1) == &minus);
+    assertTrue("get(max)", map.get(0x7fffffff) == &big);
+    assertTrue("get(1)", map.get(1) == NULL);
+    assertTrue("put(0) returns the old value", map.put(0, &other, status) == &zero);
+    assertTrue("get(0) after replacing", map.get(0) == &other);
+    assertTrue("remove(-1)", map.remove(-1) == &minus);
+    assertTrue("get(-1) after removing", map.get(-1) == NULL);
+    assertEquals("count after removing", 2, map.count());
+}
+
+void HashMapTest::TestCharsKeys() {
+    UErrorCode status = U_ZERO_ERROR;
+    HashMap<const char *, UnicodeString> map(FALSE, status);
+    UnicodeString de("German"), fr("French");
+    map.put("de", &de, status);
+    map.put("fr", &fr, status);
+    assertSuccess("put", status);
+    // Keys are compared by contents, not by address.
+    char key[3];
+    uprv_strcpy(key, "de");
+    assertTrue("get(de)", map.get(key) == &de);
+    assertTrue("get(it)", map.get("it") == NULL);
+    int32_t pos = -1;
+    int32_t count = 0;
+    const UHashElement *e;
+    while ((e = map.nextElement(pos)) != NULL) {
+        const char *k = HashMap<const char *, UnicodeString>::keyOf(e);
+        UnicodeString *v = HashMap<const char *, UnicodeString>::valueOf(e);
+        if (!((uprv_strcmp(k, "de") == 0 && v == &de) ||
+                (uprv_strcmp(k, "fr") == 0 && v == &fr))) {
+            errln("unexpected entry for key %s", k);
+        }
+        ++count;
+    }
+    assertEquals("number of entries iterated", 2, count);
+}
+
+void HashMapTest::TestUCharsKeys() {
+    UErrorCode status = U_ZERO_ERROR;
+    HashMap<const UChar *, UnicodeString> map(FALSE, status);
+    static const UChar abc[] = { 0x61, 0x62, 0x63, 0 };
+    static const UChar abd[] = { 0x61, 0x62, 0x64, 0 };
+    UnicodeString v1("1"), v2("2");
+    map.put(abc, &v1, status);
+    map.put(abd, &v2, status);
+    assertSuccess("put", status);
+    UnicodeString key("abc");
+    assertTrue("get(abc)", map.get(key.getTerminatedBuffer()) == &v1);
+    assertTrue("get(abd)", map.get(abd) == &v2);
+    map.removeAll();
+    assertEquals("count after removeAll", 0, map.count());
+    assertTrue("get(abc) after removeAll", map.get(abc) == NULL);
+}
+
+void HashMapTest::TestAdoptValues() {
+    UErrorCode status = U_ZERO_ERROR;
+    HashMap<int32_t, UnicodeString> map(TRUE, status);
+    map.put(1, new UnicodeString("one"), status);
+    map.put(2, new UnicodeString("two"), status);
+    // The map deletes the values it replaces and removes,
+    // and returns NULL instead of them.
+    assertTrue("put(1) replacing", map.put(1, new UnicodeString("uno"), status) == NULL);
+    assertTrue("remove(2)", map.remove(2) == NULL);
+    assertSuccess("put", status);
+    assertEquals("get(1)", UnicodeString("uno"), *map.get(1));
+    // Storing NULL removes the key.
+    map.put(1, NULL, status);
+    assertEquals("count", 0, map.count());
+    // The destructor deletes the remaining values.
+    map.put(3, new UnicodeString("three"), status);
+}
+
+void HashMapTest::TestGrowAndRemove() {
+    UErrorCode status = U_ZERO_ERROR;
+    HashMap<int32_t, HashMapTest> map(4, FALSE, status);
+    const int32_t kCount = 5000;
+    int32_t i;
+    // Keys that differ only in their high bits must not collide.
+    for (i = 0; i < kCount; ++i) {
+        map.put(i << 16, this, status);
+    }
+    assertSuccess("put", status);
+    assertEquals("count", kCount, map.count());
+    for (i = 0; i < kCount; i += 2) {
+        map.remove(i << 16);
+    }
+    // Reinsert into the slots of removed keys.
+    for (i = 0; i < kCount; i += 4) {
+        map.put(i << 16, this, status);
+    }
+    assertSuccess("put again", status);
+    int32_t errors = 0;
+    for (i = 0; i < kCount; ++i) {
+        UBool expected = (i & 1) != 0 || (i & 3) == 0;
+        if ((map.get(i << 16) != NULL) != expected) {
+            ++errors;
+        }
+    }
+    assertEquals("wrong lookups", 0, errors);
+    assertEquals("count after removing", kCount / 2 + kCount / 4, map.count());
+}
+
+extern IntlTest *createHashMapTest() {
+    return new HashMapTest();
+}
@@ -34,6 +34,8 @@ static IntlTest *createLocalPointerTest();
 extern IntlTest *createUCharsTrieTest();
 static IntlTest *createEnumSetTest();
 extern IntlTest *createLRUCacheTest();
+extern IntlTest *createUnifiedCacheTest();
+extern IntlTest *createHashMapTest();
 extern IntlTest *createSimplePatternFormatterTest();
 
 #define CASE(id, test) case id:                               \
@@ -113,6 +115,22 @@ void IntlTestUtilities::runIndexedTest( int32_t index, UBool exec, const char* &
                 callTest(*test, par);
             }
             break;
+        case 22:
+            name = "UnifiedCacheTest";
+            if (exec) {
+                logln("TestSuite UnifiedCacheTest---"); logln();
+                LocalPointer<IntlTest> test(createUnifiedCacheTest());
+                callTest(*test, par);
+            }
+            break;
+        case 23:
+            name = "HashMapTest";
+            if (exec) {
+                logln("TestSuite HashMapTest---"); logln();
+                LocalPointer<IntlTest> test(createHashMapTest());
+                callTest(*test, par);
+            }
+            break;
         default: name = ""; break; //needed to end loop
     }
 }
@@ -80,6 +80,7 @@ private:
     void TestErrorCallingConstructor();
     void TestLRUCache();
     void TestLRUCacheError();
+    void TestLRUCachePut();
     void verifySharedPointer(
             const CopyOnWriteForTesting* ptr,
             const UnicodeString& name,
@@ -97,6 +98,7 @@ void LRUCacheTest::runIndexedTest(int32_t index, UBool exec, const char* &name,
   TESTCASE_AUTO(TestErrorCallingConstructor);
   TESTCASE_AUTO(TestLRUCache);
   TESTCASE_AUTO(TestLRUCacheError);
+  TESTCASE_AUTO(TestLRUCachePut);
   TESTCASE_AUTO_END;
 }
 
@@ -240,6 +242,45 @@ void LRUCacheTest::TestLRUCacheError() {
     }
 }
 
+void LRUCacheTest::TestLRUCachePut() {
+    UErrorCode status = U_ZERO_ERROR;
+    LRUCacheForTesting cache(2, "little", status);
+    CopyOnWriteForTesting *data = new CopyOnWriteForTesting;
+    data->localeNamePtr.reset(new UnicodeString("put"));
+    data->formatStrPtr.reset(new UnicodeString("big"));
+    data->addRef();
+    cache.put("foo", data, status);
+    // The cache holds its own reference.
+    verifyReferences(data, 2, 1, 1);
+    const CopyOnWriteForTesting* ptr1 = NULL;
+    cache.get("foo", ptr1, status);
+    if (ptr1 != data) {
+        errln("Expected get() to return the data added with put().");
+    }
+    verifySharedPointer(ptr1, "put", "big");
+
+    // put() does not replace an existing entry.
+    CopyOnWriteForTesting *other = new CopyOnWriteForTesting;
+    other->addRef();
+    cache.put("foo", other, status);
+    if (other->getRefCount() != 1) {
+        errln("Expected put() to keep the existing entry.");
+    }
+    other->removeRef();
+
+    // put() evicts the least recently used entry when the cache is full.
+    const CopyOnWriteForTesting* ptr2 = NULL;
+    cache.get("bar", ptr2, status);
+    cache.put("baz", data, status);
+    if (U_FAILURE(status) || !cache.contains("baz") || !cache.contains("bar") || cache.contains("foo")) {
+        errln("Unexpected keys in cache after put().");
+    }
+    verifyReferences(data, 3, 1, 1);
+    data->removeRef();
+    SharedObject::clearPtr(ptr1);
+    SharedObject::clearPtr(ptr2);
+}
+
 void LRUCacheTest::verifySharedPointer(
         const CopyOnWriteForTesting* ptr,
         const UnicodeString& name,
@@ -28,6 +28,8 @@
 #include "tsmthred.h"
 #include "unicode/ushape.h"
 #include "unicode/translit.h"
+#include "unicode/ucnv.h"
+#include "unicode/ures.h"
 
 #if U_PLATFORM_USES_ONLY_WIN32_API
     /* Prefer native Windows APIs even if POSIX is implemented (i.e., on Cygwin). */
@@ -128,6 +130,7 @@ void MultithreadTest::runIndexedTest( int32_t index, UBool exec,
 #else
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>    // tolower, toupper
 
@@ -201,6 +204,38 @@ void MultithreadTest::runIndexedTest( int32_t index, UBool exec,
             TestAnyTranslit();
         }
         break;
+
+    case 7:
+        name = "TestConverterCache";
+#if !UCONFIG_NO_CONVERSION
+        if (exec) {
+            TestConverterCache();
+        }
+#endif
+        break;
+
+    case 8:
+        name = "TestResourceBundleCache";
+        if (exec) {
+            TestResourceBundleCache();
+        }
+        break;
+
+    case 9:
+        name = "TestRWLock";
+        if (exec) {
+            TestRWLock();
+        }
+        break;
+
+    case 10:
+        name = "TestConverterPool";
+#if !UCONFIG_NO_CONVERSION
+        if (exec) {
+            TestConverterPool();
+        }
+#endif
+        break;
      
     default:
         name = "";
@@ -1601,4 +1636,499 @@ void MultithreadTest::TestAnyTranslit() {
 #endif  // !UCONFIG_NO_TRANSLITERATION
 }
 
+
+//-------------------------------------------------------------------------------------------
+//
+//   TestConverterCache.  Open and close converters from several threads,
+//                        while one of them also flushes the converter cache.
+//
+//-------------------------------------------------------------------------------------------
+
+#if !UCONFIG_NO_CONVERSION
+
+const int kConverterThreadIterations = 500;  // # of iterations per thread
+const int kConverterThreadThreads    = 8;    // # of threads to spawn
+
+static const char *const gCacheTestConverterNames[] = {
+    "ibm-1047", "Shift_JIS", "windows-1252", "GB18030", "ISO-2022-JP", "UTF-8"
+};
+
+class ConverterThreadTest : public ThreadWithStatus
+{
+public:
+    int fNum;
+
+    ConverterThreadTest(int num) // constructor is NOT multithread safe.
+        : ThreadWithStatus(),
+        fNum(num)
+    {
+    };
+
+    virtual void run()
+    {
+        static const UChar text[] = {
+            0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x20, 0x31, 0x32, 0x33
+        };
+        const int32_t textLength = LENGTHOF(text);
+        const int32_t namesLength = LENGTHOF(gCacheTestConverterNames);
+        char bytes[100];
+        UChar result[50];
+
+        for (int loopCount = 0; loopCount < kConverterThreadIterations; loopCount++) {
+            const char *name = gCacheTestConverterNames[(fNum + loopCount) % namesLength];
+            UErrorCode status = U_ZERO_ERROR;
+            UConverter *cnv = ucnv_open(name, &status);
+            if (U_FAILURE(status)) {
+                error(UnicodeString("ucnv_open(") + name + ") failed: " + u_errorName(status));
+                break;
+            }
+            int32_t length = ucnv_fromUChars(cnv, bytes, (int32_t)sizeof(bytes), text, textLength, &status);
+            length = ucnv_toUChars(cnv, result, LENGTHOF(result), bytes, length, &status);
+            ucnv_close(cnv);
+            if (U_FAILURE(status) || length != textLength ||
+                    u_memcmp(text, result, textLength) != 0) {
+                error(UnicodeString("round trip through ") + name + " failed: " + u_errorName(status));
+                break;
+            }
+            if (fNum == 0 && (loopCount % 50) == 49) {
+                ucnv_flushCache();
+            }
+        }
+    }
+};
+
+void MultithreadTest::TestConverterCache()
+{
+    int32_t i;
+    UErrorCode status = U_ZERO_ERROR;
+    UConverter *cnv = ucnv_open(gCacheTestConverterNames[0], &status);
+    if (U_FAILURE(status)) {
+        dataerrln("File %s, Line %d: Error, ucnv_open() status = %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    ucnv_close(cnv);
+
+    ConverterThreadTest *threads[kConverterThreadThreads];
+    for (i = 0; i < kConverterThreadThreads; i++) {
+        threads[i] = new ConverterThreadTest(i);
+    }
+    for (i = 0; i < kConverterThreadThreads; i++) {
+        if (threads[i]->start() != 0) {
+            errln("File %s, Line %d: Error starting thread %d", __FILE__, __LINE__, (int)i);
+            return;
+        }
+    }
+
+    int32_t patience = 1000;
+    UBool someThreadRunning;
+    do {
+        someThreadRunning = FALSE;
+        for (i = 0; i < kConverterThreadThreads; i++) {
+            if (threads[i]->isRunning()) {
+                someThreadRunning = TRUE;
+                SimpleThread::sleep(100);
+                break;
+            }
+        }
+    } while (someThreadRunning && --patience > 0);
+
+    if (patience <= 0) {
+        // Leak the threads rather than crash if they are still running.
+        errln("File %s, Line %d: Error, one or more threads did not complete.", __FILE__, __LINE__);
+        return;
+    }
+
+    for (i = 0; i < kConverterThreadThreads; i++) {
+        UnicodeString theErr;
+        if (threads[i]->getError(theErr)) {
+            errln(UnicodeString("#") + i + ": " + theErr);
+        }
+        delete threads[i];
+    }
+    ucnv_flushCache();
+}
+
+//-------------------------------------------------------------------------------------------
+//
+//   TestConverterPool.  Acquire and release pooled converters from several threads,
+//                       and check that this does not allocate memory once the pool is warm.
+//
+//-------------------------------------------------------------------------------------------
+
+static u_atomic_int32_t gPoolTestAllocations = ATOMIC_INT32_T_INITIALIZER(0);
+
+static void * U_CALLCONV poolTestAlloc(const void * /*context*/, size_t size) {
+    umtx_atomic_inc(&gPoolTestAllocations);
+    return malloc(size);
+}
+
+static void * U_CALLCONV poolTestRealloc(const void * /*context*/, void *mem, size_t size) {
+    umtx_atomic_inc(&gPoolTestAllocations);
+    return realloc(mem, size);
+}
+
+static void U_CALLCONV poolTestFree(const void * /*context*/, void *mem) {
+    free(mem);
+}
+
+class ConverterPoolThreadTest : public ThreadWithStatus
+{
+public:
+    int fNum;
+
+    ConverterPoolThreadTest(int num) // constructor is NOT multithread safe.
+        : ThreadWithStatus(),
+        fNum(num)
+    {
+    };
+
+    virtual void run()
+    {
+        static const UChar text[] = {
+            0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x20, 0x31, 0x32, 0x33
+        };
+        const int32_t textLength = LENGTHOF(text);
+        const int32_t namesLength = LENGTHOF(gCacheTestConverterNames);
+        char bytes[100];
+        UChar result[50];
+
+        for (int loopCount = 0; loopCount < kConverterThreadIterations; loopCount++) {
+            const char *name = gCacheTestConverterNames[(fNum + loopCount) % namesLength];
+            UErrorCode status = U_ZERO_ERROR;
+            UConverter *cnv = ucnv_acquire(name, &status);
+            if (U_FAILURE(status)) {
+                error(UnicodeString("ucnv_acquire(") + name + ") failed: " + u_errorName(status));
+                break;
+            }
+            int32_t length = ucnv_fromUChars(cnv, bytes, (int32_t)sizeof(bytes), text, textLength, &status);
+            length = ucnv_toUChars(cnv, result, LENGTHOF(result), bytes, length, &status);
+            ucnv_release(cnv);
+            if (U_FAILURE(status) || length != textLength ||
+                    u_memcmp(text, result, textLength) != 0) {
+                error(UnicodeString("round trip through ") + name + " failed: " + u_errorName(status));
+                break;
+            }
+        }
+    }
+};
+
+void MultithreadTest::TestConverterPool()
+{
+    int32_t i, j;
+    UErrorCode status = U_ZERO_ERROR;
+    UConverter *cnv = ucnv_open(gCacheTestConverterNames[0], &status);
+    if (U_FAILURE(status)) {
+        dataerrln("File %s, Line %d: Error, ucnv_open() status = %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    ucnv_close(cnv);
+
+    // Heap functions can only be set while ICU is not initialized.
+    // u_cleanup() forgets the data directory.
+    const char *dataDir = u_getDataDirectory();
+    char *savedDataDir = (char *)malloc(uprv_strlen(dataDir) + 1);
+    uprv_strcpy(savedDataDir, dataDir);
+    u_cleanup();
+    u_setMemoryFunctions(NULL, poolTestAlloc, poolTestRealloc, poolTestFree, &status);
+    u_setDataDirectory(savedDataDir);
+    u_init(&status);
+    if (U_FAILURE(status)) {
+        errln("File %s, Line %d: Error, u_setMemoryFunctions() or u_init() status = %s",
+              __FILE__, __LINE__, u_errorName(status));
+    }
+
+    // Warm up the pool with as many converters per name as the threads may use at the same time.
+    // The second pass must be served from the pool.
+    const int32_t namesLength = LENGTHOF(gCacheTestConverterNames);
+    ConverterPoolThreadTest *threads[kConverterThreadThreads];
+    int32_t hits = 0, misses = 0, hits2, misses2;
+    for (int32_t pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            for (i = 0; i < kConverterThreadThreads; i++) {
+                threads[i] = new ConverterPoolThreadTest(i);
+            }
+            ucnv_getPoolCounts(&hits, &misses);
+            umtx_storeRelease(gPoolTestAllocations, 0);
+        }
+        UConverter *converters[LENGTHOF(gCacheTestConverterNames)][kConverterThreadThreads];
+        for (i = 0; i < namesLength; i++) {
+            for (j = 0; j < kConverterThreadThreads; j++) {
+                converters[i][j] = ucnv_acquire(gCacheTestConverterNames[i], &status);
+            }
+        }
+        for (i = 0; i < namesLength; i++) {
+            for (j = 0; j < kConverterThreadThreads; j++) {
+                ucnv_release(converters[i][j]);
+            }
+        }
+    }
+    if (U_FAILURE(status)) {
+        errln("File %s, Line %d: Error, ucnv_acquire() status = %s", __FILE__, __LINE__, u_errorName(status));
+    }
+    hits += namesLength * kConverterThreadThreads;  // the second pass hits
+
+    for (i = 0; i < kConverterThreadThreads; i++) {
+        if (threads[i]->start() != 0) {
+            errln("File %s, Line %d: Error starting thread %d", __FILE__, __LINE__, (int)i);
+            return;
+        }
+    }
+
+    int32_t patience = 1000;
+    UBool someThreadRunning;
+    do {
+        someThreadRunning = FALSE;
+        for (i = 0; i < kConverterThreadThreads; i++) {
+            if (threads[i]->isRunning()) {
+                someThreadRunning = TRUE;
+                SimpleThread::sleep(100);
+                break;
+            }
+        }
+    } while (someThreadRunning && --patience > 0);
+
+    if (patience <= 0) {
+        // Leak the threads rather than crash if they are still running.
+        errln("File %s, Line %d: Error, one or more threads did not complete.", __FILE__, __LINE__);
+        return;
+    }
+
+    int32_t allocations = umtx_loadAcquire(gPoolTestAllocations);
+    ucnv_getPoolCounts(&hits2, &misses2);
+    for (i = 0; i < kConverterThreadThreads; i++) {
+        UnicodeString theErr;
+        if (threads[i]->getError(theErr)) {
+            errln(UnicodeString("#") + i + ": " + theErr);
+        }
+        delete threads[i];
+    }
+    if (allocations != 0) {
+        errln("File %s, Line %d: Error, %d heap allocations while using the warm converter pool",
+              __FILE__, __LINE__, (int)allocations);
+    }
+    if (hits2 - hits != kConverterThreadThreads * kConverterThreadIterations || misses2 != misses) {
+        errln("File %s, Line %d: Error, %d pool hits and %d misses, expected %d and 0",
+              __FILE__, __LINE__, (int)(hits2 - hits), (int)(misses2 - misses),
+              (int)(kConverterThreadThreads * kConverterThreadIterations));
+    }
+
+    // Restore the default heap functions.
+    u_cleanup();
+    u_setDataDirectory(savedDataDir);
+    free(savedDataDir);
+    status = U_ZERO_ERROR;
+    u_init(&status);
+}
+
+#endif  // !UCONFIG_NO_CONVERSION
+
+
+//-------------------------------------------------------------------------------------------
+//
+//   TestResourceBundleCache.  Open and close resource bundles from several threads,
+//                             and check that they all see the same fallback results.
+//
+//-------------------------------------------------------------------------------------------
+
+const int kBundleThreadIterations = 2000;  // # of iterations per thread
+const int kBundleThreadThreads    = 8;     // # of threads to spawn
+
+static const char *const gCacheTestBundleLocales[] = {
+    "en_US", "de_AT", "de_AT_XY", "fr_CA", "zh_Hant_TW", "sr_Latn_BA", "pt_PT", "es_419", "root"
+};
+
+static UErrorCode gCacheTestBundleStatus[LENGTHOF(gCacheTestBundleLocales)];
+static char gCacheTestBundleActual[LENGTHOF(gCacheTestBundleLocales)][ULOC_FULLNAME_CAPACITY];
+
+class BundleThreadTest : public ThreadWithStatus
+{
+public:
+    int fNum;
+
+    BundleThreadTest(int num) // constructor is NOT multithread safe.
+        : ThreadWithStatus(),
+        fNum(num)
+    {
+    };
+
+    virtual void run()
+    {
+        const int32_t localesLength = LENGTHOF(gCacheTestBundleLocales);
+
+        for (int loopCount = 0; loopCount < kBundleThreadIterations; loopCount++) {
+            int32_t i = (fNum + loopCount) % localesLength;
+            const char *localeID = gCacheTestBundleLocales[i];
+            UErrorCode status = U_ZERO_ERROR;
+            UResourceBundle *rb = ures_open(NULL, localeID, &status);
+            if (U_FAILURE(status)) {
+                error(UnicodeString("ures_open(") + localeID + ") failed: " + u_errorName(status));
+                break;
+            }
+            UErrorCode openStatus = status;
+            const char *actual = ures_getLocaleByType(rb, ULOC_ACTUAL_LOCALE, &status);
+            UResourceBundle *item = ures_getByKey(rb, "Version", NULL, &status);
+            ures_close(item);
+            ures_close(rb);
+            if (U_FAILURE(status) || openStatus != gCacheTestBundleStatus[i] ||
+                    uprv_strcmp(actual, gCacheTestBundleActual[i]) != 0) {
+                error(UnicodeString("ures_open(") + localeID + ") gave " + actual + "/" +
+                      u_errorName(openStatus) + ", expected " + gCacheTestBundleActual[i] + "/" +
+                      u_errorName(gCacheTestBundleStatus[i]));
+                break;
+            }
+        }
+    }
+};
+
+void MultithreadTest::TestResourceBundleCache()
+{
+    int32_t i;
+    for (i = 0; i < LENGTHOF(gCacheTestBundleLocales); i++) {
+        UErrorCode status = U_ZERO_ERROR;
+        UResourceBundle *rb = ures_open(NULL, gCacheTestBundleLocales[i], &status);
+        if (U_FAILURE(status)) {
+            dataerrln("File %s, Line %d: Error, ures_open(%s) status = %s", __FILE__, __LINE__,
+                      gCacheTestBundleLocales[i], u_errorName(status));
+            return;
+        }
+        gCacheTestBundleStatus[i] = status;
+        uprv_strcpy(gCacheTestBundleActual[i], ures_getLocaleByType(rb, ULOC_ACTUAL_LOCALE, &status));
+        ures_close(rb);
+    }
+
+    BundleThreadTest *threads[kBundleThreadThreads];
+    for (i = 0; i < kBundleThreadThreads; i++) {
+        threads[i] = new BundleThreadTest(i);
+    }
+    for (i = 0; i < kBundleThreadThreads; i++) {
+        if (threads[i]->start() != 0) {
+            errln("File %s, Line %d: Error starting thread %d", __FILE__, __LINE__, (int)i);
+            return;
+        }
+    }
+
+    int32_t patience = 1000;
+    UBool someThreadRunning;
+    do {
+        someThreadRunning = FALSE;
+        for (i = 0; i < kBundleThreadThreads; i++) {
+            if (threads[i]->isRunning()) {
+                someThreadRunning = TRUE;
+                SimpleThread::sleep(100);
+                break;
+            }
+        }
+    } while (someThreadRunning && --patience > 0);
+
+    if (patience <= 0) {
+        // Leak the threads rather than crash if they are still running.
+        errln("File %s, Line %d: Error, one or more threads did not complete.", __FILE__, __LINE__);
+        return;
+    }
+
+    for (i = 0; i < kBundleThreadThreads; i++) {
+        UnicodeString theErr;
+        if (threads[i]->getError(theErr)) {
+            errln(UnicodeString("#") + i + ": " + theErr);
+        }
+        delete threads[i];
+    }
+}
+
+//-----------------------------------------------------------------------
+//
+//  TestRWLock  - Writers update two counters one after the other, and
+//                readers check that they never see them differ.
+//                Also checks that no reader is inside while a writer is.
+//
+//----------------------------------------------------------------------
+static URWLock gTestRWLock = U_RWLOCK_INITIALIZER;
+static int32_t gRWCountA = 0;
+static int32_t gRWCountB = 0;
+static u_atomic_int32_t gRWReadersInside = ATOMIC_INT32_T_INITIALIZER(0);
+static u_atomic_int32_t gRWErrors = ATOMIC_INT32_T_INITIALIZER(0);
+
+static const int32_t kRWLockThreads = 8;
+static const int32_t kRWLockIterations = 20000;
+
+class RWLockThread : public SimpleThread
+{
+public:
+    RWLockThread(UBool isWriter) : fIsWriter(isWriter) {}
+    virtual void run()
+    {
+        for (int32_t i = 0; i < kRWLockIterations; ++i) {
+            if (fIsWriter && (i % 16) == 0) {
+                WriteLock lock(&gTestRWLock);
+                if (umtx_loadAcquire(gRWReadersInside) != 0) {
+                    umtx_atomic_inc(&gRWErrors);
+                }
+                ++gRWCountA;
+                ++gRWCountB;
+            } else {
+                ReadLock lock(&gTestRWLock);
+                umtx_atomic_inc(&gRWReadersInside);
+                if (gRWCountA != gRWCountB) {
+                    umtx_atomic_inc(&gRWErrors);
+                }
+                umtx_atomic_dec(&gRWReadersInside);
+            }
+        }
+    }
+private:
+    UBool fIsWriter;
+};
+
+void MultithreadTest::TestRWLock()
+{
+    gRWCountA = 0;
+    gRWCountB = 0;
+    umtx_storeRelease(gRWErrors, 0);
+
+    RWLockThread *threads[kRWLockThreads];
+    int32_t i;
+    for (i = 0; i < kRWLockThreads; i++) {
+        // Every other thread also writes.
+        threads[i] = new RWLockThread((i & 1) == 0);
+    }
+    for (i = 0; i < kRWLockThreads; i++) {
+        if (threads[i]->start() != 0) {
+            errln("File %s, Line %d: Error starting thread %d", __FILE__, __LINE__, (int)i);
+            return;
+        }
+    }
+
+    int32_t patience = 1000;
+    UBool someThreadRunning;
+    do {
+        someThreadRunning = FALSE;
+        for (i = 0; i < kRWLockThreads; i++) {
+            if (threads[i]->isRunning()) {
+                someThreadRunning = TRUE;
+                SimpleThread::sleep(100);
+                break;
+            }
+        }
+    } while (someThreadRunning && --patience > 0);
+
+    if (patience <= 0) {
+        // Leak the threads rather than crash if they are still running.
+        errln("File %s, Line %d: Error, one or more threads did not complete.", __FILE__, __LINE__);
+        return;
+    }
+    for (i = 0; i < kRWLockThreads; i++) {
+        delete threads[i];
+    }
+
+    int32_t expected = (kRWLockThreads / 2) * ((kRWLockIterations + 15) / 16);
+    if (gRWCountA != expected || gRWCountB != expected) {
+        errln("File %s, Line %d: Error, counters are %d, %d, expected %d",
+              __FILE__, __LINE__, (int)gRWCountA, (int)gRWCountB, (int)expected);
+    }
+    if (umtx_loadAcquire(gRWErrors) != 0) {
+        errln("File %s, Line %d: Error, %d reads overlapped a write",
+              __FILE__, __LINE__, (int)umtx_loadAcquire(gRWErrors));
+    }
+}
+
 #endif // ICU_USE_THREADS
@@ -47,6 +47,24 @@ public:
     void TestCollators(void);
     void TestString();
     void TestAnyTranslit();
+#if !UCONFIG_NO_CONVERSION
+    /**
+     * test that the converter cache works with concurrent open, close and flush
+     **/
+    void TestConverterCache();
+    /**
+     * test that the converter pool does not allocate memory with concurrent acquire and release
+     **/
+    void TestConverterPool();
+#endif
+    /**
+     * test that the resource bundle cache works with concurrent open and close
+     **/
+    void TestResourceBundleCache();
+    /**
+     * test that reader/writer locks exclude writers from each other and from readers
+     **/
+    void TestRWLock();
 
 };
 
@@ -8,6 +8,7 @@
 
 #if !UCONFIG_NO_NORMALIZATION
 
+#include "unicode/bytestream.h"
 #include "unicode/uchar.h"
 #include "unicode/errorcode.h"
 #include "unicode/normlzr.h"
@@ -15,6 +16,7 @@
 #include "unicode/usetiter.h"
 #include "unicode/schriter.h"
 #include "unicode/utf16.h"
+#include "charstr.h"
 #include "cstring.h"
 #include "normalizer2impl.h"
 #include "tstnorm.h"
@@ -58,6 +60,10 @@ void BasicNormalizerTest::runIndexedTest(int32_t index, UBool exec,
         CASE(18,TestCustomFCC);
 #endif
         CASE(19,TestFilteredNormalizer2Coverage);
+        CASE(20,TestLongLowText);
+        CASE(21,TestUTF8);
+        CASE(22,TestStreaming);
+        CASE(23,TestNormalizeToBuffer);
         default: name = ""; break;
     }
 }
@@ -1523,4 +1529,370 @@ BasicNormalizerTest::TestFilteredNormalizer2Coverage() {
     }
 }
 
+// The quick check loops skip text below the normalization thresholds in blocks.
+// Put a character that needs normalization at each position of long low text.
+void
+BasicNormalizerTest::TestLongLowText() {
+    IcuTestErrorCode errorCode(*this, "TestLongLowText");
+    const Normalizer2 *nfc=Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfd=Normalizer2::getNFDInstance(errorCode);
+    if(errorCode.logDataIfFailureAndReset("unable to get NFC/NFD instances")) {
+        return;
+    }
+    static const int32_t kLength=48;
+    UnicodeString low;
+    for(int32_t i=0; i<kLength; ++i) {
+        low.append((UChar)(0x61+i%26));
+    }
+    if(!nfc->isNormalized(low, errorCode) || !nfd->isNormalized(low, errorCode) ||
+            nfc->spanQuickCheckYes(low, errorCode)!=kLength ||
+            nfc->normalize(low, errorCode)!=low || nfd->normalize(low, errorCode)!=low) {
+        errln("low text is not NFC/NFD");
+    }
+    UnicodeString composed=UNICODE_STRING_SIMPLE("\u00e9").unescape();
+    UnicodeString decomposed=UNICODE_STRING_SIMPLE("e\u0301").unescape();
+    // U+1D15E MUSICAL SYMBOL HALF NOTE decomposes to U+1D157 U+1D165.
+    UnicodeString supp=UNICODE_STRING_SIMPLE("\U0001D15E").unescape();
+    UnicodeString suppNFD=UNICODE_STRING_SIMPLE("\U0001D157\U0001D165").unescape();
+    for(int32_t i=0; i<=kLength-8; ++i) {
+        UnicodeString s, expected;
+        // NFC: e + combining acute composes.
+        s=low; s.insert(i, decomposed);
+        expected=low; expected.insert(i, composed);
+        if(nfc->isNormalized(s, errorCode) ||
+                nfc->quickCheck(s, errorCode)==UNORM_YES ||
+                nfc->spanQuickCheckYes(s, errorCode)>i ||
+                nfc->normalize(s, errorCode)!=expected) {
+            errln("NFC of low text with e+U+0301 at %d is wrong", (int)i);
+        }
+        // NFD: precomposed e-acute decomposes.
+        s=low; s.insert(i, composed);
+        expected=low; expected.insert(i, decomposed);
+        if(nfd->isNormalized(s, errorCode) ||
+                nfd->spanQuickCheckYes(s, errorCode)!=i ||
+                nfd->normalize(s, errorCode)!=expected) {
+            errln("NFD of low text with U+00E9 at %d is wrong", (int)i);
+        }
+        // Supplementary code point, which the block scan must not split.
+        s=low; s.insert(i, supp);
+        expected=low; expected.insert(i, suppNFD);
+        if(nfc->isNormalized(s, errorCode) ||
+                nfc->spanQuickCheckYes(s, errorCode)>i ||
+                nfc->normalize(s, errorCode)!=expected ||
+                nfd->normalize(s, errorCode)!=expected) {
+            errln("NFC/NFD of low text with U+1D15E at %d is wrong", (int)i);
+        }
+    }
+    errorCode.assertSuccess();
+}
+
+namespace {
+
+// Collects the UTF-8 output and counts the Append() calls.
+class AppendCountingSink : public ByteSink {
+public:
+    AppendCountingSink() : count(0), lastBytes(NULL) {}
+    virtual void Append(const char *bytes, int32_t n) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        result.append(bytes, n, errorCode);
+        ++count;
+        lastBytes=bytes;
+    }
+
+    CharString result;
+    int32_t count;
+    const char *lastBytes;
+};
+
+void
+appendUTF8(const UnicodeString &s16, CharString &s8) {
+    AppendCountingSink sink;
+    s16.toUTF8(sink);
+    UErrorCode errorCode=U_ZERO_ERROR;
+    s8.append(sink.result, errorCode);
+}
+
+}  // namespace
+
+// The UTF-8 functions must give the same results as the UTF-16 ones,
+// whether they work natively or via the default implementations.
+void
+BasicNormalizerTest::TestUTF8() {
+    IcuTestErrorCode errorCode(*this, "TestUTF8");
+    const Normalizer2 *nfc=Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfd=Normalizer2::getNFDInstance(errorCode);
+    const Normalizer2 *nfkc=Normalizer2::getNFKCInstance(errorCode);
+    const Normalizer2 *nfkd=Normalizer2::getNFKDInstance(errorCode);
+    const Normalizer2 *fcc=Normalizer2::getInstance(NULL, "nfc", UNORM2_COMPOSE_CONTIGUOUS, errorCode);
+    const Normalizer2 *fcd=Normalizer2::getInstance(NULL, "nfc", UNORM2_FCD, errorCode);
+    if(errorCode.logDataIfFailureAndReset("unable to get the standard Normalizer2 instances")) {
+        return;
+    }
+    UnicodeSet filter(UNICODE_STRING_SIMPLE("[^\\u0308\\u00e4]"), errorCode);
+    FilteredNormalizer2 filtered(*nfc, filter);
+    const Normalizer2 *norms[]={ nfc, nfd, nfkc, nfkd, fcc, fcd, &filtered };
+    const char *names[]={ "NFC", "NFD", "NFKC", "NFKD", "FCC", "FCD", "filtered NFC" };
+    static const char *const strings[]={
+        "",
+        "abc",
+        "a\\u0308bc\\u00e4",
+        "e\\u0301\\u0327 \\u00e9\\u0327",
+        "x\\u0301\\u0316y\\u0316\\u0301",
+        "\\uAC00\\u11A8\\u1100\\u1161\\u11A8",
+        "\\U0001D15E\\U0001D157\\U0001D165",
+        "\\u212B\\uF900\\uFB2C\\u0344",
+        "\\u1E0A\\u0323 \\u1E0C\\u0307 \\u0F73\\u0F75\\u0F81",
+        "low ASCII text that is long enough to be skipped in blocks \\u00e0 and more text a\\u0300",
+        "\\uFF76\\uFF9E \\u00bd \\u2460 \\u3300 \\u0061\\u0315\\u0300\\u05ae\\u0300b"
+    };
+    for(int32_t i=0; i<LENGTHOF(strings); ++i) {
+        UnicodeString s16=UnicodeString(strings[i], -1, US_INV).unescape();
+        CharString s8;
+        appendUTF8(s16, s8);
+        for(int32_t j=0; j<LENGTHOF(norms); ++j) {
+            const Normalizer2 *norm=norms[j];
+            CharString expected;
+            appendUTF8(norm->normalize(s16, errorCode), expected);
+            AppendCountingSink sink;
+            norm->normalizeUTF8(s8.toStringPiece(), sink, errorCode);
+            if(sink.result.toStringPiece()!=expected.toStringPiece()) {
+                errln("%s.normalizeUTF8(strings[%d]) differs from normalize()", names[j], (int)i);
+            }
+            UBool isNormalized=norm->isNormalized(s16, errorCode);
+            if(norm->isNormalizedUTF8(s8.toStringPiece(), errorCode)!=isNormalized) {
+                errln("%s.isNormalizedUTF8(strings[%d]) differs from isNormalized()", names[j], (int)i);
+            }
+            if(norm->quickCheckUTF8(s8.toStringPiece(), errorCode)!=norm->quickCheck(s16, errorCode)) {
+                errln("%s.quickCheckUTF8(strings[%d]) differs from quickCheck()", names[j], (int)i);
+            }
+            int32_t spanLength=norm->spanQuickCheckYesUTF8(s8.toStringPiece(), errorCode);
+            StringPiece span(s8.data(), spanLength);
+            if(isNormalized ? spanLength!=s8.length() :
+                    spanLength>=s8.length() ||
+                    norm->quickCheck(UnicodeString::fromUTF8(span), errorCode)!=UNORM_YES) {
+                errln("%s.spanQuickCheckYesUTF8(strings[%d])=%d is wrong",
+                      names[j], (int)i, (int)spanLength);
+            }
+            if(isNormalized && !s8.isEmpty() && (sink.count!=1 || sink.lastBytes!=s8.data())) {
+                errln("%s.normalizeUTF8(normalized strings[%d]) copied the text %d times",
+                      names[j], (int)i, (int)sink.count);
+            }
+            // first+second where first is normalized.
+            for(int32_t k=0; k<=s16.length(); ++k) {
+                if(k>0 && U16_IS_LEAD(s16.charAt(k-1)) && U16_IS_TRAIL(s16.charAt(k))) {
+                    continue;  // do not split a surrogate pair
+                }
+                UnicodeString first=norm->normalize(s16.tempSubString(0, k), errorCode);
+                UnicodeString second=s16.tempSubString(k);
+                CharString first8, second8;
+                appendUTF8(first, first8);
+                appendUTF8(second, second8);
+                expected.clear();
+                appendUTF8(norm->normalizeSecondAndAppend(first, second, errorCode), expected);
+                AppendCountingSink appendSink;
+                norm->normalizeSecondAndAppendUTF8(
+                    first8.toStringPiece(), second8.toStringPiece(), appendSink, errorCode);
+                if(appendSink.result.toStringPiece()!=expected.toStringPiece()) {
+                    errln("%s.normalizeSecondAndAppendUTF8(strings[%d] split at %d) is wrong",
+                          names[j], (int)i, (int)k);
+                }
+            }
+        }
+    }
+    // Ill-formed sequences are copied unchanged and do not interact with their neighbors.
+    static const struct {
+        const char *src, *nfc, *nfd;
+    } illFormed[]={
+        { "e\xCC\x81\xFF\xCC\x81", "\xC3\xA9\xFF\xCC\x81", "e\xCC\x81\xFF\xCC\x81" },
+        { "\xC3\xA9\xED\xA0\x80" "a", "\xC3\xA9\xED\xA0\x80" "a", "e\xCC\x81\xED\xA0\x80" "a" },
+        { "e\xC3\xCC\x81", "e\xC3\xCC\x81", "e\xC3\xCC\x81" },
+        { "\xCC\xA3\xCC\x81\xF0\x9D\x85", "\xCC\xA3\xCC\x81\xF0\x9D\x85", "\xCC\xA3\xCC\x81\xF0\x9D\x85" }
+    };
+    FilteredNormalizer2 nfdFiltered(*nfd, filter);
+    for(int32_t i=0; i<LENGTHOF(illFormed); ++i) {
+        StringPiece src(illFormed[i].src);
+        AppendCountingSink nfcSink, nfdSink, defaultSink;
+        nfc->normalizeUTF8(src, nfcSink, errorCode);
+        nfd->normalizeUTF8(src, nfdSink, errorCode);
+        nfdFiltered.normalizeUTF8(src, defaultSink, errorCode);
+        if(nfcSink.result.toStringPiece()!=StringPiece(illFormed[i].nfc)) {
+            errln("NFC normalizeUTF8(illFormed[%d]) is wrong", (int)i);
+        }
+        if(nfdSink.result.toStringPiece()!=StringPiece(illFormed[i].nfd)) {
+            errln("NFD normalizeUTF8(illFormed[%d]) is wrong", (int)i);
+        }
+        if(defaultSink.result.toStringPiece()!=StringPiece(illFormed[i].nfd)) {
+            errln("filtered NFD normalizeUTF8(illFormed[%d]) is wrong", (int)i);
+        }
+        if(nfc->isNormalizedUTF8(src, errorCode)!=(src==StringPiece(illFormed[i].nfc))) {
+            errln("NFC isNormalizedUTF8(illFormed[%d]) is wrong", (int)i);
+        }
+        if(nfd->isNormalizedUTF8(src, errorCode)!=(src==StringPiece(illFormed[i].nfd))) {
+            errln("NFD isNormalizedUTF8(illFormed[%d]) is wrong", (int)i);
+        }
+    }
+    errorCode.assertSuccess();
+}
+
+// Normalizing in chunks of any size must give the same result as normalizing all at once.
+void
+BasicNormalizerTest::TestStreaming() {
+    IcuTestErrorCode errorCode(*this, "TestStreaming");
+    const Normalizer2 *nfc=Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfd=Normalizer2::getNFDInstance(errorCode);
+    const Normalizer2 *nfkc=Normalizer2::getNFKCInstance(errorCode);
+    const Normalizer2 *fcc=Normalizer2::getInstance(NULL, "nfc", UNORM2_COMPOSE_CONTIGUOUS, errorCode);
+    const Normalizer2 *fcd=Normalizer2::getInstance(NULL, "nfc", UNORM2_FCD, errorCode);
+    if(errorCode.logDataIfFailureAndReset("unable to get the standard Normalizer2 instances")) {
+        return;
+    }
+    UnicodeSet filter(UNICODE_STRING_SIMPLE("[^\\u0308\\u00e4]"), errorCode);
+    FilteredNormalizer2 filtered(*nfc, filter);
+    const Normalizer2 *norms[]={ nfc, nfd, nfkc, fcc, fcd, &filtered };
+    const char *names[]={ "NFC", "NFD", "NFKC", "FCC", "FCD", "filtered NFC" };
+    UnicodeString text=UnicodeString(
+        "The quick brown fox a\\u0308\\u0301 e\\u0327\\u0301 \\u1E0A\\u0323 "
+        "\\u1100\\u1161\\u11A8\\uAC00\\u11A8 \\U0001D15E\\U0001D157\\U0001D165 "
+        "x\\u0301\\u0316\\u0301\\u0316\\u0301\\u0316\\u0301\\u0316\\u0301 "
+        "\\u212B\\uF900\\uFB2C\\u0344\\u0F73\\u0F75\\u0F81 \\uFF76\\uFF9E\\u00bd\\u2460 "
+        "\\u0061\\u0315\\u0300\\u05ae\\u0300b \\u00e4\\u0323 a\\u0307\\U000110BA\\u0316 end", -1, US_INV).unescape();
+    static const int32_t chunkLengths[]={ 1, 2, 3, 5, 64 };
+    for(int32_t j=0; j<LENGTHOF(norms); ++j) {
+        UnicodeString expected=norms[j]->normalize(text, errorCode);
+        StreamingNormalizer2 streaming(*norms[j]);
+        for(int32_t k=0; k<LENGTHOF(chunkLengths); ++k) {
+            UnicodeString result;
+            for(int32_t start=0; start<text.length(); start+=chunkLengths[k]) {
+                streaming.normalizeChunk(text.tempSubString(start, chunkLengths[k]), result, errorCode);
+                // The held-back text does not grow beyond the current combining sequence.
+                if(streaming.getPendingLength()>12) {
+                    errln("%s streaming with chunks of %d: %d UChars held back at %d",
+                          names[j], (int)chunkLengths[k],
+                          (int)streaming.getPendingLength(), (int)start);
+                }
+            }
+            streaming.finish(result, errorCode);
+            if(result!=expected) {
+                errln("%s streaming with chunks of %d differs from normalize()",
+                      names[j], (int)chunkLengths[k]);
+            }
+            if(streaming.getPendingLength()!=0) {
+                errln("%s streaming: finish() did not consume the held-back text", names[j]);
+            }
+        }
+    }
+    // Output is appended to dest without touching its earlier text,
+    // even if that ends with a combining mark of higher ccc than the new text.
+    UnicodeString prefix=UNICODE_STRING_SIMPLE("x\\u0301").unescape();
+    UnicodeString marks=UNICODE_STRING_SIMPLE("\\u0316a\\u0316\\u0301 b").unescape();
+    for(int32_t j=0; j<LENGTHOF(norms); ++j) {
+        UnicodeString expected=prefix+norms[j]->normalize(marks, errorCode);
+        StreamingNormalizer2 streaming(*norms[j]);
+        UnicodeString result(prefix);
+        streaming.normalizeChunk(marks, result, errorCode);
+        streaming.finish(result, errorCode);
+        if(result!=expected) {
+            errln("%s streaming into a non-empty dest changed its earlier text", names[j]);
+        }
+    }
+    // Boundary-free text is held back until the end.
+    StreamingNormalizer2 streaming(*nfc);
+    UnicodeString result;
+    streaming.normalizeChunk(UNICODE_STRING_SIMPLE("a\\u0316").unescape(), result, errorCode);
+    streaming.normalizeChunk(UNICODE_STRING_SIMPLE("\\u0301\\u0301\\u0301").unescape(), result, errorCode);
+    if(!result.isEmpty() || streaming.getPendingLength()!=5) {
+        errln("NFC streaming did not hold back a combining sequence");
+    }
+    streaming.reset();
+    streaming.finish(result, errorCode);
+    if(!result.isEmpty()) {
+        errln("NFC streaming reset() did not discard the held-back text");
+    }
+    errorCode.assertSuccess();
+}
+
+void
+BasicNormalizerTest::TestNormalizeToBuffer() {
+    IcuTestErrorCode errorCode(*this, "TestNormalizeToBuffer");
+    const Normalizer2 *nfc=Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfd=Normalizer2::getNFDInstance(errorCode);
+    if(errorCode.logDataIfFailureAndReset("unable to get the standard Normalizer2 instances")) {
+        return;
+    }
+    UnicodeSet filter(UNICODE_STRING_SIMPLE("[^\\u0308\\u00e4]"), errorCode);
+    FilteredNormalizer2 filtered(*nfc, filter);
+    const Normalizer2 *norms[]={ nfc, nfd, &filtered };
+    const char *names[]={ "NFC", "NFD", "filtered NFC" };
+    UnicodeString shortText=UNICODE_STRING_SIMPLE(
+        "a\\u0308\\u0301 \\u00e4\\u0323 \\u1100\\u1161\\u11A8 \\U0001D15E").unescape();
+    // Longer than the internal stack buffer.
+    UnicodeString longText;
+    for(int32_t i=0; i<40; ++i) {
+        longText.append(shortText);
+    }
+    const UnicodeString *texts[]={ &shortText, &longText };
+    UChar dest[1000];
+    for(int32_t j=0; j<LENGTHOF(norms); ++j) {
+        for(int32_t k=0; k<LENGTHOF(texts); ++k) {
+            const UnicodeString &text=*texts[k];
+            UnicodeString expected=norms[j]->normalize(text, errorCode);
+            int32_t expectedLength=expected.length();
+            // Preflighting, a buffer that is one too short,
+            // one without room for the NUL, and one with room.
+            int32_t capacities[]={ 0, expectedLength-1, expectedLength, LENGTHOF(dest) };
+            for(int32_t c=0; c<LENGTHOF(capacities); ++c) {
+                int32_t capacity=capacities[c];
+                UErrorCode ec=U_ZERO_ERROR;
+                u_memset(dest, 0xffff, LENGTHOF(dest));
+                int32_t length=norms[j]->normalizeToBuffer(
+                    text.getBuffer(), text.length(),
+                    capacity==0 ? NULL : dest, capacity, ec);
+                if(length!=expectedLength) {
+                    errln("%s normalizeToBuffer(text %d, capacity %d) returned length %d not %d",
+                          names[j], (int)k, (int)capacity, (int)length, (int)expectedLength);
+                }
+                if(capacity<expectedLength) {
+                    if(ec!=U_BUFFER_OVERFLOW_ERROR) {
+                        errln("%s normalizeToBuffer(text %d, capacity %d) did not overflow: %s",
+                              names[j], (int)k, (int)capacity, u_errorName(ec));
+                    }
+                    continue;
+                }
+                if(U_FAILURE(ec) || expected!=UnicodeString(FALSE, dest, length)) {
+                    errln("%s normalizeToBuffer(text %d, capacity %d) differs from normalize(): %s",
+                          names[j], (int)k, (int)capacity, u_errorName(ec));
+                } else if(capacity==expectedLength ?
+                          ec!=U_STRING_NOT_TERMINATED_WARNING : dest[length]!=0) {
+                    errln("%s normalizeToBuffer(text %d, capacity %d) wrong NUL termination",
+                          names[j], (int)k, (int)capacity);
+                }
+            }
+            // NUL-terminated source.
+            UnicodeString terminated(text);
+            int32_t length=norms[j]->normalizeToBuffer(
+                terminated.getTerminatedBuffer(), -1, dest, LENGTHOF(dest), errorCode);
+            if(expected!=UnicodeString(FALSE, dest, length)) {
+                errln("%s normalizeToBuffer(NUL-terminated text %d) differs from normalize()",
+                      names[j], (int)k);
+            }
+        }
+    }
+    UErrorCode ec=U_ZERO_ERROR;
+    u_strcpy(dest, shortText.getTerminatedBuffer());
+    nfc->normalizeToBuffer(dest, -1, dest, LENGTHOF(dest), ec);
+    if(ec!=U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("normalizeToBuffer(src==dest) did not fail: %s", u_errorName(ec));
+    }
+    ec=U_ZERO_ERROR;
+    nfc->normalizeToBuffer(NULL, 5, dest, LENGTHOF(dest), ec);
+    if(ec!=U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("normalizeToBuffer(NULL, 5) did not fail: %s", u_errorName(ec));
+    }
+    ec=U_ZERO_ERROR;
+    if(nfc->normalizeToBuffer(NULL, 0, dest, LENGTHOF(dest), ec)!=0 || U_FAILURE(ec) || dest[0]!=0) {
+        errln("normalizeToBuffer(empty) failed: %s", u_errorName(ec));
+    }
+    errorCode.assertSuccess();
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
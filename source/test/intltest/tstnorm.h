@@ -45,6 +45,10 @@ public:
     void TestCustomComp();
     void TestCustomFCC();
     void TestFilteredNormalizer2Coverage();
+    void TestLongLowText();
+    void TestUTF8();
+    void TestStreaming();
+    void TestNormalizeToBuffer();
 
 private:
     UnicodeString canonTests[24][3];
@@ -0,0 +1,386 @@
+/*
+*******************************************************************************
+* Copyright (C) 2014, International Business Machines Corporation and         *
+* others. All Rights Reserved.                                                *
+*******************************************************************************
+*
+* File UNIFIEDCACHETEST.CPP
+*
+********************************************************************************
+*/
+#include "charstr.h"
+#include "cstring.h"
+#include "intltest.h"
+#include "simplethread.h"
+#include "umutex.h"
+#include "unifiedcache.h"
+#include "unicode/measfmt.h"
+
+static u_atomic_int32_t gObjectCount = ATOMIC_INT32_T_INITIALIZER(0);
+static u_atomic_int32_t gCreateCount = ATOMIC_INT32_T_INITIALIZER(0);
+static int32_t gCreateDelay = 0;
+
+class UCTItem : public SharedObject {
+public:
+    UCTItem(const char *localeId, char typeChar) : value(localeId, -1, US_INV) {
+        value.append((UChar)typeChar);
+        umtx_atomic_inc(&gObjectCount);
+    }
+    virtual ~UCTItem() {
+        umtx_atomic_dec(&gObjectCount);
+    }
+    UnicodeString value;
+};
+
+static SharedObject *createItem(const char *localeId, char typeChar, UErrorCode &status) {
+    umtx_atomic_inc(&gCreateCount);
+    if (gCreateDelay > 0) {
+        SimpleThread::sleep(gCreateDelay);
+    }
+    if (uprv_strcmp(localeId, "error") == 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    SharedObject *result = new UCTItem(localeId, typeChar);
+    if (result == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    }
+    return result;
+}
+
+static SharedObject *createItemA(const char *localeId, UErrorCode &status) {
+    return createItem(localeId, 'A', status);
+}
+
+static SharedObject *createItemB(const char *localeId, UErrorCode &status) {
+    return createItem(localeId, 'B', status);
+}
+
+static const UnifiedCacheType gTypeA = U_UNIFIEDCACHE_TYPE_INITIALIZER("A", &createItemA);
+static const UnifiedCacheType gTypeB = U_UNIFIEDCACHE_TYPE_INITIALIZER("B", &createItemB);
+
+class UnifiedCacheTest : public IntlTest {
+public:
+    UnifiedCacheTest() {
+    }
+    void runIndexedTest(int32_t index, UBool exec, const char *&name, char *par=0);
+private:
+    void TestBasic();
+    void TestError();
+    void TestEviction();
+    void TestConcurrentCreation();
+    void TestConcurrentEviction();
+    void TestServicesShareCache();
+    void verifyItem(const UCTItem *item, const char *expected);
+    void verifyStatistics(const UnifiedCache &cache, const char *typeName,
+                          int32_t hits, int32_t misses, int32_t evictions);
+};
+
+void UnifiedCacheTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
+  TESTCASE_AUTO_BEGIN;
+  TESTCASE_AUTO(TestBasic);
+  TESTCASE_AUTO(TestError);
+  TESTCASE_AUTO(TestEviction);
+  TESTCASE_AUTO(TestConcurrentCreation);
+  TESTCASE_AUTO(TestConcurrentEviction);
+  TESTCASE_AUTO(TestServicesShareCache);
+  TESTCASE_AUTO_END;
+}
+
+void UnifiedCacheTest::TestBasic() {
+    UErrorCode status = U_ZERO_ERROR;
+    umtx_storeRelease(gCreateCount, 0);
+    {
+        UnifiedCache cache(10, status);
+        const UCTItem *fooA = NULL;
+        const UCTItem *fooA2 = NULL;
+        const UCTItem *fooB = NULL;
+        const UCTItem *barA = NULL;
+        cache.get(gTypeA, "foo", fooA, status);
+        cache.get(gTypeA, "foo", fooA2, status);
+        cache.get(gTypeB, "foo", fooB, status);
+        cache.get(gTypeA, "bar", barA, status);
+        if (U_FAILURE(status)) {
+            errln("UnifiedCache.get() failed - %s", u_errorName(status));
+            return;
+        }
+        verifyItem(fooA, "fooA");
+        verifyItem(fooB, "fooB");
+        verifyItem(barA, "barA");
+        if (fooA != fooA2) {
+            errln("Second get() of the same key should return the same object.");
+        }
+        // The cache holds one reference, fooA and fooA2 the others.
+        if (fooA->getRefCount() != 3) {
+            errln("Expected 3 references, got %d", (int)fooA->getRefCount());
+        }
+        if (umtx_loadAcquire(gCreateCount) != 3) {
+            errln("Expected 3 creations, got %d", (int)umtx_loadAcquire(gCreateCount));
+        }
+        if (cache.getEntryCount() != 3) {
+            errln("Expected 3 entries, got %d", (int)cache.getEntryCount());
+        }
+        verifyStatistics(cache, "A", 1, 2, 0);
+        verifyStatistics(cache, "B", 0, 1, 0);
+        int32_t hits, misses, evictions;
+        if (cache.getStatistics("C", hits, misses, evictions)) {
+            errln("Statistics for an unused type.");
+        }
+
+        // get() replaces what the pointer owned before.
+        cache.get(gTypeA, "bar", fooA2, status);
+        if (fooA2 != barA || fooA->getRefCount() != 2) {
+            errln("get() did not release the previous object.");
+        }
+        SharedObject::clearPtr(fooA);
+        SharedObject::clearPtr(fooA2);
+        SharedObject::clearPtr(fooB);
+        SharedObject::clearPtr(barA);
+        if (umtx_loadAcquire(gObjectCount) != 3) {
+            errln("The cache should still own 3 objects.");
+        }
+        cache.flush();
+        if (cache.getEntryCount() != 0 || umtx_loadAcquire(gObjectCount) != 0) {
+            errln("flush() should have released all objects.");
+        }
+    }
+    status = U_MEMORY_ALLOCATION_ERROR;
+    UnifiedCache failed(10, status);  // must not crash
+}
+
+void UnifiedCacheTest::TestError() {
+    UErrorCode status = U_ZERO_ERROR;
+    umtx_storeRelease(gCreateCount, 0);
+    UnifiedCache cache(3, status);
+    const UCTItem *item = NULL;
+    for (int32_t i = 0; i < 2; ++i) {
+        status = U_ZERO_ERROR;
+        cache.get(gTypeA, "error", item, status);
+        if (status != U_ILLEGAL_ARGUMENT_ERROR || item != NULL) {
+            errln("Expected U_ILLEGAL_ARGUMENT_ERROR, got %s", u_errorName(status));
+        }
+    }
+    // The failure is cached.
+    if (umtx_loadAcquire(gCreateCount) != 1) {
+        errln("Expected 1 creation, got %d", (int)umtx_loadAcquire(gCreateCount));
+    }
+    verifyStatistics(cache, "A", 1, 1, 0);
+}
+
+void UnifiedCacheTest::TestEviction() {
+    static const char *const keys[] = {
+        "k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7", "k8", "k9"
+    };
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCache cache(3, status);
+    const UCTItem *items[10] = { NULL };
+    for (int32_t round = 0; round < 3; ++round) {
+        for (int32_t i = 0; i < 10; ++i) {
+            cache.get(gTypeA, keys[i], items[i], status);
+            if (U_FAILURE(status)) {
+                errln("UnifiedCache.get() failed - %s", u_errorName(status));
+                return;
+            }
+            if (cache.getEntryCount() > 3) {
+                errln("Cache exceeds its budget: %d entries", (int)cache.getEntryCount());
+            }
+        }
+    }
+    // Evicted objects are still owned by their holders.
+    for (int32_t i = 0; i < 10; ++i) {
+        verifyItem(items[i], CharString(keys[i], status).append('A', status).data());
+        SharedObject::clearPtr(items[i]);
+    }
+    int32_t hits, misses, evictions;
+    if (!cache.getStatistics("A", hits, misses, evictions)) {
+        errln("No statistics for type A.");
+    } else if (hits + misses != 30 || evictions != misses - cache.getEntryCount()) {
+        errln("Unexpected statistics: hits=%d misses=%d evictions=%d",
+              (int)hits, (int)misses, (int)evictions);
+    } else if (evictions < 21) {
+        errln("Cycling through 10 keys with room for 3 should evict almost always.");
+    }
+    cache.flush();
+    if (umtx_loadAcquire(gObjectCount) != 0) {
+        errln("Objects leaked: %d", (int)umtx_loadAcquire(gObjectCount));
+    }
+}
+
+class UnifiedCacheThread : public SimpleThread {
+public:
+    UnifiedCacheThread(UnifiedCache &c, int32_t n, int32_t i)
+            : cache(c), keyCount(n), iterations(i), item(NULL), errorCount(0) {}
+    virtual ~UnifiedCacheThread() {
+        SharedObject::clearPtr(item);
+    }
+    virtual void run() {
+        for (int32_t i = 0; i < iterations; ++i) {
+            char key[16];
+            key[0] = 'k';
+            key[1] = (char)('a' + (i * 7 + keyCount) % keyCount);
+            key[2] = 0;
+            UErrorCode status = U_ZERO_ERROR;
+            cache.get(gTypeB, key, item, status);
+            key[2] = 'B';
+            key[3] = 0;
+            if (U_FAILURE(status) || item == NULL || item->value != UnicodeString(key, -1, US_INV)) {
+                ++errorCount;
+            }
+        }
+    }
+    UnifiedCache &cache;
+    int32_t keyCount;
+    int32_t iterations;
+    const UCTItem *item;
+    int32_t errorCount;
+};
+
+static UBool joinThreads(UnifiedCacheThread *threads[], int32_t count) {
+    for (int32_t patience = 3000; patience > 0; --patience) {
+        UBool someThreadRunning = FALSE;
+        for (int32_t i = 0; i < count; ++i) {
+            if (threads[i]->isRunning()) {
+                someThreadRunning = TRUE;
+                break;
+            }
+        }
+        if (!someThreadRunning) {
+            return TRUE;
+        }
+        SimpleThread::sleep(10);
+    }
+    return FALSE;
+}
+
+void UnifiedCacheTest::TestConcurrentCreation() {
+    // All threads ask for the same key while it is being created.
+    static const int32_t THREAD_COUNT = 8;
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCache cache(10, status);
+    umtx_storeRelease(gCreateCount, 0);
+    gCreateDelay = 100;
+    UnifiedCacheThread *threads[THREAD_COUNT];
+    int32_t i;
+    for (i = 0; i < THREAD_COUNT; ++i) {
+        threads[i] = new UnifiedCacheThread(cache, 1, 1);
+    }
+    for (i = 0; i < THREAD_COUNT; ++i) {
+        threads[i]->start();
+    }
+    if (!joinThreads(threads, THREAD_COUNT)) {
+        errln("Threads did not complete.");
+        gCreateDelay = 0;
+        return;  // leak the threads rather than delete running ones
+    }
+    gCreateDelay = 0;
+    if (umtx_loadAcquire(gCreateCount) != 1) {
+        errln("Expected 1 creation, got %d", (int)umtx_loadAcquire(gCreateCount));
+    }
+    for (i = 0; i < THREAD_COUNT; ++i) {
+        if (threads[i]->errorCount != 0 || threads[i]->item != threads[0]->item) {
+            errln("Thread %d got a wrong object.", (int)i);
+        }
+    }
+    verifyStatistics(cache, "B", THREAD_COUNT - 1, 1, 0);
+    for (i = 0; i < THREAD_COUNT; ++i) {
+        delete threads[i];
+    }
+}
+
+void UnifiedCacheTest::TestConcurrentEviction() {
+    // Many more keys than entries, so that hits race with evictions
+    // and with reuse of evicted entries.
+    static const int32_t THREAD_COUNT = 8;
+    UErrorCode status = U_ZERO_ERROR;
+    {
+        UnifiedCache cache(4, status);
+        UnifiedCacheThread *threads[THREAD_COUNT];
+        int32_t i;
+        for (i = 0; i < THREAD_COUNT; ++i) {
+            threads[i] = new UnifiedCacheThread(cache, 3 + i, 20000);
+        }
+        for (i = 0; i < THREAD_COUNT; ++i) {
+            threads[i]->start();
+        }
+        if (!joinThreads(threads, THREAD_COUNT)) {
+            errln("Threads did not complete.");
+            return;
+        }
+        for (i = 0; i < THREAD_COUNT; ++i) {
+            if (threads[i]->errorCount != 0) {
+                errln("Thread %d got %d wrong objects.", (int)i, (int)threads[i]->errorCount);
+            }
+            delete threads[i];
+        }
+        int32_t hits, misses, evictions;
+        cache.getStatistics("B", hits, misses, evictions);
+        logln("hits=%d misses=%d evictions=%d", (int)hits, (int)misses, (int)evictions);
+        if (hits + misses != THREAD_COUNT * 20000) {
+            errln("Lookups were not counted: hits=%d misses=%d", (int)hits, (int)misses);
+        }
+        if (cache.getEntryCount() > 4) {
+            errln("Cache exceeds its budget: %d entries", (int)cache.getEntryCount());
+        }
+    }
+    if (umtx_loadAcquire(gObjectCount) != 0) {
+        errln("Objects leaked: %d", (int)umtx_loadAcquire(gObjectCount));
+    }
+}
+
+void UnifiedCacheTest::TestServicesShareCache() {
+#if !UCONFIG_NO_FORMATTING
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCache *cache = UnifiedCache::getInstance(status);
+    MeasureFormat first("fr", UMEASFMT_WIDTH_WIDE, status);
+    if (U_FAILURE(status)) {
+        dataerrln("Error creating MeasureFormat - %s", u_errorName(status));
+        return;
+    }
+    int32_t hits, misses, evictions;
+    if (!cache->getStatistics("MeasureFormat", hits, misses, evictions) ||
+            !cache->getStatistics("NumberFormat", hits, misses, evictions) ||
+            !cache->getStatistics("PluralRules", hits, misses, evictions)) {
+        errln("MeasureFormat should use the process-wide cache for its data, "
+              "number format and plural rules.");
+        return;
+    }
+    int32_t pluralHits = hits;
+    MeasureFormat second("fr", UMEASFMT_WIDTH_SHORT, status);
+    cache->getStatistics("PluralRules", hits, misses, evictions);
+    if (hits <= pluralHits) {
+        errln("Second MeasureFormat for the same locale should hit the cache.");
+    }
+    if (cache->getEntryCount() > cache->getMaxEntries()) {
+        errln("Cache exceeds its budget.");
+    }
+#endif
+}
+
+void UnifiedCacheTest::verifyItem(const UCTItem *item, const char *expected) {
+    if (item == NULL) {
+        errln("Expected '%s', got NULL", expected);
+        return;
+    }
+    UnicodeString expectedString(expected, -1, US_INV);
+    if (item->value != expectedString) {
+        errln(UnicodeString("Expected '") + expectedString + "', got '" + item->value + "'");
+    }
+}
+
+void UnifiedCacheTest::verifyStatistics(const UnifiedCache &cache, const char *typeName,
+                                        int32_t hits, int32_t misses, int32_t evictions) {
+    int32_t actualHits, actualMisses, actualEvictions;
+    if (!cache.getStatistics(typeName, actualHits, actualMisses, actualEvictions)) {
+        errln("No statistics for type %s", typeName);
+        return;
+    }
+    if (actualHits != hits || actualMisses != misses || actualEvictions != evictions) {
+        errln("Type %s: expected hits=%d misses=%d evictions=%d, got %d %d %d",
+              typeName, (int)hits, (int)misses, (int)evictions,
+              (int)actualHits, (int)actualMisses, (int)actualEvictions);
+    }
+}
+
+extern IntlTest *createUnifiedCacheTest() {
+    return new UnifiedCacheTest();
+}
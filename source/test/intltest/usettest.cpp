@@ -92,6 +92,8 @@ UnicodeSetTest::runIndexedTest(int32_t index, UBool exec,
         CASE(21,TestFreezable);
         CASE(22,TestSpan);
         CASE(23,TestStringSpan);
+        CASE(24,TestSpanLongStrings);
+        CASE(25,TestSpanFrozenNegatedSets);
         default: name = ""; break;
     }
 }
@@ -3734,6 +3736,179 @@ void UnicodeSetTest::TestSpan() {
     }
 }
 
+static UnicodeString repeatString(const char *s, int32_t count) {
+    UnicodeString unit=UnicodeString(s, -1, US_INV).unescape();
+    UnicodeString result;
+    while(count-->0) {
+        result.append(unit);
+    }
+    return result;
+}
+
+// The frozen set spans long runs of code units with blocks of code units,
+// and the beginning and end of a longer span one code point at a time.
+// Compare with the spans of the same set before freezing, starting at each offset
+// so that the spans end at every position within a block of 16 code units,
+// and the stretches of single code points end on both halves of surrogate pairs.
+void UnicodeSetTest::TestSpanLongStrings() {
+    static const char *const patterns[]={
+        "[]",
+        "[:Any:]",
+        "[a-z]",
+        "[:P:]",
+        // More than 16 ranges in ASCII.
+        "[acegikmoqsuwy02468\\u0430-\\u044f]",
+        // Ranges which start in ASCII and continue beyond.
+        "[\\u0000-\\u04ff]",
+        "[\\u0000-\\uffff]",
+        "[a-z\\u0430-\\u044f\\ud800-\\udfff\\U00010400-\\U0001044f]",
+        "[^a\\u0430\\U00010400]"
+    };
+    UnicodeString strings[]={
+        repeatString("a", 40)+repeatString("-", 1)+repeatString("a", 400)+repeatString("-", 1)+repeatString("a", 40),
+        repeatString("The quick brown fox, jumps over the lazy dog. ", 10),
+        repeatString("abcdefghijklmno\\u00e9", 30),
+        // Non-ASCII code points after runs of ASCII which are not in the set.
+        repeatString("A", 300)+repeatString("\\u0430\\u2014", 1)+repeatString("A", 100),
+        repeatString("\\u0430", 40)+repeatString(" ", 1)+repeatString("\\u0430", 400)+repeatString(" ", 1)+
+            repeatString("\\u0430", 40),
+        // Blocks of mixed ASCII and non-ASCII code units, with non-ASCII ranges changing within blocks.
+        repeatString("\\u0430\\u0431\\u0432 \\u0433\\u0434 \\u00e9\\u0435.", 30)+
+            repeatString("\\u4e00 a\\u4e01b", 30)+repeatString("\\u2014", 1)+repeatString("x\\u0430", 100),
+        // Surrogate pairs after runs below and above the surrogates.
+        repeatString("\\u0430", 300)+repeatString("\\U00010400", 1)+repeatString("\\uff41", 300)+
+            repeatString("\\U00010400", 1)+repeatString("\\u0430", 40),
+        // Surrogate pairs at every offset from the start of a block or stretch.
+        repeatString("aaaaaaaaaaaaaaa\\U00010400", 25),
+        repeatString("a", 300)+repeatString("\\U00010400", 1)+repeatString("a", 100),
+        repeatString("\\U00010400", 200),
+        // Unpaired surrogates within runs of BMP code points.
+        repeatString("\\u0430\\u0431\\u0432\\ud800\\u0433", 100),
+        repeatString("\\u0430\\udc00\\u0431\\u0432\\udc00\\ud800", 70)
+    };
+    static const USetSpanCondition conditions[]={ USET_SPAN_NOT_CONTAINED, USET_SPAN_CONTAINED };
+    char s8[3000];
+    int32_t i, j, k, start, length8;
+    for(i=0; i<LENGTHOF(patterns); ++i) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        UnicodeSet set(UnicodeString(patterns[i], -1, US_INV), errorCode);
+        if(U_FAILURE(errorCode)) {
+            dataerrln("FAIL: UnicodeSet(%s) - %s", patterns[i], u_errorName(errorCode));
+            continue;
+        }
+        UnicodeSet frozen(set);
+        frozen.freeze();
+        for(j=0; j<LENGTHOF(strings); ++j) {
+            const UChar *s16=strings[j].getBuffer();
+            int32_t length16=strings[j].length();
+            u_strToUTF8WithSub(s8, LENGTHOF(s8), &length8, s16, length16, 0xfffd, NULL, &errorCode);
+            if(U_FAILURE(errorCode)) {
+                errln("FAIL: u_strToUTF8WithSub(long string %d) - %s", (int)j, u_errorName(errorCode));
+                return;
+            }
+            for(k=0; k<LENGTHOF(conditions); ++k) {
+                USetSpanCondition condition=conditions[k];
+                for(start=0; start<=length16; ++start) {
+                    int32_t expect=set.span(s16+start, length16-start, condition);
+                    int32_t actual=frozen.span(s16+start, length16-start, condition);
+                    if(expect!=actual) {
+                        errln("FAIL: frozen UnicodeSet(%s).span(long string %d from %d, %d)=%d != %d",
+                              patterns[i], (int)j, (int)start, (int)condition, (int)actual, (int)expect);
+                        break;
+                    }
+                    expect=set.spanBack(s16, start, condition);
+                    actual=frozen.spanBack(s16, start, condition);
+                    if(expect!=actual) {
+                        errln("FAIL: frozen UnicodeSet(%s).spanBack(long string %d to %d, %d)=%d != %d",
+                              patterns[i], (int)j, (int)start, (int)condition, (int)actual, (int)expect);
+                        break;
+                    }
+                }
+                for(start=0; start<=length8; ++start) {
+                    int32_t expect=set.spanUTF8(s8+start, length8-start, condition);
+                    int32_t actual=frozen.spanUTF8(s8+start, length8-start, condition);
+                    if(expect!=actual) {
+                        errln("FAIL: frozen UnicodeSet(%s).spanUTF8(long string %d from %d, %d)=%d != %d",
+                              patterns[i], (int)j, (int)start, (int)condition, (int)actual, (int)expect);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// A negated set ends with a range up to U+10FFFF, so its inversion list
+// has only the terminator after the start of the last range.
+// Freezing such sets must not read beyond the terminator for the ASCII ranges,
+// and their frozen spans must match those of the unfrozen sets.
+void UnicodeSetTest::TestSpanFrozenNegatedSets() {
+    static const char *const patterns[]={
+        "[^a]",
+        "[^\\u0000]",
+        "[^!-/]",
+        "[^\\u0080]",
+        "[^acegikmoqsuwy]",
+        "[\\u007f-\\U0010ffff]"
+    };
+    UnicodeString strings[]={
+        UnicodeString("abcdefgh ABC 012 xyz!? ~", -1, US_INV),
+        repeatString("b", 40)+repeatString("a", 1)+repeatString("b", 300)+repeatString("!", 1),
+        repeatString("The quick brown fox, jumps over the lazy dog. ", 10),
+        repeatString("x\\u0000\\u0080\\u0430", 50)
+    };
+    static const USetSpanCondition conditions[]={ USET_SPAN_NOT_CONTAINED, USET_SPAN_CONTAINED };
+    char s8[3000];
+    int32_t i, j, k, length8;
+    for(i=0; i<LENGTHOF(patterns); ++i) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        UnicodeSet set(UnicodeString(patterns[i], -1, US_INV), errorCode);
+        if(U_FAILURE(errorCode)) {
+            dataerrln("FAIL: UnicodeSet(%s) - %s", patterns[i], u_errorName(errorCode));
+            continue;
+        }
+        // Also negate a copy after the fact, which reuses the list buffer.
+        UnicodeSet complement(set);
+        complement.complement().complement();
+        UnicodeSet frozen(set);
+        frozen.freeze();
+        complement.freeze();
+        for(j=0; j<LENGTHOF(strings); ++j) {
+            const UChar *s16=strings[j].getBuffer();
+            int32_t length16=strings[j].length();
+            u_strToUTF8WithSub(s8, LENGTHOF(s8), &length8, s16, length16, 0xfffd, NULL, &errorCode);
+            if(U_FAILURE(errorCode)) {
+                errln("FAIL: u_strToUTF8WithSub(string %d) - %s", (int)j, u_errorName(errorCode));
+                return;
+            }
+            for(k=0; k<LENGTHOF(conditions); ++k) {
+                USetSpanCondition condition=conditions[k];
+                int32_t expect=set.span(s16, length16, condition);
+                if( frozen.span(s16, length16, condition)!=expect ||
+                    complement.span(s16, length16, condition)!=expect
+                ) {
+                    errln("FAIL: frozen UnicodeSet(%s).span(string %d, %d) != %d",
+                          patterns[i], (int)j, (int)condition, (int)expect);
+                }
+                expect=set.spanBack(s16, length16, condition);
+                if( frozen.spanBack(s16, length16, condition)!=expect ||
+                    complement.spanBack(s16, length16, condition)!=expect
+                ) {
+                    errln("FAIL: frozen UnicodeSet(%s).spanBack(string %d, %d) != %d",
+                          patterns[i], (int)j, (int)condition, (int)expect);
+                }
+                expect=set.spanUTF8(s8, length8, condition);
+                if( frozen.spanUTF8(s8, length8, condition)!=expect ||
+                    complement.spanUTF8(s8, length8, condition)!=expect
+                ) {
+                    errln("FAIL: frozen UnicodeSet(%s).spanUTF8(string %d, %d) != %d",
+                          patterns[i], (int)j, (int)condition, (int)expect);
+                }
+            }
+        }
+    }
+}
+
 // Test select patterns and strings, and test USET_SPAN_SIMPLE.
 void UnicodeSetTest::TestStringSpan() {
     static const char *pattern="[x{xy}{xya}{axy}{ax}]";
@@ -85,6 +85,9 @@ private:
 
     void TestSpan();
 
+    void TestSpanLongStrings();
+    void TestSpanFrozenNegatedSets();
+
     void TestStringSpan();
 
 private:
@@ -95,6 +95,8 @@ my $tests = {
     "sort UnicodeString*[]: compare()",         ["$p1,TestUniStrSort", "$p2,TestUniStrSort"],
     "sort StringPiece[]: compareUTF8()",        ["$p1,TestStringPieceSortCpp", "$p2,TestStringPieceSortCpp"],
     "sort StringPiece[]: ucol_strcollUTF8()",   ["$p1,TestStringPieceSortC", "$p2,TestStringPieceSortC"],
+    "sort UnicodeString[]: sortIndexes()",      ["$p1,TestUniStrBatchSort", "$p2,TestUniStrBatchSort"],
+    "sort StringPiece[]: sortIndexesUTF8()",    ["$p1,TestStringPieceBatchSort", "$p2,TestStringPieceBatchSort"],
 
     "binary search UnicodeString*[]: compare()",        ["$p1,TestUniStrBinSearch", "$p2,TestUniStrBinSearch"],
     "binary search StringPiece[]: compareUTF8()",       ["$p1,TestStringPieceBinSearchCpp", "$p2,TestStringPieceBinSearchCpp"],
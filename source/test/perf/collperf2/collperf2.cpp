@@ -13,6 +13,7 @@
 #include "unicode/uiter.h"
 #include "unicode/ustring.h"
 #include "unicode/sortkey.h"
+#include "unicode/tblcoll.h"
 #include "uarrsort.h"
 #include "uoptions.h"
 #include "ustr_imp.h"
@@ -946,6 +947,74 @@ void StringPieceSortC::call(UErrorCode* status) {
     ops = cc.counter;
 }
 
+//
+// Test case sorting an array of UnicodeString's with RuleBasedCollator::sortIndexes().
+//
+class UniStrBatchSort : public UPerfFunction {
+public:
+    UniStrBatchSort(const RuleBasedCollator& coll, const CA_uchar* data16)
+            : coll(coll), d16(data16),
+              source(new UnicodeString[d16->count]),
+              indexes(new int32_t[d16->count]) {
+        for (int32_t i = 0; i < d16->count; ++i) {
+            source[i].setTo(FALSE, d16->dataOf(i), d16->lengthOf(i));
+        }
+    }
+    virtual ~UniStrBatchSort();
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration() { return d16->count; }
+
+private:
+    const RuleBasedCollator& coll;
+    const CA_uchar* d16;
+    UnicodeString* source;
+    int32_t* indexes;
+};
+
+UniStrBatchSort::~UniStrBatchSort() {
+    delete[] source;
+    delete[] indexes;
+}
+
+void UniStrBatchSort::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+    coll.sortIndexes(source, d16->count, indexes, *status);
+}
+
+//
+// Test case sorting an array of UTF-8 StringPiece's with RuleBasedCollator::sortIndexesUTF8().
+//
+class StringPieceBatchSort : public UPerfFunction {
+public:
+    StringPieceBatchSort(const RuleBasedCollator& coll, const CA_char* data8)
+            : coll(coll), d8(data8),
+              source(new StringPiece[d8->count]),
+              indexes(new int32_t[d8->count]) {
+        for (int32_t i = 0; i < d8->count; ++i) {
+            source[i].set(d8->dataOf(i), d8->lengthOf(i));
+        }
+    }
+    virtual ~StringPieceBatchSort();
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration() { return d8->count; }
+
+private:
+    const RuleBasedCollator& coll;
+    const CA_char* d8;
+    StringPiece* source;
+    int32_t* indexes;
+};
+
+StringPieceBatchSort::~StringPieceBatchSort() {
+    delete[] source;
+    delete[] indexes;
+}
+
+void StringPieceBatchSort::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+    coll.sortIndexesUTF8(source, d8->count, indexes, *status);
+}
+
 //
 // Test case performing binary searches in a sorted array of UnicodeString pointers.
 //
@@ -1118,6 +1187,8 @@ private:
     UPerfFunction* TestUniStrSort();
     UPerfFunction* TestStringPieceSortCpp();
     UPerfFunction* TestStringPieceSortC();
+    UPerfFunction* TestUniStrBatchSort();
+    UPerfFunction* TestStringPieceBatchSort();
 
     UPerfFunction* TestUniStrBinSearch();
     UPerfFunction* TestStringPieceBinSearchCpp();
@@ -1545,6 +1616,8 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
     TESTCASE_AUTO(TestUniStrSort);
     TESTCASE_AUTO(TestStringPieceSortCpp);
     TESTCASE_AUTO(TestStringPieceSortC);
+    TESTCASE_AUTO(TestUniStrBatchSort);
+    TESTCASE_AUTO(TestStringPieceBatchSort);
 
     TESTCASE_AUTO(TestUniStrBinSearch);
     TESTCASE_AUTO(TestStringPieceBinSearchCpp);
@@ -1872,6 +1945,34 @@ UPerfFunction* CollPerf2Test::TestStringPieceSortC() {
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestUniStrBatchSort() {
+    UErrorCode status = U_ZERO_ERROR;
+    const RuleBasedCollator *rbc = dynamic_cast<const RuleBasedCollator *>(collObj);
+    if (rbc == NULL) {
+        return NULL;
+    }
+    UPerfFunction *testCase = new UniStrBatchSort(*rbc, getRandomData16(status));
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestStringPieceBatchSort() {
+    UErrorCode status = U_ZERO_ERROR;
+    const RuleBasedCollator *rbc = dynamic_cast<const RuleBasedCollator *>(collObj);
+    if (rbc == NULL) {
+        return NULL;
+    }
+    UPerfFunction *testCase = new StringPieceBatchSort(*rbc, getRandomData8(status));
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
 UPerfFunction* CollPerf2Test::TestUniStrBinSearch() {
     UErrorCode status = U_ZERO_ERROR;
     UPerfFunction *testCase = new UniStrBinSearch(*collObj, coll, getSortedData16(status));
@@ -111,6 +111,8 @@ UPerfFunction* ConverterPerformanceTest::runIndexedTest(int32_t index, UBool exe
         TESTCASE(52,TestWinANSI_ISO2022JP_ToUnicode);
         TESTCASE(53,TestWinANSI_ISO2022JP_FromUnicode);
 
+        TESTCASE(54,TestICU_ThreadedOpenClose);
+
         default: 
             name = ""; 
             return NULL;
@@ -137,6 +139,16 @@ UPerfFunction* ConverterPerformanceTest::TestICU_OpenAllConverters() {
     return pf;
 }
 
+UPerfFunction* ConverterPerformanceTest::TestICU_ThreadedOpenClose() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUThreadedOpenCloseFunction(status);
+    if(U_FAILURE(status)){
+        delete pf;
+        return NULL;
+    }
+    return pf;
+}
+
 UPerfFunction* ConverterPerformanceTest::TestICU_UTF8_FromUnicode(){
     UErrorCode status = U_ZERO_ERROR;
     ICUFromUnicodePerfFunction* pf = new ICUFromUnicodePerfFunction("utf-8",utf8_uniSource, LENGTHOF(utf8_uniSource), status);
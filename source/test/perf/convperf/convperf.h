@@ -145,6 +145,65 @@ public:
     }
 };
 
+/*
+ * Opens and closes a few cached converters from several threads at once,
+ * to measure contention in the converter cache.
+ */
+#define OPEN_CLOSE_THREAD_COUNT 8
+#define OPEN_CLOSE_LOOP_COUNT 1000
+
+class ICUThreadedOpenCloseFunction : public UPerfFunction{
+private:
+    static const char *const *getNames(int32_t &count){
+        static const char *const names[]={
+            "ibm-1047", "shift_jis", "windows-1252", "gb18030", "iso-8859-1", "utf-8"
+        };
+        count=(int32_t)LENGTHOF(names);
+        return names;
+    }
+    static DWORD WINAPI openClose(LPVOID param){
+        int32_t count, idx;
+        const char *const *names=getNames(count);
+        UErrorCode status=U_ZERO_ERROR;
+        for (idx = 0; idx < OPEN_CLOSE_LOOP_COUNT; idx++) {
+            ucnv_close(ucnv_open(names[(idx + (int32_t)(size_t)param) % count], &status));
+        }
+        return U_FAILURE(status) ? 1 : 0;
+    }
+public:
+    ICUThreadedOpenCloseFunction(UErrorCode& status){
+        int32_t count, idx;
+        const char *const *names=getNames(count);
+        /* load the converters into the cache */
+        for (idx = 0; idx < count; idx++) {
+            ucnv_close(ucnv_open(names[idx], &status));
+        }
+    }
+    virtual void call(UErrorCode* status){
+        HANDLE threads[OPEN_CLOSE_THREAD_COUNT];
+        DWORD exitCode;
+        int32_t idx;
+        for (idx = 0; idx < OPEN_CLOSE_THREAD_COUNT; idx++) {
+            threads[idx] = CreateThread(NULL, 0, openClose, (LPVOID)(size_t)idx, 0, NULL);
+            if (threads[idx] == NULL) {
+                *status = U_INTERNAL_PROGRAM_ERROR;
+                break;
+            }
+        }
+        WaitForMultipleObjects(idx, threads, TRUE, INFINITE);
+        while (idx > 0) {
+            --idx;
+            if (GetExitCodeThread(threads[idx], &exitCode) && exitCode != 0) {
+                *status = U_INTERNAL_PROGRAM_ERROR;
+            }
+            CloseHandle(threads[idx]);
+        }
+    }
+    virtual long getOperationsPerIteration(void){
+        return OPEN_CLOSE_THREAD_COUNT * OPEN_CLOSE_LOOP_COUNT;
+    }
+};
+
 class WinANSIToUnicodePerfFunction : public UPerfFunction{
 
 private:
@@ -496,6 +555,7 @@ public:
     
     UPerfFunction* TestICU_CleanOpenAllConverters();
     UPerfFunction* TestICU_OpenAllConverters();
+    UPerfFunction* TestICU_ThreadedOpenClose();
 
     UPerfFunction* TestICU_UTF8_ToUnicode();
     UPerfFunction* TestICU_UTF8_FromUnicode();
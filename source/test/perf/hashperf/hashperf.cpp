@@ -0,0 +1,555 @@
+/*
+ **********************************************************************
+ *   Copyright (C) 2014, International Business Machines
+ *   Corporation and others.  All Rights Reserved.
+ **********************************************************************
+ *  file name:  hashperf.cpp
+ *  encoding:   US-ASCII
+ *  tab size:   8 (not used)
+ *  indentation:4
+ *
+ *  created on: 2014jun20
+ *
+ *  Performance test program for UHashtable: lookup and insert throughput
+ *  of the uhash.c table with its 16-slot control byte groups, compared with
+ *  a copy of the double-hashing table that uhash.c used up to ICU 53.
+ *
+ *  Also compares the sampling uhash_hashChars() with the word-at-a-time
+ *  uhash_fastHashChars() on locale IDs, converter names and aliases,
+ *  and resource paths, and prints how many of those keys share
+ *  their hash code with another key.
+ *
+ * Usage from within <ICU build tree>/test/perf/hashperf/ :
+ * (Linux)
+ *  make
+ *  export LD_LIBRARY_PATH=../../../lib:../../../stubdata:../../../tools/ctestfw
+ *  ./hashperf --passes 3 --iterations 100
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "unicode/ucnv.h"
+#include "unicode/uloc.h"
+#include "unicode/uperf.h"
+#include "cmemory.h"
+#include "cstring.h"
+#include "toolutil.h"
+#include "uhash.h"
+
+// Number of keys in each table.
+static const int32_t KEY_COUNT = 20000;
+
+// Test object.
+class HashPerfTest : public UPerfTest {
+public:
+    HashPerfTest(int32_t argc, const char *argv[], UErrorCode &status)
+            : UPerfTest(argc, argv, NULL, 0, "", status),
+              names(NULL), missNames(NULL) {
+        if(U_FAILURE(status)) {
+            return;
+        }
+        // Locale-ID-like string keys, as in the resource bundle and converter caches,
+        // and the same number of similar keys that are not in the tables.
+        names=new char *[KEY_COUNT];
+        missNames=new char *[KEY_COUNT];
+        for(int32_t i=0; i<KEY_COUNT; ++i) {
+            char buffer[32];
+            sprintf(buffer, "xx_%c%c_%d", 'A'+(i%26), 'A'+((i/26)%26), (int)i);
+            names[i]=uprv_strdup(buffer);
+            buffer[0]='y';
+            missNames[i]=uprv_strdup(buffer);
+        }
+    }
+    virtual ~HashPerfTest() {
+        for(int32_t i=0; names!=NULL && i<KEY_COUNT; ++i) {
+            uprv_free(names[i]);
+            uprv_free(missNames[i]);
+        }
+        delete[] names;
+        delete[] missNames;
+    }
+
+    virtual UPerfFunction *runIndexedTest(int32_t index, UBool exec, const char *&name, char *par=NULL);
+
+    const char *getName(int32_t i) const { return names[i]; }
+    const char *getMissName(int32_t i) const { return missNames[i]; }
+
+private:
+    char **names;
+    char **missNames;
+};
+
+// Similar to the ICU 53 uhash.c double hashing, without removal and shrinking:
+// Prime table lengths, a secondary hash for the probe increment,
+// and rehashing into the next prime when the table is half full.
+class DoubleHashtable {
+public:
+    DoubleHashtable(UHashFunction *keyHash, UKeyComparator *keyComp)
+            : keyHasher(keyHash), keyComparator(keyComp), elements(NULL), count(0) {
+        allocate(3);
+    }
+    ~DoubleHashtable() { uprv_free(elements); }
+
+    void *get(const void *key) const {
+        UHashTok tok;
+        tok.pointer=(void *)key;
+        return find(tok, keyHasher(tok))->value.pointer;
+    }
+    int32_t iget(int32_t key) const {
+        UHashTok tok;
+        tok.integer=key;
+        return find(tok, keyHasher(tok))->value.integer;
+    }
+    void put(void *key, void *value) {
+        UHashTok k, v;
+        k.pointer=key;
+        v.pointer=value;
+        putTok(k, v);
+    }
+    void iput(int32_t key, int32_t value) {
+        UHashTok k, v;
+        k.integer=key;
+        v.integer=value;
+        putTok(k, v);
+    }
+
+private:
+    enum { HASH_EMPTY=(int32_t)0x80000001 };
+
+    void allocate(int32_t newPrimeIndex) {
+        static const int32_t PRIMES[]={
+            13, 31, 61, 127, 251, 509, 1021, 2039, 4093, 8191, 16381, 32749,
+            65521, 131071, 262139, 524287, 1048573, 2097143, 4194301, 8388593
+        };
+        primeIndex=newPrimeIndex;
+        length=PRIMES[primeIndex];
+        elements=(UHashElement *)uprv_malloc(length*sizeof(UHashElement));
+        for(int32_t i=0; i<length; ++i) {
+            elements[i].key.pointer=NULL;
+            elements[i].value.pointer=NULL;
+            elements[i].hashcode=HASH_EMPTY;
+        }
+        count=0;
+    }
+
+    UHashElement *find(UHashTok key, int32_t hashcode) const {
+        hashcode&=0x7fffffff;
+        int32_t startIndex, theIndex;
+        startIndex=theIndex=(hashcode^0x4000000)%length;
+        int32_t jump=0;
+        do {
+            int32_t tableHash=elements[theIndex].hashcode;
+            if(tableHash==hashcode) {
+                if(keyComparator(key, elements[theIndex].key)) {
+                    break;
+                }
+            } else if(tableHash==HASH_EMPTY) {
+                break;
+            }
+            if(jump==0) {
+                jump=(hashcode%(length-1))+1;
+            }
+            theIndex=(theIndex+jump)%length;
+        } while(theIndex!=startIndex);
+        return elements+theIndex;
+    }
+
+    void putTok(UHashTok key, UHashTok value) {
+        if(count>length/2) {
+            UHashElement *old=elements;
+            int32_t oldLength=length;
+            allocate(primeIndex+1);
+            for(int32_t i=0; i<oldLength; ++i) {
+                if(old[i].hashcode>=0) {
+                    *find(old[i].key, old[i].hashcode)=old[i];
+                    ++count;
+                }
+            }
+            uprv_free(old);
+        }
+        int32_t hashcode=keyHasher(key)&0x7fffffff;
+        UHashElement *e=find(key, hashcode);
+        if(e->hashcode!=hashcode) {
+            ++count;
+        }
+        e->key=key;
+        e->value=value;
+        e->hashcode=hashcode;
+    }
+
+    UHashFunction *keyHasher;
+    UKeyComparator *keyComparator;
+    UHashElement *elements;
+    int32_t length;
+    int32_t primeIndex;
+    int32_t count;
+};
+
+// Performance test function objects.
+class HashPerfFunction : public UPerfFunction {
+public:
+    HashPerfFunction(const HashPerfTest &perfTest) : perf(perfTest), checksum(0) {}
+    virtual ~HashPerfFunction() {}
+
+    virtual long getOperationsPerIteration() {
+        return KEY_COUNT;
+    }
+
+protected:
+    const HashPerfTest &perf;
+    int32_t checksum;  // Keeps the compiler from optimizing the lookups away.
+};
+
+// Inserts all string keys into a new table.
+class UHashCharsInsert : public HashPerfFunction {
+public:
+    UHashCharsInsert(const HashPerfTest &perfTest) : HashPerfFunction(perfTest) {}
+    virtual void call(UErrorCode *pErrorCode) {
+        UHashtable *hash=uhash_open(uhash_hashChars, uhash_compareChars, NULL, pErrorCode);
+        for(int32_t i=0; i<KEY_COUNT; ++i) {
+            uhash_puti(hash, (void *)perf.getName(i), i+1, pErrorCode);
+        }
+        checksum+=uhash_count(hash);
+        uhash_close(hash);
+    }
+};
+
+class DoubleHashCharsInsert : public HashPerfFunction {
+public:
+    DoubleHashCharsInsert(const HashPerfTest &perfTest) : HashPerfFunction(perfTest) {}
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        DoubleHashtable hash(uhash_hashChars, uhash_compareChars);
+        for(int32_t i=0; i<KEY_COUNT; ++i) {
+            hash.put((void *)perf.getName(i), (void *)perf.getName(i));
+        }
+        checksum+=hash.get(perf.getName(0))!=NULL;
+    }
+};
+
+// Looks up all string keys, and as many absent ones.
+class UHashCharsLookup : public HashPerfFunction {
+public:
+    UHashCharsLookup(const HashPerfTest &perfTest) : HashPerfFunction(perfTest) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        hash=uhash_open(uhash_hashChars, uhash_compareChars, NULL, &errorCode);
+        for(int32_t i=0; i<KEY_COUNT; ++i) {
+            uhash_put(hash, (void *)perf.getName(i), (void *)perf.getName(i), &errorCode);
+        }
+    }
+    virtual ~UHashCharsLookup() {
+        uhash_close(hash);
+    }
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        for(int32_t i=0; i<KEY_COUNT; ++i) {
+            checksum+=uhash_get(hash, perf.getName(i))!=NULL;
+            checksum+=uhash_get(hash, perf.getMissName(i))!=NULL;
+        }
+    }
+    virtual long getOperationsPerIteration() {
+        return 2*KEY_COUNT;
+    }
+private:
+    UHashtable *hash;
+};
+
+class DoubleHashCharsLookup : public HashPerfFunction {
+public:
+    DoubleHashCharsLookup(const HashPerfTest &perfTest)
+            : HashPerfFunction(perfTest), hash(uhash_hashChars, uhash_compareChars) {
+        for(int32_t i=0; i<KEY_COUNT; ++i) {
+            hash.put((void *)perf.getName(i), (void *)perf.getName(i));
+        }
+    }
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        for(int32_t i=0; i<KEY_COUNT; ++i) {
+            checksum+=hash.get(perf.getName(i))!=NULL;
+            checksum+=hash.get(perf.getMissName(i))!=NULL;
+        }
+    }
+    virtual long getOperationsPerIteration() {
+        return 2*KEY_COUNT;
+    }
+private:
+    DoubleHashtable hash;
+};
+
+// Integer keys with uhash_hashLong(), which hashes a key to itself.
+// Every 7th key is looked up, so that most lookups miss.
+// Without scattering, the keys are dense and consecutive lookups
+// touch neighboring slots of the old table.
+static inline int32_t longKey(int32_t i, UBool scatter) {
+    if(scatter) {
+        return (int32_t)((uint32_t)(i/7)*0x9e3779b1u+(uint32_t)(i%7));
+    } else {
+        return i;
+    }
+}
+
+class UHashLongLookup : public HashPerfFunction {
+public:
+    UHashLongLookup(const HashPerfTest &perfTest, UBool scatterKeys)
+            : HashPerfFunction(perfTest), scatter(scatterKeys) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        hash=uhash_open(uhash_hashLong, uhash_compareLong, NULL, &errorCode);
+        for(int32_t i=0; i<KEY_COUNT; ++i) {
+            uhash_iputi(hash, longKey(i*7, scatter), i+1, &errorCode);
+        }
+    }
+    virtual ~UHashLongLookup() {
+        uhash_close(hash);
+    }
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        for(int32_t i=0; i<7*KEY_COUNT; ++i) {
+            checksum+=uhash_igeti(hash, longKey(i, scatter));
+        }
+    }
+    virtual long getOperationsPerIteration() {
+        return 7*KEY_COUNT;
+    }
+private:
+    UHashtable *hash;
+    UBool scatter;
+};
+
+class DoubleHashLongLookup : public HashPerfFunction {
+public:
+    DoubleHashLongLookup(const HashPerfTest &perfTest, UBool scatterKeys)
+            : HashPerfFunction(perfTest), hash(uhash_hashLong, uhash_compareLong),
+              scatter(scatterKeys) {
+        for(int32_t i=0; i<KEY_COUNT; ++i) {
+            hash.iput(longKey(i*7, scatter), i+1);
+        }
+    }
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        for(int32_t i=0; i<7*KEY_COUNT; ++i) {
+            checksum+=hash.iget(longKey(i, scatter));
+        }
+    }
+    virtual long getOperationsPerIteration() {
+        return 7*KEY_COUNT;
+    }
+private:
+    DoubleHashtable hash;
+    UBool scatter;
+};
+
+// Hashes a set of real keys with one hash function.
+class StringHashFunction : public UPerfFunction {
+public:
+    enum KeySet { LOCALE_IDS, CONVERTER_NAMES, RESOURCE_PATHS };
+
+    StringHashFunction(KeySet keySet, UHashFunction *hashFunction)
+            : hasher(hashFunction), keys(NULL), ownedKeys(NULL), count(0), checksum(0) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        int32_t i;
+        switch(keySet) {
+        case LOCALE_IDS:
+            count=uloc_countAvailable();
+            keys=new const char *[count];
+            for(i=0; i<count; ++i) {
+                keys[i]=uloc_getAvailable(i);
+            }
+            break;
+        case CONVERTER_NAMES: {
+            int32_t cnvCount=ucnv_countAvailable();
+            int32_t capacity=0;
+            for(i=0; i<cnvCount; ++i) {
+                capacity+=ucnv_countAliases(ucnv_getAvailableName(i), &errorCode);
+            }
+            keys=new const char *[capacity];
+            for(i=0; i<cnvCount; ++i) {
+                const char *name=ucnv_getAvailableName(i);
+                int32_t aliasCount=ucnv_countAliases(name, &errorCode);
+                for(uint16_t j=0; j<aliasCount && count<capacity; ++j) {
+                    keys[count++]=ucnv_getAlias(name, j, &errorCode);
+                }
+            }
+            break;
+        }
+        case RESOURCE_PATHS: {
+            // Keys longer than 63 characters with a long common prefix,
+            // like a data path plus a resource path.
+            // uhash_hashChars() samples only every other character of these.
+            static const char *const widths[]={ "abbreviated", "narrow", "short", "wide" };
+            count=uloc_countAvailable()*8;
+            keys=new const char *[count];
+            ownedKeys=new char *[count];
+            for(i=0; i<count; ++i) {
+                char buffer[128];
+                sprintf(buffer, "/usr/share/icu/53.1/icudt53l/calendar/gregorian/dayNames/%s/%s/%s",
+                        (i&4)!=0 ? "format" : "stand-alone", widths[i&3],
+                        uloc_getAvailable(i/8));
+                keys[i]=ownedKeys[i]=uprv_strdup(buffer);
+            }
+            break;
+        }
+        }
+        printCollisions();
+    }
+    virtual ~StringHashFunction() {
+        for(int32_t i=0; ownedKeys!=NULL && i<count; ++i) {
+            uprv_free(ownedKeys[i]);
+        }
+        delete[] ownedKeys;
+        delete[] keys;
+    }
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        UHashTok key;
+        for(int32_t i=0; i<count; ++i) {
+            key.pointer=(void *)keys[i];
+            checksum+=hasher(key);
+        }
+    }
+    virtual long getOperationsPerIteration() {
+        return count;
+    }
+
+private:
+    static int U_CALLCONV compareHashes(const void *left, const void *right) {
+        int32_t l=*(const int32_t *)left, r=*(const int32_t *)right;
+        return l<r ? -1 : l>r ? 1 : 0;
+    }
+
+    // Counts the keys whose hash codes are not unique.
+    // Aliases can be listed for several converters; only distinct keys count.
+    void printCollisions() {
+        int32_t *hashes=new int32_t[count];
+        int32_t distinctKeys=0;
+        UErrorCode errorCode=U_ZERO_ERROR;
+        UHashtable *seen=uhash_open(uhash_hashChars, uhash_compareChars, NULL, &errorCode);
+        int32_t i;
+        for(i=0; i<count; ++i) {
+            UHashTok key;
+            key.pointer=(void *)keys[i];
+            if(uhash_get(seen, keys[i])==NULL) {
+                uhash_put(seen, (void *)keys[i], (void *)keys[i], &errorCode);
+                hashes[distinctKeys++]=hasher(key);
+            }
+        }
+        uhash_close(seen);
+        qsort(hashes, distinctKeys, sizeof(int32_t), compareHashes);
+        int32_t colliding=0;
+        for(i=0; i<distinctKeys; ++i) {
+            if((i>0 && hashes[i]==hashes[i-1]) || (i+1<distinctKeys && hashes[i]==hashes[i+1])) {
+                ++colliding;
+            }
+        }
+        printf("%ld keys, %ld share their hash code\n", (long)distinctKeys, (long)colliding);
+        delete[] hashes;
+    }
+
+    UHashFunction *hasher;
+    const char **keys;
+    char **ownedKeys;
+    int32_t count;
+    int32_t checksum;
+};
+
+UPerfFunction *HashPerfTest::runIndexedTest(int32_t index, UBool exec,
+                                            const char *&name, char * /*par*/) {
+    switch(index) {
+    case 0:
+        name="uhashcharsinsert";
+        if(exec) {
+            return new UHashCharsInsert(*this);
+        }
+        break;
+    case 1:
+        name="doublehashcharsinsert";
+        if(exec) {
+            return new DoubleHashCharsInsert(*this);
+        }
+        break;
+    case 2:
+        name="uhashcharslookup";
+        if(exec) {
+            return new UHashCharsLookup(*this);
+        }
+        break;
+    case 3:
+        name="doublehashcharslookup";
+        if(exec) {
+            return new DoubleHashCharsLookup(*this);
+        }
+        break;
+    case 4:
+        name="uhashlonglookup";
+        if(exec) {
+            return new UHashLongLookup(*this, FALSE);
+        }
+        break;
+    case 5:
+        name="doublehashlonglookup";
+        if(exec) {
+            return new DoubleHashLongLookup(*this, FALSE);
+        }
+        break;
+    case 6:
+        name="uhashscatteredlonglookup";
+        if(exec) {
+            return new UHashLongLookup(*this, TRUE);
+        }
+        break;
+    case 7:
+        name="doublehashscatteredlonglookup";
+        if(exec) {
+            return new DoubleHashLongLookup(*this, TRUE);
+        }
+        break;
+    case 8:
+        name="hashcharslocales";
+        if(exec) {
+            return new StringHashFunction(StringHashFunction::LOCALE_IDS, uhash_hashChars);
+        }
+        break;
+    case 9:
+        name="fasthashcharslocales";
+        if(exec) {
+            return new StringHashFunction(StringHashFunction::LOCALE_IDS, uhash_fastHashChars);
+        }
+        break;
+    case 10:
+        name="hashcharsconverters";
+        if(exec) {
+            return new StringHashFunction(StringHashFunction::CONVERTER_NAMES, uhash_hashChars);
+        }
+        break;
+    case 11:
+        name="fasthashcharsconverters";
+        if(exec) {
+            return new StringHashFunction(StringHashFunction::CONVERTER_NAMES, uhash_fastHashChars);
+        }
+        break;
+    case 12:
+        name="hashcharspaths";
+        if(exec) {
+            return new StringHashFunction(StringHashFunction::RESOURCE_PATHS, uhash_hashChars);
+        }
+        break;
+    case 13:
+        name="fasthashcharspaths";
+        if(exec) {
+            return new StringHashFunction(StringHashFunction::RESOURCE_PATHS, uhash_fastHashChars);
+        }
+        break;
+    default:
+        name="";
+        break;
+    }
+    return NULL;
+}
+
+int main(int argc, const char *argv[]) {
+    IcuToolErrorCode errorCode("hashperf main()");
+    HashPerfTest test(argc, argv, errorCode);
+    if(errorCode.isFailure()) {
+        fprintf(stderr, "HashPerfTest() failed: %s\n", errorCode.errorName());
+        test.usage();
+        return errorCode.reset();
+    }
+    if(!test.run()) {
+        fprintf(stderr, "FAILED: Tests could not be run, please check the arguments.\n");
+        return -1;
+    }
+    return 0;
+}
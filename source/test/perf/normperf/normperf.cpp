@@ -12,6 +12,7 @@
  * c:\normperf.exe -s C:\work\ICUCupertinoRep\icu4c\collation-perf-data  -i 10 -p 15 -f TestNames_Asian.txt -u -e UTF-8  -l
  */
 #include "normperf.h"
+#include "unicode/uclean.h"
 #include "uoptions.h"
 #include <stdio.h>
 
@@ -63,6 +64,14 @@ UPerfFunction* NormalizerPerformanceTest::runIndexedTest(int32_t index, UBool ex
         TESTCASE(31,TestIsNormalized_FCD_NFC_Text);
         TESTCASE(32,TestIsNormalized_FCD_Orig_Text);
 
+        TESTCASE(33,TestNorm2_NFC_ToBuffer_Orig_Text);
+        TESTCASE(34,TestNorm2_NFC_Preflight_Orig_Text);
+        TESTCASE(35,TestNorm2_NFC_ToString_Orig_Text);
+
+        TESTCASE(36,TestNorm2_NFD_ToBuffer_Orig_Text);
+        TESTCASE(37,TestNorm2_NFD_Preflight_Orig_Text);
+        TESTCASE(38,TestNorm2_NFD_ToString_Orig_Text);
+
         default: 
             name = ""; 
             return NULL;
@@ -491,8 +500,70 @@ UPerfFunction* NormalizerPerformanceTest::TestIsNormalized_FCD_Orig_Text(){
     }
 }
 
+// Normalizer2 output and heap allocations
+UPerfFunction* NormalizerPerformanceTest::Norm2Test(const icu::Normalizer2* n2, Norm2Output output){
+    if(n2==NULL){
+        return NULL;
+    }
+    if(line_mode){
+        return new Norm2PerfFunction(n2, output, lines, numLines);
+    }else{
+        return new Norm2PerfFunction(n2, output, buffer, bufferLen);
+    }
+}
+UPerfFunction* NormalizerPerformanceTest::TestNorm2_NFC_ToBuffer_Orig_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return Norm2Test(icu::Normalizer2::getNFCInstance(status), NORM2_TO_BUFFER);
+}
+UPerfFunction* NormalizerPerformanceTest::TestNorm2_NFC_Preflight_Orig_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return Norm2Test(icu::Normalizer2::getNFCInstance(status), NORM2_PREFLIGHT);
+}
+UPerfFunction* NormalizerPerformanceTest::TestNorm2_NFC_ToString_Orig_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return Norm2Test(icu::Normalizer2::getNFCInstance(status), NORM2_TO_STRING);
+}
+UPerfFunction* NormalizerPerformanceTest::TestNorm2_NFD_ToBuffer_Orig_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return Norm2Test(icu::Normalizer2::getNFDInstance(status), NORM2_TO_BUFFER);
+}
+UPerfFunction* NormalizerPerformanceTest::TestNorm2_NFD_Preflight_Orig_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return Norm2Test(icu::Normalizer2::getNFDInstance(status), NORM2_PREFLIGHT);
+}
+UPerfFunction* NormalizerPerformanceTest::TestNorm2_NFD_ToString_Orig_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return Norm2Test(icu::Normalizer2::getNFDInstance(status), NORM2_TO_STRING);
+}
+
+int32_t gAllocationCount = 0;
+
+static void * U_CALLCONV
+countingAlloc(const void * /*context*/, size_t size){
+    ++gAllocationCount;
+    return malloc(size);
+}
+
+static void * U_CALLCONV
+countingRealloc(const void * /*context*/, void *mem, size_t size){
+    ++gAllocationCount;
+    return realloc(mem, size);
+}
+
+static void U_CALLCONV
+countingFree(const void * /*context*/, void *mem){
+    free(mem);
+}
+
 int main(int argc, const char* argv[]){
     UErrorCode status = U_ZERO_ERROR;
+    // Count heap allocations, reported as the events of the Norm2 tests.
+    // This must be set up before ICU allocates any memory.
+    u_setMemoryFunctions(NULL, countingAlloc, countingRealloc, countingFree, &status);
+    if(U_FAILURE(status)){
+        fprintf(stderr, "u_setMemoryFunctions() failed: %s\n", u_errorName(status));
+        return status;
+    }
     NormalizerPerformanceTest test(argc, argv, status);
     if(U_FAILURE(status)){
         return status;
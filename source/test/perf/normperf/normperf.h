@@ -8,6 +8,7 @@
 #ifndef _NORMPERF_H
 #define _NORMPERF_H
 
+#include "unicode/normalizer2.h"
 #include "unicode/unorm.h"
 #include "unicode/ustring.h"
 
@@ -174,6 +175,83 @@ public:
 
 
 
+// Number of ICU heap allocations so far, counted via u_setMemoryFunctions() in main().
+extern int32_t gAllocationCount;
+
+enum Norm2Output {
+    NORM2_TO_BUFFER,     // Normalizer2::normalizeToBuffer() into a large enough buffer
+    NORM2_PREFLIGHT,     // Normalizer2::normalizeToBuffer() with capacity 0
+    NORM2_TO_STRING      // Normalizer2::normalize() into a UnicodeString
+};
+
+// Normalizes with a Normalizer2 instance and reports the number of
+// heap allocations in the last call() as its events.
+class Norm2PerfFunction : public UPerfFunction{
+private:
+    const icu::Normalizer2* norm2;
+    ULine* lines;
+    int32_t numLines;
+    ULine wholeText;
+    Norm2Output output;
+    UChar* pDest;
+    int32_t destLen;
+    icu::UnicodeString destString;
+    long allocations;
+
+public:
+    virtual void call(UErrorCode* status){
+        int32_t startCount = gAllocationCount;
+        for(int32_t i = 0; i< numLines; i++){
+            const UChar* src = lines[i].name;
+            int32_t srcLen = lines[i].len;
+            if(output == NORM2_TO_BUFFER){
+                norm2->normalizeToBuffer(src, srcLen, pDest, destLen, *status);
+            }else if(output == NORM2_PREFLIGHT){
+                UErrorCode preflightStatus = U_ZERO_ERROR;
+                norm2->normalizeToBuffer(src, srcLen, NULL, 0, preflightStatus);
+                if(preflightStatus != U_BUFFER_OVERFLOW_ERROR && U_FAILURE(preflightStatus)){
+                    *status = preflightStatus;
+                }
+            }else{
+                norm2->normalize(icu::UnicodeString(FALSE, src, srcLen), destString, *status);
+            }
+        }
+        allocations = gAllocationCount - startCount;
+    }
+    virtual long getOperationsPerIteration(){
+        int32_t totalChars=0;
+        for(int32_t i =0; i< numLines; i++){
+            totalChars+= lines[i].len;
+        }
+        return totalChars;
+    }
+    virtual long getEventsPerIteration(){
+        return allocations;
+    }
+    Norm2PerfFunction(const icu::Normalizer2* n2, Norm2Output out, ULine* srcLines, int32_t srcNumLines)
+            : norm2(n2), lines(srcLines), numLines(srcNumLines), output(out), allocations(0) {
+        int32_t maxLen = 0;
+        for(int32_t i =0; i< numLines; i++){
+            if(lines[i].len > maxLen){
+                maxLen = lines[i].len;
+            }
+        }
+        destLen = maxLen*3;
+        pDest = (UChar*) malloc(destLen * U_SIZEOF_UCHAR);
+    }
+    Norm2PerfFunction(const icu::Normalizer2* n2, Norm2Output out, UChar* source, int32_t sourceLen)
+            : norm2(n2), lines(&wholeText), numLines(1), output(out), allocations(0) {
+        wholeText.name = source;
+        wholeText.len = sourceLen;
+        destLen = sourceLen*3;
+        pDest = (UChar*) malloc(destLen * U_SIZEOF_UCHAR);
+    }
+    ~Norm2PerfFunction(){
+        free(pDest);
+    }
+};
+
+
 class  NormalizerPerformanceTest : public UPerfTest{
 private:
     ULine* NFDFileLines;
@@ -245,6 +323,18 @@ public:
     UPerfFunction* TestIsNormalized_FCD_NFC_Text();
     UPerfFunction* TestIsNormalized_FCD_Orig_Text();
 
+    /* Normalizer2 output and heap allocations */
+    UPerfFunction* TestNorm2_NFC_ToBuffer_Orig_Text();
+    UPerfFunction* TestNorm2_NFC_Preflight_Orig_Text();
+    UPerfFunction* TestNorm2_NFC_ToString_Orig_Text();
+
+    UPerfFunction* TestNorm2_NFD_ToBuffer_Orig_Text();
+    UPerfFunction* TestNorm2_NFD_Preflight_Orig_Text();
+    UPerfFunction* TestNorm2_NFD_ToString_Orig_Text();
+
+private:
+    UPerfFunction* Norm2Test(const icu::Normalizer2* n2, Norm2Output output);
+
 };
 
 //---------------------------------------------------------------------------------------
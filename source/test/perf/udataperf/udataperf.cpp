@@ -0,0 +1,109 @@
+/*
+*******************************************************************************
+*
+*   Copyright (C) 2014, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+*
+*******************************************************************************
+*   file name:  udataperf.cpp
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   created on: 2014oct16
+*
+*   Test startup performance of looking up many data items
+*   in the common data package, for a before-and-after comparison of
+*   the optional perfect hash ToC index (item <package>/tocindex.idx)
+*   versus the binary search over the item names.
+*
+*   Run with optional command-line arguments:
+*   The path to the ICU data directory, and the number of iterations.
+*
+*   To measure the binary search, run against a .dat package without
+*   the index, for example one written by an older icupkg, or one where
+*   the dataFormat of the tocindex.idx item has been patched so that
+*   the loader ignores it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "unicode/utypes.h"
+#include "unicode/putil.h"
+#include "unicode/uclean.h"
+#include "unicode/udata.h"
+#include "unicode/uloc.h"
+#include "unicode/ures.h"
+#include "unicode/utimer.h"
+
+// Open and close the .res item for each name; returns the number of items found.
+static int32_t openItems(const char *type, const char *const names[], int32_t count) {
+    int32_t found = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        UDataMemory *pData = udata_open(NULL, type, names[i], &errorCode);
+        if (U_SUCCESS(errorCode)) {
+            udata_close(pData);
+            ++found;
+        }
+    }
+    return found;
+}
+
+int main(int argc, const char *argv[]) {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    int32_t iterations = 100;
+
+    if (argc > 1) {
+        printf("u_setDataDirectory(%s)\n", argv[1]);
+        u_setDataDirectory(argv[1]);
+    }
+    if (argc > 2) {
+        iterations = atoi(argv[2]);
+    }
+
+    // Measure a cold start: the first time each locale bundle is opened.
+    int32_t count = uloc_countAvailable();
+    UTimer start_time;
+    utimer_getTime(&start_time);
+    for (int32_t i = 0; i < count; ++i) {
+        errorCode = U_ZERO_ERROR;
+        ures_close(ures_open(NULL, uloc_getAvailable(i), &errorCode));
+    }
+    double elapsed = utimer_getElapsedSeconds(&start_time);
+    printf("ures_open() of %d locales took %g seconds.\n", count, elapsed);
+
+    // Collect item names: every available locale once as a locale bundle
+    // and once as a collation tailoring, keeping only the ones that exist
+    // in the package, so that misses do not probe the file system.
+    const char **names = (const char **)malloc(2 * count * sizeof(const char *));
+    char (*collNames)[ULOC_FULLNAME_CAPACITY + 8] =
+        (char (*)[ULOC_FULLNAME_CAPACITY + 8])malloc(count * sizeof(*collNames));
+    if (names == NULL || collNames == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return U_MEMORY_ALLOCATION_ERROR;
+    }
+    int32_t nameCount = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        names[nameCount] = uloc_getAvailable(i);
+        nameCount += openItems("res", names + nameCount, 1);
+        sprintf(collNames[i], "coll/%s", uloc_getAvailable(i));
+        names[nameCount] = collNames[i];
+        nameCount += openItems("res", names + nameCount, 1);
+    }
+
+    // Measure repeated lookups of the same items.
+    int32_t found = 0;
+    utimer_getTime(&start_time);
+    for (int32_t n = 0; n < iterations; ++n) {
+        found += openItems("res", names, nameCount);
+    }
+    elapsed = utimer_getElapsedSeconds(&start_time);
+    printf("%d udata_open() of %d items took %g seconds = %g ns per open.\n",
+           found, nameCount, elapsed, elapsed * 1e9 / found);
+
+    free(collNames);
+    free(names);
+    u_cleanup();
+    return 0;
+}
@@ -41,6 +41,10 @@ my $tests = {
     "Roundtrip",      ["$p1,Roundtrip",        "$p2,Roundtrip"],
     "FromUnicode",    ["$p1,FromUnicode",      "$p2,FromUnicode"],
     "FromUTF8",       ["$p1,FromUTF8",         "$p2,FromUTF8"],
+    "ToUnicodeUTF8",  ["$p1,ToUnicodeUTF8",    "$p2,ToUnicodeUTF8"],
+    "StrFromUTF8",    ["$p1,StrFromUTF8",      "$p2,StrFromUTF8"],
+    "StrToUTF8",      ["$p1,StrToUTF8",        "$p2,StrToUTF8"],
+    "StrToUTF8Length",["$p1,StrToUTF8Length",  "$p2,StrToUTF8Length"],
 };
 
 my $dataFiles = {
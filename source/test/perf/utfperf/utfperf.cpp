@@ -1,6 +1,6 @@
 /*  
  **********************************************************************
- *   Copyright (C) 2002-2007, International Business Machines
+ *   Copyright (C) 2002-2014, International Business Machines
  *   Corporation and others.  All Rights Reserved.
  **********************************************************************
  *   file name:  utfperf.cpp
@@ -325,11 +325,197 @@ protected:
     int32_t input8Length;
 };
 
+// Test one-way conversion encoding->UTF-8.
+// MBCS converters convert directly to UTF-8 without the UTF-16 pivot where possible.
+class ToUTF8 : public Command {
+protected:
+    ToUTF8(const UtfPerformanceTest &testcase)
+            : Command(testcase),
+              utf8Cnv(NULL),
+              encoded(NULL), encodedInputLength(0) {
+        utf8Cnv=ucnv_open("UTF-8", &errorCode);
+        if (U_SUCCESS(errorCode)) {
+            encoded=new char[OUTPUT_CAPACITY];
+            encodedInputLength=ucnv_fromUChars(cnv, encoded, OUTPUT_CAPACITY, input, inputLength, &errorCode);
+        }
+    }
+public:
+    static UPerfFunction* get(const UtfPerformanceTest &testcase) {
+        ToUTF8 * t = new ToUTF8(testcase);
+        if (U_SUCCESS(t->errorCode)){
+            return t;
+        } else {
+            delete t;
+            return NULL;
+        }
+    }
+    ~ToUTF8() {
+        ucnv_close(utf8Cnv);
+        delete[] encoded;
+    }
+    virtual void call(UErrorCode* pErrorCode){
+        const char *pIn, *pInLimit;
+        char *pInter, *pInterLimit;
+        UChar *pivotSource, *pivotTarget, *pivotLimit;
+
+        ucnv_resetToUnicode(cnv);
+        ucnv_resetFromUnicode(utf8Cnv);
+
+        pIn=encoded;
+        pInLimit=encoded+encodedInputLength;
+
+        pInterLimit=intermediate+testcase.chunkLength;
+
+        pivotSource=pivotTarget=pivot;
+        pivotLimit=pivot+testcase.pivotLength;
+
+        encodedLength=0;
+
+        for(;;) {
+            pInter=intermediate;
+            ucnv_convertEx(utf8Cnv, cnv,
+                           &pInter, pInterLimit,
+                           &pIn, pInLimit,
+                           pivot, &pivotSource, &pivotTarget, pivotLimit,
+                           FALSE, TRUE, pErrorCode);
+            encodedLength+=(int32_t)(pInter-intermediate);
+
+            if(*pErrorCode==U_BUFFER_OVERFLOW_ERROR) {
+                /* make sure that we convert once more to really flush */
+                *pErrorCode=U_ZERO_ERROR;
+            } else if(U_FAILURE(*pErrorCode)) {
+                return;
+            } else {
+                break;  // all done
+            }
+        }
+    }
+protected:
+    UConverter *utf8Cnv;
+    char *encoded;
+    int32_t encodedInputLength;
+};
+
+// Test one-way conversion UTF-8->UTF-16 with the UTF-8 converter.
+// Events are UTF-8 input bytes, so that ns/event gives the byte throughput.
+class ToUnicodeUTF8 : public Command {
+protected:
+    ToUnicodeUTF8(const UtfPerformanceTest &testcase)
+            : Command(testcase),
+              utf8Cnv(NULL),
+              input8(utf8), input8Length(utf8Length) {
+        utf8Cnv=ucnv_open("UTF-8", &errorCode);
+    }
+public:
+    static UPerfFunction* get(const UtfPerformanceTest &testcase) {
+        ToUnicodeUTF8 * t = new ToUnicodeUTF8(testcase);
+        if (U_SUCCESS(t->errorCode)){
+            return t;
+        } else {
+            delete t;
+            return NULL;
+        }
+    }
+    ~ToUnicodeUTF8() {
+        ucnv_close(utf8Cnv);
+    }
+    virtual long getEventsPerIteration(){
+        return input8Length;
+    }
+    virtual void call(UErrorCode* pErrorCode){
+        const char *pIn=input8;
+        UChar *pOut=output;
+
+        ucnv_resetToUnicode(utf8Cnv);
+        ucnv_toUnicode(utf8Cnv, &pOut, output+OUTPUT_CAPACITY, &pIn, input8+input8Length, NULL, TRUE, pErrorCode);
+        outputLength=pOut-output;
+    }
+protected:
+    UConverter *utf8Cnv;
+    const char *input8;
+    int32_t input8Length;
+};
+
+// Test u_strFromUTF8WithSub(), UTF-8->UTF-16 without a converter object.
+class StrFromUTF8 : public Command {
+protected:
+    StrFromUTF8(const UtfPerformanceTest &testcase) : Command(testcase) {}
+public:
+    static UPerfFunction* get(const UtfPerformanceTest &testcase) {
+        StrFromUTF8 * t = new StrFromUTF8(testcase);
+        if (U_SUCCESS(t->errorCode)){
+            return t;
+        } else {
+            delete t;
+            return NULL;
+        }
+    }
+    virtual long getEventsPerIteration(){
+        return utf8Length;
+    }
+    virtual void call(UErrorCode* pErrorCode){
+        u_strFromUTF8WithSub(output, OUTPUT_CAPACITY, &outputLength,
+                             utf8, utf8Length, 0xfffd, NULL, pErrorCode);
+    }
+};
+
+// Test u_strToUTF8WithSub(), UTF-16->UTF-8 without a converter object.
+// Events are UTF-16 input code units.
+class StrToUTF8 : public Command {
+protected:
+    StrToUTF8(const UtfPerformanceTest &testcase) : Command(testcase) {}
+public:
+    static UPerfFunction* get(const UtfPerformanceTest &testcase) {
+        StrToUTF8 * t = new StrToUTF8(testcase);
+        if (U_SUCCESS(t->errorCode)){
+            return t;
+        } else {
+            delete t;
+            return NULL;
+        }
+    }
+    virtual long getEventsPerIteration(){
+        return inputLength;
+    }
+    virtual void call(UErrorCode* pErrorCode){
+        u_strToUTF8WithSub(intermediate, OUTPUT_CAPACITY, &encodedLength,
+                           input, inputLength, 0xfffd, NULL, pErrorCode);
+    }
+};
+
+// Test the length-only pass of u_strToUTF8WithSub() (preflighting).
+class StrToUTF8Length : public StrToUTF8 {
+protected:
+    StrToUTF8Length(const UtfPerformanceTest &testcase) : StrToUTF8(testcase) {}
+public:
+    static UPerfFunction* get(const UtfPerformanceTest &testcase) {
+        StrToUTF8Length * t = new StrToUTF8Length(testcase);
+        if (U_SUCCESS(t->errorCode)){
+            return t;
+        } else {
+            delete t;
+            return NULL;
+        }
+    }
+    virtual void call(UErrorCode* pErrorCode){
+        u_strToUTF8WithSub(NULL, 0, &encodedLength,
+                           input, inputLength, 0xfffd, NULL, pErrorCode);
+        if(*pErrorCode==U_BUFFER_OVERFLOW_ERROR) {
+            *pErrorCode=U_ZERO_ERROR;
+        }
+    }
+};
+
 UPerfFunction* UtfPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* par) {
     switch (index) {
         case 0: name = "Roundtrip";     if (exec) return Roundtrip::get(*this); break;
         case 1: name = "FromUnicode";   if (exec) return FromUnicode::get(*this); break;
         case 2: name = "FromUTF8";      if (exec) return FromUTF8::get(*this); break;
+        case 3: name = "ToUnicodeUTF8"; if (exec) return ToUnicodeUTF8::get(*this); break;
+        case 4: name = "StrFromUTF8";   if (exec) return StrFromUTF8::get(*this); break;
+        case 5: name = "StrToUTF8";     if (exec) return StrToUTF8::get(*this); break;
+        case 6: name = "StrToUTF8Length"; if (exec) return StrToUTF8Length::get(*this); break;
+        case 7: name = "ToUTF8";        if (exec) return ToUTF8::get(*this); break;
         default: name = ""; break;
     }
     return NULL;
@@ -31,6 +31,7 @@
 #include "swapimpl.h"
 #include "toolutil.h"
 #include "package.h"
+#include "pkg_gencmn.h"
 #include "cmemory.h"
 
 #include <stdio.h>
@@ -675,6 +676,9 @@ Package::readPackage(const char *filename) {
             // sort the item names for the local charset
             sortItems();
         }
+
+        // drop the ToC index; writePackage() creates a new one for the output item names
+        removeItem(findItem(UDATA_TOC_INDEX_NAME));
     }
 
     udata_closeSwapper(ds);
@@ -807,6 +811,9 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
         items[i].name=name;
     }
 
+    // add the ToC index item with a perfect hash of the output item names
+    addTOCIndex(prefix, prefixLength, outType, outIsBigEndian, outCharset, dsLocalToOut);
+
     // calculate offsets for item names and items, pad to 16-align items
     // align only the first item; each item's length is a multiple of 16
     basenameOffset=4+8*itemCount;
@@ -897,6 +904,68 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
     }
 }
 
+void
+Package::addTOCIndex(const char *prefix, int32_t prefixLength, char outType,
+                     UBool outIsBigEndian, uint8_t outCharset,
+                     UDataSwapper *dsLocalToOut) {
+    const char **names;
+    char *name;
+    uint8_t *data;
+    UErrorCode errorCode;
+    int32_t i, idx, nameLength, length;
+
+    // create the item name in the output charset
+    // the same way as for the other items
+    nameLength=(int32_t)strlen(UDATA_TOC_INDEX_NAME);
+    name=allocString(FALSE, prefixLength+nameLength);
+    memcpy(name, prefix, prefixLength);
+    memcpy(name+prefixLength, UDATA_TOC_INDEX_NAME, nameLength+1);
+    if(dsLocalToOut!=NULL) {
+        errorCode=U_ZERO_ERROR;
+        dsLocalToOut->swapInvChars(dsLocalToOut, name+prefixLength, nameLength, name+prefixLength, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            fprintf(stderr, "icupkg: swapInvChars(ToC index name) failed - %s\n", u_errorName(errorCode));
+            exit(errorCode);
+        }
+    }
+
+    // insert the item in sorted order
+    // (the items are sorted for the output charset by now)
+    for(idx=itemCount; idx>0 && strcmp(items[idx-1].name, name)>0; --idx) {}
+    if(idx>0 && strcmp(items[idx-1].name, name)==0) {
+        // replace an item that was added with the same name
+        removeItem(--idx);
+    }
+    ensureItemCapacity();
+    if(idx<itemCount) {
+        memmove(items+idx+1, items+idx, (itemCount-idx)*sizeof(Item));
+    }
+    ++itemCount;
+    memset(items+idx, 0, sizeof(Item));
+    items[idx].name=name;
+    items[idx].type=outType;
+
+    // build the index over all output item names, including its own
+    names=(const char **)malloc(itemCount*sizeof(const char *));
+    length=createTOCIndex(NULL, itemCount, outIsBigEndian, outCharset, NULL, 0);
+    data=(uint8_t *)malloc(length);
+    if(names==NULL || data==NULL) {
+        fprintf(stderr, "icupkg: unable to allocate memory for the ToC index\n");
+        exit(U_MEMORY_ALLOCATION_ERROR);
+    }
+    for(i=0; i<itemCount; ++i) {
+        names[i]=items[i].name;
+    }
+    if(createTOCIndex(names, itemCount, outIsBigEndian, outCharset, data, length)!=length) {
+        fprintf(stderr, "icupkg: unable to create the ToC index\n");
+        exit(U_INTERNAL_PROGRAM_ERROR);
+    }
+    free(names);
+    items[idx].data=data;
+    items[idx].length=length;
+    items[idx].isDataOwned=TRUE;
+}
+
 int32_t
 Package::findItem(const char *name, int32_t length) const {
     int32_t i, start, limit;
@@ -20,6 +20,7 @@
 #define __PACKAGE_H__
 
 #include "unicode/utypes.h"
+#include "udataswp.h"
 
 #include <stdio.h>
 
@@ -151,6 +152,10 @@ private:
      */
     char *allocString(UBool in, int32_t length);
 
+    void addTOCIndex(const char *prefix, int32_t prefixLength, char outType,
+                     UBool outIsBigEndian, uint8_t outCharset,
+                     UDataSwapper *dsLocalToOut);
+
     void sortItems();
 
     // data fields
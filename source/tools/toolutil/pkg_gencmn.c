@@ -16,6 +16,7 @@
 #include "unicode/uclean.h"
 #include "unewdata.h"
 #include "putilimp.h"
+#include "ucmndata.h"
 #include "pkg_gencmn.h"
 
 #define STRING_STORE_SIZE 200000
@@ -57,6 +58,13 @@ the length of the last item is the difference between its offset and
 the .dat file length, and the length of all previous items is the difference
 between its offset and the next one.
 
+4. optional ToC index
+
+Packages may contain an item named <package>/tocindex.idx with a minimal
+perfect hash of all item names (dataFormat="ToCH", see ucmndata.h).
+The loader uses it instead of the binary search over the item names.
+Readers that do not know about it treat it like any other item.
+
 ----------------------------------------------------------------------------- */
 
 /* UDataInfo cf. udata.h */
@@ -80,7 +88,7 @@ static char stringStore[STRING_STORE_SIZE];
 static uint32_t stringTop=0, basenameTotal=0;
 
 typedef struct {
-    char *pathname, *basename;
+    char *pathname, *basename;  /* pathname==NULL for the generated ToC index */
     uint32_t basenameLength, basenameOffset, fileSize, fileOffset;
 } File;
 
@@ -98,6 +106,12 @@ static char *symPrefix = NULL;
 static void
 addFile(const char *filename, const char *name, const char *source, UBool sourceTOC, UBool verbose);
 
+static void
+addTOCIndex(const char *name);
+
+static void
+writeTOCIndex(UNewDataMemory *out, uint32_t length);
+
 static char *
 allocString(uint32_t length);
 
@@ -214,6 +228,10 @@ createCommonDataFile(const char *destDir, const char *name, const char *entrypoi
         return;
     }
 
+    if(!sourceTOC) {
+        addTOCIndex(name);
+    }
+
     /* sort the files by basename */
     qsort(files, fileCount, sizeof(File), compareFiles);
 
@@ -263,6 +281,15 @@ createCommonDataFile(const char *destDir, const char *name, const char *entrypoi
                 udata_writePadding(out, 16-length);
             }
 
+            if(files[i].pathname==NULL) {
+                if (verbose) {
+                    printf("adding ToC index %s (%ld bytes)\n", files[i].basename, (long)files[i].fileSize);
+                }
+                writeTOCIndex(out, files[i].fileSize);
+                length=files[i].fileSize;
+                continue;
+            }
+
             if (verbose) {
                 printf("adding %s (%ld byte%s)\n", files[i].pathname, (long)files[i].fileSize, files[i].fileSize == 1 ? "" : "s");
             }
@@ -490,6 +517,220 @@ addFile(const char *filename, const char *name, const char *source, UBool source
     ++fileCount;
 }
 
+static void
+addTOCIndex(const char *name) {
+    uint32_t length;
+    char *s;
+
+    if(fileCount==fileMax) {
+      fileMax += CHUNK_FILE_COUNT;
+      files = uprv_realloc(files, fileMax*sizeof(files[0])); /* note: never freed. */
+      if(files==NULL) {
+        fprintf(stderr, "pkgdata/gencmn: Could not allocate %u bytes for %d files\n", (unsigned int)(fileMax*sizeof(files[0])), fileCount);
+        exit(U_MEMORY_ALLOCATION_ERROR);
+      }
+    }
+
+    /* store the basename; there is no file, the contents are generated */
+    length = (uint32_t)(uprv_strlen(name) + 1 + uprv_strlen(UDATA_TOC_INDEX_NAME) + 1);
+    s=allocString(length);
+    uprv_strcpy(s, name);
+    uprv_strcat(s, U_TREE_ENTRY_SEP_STRING);
+    uprv_strcat(s, UDATA_TOC_INDEX_NAME);
+    files[fileCount].basename=s;
+    files[fileCount].basenameLength=length;
+    files[fileCount].pathname=NULL;
+    basenameTotal+=length;
+    ++fileCount;
+
+    /* the index covers all items including itself */
+    files[fileCount-1].fileSize=(uint32_t)createTOCIndex(NULL, (int32_t)fileCount,
+                                                         U_IS_BIG_ENDIAN, U_CHARSET_FAMILY, NULL, 0);
+}
+
+static void
+writeTOCIndex(UNewDataMemory *out, uint32_t length) {
+    const char **names;
+    uint8_t *index;
+    uint32_t i;
+
+    names=(const char **)uprv_malloc(fileCount*sizeof(const char *));
+    index=(uint8_t *)uprv_malloc(length);
+    if(names==NULL || index==NULL) {
+        fprintf(stderr, "gencmn: unable to allocate memory for the ToC index\n");
+        exit(U_MEMORY_ALLOCATION_ERROR);
+    }
+    for(i=0; i<fileCount; ++i) {
+        names[i]=files[i].basename;
+    }
+    if((uint32_t)createTOCIndex(names, (int32_t)fileCount, U_IS_BIG_ENDIAN, U_CHARSET_FAMILY,
+                                index, (int32_t)length)!=length) {
+        fprintf(stderr, "gencmn: unable to create the ToC index\n");
+        exit(U_INTERNAL_PROGRAM_ERROR);
+    }
+    udata_writeBlock(out, index, length);
+    uprv_free(index);
+    uprv_free(names);
+}
+
+static void
+writeUInt32(uint8_t *p, uint32_t x, UBool isBigEndian) {
+    if(isBigEndian) {
+        p[0]=(uint8_t)(x>>24);
+        p[1]=(uint8_t)(x>>16);
+        p[2]=(uint8_t)(x>>8);
+        p[3]=(uint8_t)x;
+    } else {
+        p[0]=(uint8_t)x;
+        p[1]=(uint8_t)(x>>8);
+        p[2]=(uint8_t)(x>>16);
+        p[3]=(uint8_t)(x>>24);
+    }
+}
+
+/* maximum number of displacement values to try for one hash bucket */
+#define TOC_INDEX_MAX_DISPLACEMENT 0x100000
+
+U_CAPI int32_t U_EXPORT2
+createTOCIndex(const char *const names[], int32_t count,
+               UBool isBigEndian, uint8_t charsetFamily,
+               uint8_t *dest, int32_t capacity) {
+    /* one bucket per name keeps the displacement search short */
+    int32_t bucketCount=count;
+    /* 32-byte data header, then count, bucketCount, displacements and entry indexes */
+    int32_t length=(32+4*(UDATA_TOC_INDEX_DISPLACEMENTS+bucketCount+count)+15)&~0xf;
+    uint32_t *displacements, *entries, *nameBuckets, *slots;
+    int32_t *bucketStarts, *members;
+    uint8_t *isTaken;
+    int32_t i, j, k, b, size, maxBucketSize;
+    uint32_t d;
+
+    if(dest==NULL || count<=0) {
+        return length;
+    }
+    if(capacity<length) {
+        return 0;
+    }
+
+    displacements=(uint32_t *)uprv_malloc(bucketCount*4);
+    entries=(uint32_t *)uprv_malloc(count*4);
+    nameBuckets=(uint32_t *)uprv_malloc(count*4);
+    slots=(uint32_t *)uprv_malloc(count*4);
+    bucketStarts=(int32_t *)uprv_malloc((bucketCount+1)*4);
+    members=(int32_t *)uprv_malloc(count*4);
+    isTaken=(uint8_t *)uprv_malloc(count);
+    if( displacements==NULL || entries==NULL || nameBuckets==NULL || slots==NULL ||
+        bucketStarts==NULL || members==NULL || isTaken==NULL
+    ) {
+        fprintf(stderr, "gencmn: unable to allocate memory for the ToC index\n");
+        exit(U_MEMORY_ALLOCATION_ERROR);
+    }
+    uprv_memset(displacements, 0, bucketCount*4);
+    uprv_memset(isTaken, 0, count);
+
+    /* distribute the names into buckets, and list the members of each bucket */
+    uprv_memset(bucketStarts, 0, (bucketCount+1)*4);
+    for(i=0; i<count; ++i) {
+        nameBuckets[i]=udata_hashTOCEntryName(names[i], 0)%(uint32_t)bucketCount;
+        ++bucketStarts[nameBuckets[i]+1];
+    }
+    maxBucketSize=0;
+    for(b=0; b<bucketCount; ++b) {
+        if(bucketStarts[b+1]>maxBucketSize) {
+            maxBucketSize=bucketStarts[b+1];
+        }
+        bucketStarts[b+1]+=bucketStarts[b];
+    }
+    /* fill each bucket from its limit down; this moves bucketStarts[b+1] to the start of bucket b */
+    for(i=count; i>0;) {
+        --i;
+        members[--bucketStarts[nameBuckets[i]+1]]=i;
+    }
+    for(b=0; b<bucketCount; ++b) {
+        bucketStarts[b]=bucketStarts[b+1];
+    }
+    bucketStarts[bucketCount]=count;
+
+    /*
+     * Hash and displace: Place the largest buckets first, each with the
+     * smallest displacement for which all of its names hash to distinct free slots.
+     */
+    for(size=maxBucketSize; size>0; --size) {
+        for(b=0; b<bucketCount; ++b) {
+            int32_t start=bucketStarts[b];
+            if((bucketStarts[b+1]-start)!=size) {
+                continue;
+            }
+            for(d=1; d<TOC_INDEX_MAX_DISPLACEMENT; ++d) {
+                for(j=0; j<size; ++j) {
+                    slots[j]=udata_hashTOCEntryName(names[members[start+j]], d)%(uint32_t)count;
+                    if(isTaken[slots[j]]) {
+                        break;
+                    }
+                    for(k=0; k<j && slots[k]!=slots[j]; ++k) {}
+                    if(k<j) {
+                        break;
+                    }
+                }
+                if(j==size) {
+                    break;
+                }
+            }
+            if(d==TOC_INDEX_MAX_DISPLACEMENT) {
+                length=0;
+                goto cleanup;
+            }
+            displacements[b]=d;
+            for(j=0; j<size; ++j) {
+                isTaken[slots[j]]=1;
+                entries[slots[j]]=(uint32_t)members[start+j];
+            }
+        }
+    }
+
+    /* write the data header */
+    uprv_memset(dest, 0, 32);
+    if(isBigEndian) {
+        dest[1]=32;             /* headerSize */
+        dest[5]=(uint8_t)sizeof(UDataInfo);
+    } else {
+        dest[0]=32;
+        dest[4]=(uint8_t)sizeof(UDataInfo);
+    }
+    dest[2]=0xda;               /* magic */
+    dest[3]=0x27;
+    dest[8]=isBigEndian;
+    dest[9]=charsetFamily;
+    dest[10]=U_SIZEOF_UCHAR;
+    dest[12]=0x54;              /* dataFormat="ToCH" */
+    dest[13]=0x6f;
+    dest[14]=0x43;
+    dest[15]=0x48;
+    dest[16]=1;                 /* formatVersion */
+
+    /* write the index */
+    writeUInt32(dest+32, (uint32_t)count, isBigEndian);
+    writeUInt32(dest+36, (uint32_t)bucketCount, isBigEndian);
+    for(b=0; b<bucketCount; ++b) {
+        writeUInt32(dest+40+4*b, displacements[b], isBigEndian);
+    }
+    for(i=0; i<count; ++i) {
+        writeUInt32(dest+40+4*(bucketCount+i), entries[i], isBigEndian);
+    }
+    i=40+4*(bucketCount+count);
+    uprv_memset(dest+i, 0, length-i);
+
+cleanup:
+    uprv_free(displacements);
+    uprv_free(entries);
+    uprv_free(nameBuckets);
+    uprv_free(slots);
+    uprv_free(bucketStarts);
+    uprv_free(members);
+    uprv_free(isTaken);
+    return length;
+}
+
 static char *
 allocString(uint32_t length) {
     uint32_t top=stringTop+length;
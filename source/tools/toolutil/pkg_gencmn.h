@@ -13,4 +13,21 @@ U_CAPI void U_EXPORT2
 createCommonDataFile(const char *destDir, const char *name, const char *entrypointName, const char *type, const char *source, const char *copyRight,
                      const char *dataFile, uint32_t max_size, UBool sourceTOC, UBool verbose, char *gencmnFileName);
 
+/**
+ * Create the optional ToC index item for a .dat package:
+ * a minimal perfect hash of the full item names (see ucmndata.h).
+ * The names must include the one for the index item itself,
+ * in the same order as in the package ToC.
+ *
+ * Writes the item with its ICU data header in the requested byte order
+ * and charset family, padded to a multiple of 16 bytes.
+ * With dest==NULL, only returns the length.
+ *
+ * @return the length of the item, or 0 if no perfect hash was found
+ */
+U_CAPI int32_t U_EXPORT2
+createTOCIndex(const char *const names[], int32_t count,
+               UBool isBigEndian, uint8_t charsetFamily,
+               uint8_t *dest, int32_t capacity);
+
 #endif
@@ -699,6 +699,81 @@ test_swap(const UDataSwapper *ds,
     return headerSize+size;
 }
 
+/* Swap the optional .dat package ToC index, see ucmndata.h */
+static int32_t U_CALLCONV
+tocindex_swap(const UDataSwapper *ds,
+              const void *inData, int32_t length, void *outData,
+              UErrorCode *pErrorCode) {
+    const UDataInfo *pInfo;
+    int32_t headerSize;
+
+    const uint8_t *inBytes;
+    uint8_t *outBytes;
+
+    int32_t count, bucketCount, size;
+
+    /* udata_swapDataHeader checks the arguments */
+    headerSize=udata_swapDataHeader(ds, inData, length, outData, pErrorCode);
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+
+    /* check data format and format version */
+    pInfo=(const UDataInfo *)((const char *)inData+4);
+    if(!(
+        pInfo->dataFormat[0]==0x54 &&   /* dataFormat="ToCH" */
+        pInfo->dataFormat[1]==0x6f &&
+        pInfo->dataFormat[2]==0x43 &&
+        pInfo->dataFormat[3]==0x48 &&
+        pInfo->formatVersion[0]==1
+    )) {
+        udata_printError(ds, "tocindex_swap(): data format %02x.%02x.%02x.%02x (format version %02x) is not recognized as a .dat package ToC index\n",
+                         pInfo->dataFormat[0], pInfo->dataFormat[1],
+                         pInfo->dataFormat[2], pInfo->dataFormat[3],
+                         pInfo->formatVersion[0]);
+        *pErrorCode=U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+
+    inBytes=(const uint8_t *)inData+headerSize;
+    outBytes=(uint8_t *)outData+headerSize;
+
+    if(length>=0) {
+        length-=headerSize;
+        if(length<4*UDATA_TOC_INDEX_DISPLACEMENTS) {
+            udata_printError(ds, "tocindex_swap(): too few bytes (%d after header) for a ToC index\n",
+                             length);
+            *pErrorCode=U_INDEX_OUTOFBOUNDS_ERROR;
+            return 0;
+        }
+    }
+
+    count=(int32_t)(ds->readUInt32(((const uint32_t *)inBytes)[UDATA_TOC_INDEX_COUNT])&~UDATA_TOC_INDEX_INVALID);
+    bucketCount=udata_readInt32(ds, ((const int32_t *)inBytes)[UDATA_TOC_INDEX_BUCKET_COUNT]);
+    size=4*(UDATA_TOC_INDEX_DISPLACEMENTS+bucketCount+count);
+
+    if(length>=0) {
+        if(length<size) {
+            udata_printError(ds, "tocindex_swap(): too few bytes (%d after header) for the ToC index\n",
+                             length);
+            *pErrorCode=U_INDEX_OUTOFBOUNDS_ERROR;
+            return 0;
+        }
+
+        ds->swapArray32(ds, inBytes, size, outBytes, pErrorCode);
+
+        /*
+         * The hash values depend on the item names,
+         * which change with the package name and the charset family.
+         * Invalidate the index so that the loader ignores it.
+         * (icupkg builds a new index instead.)
+         */
+        ds->writeUInt32((uint32_t *)outBytes+UDATA_TOC_INDEX_COUNT, (uint32_t)count|UDATA_TOC_INDEX_INVALID);
+    }
+
+    return headerSize+size;
+}
+
 /* swap any data (except a .dat package) ------------------------------------ */
 
 static const struct {
@@ -741,6 +816,7 @@ static const struct {
 #if !UCONFIG_NO_NORMALIZATION
     { { 0x43, 0x66, 0x75, 0x20 }, uspoof_swap },         /* dataFormat="Cfu " */
 #endif
+    { { 0x54, 0x6f, 0x43, 0x48 }, tocindex_swap },      /* dataFormat="ToCH" */
     { { 0x54, 0x65, 0x73, 0x74 }, test_swap }            /* dataFormat="Test" */
 };
 